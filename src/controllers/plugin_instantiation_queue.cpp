@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_set>
+
+#include "controllers/plugin_instantiation_queue.h"
+#include "plugins/plugin.h"
+#include "structure/project/project.h"
+#include "utils/logger.h"
+
+namespace zrythm::controllers
+{
+
+namespace
+{
+/** Time to wait for more plugins to finish before requesting a graph update. */
+constexpr auto kReadyBatchInterval = std::chrono::milliseconds (100);
+
+/** Number of instantiations listed by report_durations(). */
+constexpr size_t kNumSlowestReported = 5;
+
+bool
+has_clip_at (const structure::tracks::Track &track, units::sample_t position)
+{
+  const auto * lanes = track.lanes ();
+  if (lanes == nullptr)
+    return false;
+
+  const auto is_hit = [position] (const structure::arrangement::Clip * clip) {
+    return clip->is_hit (position);
+  };
+  return std::ranges::any_of (lanes->lanes_view (), [&] (const auto * lane) {
+    return std::ranges::any_of (
+             lane->structure::arrangement::ArrangerObjectOwner<
+               structure::arrangement::MidiClip>::get_children_view (),
+             is_hit)
+           || std::ranges::any_of (
+             lane->structure::arrangement::ArrangerObjectOwner<
+               structure::arrangement::AudioClip>::get_children_view (),
+             is_hit);
+  });
+}
+}
+
+PluginInstantiationQueue::PluginInstantiationQueue (
+  int       max_in_flight,
+  QObject * parent)
+    : QObject (parent), max_in_flight_ (std::max (max_in_flight, 1)),
+      ready_timer_ (utils::make_qobject_unique<QTimer> (this))
+{
+  ready_timer_->setSingleShot (true);
+  ready_timer_->setInterval (kReadyBatchInterval);
+  QObject::connect (
+    ready_timer_.get (), &QTimer::timeout, this,
+    &PluginInstantiationQueue::pluginsReady);
+}
+
+int
+PluginInstantiationQueue::numPending () const
+{
+  return static_cast<int> (queue_.size ()) + num_in_flight ();
+}
+
+std::vector<plugins::Plugin *>
+PluginInstantiationQueue::collect_deferred_plugins (
+  const structure::project::Project &project)
+{
+  const auto &playhead = project.transport_->playhead ()->playhead ();
+  const auto  playhead_pos = playhead.get_tempo_map ().tick_to_samples_rounded (
+    dsp::TimelineTick{ playhead.position_ticks () });
+
+  std::vector<structure::tracks::Track *> tracks;
+  for (const auto &tr_ref : project.tracklist ()->collection ()->tracks ())
+    {
+      tracks.push_back (tr_ref.get ());
+    }
+  std::ranges::stable_partition (tracks, [&] (const auto * track) {
+    return has_clip_at (*track, playhead_pos);
+  });
+
+  std::vector<plugins::Plugin *>        ret;
+  std::unordered_set<plugins::Plugin *> added;
+  const auto add = [&] (plugins::Plugin * plugin) {
+    if (plugin->instantiation_deferred () && added.insert (plugin).second)
+      {
+        ret.push_back (plugin);
+      }
+  };
+  for (const auto * track : tracks)
+    {
+      std::vector<plugins::PluginUuidReference> plugins;
+      track->collect_plugins (plugins);
+      for (const auto &pl_ref : plugins)
+        {
+          add (pl_ref.get ());
+        }
+    }
+  project.get_registry ().for_each_matching<plugins::Plugin> (
+    [&] (plugins::Plugin &plugin) { add (&plugin); });
+  return ret;
+}
+
+void
+PluginInstantiationQueue::enqueue_deferred_plugins (
+  const structure::project::Project &project)
+{
+  const auto plugins = collect_deferred_plugins (project);
+  if (plugins.empty ())
+    return;
+
+  z_info ("Queueing {} deferred plugin instantiations", plugins.size ());
+  for (auto * plugin : plugins)
+    {
+      queue_.emplace_back (plugin);
+    }
+  Q_EMIT numPendingChanged ();
+
+  for (int i = num_in_flight (); i < max_in_flight_; ++i)
+    {
+      QTimer::singleShot (0, this, &PluginInstantiationQueue::start_next);
+    }
+}
+
+void
+PluginInstantiationQueue::start_next ()
+{
+  bool dropped_stale = false;
+  while (!queue_.empty () && num_in_flight () < max_in_flight_)
+    {
+      const QPointer<plugins::Plugin> plugin = queue_.front ();
+      queue_.pop_front ();
+
+      // removed or instantiated in the meantime
+      if (plugin.isNull () || !plugin->instantiation_deferred ())
+        {
+          dropped_stale = true;
+          Q_EMIT numPendingChanged ();
+          continue;
+        }
+
+      in_flight_.push_back (plugin.data ());
+      QObject::connect (
+        plugin.data (), &plugins::Plugin::instantiationFinished, this,
+        [this, obj = plugin.data ()] (bool successful) {
+          if (const auto duration = obj->instantiation_duration ())
+            {
+              durations_.emplace_back (obj->get_name (), *duration);
+            }
+          on_plugin_finished (obj, successful);
+        },
+        Qt::SingleShotConnection);
+      QObject::connect (
+        plugin.data (), &QObject::destroyed, this,
+        [this] (QObject * obj) { on_plugin_finished (obj, false); });
+      plugin->instantiate ();
+
+      // one per event loop iteration
+      break;
+    }
+
+  if (dropped_stale && numPending () == 0)
+    {
+      report_durations ();
+      Q_EMIT finished ();
+    }
+}
+
+void
+PluginInstantiationQueue::on_plugin_finished (
+  const QObject * plugin,
+  bool            successful)
+{
+  if (std::erase (in_flight_, plugin) == 0)
+    return;
+
+  Q_EMIT numPendingChanged ();
+  if (successful)
+    {
+      ready_timer_->start ();
+    }
+  if (numPending () == 0)
+    {
+      report_durations ();
+      Q_EMIT finished ();
+      return;
+    }
+  QTimer::singleShot (0, this, &PluginInstantiationQueue::start_next);
+}
+
+void
+PluginInstantiationQueue::report_durations ()
+{
+  if (durations_.empty ())
+    return;
+
+  std::ranges::sort (durations_, std::ranges::greater{}, [] (const auto &d) {
+    return d.second;
+  });
+  const auto to_ms = [] (std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::milliseconds> (duration)
+      .count ();
+  };
+  z_info ("Instantiated {} deferred plugins, slowest:", durations_.size ());
+  for (
+    const auto &[name, duration] :
+    durations_ | std::views::take (kNumSlowestReported))
+    {
+      z_info ("  {}: {} ms", name, to_ms (duration));
+    }
+  durations_.clear ();
+}
+
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "utils/qt.h"
+#include "utils/utf8_string.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QtQmlIntegration/qqmlintegration.h>
+
+namespace zrythm::plugins
+{
+class Plugin;
+}
+
+namespace zrythm::structure::project
+{
+class Project;
+}
+
+namespace zrythm::controllers
+{
+
+/**
+ * @brief Instantiates plugins whose instantiation was deferred while loading a
+ * project (see Plugin::defer_instantiation()).
+ *
+ * This allows the project to be shown (and edited) before its plugins are
+ * ready. Plugins are started one per event loop iteration so that the UI stays
+ * responsive, with a bounded number of (asynchronous) instantiations in
+ * flight at a time. Plugins that allow it are created concurrently on
+ * Plugin::instantiation_thread_pool().
+ *
+ * Plugins that just finished instantiating must be prepared for processing
+ * before they can process (until then they pass their input through), so
+ * pluginsReady() is emitted to request a graph update, batched for plugins
+ * that finish close together.
+ */
+class PluginInstantiationQueue : public QObject
+{
+  Q_OBJECT
+  Q_PROPERTY (int numPending READ numPending NOTIFY numPendingChanged)
+  QML_ELEMENT
+  QML_UNCREATABLE ("")
+
+public:
+  explicit PluginInstantiationQueue (
+    int       max_in_flight,
+    QObject * parent = nullptr);
+
+  // ========================================================================
+  // QML Interface
+  // ========================================================================
+
+  /**
+   * @brief Number of plugins that haven't finished instantiating yet.
+   */
+  int           numPending () const;
+  Q_SIGNAL void numPendingChanged ();
+
+  // ========================================================================
+
+  /**
+   * @brief Returns the project's deferred plugins in the order they should be
+   * instantiated.
+   *
+   * Plugins on tracks with clips under the playhead come first (what the user
+   * is most likely to play next), then the plugins on the rest of the tracks,
+   * both in track order. Deferred plugins not on any track come last.
+   */
+  static std::vector<plugins::Plugin *>
+  collect_deferred_plugins (const structure::project::Project &project);
+
+  /**
+   * @brief Queues all the deferred plugins of @p project.
+   *
+   * @see collect_deferred_plugins().
+   */
+  void enqueue_deferred_plugins (const structure::project::Project &project);
+
+  /**
+   * @brief Emitted (batched) when one or more plugins finished instantiating.
+   *
+   * The handler should update the processing graph so that the plugins get
+   * prepared for processing.
+   */
+  Q_SIGNAL void pluginsReady ();
+
+  /**
+   * @brief Emitted when all queued plugins finished instantiating.
+   */
+  Q_SIGNAL void finished ();
+
+private:
+  /**
+   * @brief Starts the next queued plugin, if allowed.
+   */
+  void start_next ();
+
+  /**
+   * @brief Called when an instantiation started by start_next() finished or
+   * the plugin was deleted before finishing.
+   */
+  void on_plugin_finished (const QObject * plugin, bool successful);
+
+  int num_in_flight () const { return static_cast<int> (in_flight_.size ()); }
+
+  /**
+   * @brief Logs the slowest instantiations since the last report.
+   */
+  void report_durations ();
+
+private:
+  int max_in_flight_;
+
+  std::deque<QPointer<plugins::Plugin>> queue_;
+
+  /** Plugins whose instantiation is underway. */
+  std::vector<const QObject *> in_flight_;
+
+  /** Instantiation times of finished plugins, for report_durations(). */
+  std::vector<std::pair<utils::Utf8String, std::chrono::steady_clock::duration>>
+    durations_;
+
+  /** Batches pluginsReady() emissions. */
+  utils::QObjectUniquePtr<QTimer> ready_timer_;
+};
+
+}
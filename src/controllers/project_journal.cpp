@@ -0,0 +1,312 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+
+#include "utils/format_qt.h"
+#include <fmt/std.h>
+
+#include "controllers/project_journal.h"
+#include "controllers/project_json_serializer.h"
+#include "structure/project/project.h"
+#include "utils/io_utils.h"
+
+#include <QFile>
+
+namespace zrythm::controllers
+{
+
+namespace
+{
+const nlohmann::json::json_pointer &
+registry_pointer ()
+{
+  static const nlohmann::json::json_pointer ptr (
+    fmt::format (
+      "/{}/{}", ProjectJsonSerializer::kProjectData,
+      structure::project::Project::kRegistryKey));
+  return ptr;
+}
+
+constexpr auto kIdKey = "id"sv;
+}
+
+ProjectJournal::ProjectJournal (std::filesystem::path path)
+    : path_ (std::move (path))
+{
+}
+
+nlohmann::json
+ProjectJournal::to_keyed (nlohmann::json document)
+{
+  if (!document.contains (registry_pointer ()))
+    return document;
+
+  for (auto &bucket : document[registry_pointer ()])
+    {
+      const auto has_id = [] (const nlohmann::json &obj) {
+        const auto it = obj.find (kIdKey);
+        return it != obj.end () && it->is_string ();
+      };
+      if (!bucket.is_array () || !std::ranges::all_of (bucket, has_id))
+        {
+          z_warning ("not keying registry bucket (objects without an ID)");
+          continue;
+        }
+
+      // the registry has a single object per UUID
+      auto keyed = nlohmann::json::object ();
+      for (auto &obj : bucket)
+        {
+          const auto id = obj[kIdKey].get<std::string> ();
+          keyed[id] = std::move (obj);
+        }
+      bucket = std::move (keyed);
+    }
+  return document;
+}
+
+nlohmann::json
+ProjectJournal::from_keyed (nlohmann::json keyed)
+{
+  if (!keyed.contains (registry_pointer ()))
+    return keyed;
+
+  // the order of registry objects doesn't matter
+  for (auto &bucket : keyed[registry_pointer ()])
+    {
+      if (!bucket.is_object ())
+        continue;
+
+      auto arr = nlohmann::json::array ();
+      for (auto &obj : bucket)
+        {
+          arr.push_back (std::move (obj));
+        }
+      bucket = std::move (arr);
+    }
+  return keyed;
+}
+
+void
+ProjectJournal::append_line (std::string_view line, bool truncate)
+{
+  QFile file (utils::Utf8String::from_path (path_).to_qstring ());
+  if (!file.open (
+        QIODevice::WriteOnly
+        | (truncate ? QIODevice::Truncate : QIODevice::Append)))
+    {
+      throw ZrythmException (
+        fmt::format (
+          "Failed to open journal at {}: {}", path_, file.errorString ()));
+    }
+
+  std::string str{ line };
+  str += '\n';
+  if (
+    file.write (str.data (), static_cast<qint64> (str.size ()))
+      != static_cast<qint64> (str.size ())
+    || !file.flush ())
+    {
+      throw ZrythmException (
+        fmt::format (
+          "Failed to write journal at {}: {}", path_, file.errorString ()));
+    }
+}
+
+void
+ProjectJournal::reset (utils::hash::HashT snapshot_hash, Revision revision)
+{
+  const std::lock_guard lock (mutex_);
+  append_line (
+    nlohmann::json{
+      { kSnapshotHashKey, utils::hash::to_string (snapshot_hash) } }
+      .dump (),
+    true);
+
+  // entries serialized after the snapshot are not part of it
+  std::erase_if (lines_, [revision] (const auto &line) {
+    return line.first <= revision;
+  });
+  for (const auto &line : lines_ | std::views::values)
+    {
+      append_line (line, false);
+    }
+  started_ = true;
+  snapshot_revision_ = revision;
+  section_hashes_.clear ();
+}
+
+void
+ProjectJournal::resume (Revision revision)
+{
+  const std::lock_guard lock (mutex_);
+  started_ = true;
+  snapshot_revision_ = revision;
+  section_hashes_.clear ();
+  lines_.clear ();
+}
+
+size_t
+ProjectJournal::append (Entry entry, Revision revision)
+{
+  const std::lock_guard lock (mutex_);
+  if (!started_ || revision <= snapshot_revision_)
+    return 0;
+
+  auto   sections = nlohmann::json::object ();
+  size_t num_changes = entry.removed.size ();
+  for (const auto &objects : entry.objects)
+    {
+      num_changes += objects.size ();
+    }
+  std::vector<std::pair<std::string, utils::hash::HashT>> section_hashes;
+  for (auto &[ptr, contents] : entry.sections)
+    {
+      const auto hash = utils::hash::get_string_hash (contents.dump ());
+      if (const auto it = section_hashes_.find (ptr);
+          it != section_hashes_.end () && it->second == hash)
+        continue;
+
+      section_hashes.emplace_back (ptr, hash);
+      sections[ptr] = std::move (contents);
+      ++num_changes;
+    }
+  if (num_changes == 0)
+    return 0;
+
+  auto line = nlohmann::json{
+    { kObjectsKey, std::move (entry.objects) },
+    { kRemovedKey, std::move (entry.removed) },
+    { kSectionsKey, std::move (sections) },
+  }.dump ();
+  append_line (line, false);
+  for (auto &[ptr, hash] : section_hashes)
+    {
+      section_hashes_.insert_or_assign (std::move (ptr), hash);
+    }
+  lines_.emplace_back (revision, std::move (line));
+  return num_changes;
+}
+
+void
+ProjectJournal::remove ()
+{
+  const std::lock_guard lock (mutex_);
+  started_ = false;
+  section_hashes_.clear ();
+  lines_.clear ();
+  utils::io::remove (path_);
+}
+
+void
+ProjectJournal::apply_entry (nlohmann::json &keyed, const nlohmann::json &entry)
+{
+  auto &registry = keyed.at (registry_pointer ());
+  for (const auto &id : entry.at (kRemovedKey))
+    {
+      for (auto &bucket : registry)
+        {
+          if (bucket.is_object ())
+            bucket.erase (id.get<std::string> ());
+        }
+    }
+  for (const auto &[bucket, objects] : entry.at (kObjectsKey).items ())
+    {
+      for (const auto &[id, obj] : objects.items ())
+        {
+          registry[bucket][id] = obj;
+        }
+    }
+  for (const auto &[ptr, contents] : entry.at (kSectionsKey).items ())
+    {
+      keyed[nlohmann::json::json_pointer (ptr)] = contents;
+    }
+}
+
+size_t
+ProjectJournal::replay (
+  nlohmann::json              &snapshot,
+  utils::hash::HashT           snapshot_hash,
+  const std::filesystem::path &path)
+{
+  if (!utils::io::path_exists (path))
+    return 0;
+
+  QByteArray contents;
+  try
+    {
+      contents = utils::io::read_file_contents (path);
+    }
+  catch (const ZrythmException &e)
+    {
+      z_warning ("Failed to read journal at {}: {}", path, e.what ());
+      return 0;
+    }
+
+  const auto lines = contents.split ('\n');
+  try
+    {
+      const auto header = nlohmann::json::parse (
+        lines.front ().constData (),
+        lines.front ().constData () + lines.front ().size ());
+      if (
+        header.value (kSnapshotHashKey, std::string{})
+        != utils::hash::to_string (snapshot_hash))
+        {
+          z_warning (
+            "Ignoring journal at {} (made for another snapshot)", path);
+          return 0;
+        }
+    }
+  catch (const nlohmann::json::exception &e)
+    {
+      z_warning ("Ignoring journal at {}: {}", path, e.what ());
+      return 0;
+    }
+
+  auto   keyed = to_keyed (snapshot);
+  size_t num_entries = 0;
+  for (const auto &line : lines | std::views::drop (1))
+    {
+      if (line.isEmpty ())
+        continue;
+
+      nlohmann::json entry;
+      try
+        {
+          entry = nlohmann::json::parse (
+            line.constData (), line.constData () + line.size ());
+        }
+      catch (const nlohmann::json::parse_error &e)
+        {
+          // only the last entry can be incomplete
+          z_warning ("Discarding incomplete journal entry: {}", e.what ());
+          break;
+        }
+
+      try
+        {
+          apply_entry (keyed, entry);
+        }
+      catch (const nlohmann::json::exception &e)
+        {
+          z_warning (
+            "Failed to apply journal entry {} from {}: {}", num_entries + 1,
+            path, e.what ());
+          return 0;
+        }
+      ++num_entries;
+    }
+
+  if (num_entries > 0)
+    {
+      snapshot = from_keyed (std::move (keyed));
+    }
+  z_info ("Replayed {} journal entries from {}", num_entries, path);
+  return num_entries;
+}
+
+}
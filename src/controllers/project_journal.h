@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "utils/hash.h"
+
+#include <nlohmann/json.hpp>
+
+namespace zrythm::controllers
+{
+
+using namespace std::string_view_literals;
+
+/**
+ * @brief Append-only log of the changes made to a project document since the
+ * last snapshot (the project file written by the last full save).
+ *
+ * Each entry is written as a single line of compact JSON containing only what
+ * changed: the registry objects that were added or changed (see
+ * structure::project::ProjectRegistry::take_changes()), the IDs of the ones
+ * that were removed, and the document sections outside the registry whose
+ * contents changed since the previous entry. The I/O and serialization per
+ * entry are therefore proportional to the edit rather than to the project.
+ * Only the hashes of the sections are kept in memory, never the document.
+ *
+ * The first line records the hash of the snapshot's contents so that a
+ * journal is never replayed onto a different snapshot (e.g. after a crash
+ * between writing the project file and restarting the journal). An
+ * incomplete last line (e.g. after a crash while appending) is ignored.
+ *
+ * The journal is removed when the project is closed normally, so an existing
+ * journal means the project has unsaved changes from a session that didn't
+ * end cleanly.
+ *
+ * All methods are thread-safe.
+ */
+class ProjectJournal
+{
+public:
+  using Revision = std::uint64_t;
+
+  /**
+   * @brief Changes to append to the journal.
+   */
+  struct Entry
+  {
+    /**
+     * @brief Added or changed registry objects, keyed by registry bucket and
+     * then by ID (see ProjectRegistry::serialize_objects()).
+     */
+    nlohmann::json objects = nlohmann::json::object ();
+
+    /** IDs of the objects removed from the registry. */
+    std::vector<std::string> removed;
+
+    /**
+     * @brief Current contents of the sections outside the registry, keyed by
+     * their JSON pointer in the document.
+     *
+     * Sections that didn't change since the previous entry are dropped.
+     */
+    std::vector<std::pair<std::string, nlohmann::json>> sections;
+  };
+
+  explicit ProjectJournal (std::filesystem::path path);
+
+  const std::filesystem::path &path () const { return path_; }
+
+  /**
+   * @brief Returns a new revision number for a document or entry that has
+   * just been serialized.
+   *
+   * Snapshots and entries may reach the journal out of order (they are
+   * written on worker threads), so the journal uses the revision to drop
+   * entries already contained in the snapshot.
+   */
+  Revision next_revision () { return ++revision_counter_; }
+
+  /**
+   * @brief Starts a new journal on top of a snapshot.
+   *
+   * Entries newer than the snapshot that were already appended are kept.
+   *
+   * @param snapshot_hash Hash of the (uncompressed) project file contents.
+   * @param revision Revision of the snapshot.
+   * @throw ZrythmException if the journal file can't be written.
+   */
+  void reset (utils::hash::HashT snapshot_hash, Revision revision);
+
+  /**
+   * @brief Continues the existing journal file.
+   *
+   * @see replay().
+   */
+  void resume (Revision revision);
+
+  /**
+   * @brief Appends @p entry.
+   *
+   * Does nothing if the journal wasn't started, @p entry has no changes or
+   * it is older than the snapshot.
+   *
+   * @return The number of objects and sections appended.
+   * @throw ZrythmException if the journal file can't be written.
+   */
+  size_t append (Entry entry, Revision revision);
+
+  /**
+   * @brief Stops journaling and removes the journal file.
+   *
+   * @throw ZrythmException if the file can't be removed.
+   */
+  void remove ();
+
+  /**
+   * @brief Applies the journal at @p path onto @p snapshot.
+   *
+   * Leaves @p snapshot untouched if the journal belongs to another snapshot or
+   * its entries can't be applied.
+   *
+   * @param snapshot_hash Hash of the (uncompressed) project file contents.
+   * @return The number of entries applied.
+   */
+  static size_t replay (
+    nlohmann::json              &snapshot,
+    utils::hash::HashT           snapshot_hash,
+    const std::filesystem::path &path);
+
+private:
+  static constexpr auto kSnapshotHashKey = "snapshotHash"sv;
+  static constexpr auto kObjectsKey = "objects"sv;
+  static constexpr auto kRemovedKey = "removed"sv;
+  static constexpr auto kSectionsKey = "sections"sv;
+
+  /**
+   * @brief Converts the registry buckets of a project document to objects
+   * keyed by UUID.
+   */
+  static nlohmann::json to_keyed (nlohmann::json document);
+
+  /**
+   * @brief Inverse of to_keyed().
+   */
+  static nlohmann::json from_keyed (nlohmann::json keyed);
+
+  /**
+   * @brief Applies an entry line to a keyed document.
+   *
+   * @throw nlohmann::json::exception if the entry can't be applied.
+   */
+  static void apply_entry (nlohmann::json &keyed, const nlohmann::json &entry);
+
+  void append_line (std::string_view line, bool truncate);
+
+private:
+  std::filesystem::path path_;
+
+  std::atomic<Revision> revision_counter_;
+
+  std::mutex mutex_;
+
+  bool started_{};
+
+  /** Revision of the snapshot. */
+  Revision snapshot_revision_{};
+
+  /** Hashes of the sections written since the snapshot. */
+  std::map<std::string, utils::hash::HashT> section_hashes_;
+
+  /**
+   * @brief Lines appended since the snapshot, with their revision.
+   *
+   * Kept so that reset() can carry over entries newer than the new snapshot.
+   */
+  std::vector<std::pair<Revision, std::string>> lines_;
+};
+
+}
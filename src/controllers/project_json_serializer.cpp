@@ -67,6 +67,52 @@ ProjectJsonSerializer::serialize (
   return j;
 }
 
+std::string
+ProjectJsonSerializer::encode (const nlohmann::json &j, Encoding encoding)
+{
+  switch (encoding)
+    {
+    case Encoding::Json:
+      return j.dump (2);
+    case Encoding::Cbor:
+      {
+        std::string data{ CBOR_MAGIC };
+        nlohmann::json::to_cbor (j, data);
+        return data;
+      }
+    }
+  z_return_val_if_reached ({});
+}
+
+ProjectJsonSerializer::Encoding
+ProjectJsonSerializer::detect_encoding (std::string_view data)
+{
+  return data.starts_with (CBOR_MAGIC) ? Encoding::Cbor : Encoding::Json;
+}
+
+nlohmann::json
+ProjectJsonSerializer::decode (std::string_view data)
+{
+  try
+    {
+      switch (detect_encoding (data))
+        {
+        case Encoding::Json:
+          return nlohmann::json::parse (data);
+        case Encoding::Cbor:
+          data.remove_prefix (CBOR_MAGIC.size ());
+          return nlohmann::json::from_cbor (
+            data, true, true, nlohmann::json::cbor_tag_handler_t::error);
+        }
+    }
+  catch (const nlohmann::json::exception &e)
+    {
+      throw ZrythmException (
+        fmt::format ("Failed to parse project data: {}", e.what ()));
+    }
+  z_return_val_if_reached ({});
+}
+
 void
 ProjectJsonSerializer::validate_json (const nlohmann::json &j)
 {
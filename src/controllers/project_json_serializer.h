@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
 
 #include "utils/version.h"
@@ -47,6 +49,30 @@ public:
   static constexpr auto kDatetimeKey = "datetime"sv;
   static constexpr auto kTitle = "title"sv;
 
+  /**
+   * @brief How the project document is stored in the project file.
+   *
+   * Both encodings hold the same document (following the same schema), so a
+   * project can be converted by loading it and saving it with the other
+   * encoding.
+   */
+  enum class Encoding : std::uint8_t
+  {
+    /** JSON text (the default). */
+    Json,
+
+    /**
+     * @brief CBOR (RFC 8949), which is faster to write and parse than text.
+     *
+     * Starts with the CBOR self-describe tag (@ref CBOR_MAGIC) so that it can
+     * be told apart from JSON text.
+     */
+    Cbor,
+  };
+
+  /** Encoded CBOR self-describe tag (55799). */
+  static constexpr auto CBOR_MAGIC = "\xd9\xd9\xf7"sv;
+
   /**
    * @brief Returns a json representation of the project.
    *
@@ -64,6 +90,29 @@ public:
     const utils::Version                     &app_version,
     std::string_view                          title);
 
+  /**
+   * @brief Encodes the project document.
+   *
+   * @param j The document (as returned by serialize()).
+   * @param encoding The encoding to use.
+   * @return The encoded bytes.
+   */
+  static std::string encode (const nlohmann::json &j, Encoding encoding);
+
+  /**
+   * @brief Returns the encoding of an encoded project document.
+   */
+  static Encoding detect_encoding (std::string_view data);
+
+  /**
+   * @brief Decodes a project document in any encoding (without validating
+   * it).
+   *
+   * @param data Bytes returned by encode().
+   * @throw ZrythmException if the data can't be decoded.
+   */
+  static nlohmann::json decode (std::string_view data);
+
   /**
    * @brief Validates JSON against the project schema.
    *
@@ -3,10 +3,12 @@
 
 #include <fmt/std.h>
 
+#include "controllers/project_journal.h"
 #include "controllers/project_json_serializer.h"
 #include "controllers/project_loader.h"
 #include "controllers/project_saver.h"
 #include "plugins/plugin.h"
+#include "plugins/plugin_factory.h"
 #include "structure/project/project_path_provider.h"
 #include "structure/project/project_ui_state.h"
 #include "undo/undo_stack.h"
@@ -30,16 +32,7 @@ ProjectLoader::get_uncompressed_project_text (
 nlohmann::json
 ProjectLoader::parse_and_validate (const std::string &json_str)
 {
-  nlohmann::json j;
-  try
-    {
-      j = nlohmann::json::parse (json_str);
-    }
-  catch (const nlohmann::json::parse_error &e)
-    {
-      throw ZrythmException (
-        fmt::format ("Failed to parse project JSON: {}", e.what ()));
-    }
+  auto j = ProjectJsonSerializer::decode (json_str);
 
   // Validate against schema
   ProjectJsonSerializer::validate_json (j);
@@ -92,7 +85,18 @@ ProjectLoader::load_from_directory (const std::filesystem::path &project_dir)
     if (promise.isCanceled ())
       return;
 
-    auto j = parse_and_validate (json_str);
+    const auto encoding = ProjectJsonSerializer::detect_encoding (json_str);
+    const auto file_hash = utils::hash::get_string_hash (json_str);
+    auto       j = ProjectJsonSerializer::decode (json_str);
+
+    // recover unsaved changes
+    const auto num_journal_entries = ProjectJournal::replay (
+      j, file_hash,
+      project_dir
+        / structure::project::ProjectPathProvider::get_path (
+          structure::project::ProjectPathProvider::ProjectPath::JournalFile));
+
+    ProjectJsonSerializer::validate_json (j);
 
     // 4. Extract metadata
     promise.setProgressValueAndText (3, QObject::tr ("Extracting metadata..."));
@@ -108,7 +112,10 @@ ProjectLoader::load_from_directory (const std::filesystem::path &project_dir)
       LoadResult{
         .json = std::move (j),
         .title = std::move (title),
-        .project_directory = project_dir });
+        .project_directory = project_dir,
+        .encoding = encoding,
+        .file_hash = file_hash,
+        .num_journal_entries = num_journal_entries });
   });
 }
 
@@ -117,15 +124,34 @@ ProjectLoader::deserialize (
   const nlohmann::json               &j,
   structure::project::Project        &project,
   structure::project::ProjectUiState &ui_state,
-  undo::UndoStack                    &undo_stack)
+  undo::UndoStack                    &undo_stack,
+  PluginInstantiation                 plugin_instantiation)
 {
-  ProjectJsonSerializer::deserialize (j, project, ui_state, undo_stack);
+  const bool defer_plugins =
+    plugin_instantiation == PluginInstantiation::Deferred;
+  project.plugin_factory_->set_defer_instantiation (defer_plugins);
+  try
+    {
+      ProjectJsonSerializer::deserialize (j, project, ui_state, undo_stack);
+    }
+  catch (...)
+    {
+      project.plugin_factory_->set_defer_instantiation (false);
+      throw;
+    }
+  project.plugin_factory_->set_defer_instantiation (false);
 
   // Load audio files for each FileAudioSource
   project.pool_->init_loaded ();
 
+  // Deferred plugins pass their input through until they are instantiated
+  // and prepared for processing again
+  if (defer_plugins)
+    return;
+
   // Wait for all asynchronously-instantiating plugins to finish.
-  // JUCE (VST3/AU) plugins instantiate asynchronously — deserialization
+  // JUCE (VST3/AU) plugins, and CLAP plugins created on the instantiation
+  // thread pool, instantiate asynchronously — deserialization
   // triggers the init but returns before it completes. If we don't wait,
   // the engine can start processing before buffers are allocated.
   wait_for_plugin_instantiations (project);
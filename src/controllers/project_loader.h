@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 
+#include "controllers/project_json_serializer.h"
+#include "utils/hash.h"
 #include "utils/utf8_string.h"
 
 #include <QFuture>
@@ -32,10 +35,14 @@ namespace zrythm::controllers
  * This class manages the complete project loading pipeline:
  * 1. Reading compressed project file
  * 2. Zstd decompression
- * 3. JSON parsing
- * 4. Schema validation
- * 5. Metadata extraction
- * 6. Deserialization of Project, ProjectUiState, and UndoStack
+ * 3. JSON (or CBOR) parsing
+ * 4. Replaying the journal of unsaved changes, if any (see ProjectJournal)
+ * 5. Schema validation
+ * 6. Metadata extraction
+ * 7. Deserialization of Project, ProjectUiState, and UndoStack
+ *
+ * Plugins can optionally be instantiated after the project is shown (see
+ * PluginInstantiation).
  */
 class ProjectLoader
 {
@@ -48,6 +55,20 @@ public:
     nlohmann::json        json;
     utils::Utf8String     title;
     std::filesystem::path project_directory;
+
+    /** Encoding of the project file (to save the project with). */
+    ProjectJsonSerializer::Encoding encoding{};
+
+    /** Hash of the uncompressed project file contents. */
+    utils::hash::HashT file_hash{};
+
+    /**
+     * @brief Number of journal entries replayed onto the project file.
+     *
+     * Non-zero if the project was recovered from a session that didn't end
+     * cleanly (the changes are not in the project file).
+     */
+    size_t num_journal_entries{};
   };
 
   /**
@@ -64,16 +85,17 @@ public:
    * @brief Reads and decompresses the project file.
    *
    * @param project_dir The project directory.
-   * @return The decompressed JSON string.
+   * @return The decompressed project data (JSON text or CBOR, see
+   * ProjectJsonSerializer::Encoding).
    * @throw ZrythmException if reading or decompression fails.
    */
   static std::string
   get_uncompressed_project_text (const std::filesystem::path &project_dir);
 
   /**
-   * @brief Parses JSON string and validates against schema.
+   * @brief Parses the project data and validates it against the schema.
    *
-   * @param json_str The raw JSON string.
+   * @param json_str The decompressed project data, in any encoding.
    * @return Parsed and validated JSON object.
    * @throw ZrythmException if parsing or validation fails.
    */
@@ -87,6 +109,23 @@ public:
    */
   static utils::Utf8String extract_title (const nlohmann::json &j);
 
+  /**
+   * @brief How deserialize() instantiates the project's plugins.
+   */
+  enum class PluginInstantiation : std::uint8_t
+  {
+    /** Instantiate all plugins and wait for them to finish. */
+    Blocking,
+
+    /**
+     * @brief Leave external plugins uninstantiated, so that the project can
+     * be shown before they are ready.
+     *
+     * They are to be instantiated with a PluginInstantiationQueue.
+     */
+    Deferred,
+  };
+
   /**
    * @brief Deserializes the project data into the given objects.
    *
@@ -94,13 +133,15 @@ public:
    * @param project The project instance to populate.
    * @param ui_state The UI state instance to populate.
    * @param undo_stack The undo stack instance to populate.
+   * @param plugin_instantiation How to instantiate plugins.
    * @throw ZrythmException on deserialization error.
    */
   static void deserialize (
     const nlohmann::json               &j,
     structure::project::Project        &project,
     structure::project::ProjectUiState &ui_state,
-    undo::UndoStack                    &undo_stack);
+    undo::UndoStack                    &undo_stack,
+    PluginInstantiation plugin_instantiation = PluginInstantiation::Blocking);
 
 private:
   /**
@@ -11,9 +11,16 @@
 #include "structure/project/project_ui_state.h"
 #include "undo/undo_stack.h"
 #include "utils/format.h"
+#include "utils/hash.h"
 #include "utils/io_utils.h"
 #include "utils/views.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <QThreadPool>
 #include <QtConcurrentRun>
 
 #include <zstd.h>
@@ -21,6 +28,27 @@
 namespace zrythm::controllers
 {
 
+namespace
+{
+/** Held while writing a project file (saves may overlap, e.g. when saving
+ * while the previous save is still being written). */
+std::mutex project_file_write_mutex;
+
+/**
+ * @brief Pool writing journal entries.
+ *
+ * Entries only contain what changed since the previous one, so they are
+ * written one at a time, in order.
+ */
+QThreadPool &
+journal_write_pool ()
+{
+  static QThreadPool pool;
+  pool.setMaxThreadCount (1);
+  return pool;
+}
+}
+
 void
 ProjectSaver::make_project_dirs (const std::filesystem::path &project_directory)
 {
@@ -65,8 +93,32 @@ ProjectSaver::compress_or_decompress (
       z_info ("compressing project...");
       size_t compress_bound = ZSTD_compressBound (src.size ());
       dest = (char *) malloc (compress_bound);
+#if ZSTD_VERSION_NUMBER >= 10400
+      /* compress in parallel jobs if zstd was built with multithreading
+       * support (otherwise this falls back to compressing on this thread) */
+      const std::unique_ptr<ZSTD_CCtx, decltype (&ZSTD_freeCCtx)> cctx (
+        ZSTD_createCCtx (), ZSTD_freeCCtx);
+      if (cctx == nullptr)
+        {
+          free (dest);
+          throw ZrythmException ("Failed to create zstd context");
+        }
+      ZSTD_CCtx_setParameter (cctx.get (), ZSTD_c_compressionLevel, 1);
+      const auto nb_workers_ret = ZSTD_CCtx_setParameter (
+        cctx.get (), ZSTD_c_nbWorkers,
+        static_cast<int> (std::max (1u, std::thread::hardware_concurrency ())));
+      if (ZSTD_isError (nb_workers_ret))
+        {
+          z_debug (
+            "compressing on a single thread: {}",
+            ZSTD_getErrorName (nb_workers_ret));
+        }
+      dest_size = ZSTD_compress2 (
+        cctx.get (), dest, compress_bound, src.constData (), src.size ());
+#else
       dest_size =
         ZSTD_compress (dest, compress_bound, src.constData (), src.size (), 1);
+#endif
       if (ZSTD_isError (dest_size))
         {
           free (dest);
@@ -190,10 +242,8 @@ ProjectSaver::get_existing_uncompressed_text (
         project_file_path));
     }
 
-  /* make string null-terminated */
-  text = (char *) realloc (text, text_size + sizeof (char));
-  text[text_size] = '\0';
-  std::string ret (text);
+  /* binary encodings may contain null bytes */
+  std::string ret (text, text_size);
   free (text);
   return ret;
 }
@@ -309,9 +359,13 @@ ProjectSaver::save (
   const undo::UndoStack                    &undo_stack,
   utils::Version                            app_version,
   const std::filesystem::path              &path,
-  bool                                      is_backup)
+  bool                                      is_backup,
+  ProjectJsonSerializer::Encoding           encoding,
+  std::shared_ptr<ProjectJournal>           journal)
 {
-  z_info ("Saving project at {}, is backup: {}", path, is_backup);
+  z_info (
+    "Saving project at {}, is backup: {}, binary: {}", path, is_backup,
+    encoding == ProjectJsonSerializer::Encoding::Cbor);
 
   const auto title = utils::Utf8String::from_path (path.filename ());
   const auto project_file_path =
@@ -336,9 +390,13 @@ ProjectSaver::save (
       engine_paused = true;
     }
 
-  const auto resume_engine = [engine, engine_paused, state] () {
-    if (engine_paused)
+  // the engine is resumed as soon as the project is serialized (or on
+  // failure) - the rest of the save works on the serialized copy
+  auto       engine_resumed = std::make_shared<bool> (false);
+  const auto resume_engine = [engine, engine_paused, state, engine_resumed] () {
+    if (engine_paused && !*engine_resumed)
       {
+        *engine_resumed = true;
         engine->resume (state);
       }
   };
@@ -365,16 +423,25 @@ ProjectSaver::save (
     project.pool_->write_to_disk (is_backup);
   };
 
-  const auto build_json_task =
-    [&project, &ui_state, &undo_stack, app_version, title] () {
-      z_debug ("serializing project to json...");
-      QElapsedTimer timer;
-      timer.start ();
-      auto json = ProjectJsonSerializer::serialize (
-        project, ui_state, undo_stack, app_version, title.view ());
-      z_debug ("time to serialize: {}ms", timer.elapsed ());
-      return json;
-    };
+  // revision of the saved document in the journal
+  auto journal_revision = std::make_shared<ProjectJournal::Revision> ();
+
+  const auto build_json_task = [&project, &ui_state, &undo_stack, app_version,
+                                title, resume_engine, journal,
+                                journal_revision] () {
+    z_debug ("serializing project to json...");
+    QElapsedTimer timer;
+    timer.start ();
+    auto json = ProjectJsonSerializer::serialize (
+      project, ui_state, undo_stack, app_version, title.view ());
+    z_debug ("time to serialize: {}ms", timer.elapsed ());
+    if (journal != nullptr)
+      {
+        *journal_revision = journal->next_revision ();
+      }
+    resume_engine ();
+    return json;
+  };
 
   const auto validate_json_task = [] (const nlohmann::json &json) {
     z_debug ("Validating project JSON...");
@@ -393,39 +460,64 @@ ProjectSaver::save (
     return json;
   };
 
-  const auto write_json_task =
-    [temp_project_file_path] (const nlohmann::json &json) {
-      char * compressed_json{};
-      size_t compressed_size{};
-
-      const auto json_str = json.dump (2);
-      utils::io::set_file_contents (
-        temp_project_file_path.parent_path () / "project-debug.json",
-        utils::Utf8String::from_utf8_encoded_string (json_str));
-
-      /* compress */
-      // warning: this byte array depends on json_str being alive while it's used
-      QByteArray src_data = QByteArray::fromRawData (
-        json_str.c_str (), static_cast<qsizetype> (json_str.length ()));
-      compress (&compressed_json, &compressed_size, src_data);
-
-      /* set file contents */
-      z_debug ("saving project file at {}...", temp_project_file_path);
-      utils::io::set_file_contents (
-        temp_project_file_path, compressed_json, compressed_size);
-      free (compressed_json);
-    };
-
   const auto rename_file_task = [project_file_path, temp_project_file_path] () {
     utils::io::move_file (project_file_path, temp_project_file_path, true);
   };
 
+  const auto write_json_task = [temp_project_file_path, rename_file_task,
+                                 encoding, journal, journal_revision] (
+                                  const nlohmann::json &json) {
+    const std::lock_guard lock (project_file_write_mutex);
+
+    char * compressed_json{};
+    size_t compressed_size{};
+
+    z_debug ("encoding project...");
+    QElapsedTimer timer;
+    timer.start ();
+    const auto json_str = ProjectJsonSerializer::encode (json, encoding);
+    z_debug ("time to encode: {}ms", timer.elapsed ());
+    if (encoding == ProjectJsonSerializer::Encoding::Json)
+      {
+        utils::io::set_file_contents (
+          temp_project_file_path.parent_path () / "project-debug.json",
+          utils::Utf8String::from_utf8_encoded_string (json_str));
+      }
+
+    /* compress */
+    // warning: this byte array depends on json_str being alive while it's used
+    QByteArray src_data = QByteArray::fromRawData (
+      json_str.c_str (), static_cast<qsizetype> (json_str.length ()));
+    compress (&compressed_json, &compressed_size, src_data);
+
+    /* set file contents */
+    z_debug ("saving project file at {}...", temp_project_file_path);
+    utils::io::set_file_contents (
+      temp_project_file_path, compressed_json, compressed_size);
+    free (compressed_json);
+
+    rename_file_task ();
+
+    if (journal != nullptr)
+      {
+        // the saved changes no longer need to be recovered
+        try
+          {
+            journal->reset (
+              utils::hash::get_string_hash (json_str), *journal_revision);
+          }
+        catch (const ZrythmException &e)
+          {
+            z_warning ("Failed to restart project journal: {}", e.what ());
+          }
+      }
+  };
+
   return QtConcurrent::run (create_dirs_task)
     .then (engine, write_pool_task)
     .then (engine, build_json_task)
     .then (QtFuture::Launch::Async, validate_json_task)
     .then (QtFuture::Launch::Sync, write_json_task)
-    .then (QtFuture::Launch::Sync, rename_file_task)
     .then (
       engine,
       [path, is_backup, resume_engine] () {
@@ -449,4 +541,64 @@ ProjectSaver::save (
       return QString{};
     });
 }
+
+QFuture<size_t>
+ProjectSaver::write_journal_entry (
+  const structure::project::Project                  &project,
+  const structure::project::ProjectUiState           &ui_state,
+  const undo::UndoStack                              &undo_stack,
+  std::string_view                                    title,
+  const structure::project::ProjectRegistry::Changes &changes,
+  std::shared_ptr<ProjectJournal>                     journal)
+{
+  // only the changed objects (and the small sections outside the registry)
+  // are serialized. The engine only reads them (or updates atomics, like the
+  // playhead), so it keeps running
+  ProjectJournal::Entry entry;
+  entry.objects =
+    project.get_project_registry ().serialize_objects (changes.changed);
+  for (const auto &id : changes.removed)
+    {
+      entry.removed.push_back (nlohmann::json (id).get<std::string> ());
+    }
+  nlohmann::json project_sections;
+  project.serialize_without_registry (project_sections);
+  for (auto &[key, contents] : project_sections.items ())
+    {
+      entry.sections.emplace_back (
+        fmt::format ("/{}/{}", ProjectJsonSerializer::kProjectData, key),
+        std::move (contents));
+    }
+  entry.sections.emplace_back (
+    fmt::format ("/{}", ProjectJsonSerializer::kUiState), ui_state);
+  entry.sections.emplace_back (
+    fmt::format ("/{}", ProjectJsonSerializer::kUndoHistory), undo_stack);
+  entry.sections.emplace_back (
+    fmt::format ("/{}", ProjectJsonSerializer::kTitle), title);
+  const auto revision = journal->next_revision ();
+
+  return QtConcurrent::run (
+    &journal_write_pool (),
+    [journal = std::move (journal), revision,
+     entry = std::move (entry)] () mutable -> size_t {
+      QElapsedTimer timer;
+      timer.start ();
+      try
+        {
+          const auto num_changes =
+            journal->append (std::move (entry), revision);
+          if (num_changes > 0)
+            {
+              z_debug (
+                "journaled {} changes in {}ms", num_changes, timer.elapsed ());
+            }
+          return num_changes;
+        }
+      catch (const ZrythmException &e)
+        {
+          z_warning ("Failed to write journal entry: {}", e.what ());
+          return 0;
+        }
+    });
+}
 }
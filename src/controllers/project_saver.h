@@ -4,8 +4,12 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
+#include "controllers/project_journal.h"
+#include "controllers/project_json_serializer.h"
+#include "structure/project/project_registry.h"
 #include "utils/version.h"
 
 #include <QByteArray>
@@ -36,6 +40,11 @@ public:
   /**
    * Saves the project asynchronously to the specified directory.
    *
+   * The engine is only paused while the pool is written and the project is
+   * serialized. Validating, compressing and writing the project file happen
+   * on a worker thread. Pool clips whose content didn't change since they
+   * were last written (or loaded) are not written again.
+   *
    * @param project The core project data to save.
    * @param ui_state The UI state to save.
    * @param undo_stack The undo history to save.
@@ -43,6 +52,10 @@ public:
    * @param path The directory to save the project in (including the title).
    * @param is_backup True if this is a backup. Backups will be saved as
    *                  <original filename>.bak<num>.
+   * @param encoding Encoding of the project file (backups should use the
+   *                 encoding of the project they back up).
+   * @param journal Journal to restart on top of the saved project file, if
+   *                any.
    *
    * @return A QFuture that resolves to the project path on success.
    * @throw ZrythmException If any step failed.
@@ -60,7 +73,30 @@ public:
     const undo::UndoStack                    &undo_stack,
     utils::Version                            app_version,
     const std::filesystem::path              &path,
-    bool                                      is_backup);
+    bool                                      is_backup,
+    ProjectJsonSerializer::Encoding           encoding =
+      ProjectJsonSerializer::Encoding::Json,
+    std::shared_ptr<ProjectJournal>           journal = nullptr);
+
+  /**
+   * @brief Appends the changes since the last entry (or the last save) to
+   * @p journal.
+   *
+   * Only the registry objects in @p changes and the sections outside the
+   * registry are serialized, without pausing the engine. Writing the entry
+   * happens on a worker thread.
+   *
+   * @param changes Registry changes since the last entry (see
+   * structure::project::ProjectRegistry::take_changes()).
+   * @return A QFuture that resolves to the number of changes appended.
+   */
+  [[nodiscard]] static QFuture<size_t> write_journal_entry (
+    const structure::project::Project                  &project,
+    const structure::project::ProjectUiState           &ui_state,
+    const undo::UndoStack                              &undo_stack,
+    std::string_view                                    title,
+    const structure::project::ProjectRegistry::Changes &changes,
+    std::shared_ptr<ProjectJournal>                     journal);
 
   /**
    * Autosave callback.
@@ -110,7 +146,8 @@ public:
   }
 
   /**
-   * Returns the uncompressed text representation of the saved project file.
+   * Returns the uncompressed contents of the saved project file (JSON text or
+   * CBOR, see ProjectJsonSerializer::Encoding).
    *
    * @param project_dir The project directory.
    *
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <ranges>
+
+#include "dsp/audio_peak_summary.h"
+
+namespace zrythm::dsp
+{
+
+void
+AudioPeakSummary::extend (units::sample_t num_frames, const FrameReader &read)
+{
+  if (num_frames <= num_frames_ || num_channels () == 0)
+    return;
+
+  // restart from the last partial block
+  const auto first_block =
+    num_frames_.in<int64_t> (units::samples) / FRAMES_PER_BLOCK;
+  const auto total_frames = num_frames.in<int64_t> (units::samples);
+  const auto num_blocks =
+    (total_frames + FRAMES_PER_BLOCK - 1) / FRAMES_PER_BLOCK;
+  for (const auto ch : std::views::iota (0, num_channels ()))
+    {
+      mins_[ch].resize (static_cast<size_t> (num_blocks));
+      maxes_[ch].resize (static_cast<size_t> (num_blocks));
+    }
+
+  juce::AudioSampleBuffer window (num_channels (), WINDOW_FRAMES);
+  for (
+    int64_t window_start = first_block * FRAMES_PER_BLOCK;
+    window_start < total_frames; window_start += WINDOW_FRAMES)
+    {
+      const auto window_frames = static_cast<int> (
+        std::min (int64_t{ WINDOW_FRAMES }, total_frames - window_start));
+      window.clear ();
+      read (units::samples (window_start), window_frames, window);
+
+      for (int offset = 0; offset < window_frames; offset += FRAMES_PER_BLOCK)
+        {
+          const auto block =
+            static_cast<size_t> ((window_start + offset) / FRAMES_PER_BLOCK);
+          const auto block_frames =
+            std::min (FRAMES_PER_BLOCK, window_frames - offset);
+          for (const auto ch : std::views::iota (0, num_channels ()))
+            {
+              const auto range = juce::FloatVectorOperations::findMinAndMax (
+                window.getReadPointer (ch, offset), block_frames);
+              mins_[ch][block] = range.getStart ();
+              maxes_[ch][block] = range.getEnd ();
+            }
+        }
+    }
+
+  num_frames_ = num_frames;
+}
+
+juce::Range<float>
+AudioPeakSummary::find_min_and_max (
+  int             channel,
+  units::sample_t start,
+  units::sample_t end) const
+{
+  const auto first_frame =
+    std::max (int64_t{ 0 }, start.in<int64_t> (units::samples));
+  const auto end_frame = std::min (
+    num_frames_.in<int64_t> (units::samples), end.in<int64_t> (units::samples));
+  if (channel < 0 || channel >= num_channels () || first_frame >= end_frame)
+    return {};
+
+  const auto &mins = mins_[channel];
+  const auto &maxes = maxes_[channel];
+  const auto  first_block = first_frame / FRAMES_PER_BLOCK;
+  const auto  end_block = (end_frame + FRAMES_PER_BLOCK - 1) / FRAMES_PER_BLOCK;
+  const auto  min =
+    std::min_element (mins.begin () + first_block, mins.begin () + end_block);
+  const auto max = std::max_element (
+    maxes.begin () + first_block, maxes.begin () + end_block);
+  return { *min, *max };
+}
+
+} // namespace zrythm::dsp
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "utils/units.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace zrythm::dsp
+{
+
+/**
+ * @brief Minimum and maximum of each block of frames of an audio source.
+ *
+ * Used to draw waveforms without reading the source frames: the peaks of any
+ * range of the source are looked up from the blocks it overlaps.
+ *
+ * The summary is built by reading the source one window at a time, so the
+ * source is never held in memory as a whole (streamed sources are read
+ * through their page cache).
+ */
+class AudioPeakSummary final
+{
+public:
+  /** Number of source frames summarized by each block. */
+  static constexpr int FRAMES_PER_BLOCK = 256;
+
+  /** Number of source frames read at a time while building the summary. */
+  static constexpr int WINDOW_FRAMES = FRAMES_PER_BLOCK * 256;
+
+  /**
+   * @brief Reads @p num_frames frames starting at @p start_frame to the start
+   * of the given buffer.
+   */
+  using FrameReader = std::function<void (
+    units::sample_t          start_frame,
+    int                      num_frames,
+    juce::AudioSampleBuffer &dest)>;
+
+  AudioPeakSummary () = default;
+  explicit AudioPeakSummary (int num_channels)
+      : mins_ (num_channels), maxes_ (num_channels)
+  {
+  }
+
+  int  num_channels () const { return static_cast<int> (mins_.size ()); }
+  auto num_frames () const { return num_frames_; }
+
+  /**
+   * @brief Summarizes the source frames from the end of the summary up to
+   * @p num_frames.
+   *
+   * The last (partial) block is summarized again, so this can be called as a
+   * source grows (e.g., while recording).
+   */
+  void extend (units::sample_t num_frames, const FrameReader &read);
+
+  /**
+   * @brief Returns the minimum and maximum of the frames of channel
+   * @p channel in [@p start, @p end).
+   *
+   * The peaks of the whole blocks overlapping the range are used, so the
+   * result may include frames up to FRAMES_PER_BLOCK - 1 frames outside the
+   * range. Ranges outside the summary are silent.
+   */
+  juce::Range<float> find_min_and_max (
+    int             channel,
+    units::sample_t start,
+    units::sample_t end) const;
+
+private:
+  /** Peaks of each block, per channel. */
+  std::vector<std::vector<float>> mins_;
+  std::vector<std::vector<float>> maxes_;
+
+  /** Number of source frames summarized. */
+  units::sample_t num_frames_{};
+};
+
+} // namespace zrythm::dsp
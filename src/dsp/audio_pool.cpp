@@ -3,13 +3,17 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <span>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <fmt/std.h>
 
 #include "dsp/audio_pool.h"
+#include "utils/audio_file.h"
 #include "utils/exceptions.h"
 #include "utils/io_utils.h"
 #include "utils/logger.h"
@@ -28,7 +32,9 @@ AudioPool::AudioPool (
   ProjectPoolPathGetter   path_getter,
   SampleRateGetter        sr_getter)
     : sample_rate_getter_ (std::move (sr_getter)),
-      project_pool_path_getter_ (std::move (path_getter)), registry_ (registry)
+      project_pool_path_getter_ (std::move (path_getter)), registry_ (registry),
+      page_cache_ (
+        std::make_shared<DecodedPageCache> (DEFAULT_PAGE_CACHE_CAPACITY_BYTES))
 {
 }
 
@@ -44,13 +50,110 @@ AudioPool::init_loaded ()
 {
   for_each_clip ([&] (dsp::FileAudioSource &clip) {
     const auto name = clip.get_name ();
-    clip.init_from_file (
-      get_clip_path (clip.get_uuid (), false), sample_rate_getter_ (),
-      clip.source_bpm ());
+    load_clip (clip, clip.source_bpm ());
     clip.set_name (name);
   });
 }
 
+void
+AudioPool::load_clip (
+  FileAudioSource            &clip,
+  std::optional<units::bpm_t> bpm_to_set)
+{
+  const auto path = get_clip_path (clip.get_uuid (), false);
+  const auto sample_rate = sample_rate_getter_ ();
+
+  // the file may have changed since its pages were cached
+  page_cache_->remove_source (clip.get_uuid ());
+
+  if (streaming_threshold_seconds_.has_value ())
+    {
+      try
+        {
+          utils::audio::AudioFile file (path);
+          const auto              md = file.read_metadata ();
+          const auto min_frames = static_cast<int64_t> (
+            *streaming_threshold_seconds_
+            * sample_rate.in<double> (units::sample_rate));
+          if (
+            md.num_frames >= min_frames
+            && md.samplerate == sample_rate.in<int> (units::sample_rate))
+            {
+              auto store = std::make_shared<StreamingSampleStore> (
+                path, sample_rate,
+                StreamingSampleStore::Options{
+                  .page_cache_ = page_cache_,
+                  .cache_source_id_ = clip.get_uuid (),
+                });
+              if (prefetcher_ == nullptr)
+                {
+                  prefetcher_ = std::make_unique<StreamingPrefetcher> ();
+                }
+              prefetcher_->add_store (store);
+              clip.init_streaming_from_file (std::move (store), bpm_to_set);
+              return;
+            }
+        }
+      catch (const ZrythmException &e)
+        {
+          z_warning (
+            "cannot stream '{}', loading it into memory instead: {}", path,
+            e.what ());
+        }
+    }
+
+  clip.init_from_file (path, sample_rate, bpm_to_set);
+
+  // the file holds the clip's content until the clip is edited
+  remember_written_content (path, get_content_hash (clip));
+}
+
+utils::hash::HashT
+AudioPool::get_content_hash (const FileAudioSource &clip)
+{
+  const auto &samples = clip.get_samples ();
+  const auto  bit_depth = clip.get_bit_depth ();
+  const auto  sample_rate = clip.get_samplerate ().in<int> (units::sample_rate);
+  std::vector<std::span<const std::byte>> parts{
+    std::as_bytes (std::span (&bit_depth, 1)),
+    std::as_bytes (std::span (&sample_rate, 1)),
+  };
+  for (int ch = 0; ch < samples.getNumChannels (); ++ch)
+    {
+      parts.push_back (std::as_bytes (
+        std::span (
+          samples.getReadPointer (ch),
+          static_cast<size_t> (samples.getNumSamples ()))));
+    }
+  return utils::hash::get_combined_hash (parts);
+}
+
+void
+AudioPool::remember_written_content (
+  const std::filesystem::path &path,
+  utils::hash::HashT           content_hash)
+{
+  written_content_hashes_.insert_or_assign (path, content_hash);
+  files_by_content_hash_.insert_or_assign (content_hash, path);
+}
+
+StreamingSampleStore::Stats
+AudioPool::streaming_stats () const
+{
+  return prefetcher_ != nullptr
+           ? prefetcher_->stats ()
+           : StreamingSampleStore::Stats{};
+}
+
+void
+AudioPool::prefetch_streamed_clips ()
+{
+  if (prefetcher_ != nullptr)
+    {
+      prefetcher_->wake ();
+    }
+}
+
 void
 init_from (
   AudioPool             &obj,
@@ -85,71 +188,78 @@ AudioPool::write_clip (const FileAudioSource * clip, bool parts, bool backup)
   const auto clip_id = clip->get_uuid ();
 
   /* generate a copy of the given filename in the project dir */
-  auto path_in_main_project = get_clip_path (clip_id, false);
   auto new_path = get_clip_path (clip_id, backup);
-  z_return_if_fail (!path_in_main_project.empty ());
   z_return_if_fail (!new_path.empty ());
 
-  // get last known hash
-  std::optional<utils::hash::HashT> last_known_hash_for_clip;
-  {
-    last_known_file_hashes_.cvisit (
-      clip_id, [&last_known_hash_for_clip] (const auto &hash) {
-        last_known_hash_for_clip = hash.second;
-      });
-  }
+  /* streamed clips are not in memory, but their file is already in the pool
+   * (streamed clips can't be edited) */
+  if (clip->is_streaming ())
+    {
+      const auto &streamed_path = clip->streaming_store ()->path ();
+      if (streamed_path != new_path)
+        {
+          z_debug (
+            "copying streamed clip from '{}' to '{}'", streamed_path, new_path);
+          utils::io::copy_file (new_path, streamed_path);
+        }
+      return;
+    }
 
-  /* skip if file with same hash already exists */
-  if (
-    last_known_hash_for_clip.has_value () && !parts
-    && utils::io::path_exists (new_path)
-    && last_known_hash_for_clip.value () == utils::hash::get_file_hash (new_path))
+  /* recordings are written as they grow */
+  if (parts)
     {
-      z_debug ("skipping writing to existing clip {} in pool", new_path);
+      z_debug (
+        "writing new parts of clip {} to pool (is backup {}): '{}'",
+        clip->get_name (), backup, new_path);
+      dsp::FileAudioSourceWriter writer{ *clip, new_path, true };
+      writer.write_to_file ();
+      written_content_hashes_.erase (new_path);
       return;
     }
 
-  /* if writing to backup and same file exists in main project dir, copy (first
-   * try reflink) */
-  if (last_known_hash_for_clip.has_value () && backup)
+  const auto content_hash = get_content_hash (*clip);
+  const auto has_content = [&] (const std::filesystem::path &path) {
+    bool same = false;
+    written_content_hashes_.cvisit (path, [&] (const auto &entry) {
+      same = entry.second == content_hash;
+    });
+    return same && utils::io::path_exists (path);
+  };
+
+  /* skip if the file already has the same content */
+  if (has_content (new_path))
     {
-      bool exists_in_main_project = false;
-      if (utils::io::path_exists (path_in_main_project))
-        {
-          exists_in_main_project =
-            last_known_hash_for_clip.value ()
-            == utils::hash::get_file_hash (path_in_main_project);
-        }
+      z_debug ("skipping writing to existing clip {} in pool", new_path);
+      return;
+    }
 
-      if (exists_in_main_project)
+  /* if a file with the same content exists (e.g., in the main project when
+   * writing a backup, or the file of the original of a duplicated clip), copy
+   * it (first try reflink) */
+  std::optional<std::filesystem::path> same_content_path;
+  files_by_content_hash_.cvisit (content_hash, [&] (const auto &entry) {
+    same_content_path = entry.second;
+  });
+  if (same_content_path.has_value () && has_content (*same_content_path))
+    {
+      z_debug (
+        "reflinking clip with same content ('{}' to '{}')", *same_content_path,
+        new_path);
+      if (!utils::io::reflink_file (*same_content_path, new_path))
         {
-          /* try reflink and fall back to normal copying */
-          z_debug (
-            "reflinking clip from main project ('{}' to '{}')",
-            path_in_main_project, new_path);
-
-          if (!utils::io::reflink_file (path_in_main_project, new_path))
-            {
-              z_debug ("failed to reflink, copying instead");
-              z_debug (
-                "copying clip from main project ('{}' to '{}')",
-                path_in_main_project, new_path);
-              utils::io::copy_file (new_path, path_in_main_project);
-            }
+          z_debug ("failed to reflink, copying instead");
+          utils::io::copy_file (new_path, *same_content_path);
         }
     }
-
-  z_debug (
-    "writing clip {} to pool (parts {}, is backup  {}): '{}'",
-    clip->get_name (), parts, backup, new_path);
-  dsp::FileAudioSourceWriter writer{ *clip, new_path, parts };
-  writer.write_to_file ();
-  if (!parts)
+  else
     {
-      /* store file hash */
-      last_known_file_hashes_.emplace (
-        clip_id, utils::hash::get_file_hash (new_path));
+      z_debug (
+        "writing clip {} to pool (is backup {}): '{}'", clip->get_name (),
+        backup, new_path);
+      dsp::FileAudioSourceWriter writer{ *clip, new_path, false };
+      writer.write_to_file ();
     }
+  remember_written_content (new_path, content_hash);
 }
 
 auto
@@ -158,9 +268,18 @@ AudioPool::duplicate_clip (const FileAudioSource::Uuid &clip_id, bool write_file
 {
   auto &clip = utils::get_typed<dsp::FileAudioSource> (registry_, clip_id);
 
+  // streamed clips need to be read from disk
+  utils::audio::AudioBuffer samples;
+  if (clip.is_streaming ())
+    {
+      samples.setSize (clip.get_num_channels (), clip.get_num_frames ());
+      clip.read_frames (units::samples (0), clip.get_num_frames (), samples, 0);
+    }
+
   auto new_clip_ref = utils::create_object<FileAudioSource> (
-    registry_, clip.get_samples (), clip.get_bit_depth (),
-    sample_rate_getter_ (), clip.source_bpm (), clip.get_name ());
+    registry_, clip.is_streaming () ? samples : clip.get_samples (),
+    clip.get_bit_depth (), sample_rate_getter_ (), clip.source_bpm (),
+    clip.get_name ());
 
   z_debug ("duplicating clip {} to {}...", clip.get_name (), new_clip_ref.id ());
 
@@ -209,9 +328,7 @@ AudioPool::reload_clip_frame_bufs ()
   for_each_clip ([&] (dsp::FileAudioSource &clip) {
     if (clip.get_num_frames () == 0)
       {
-        clip.init_from_file (
-          get_clip_path (clip.get_uuid (), false), sample_rate_getter_ (),
-          std::nullopt);
+        load_clip (clip, std::nullopt);
       }
   });
 }
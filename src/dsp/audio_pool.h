@@ -4,6 +4,7 @@
 #pragma once
 
 #include "dsp/file_audio_source.h"
+#include "dsp/streaming_sample_store.h"
 #include "utils/hash.h"
 #include "utils/units.h"
 
@@ -35,6 +36,9 @@ public:
     std::function<std::filesystem::path (bool backup)>;
   using SampleRateGetter = std::function<units::sample_rate_t ()>;
 
+  /** Default capacity of the decoded page cache. */
+  static constexpr size_t DEFAULT_PAGE_CACHE_CAPACITY_BYTES = 512zu << 20;
+
   AudioPool (
     utils::IObjectRegistry &registry,
     ProjectPoolPathGetter   path_getter,
@@ -112,7 +116,67 @@ public:
   void
   for_each_clip (std::function<void (dsp::FileAudioSource &)> visitor) const;
 
+  /**
+   * @brief Sets the minimum length of clip files to stream from disk instead
+   * of loading them into memory.
+   *
+   * Applies to clips loaded afterwards. Streaming is disabled by default
+   * (nullopt).
+   */
+  void set_streaming_threshold (std::optional<double> min_seconds)
+  {
+    streaming_threshold_seconds_ = min_seconds;
+  }
+
+  /**
+   * @brief Returns the accumulated statistics (including underruns) of all
+   * streamed clips.
+   */
+  StreamingSampleStore::Stats streaming_stats () const;
+
+  /**
+   * @brief Requests streamed clips to be prefetched immediately (e.g., after
+   * the playhead was moved).
+   */
+  void prefetch_streamed_clips ();
+
+  /**
+   * @brief Cache of decoded pages shared by all streamed clips (for playback,
+   * waveform rendering and stretching).
+   */
+  auto &page_cache () const { return *page_cache_; }
+
+  /**
+   * @brief Sets the memory budget of the decoded page cache.
+   */
+  void set_page_cache_capacity (size_t capacity_bytes)
+  {
+    page_cache_->set_capacity (capacity_bytes);
+  }
+
 private:
+  /**
+   * Loads the clip's frames from its file in the pool, or sets up streaming
+   * for it if the file is long enough.
+   *
+   * @throw ZrythmException on I/O error.
+   */
+  void
+  load_clip (FileAudioSource &clip, std::optional<units::bpm_t> bpm_to_set);
+
+  /**
+   * @brief Returns a hash of everything that ends up in the clip's file
+   * (samples and format).
+   */
+  static utils::hash::HashT get_content_hash (const FileAudioSource &clip);
+
+  /**
+   * @brief Remembers that the file at @p path holds the given content.
+   */
+  void remember_written_content (
+    const std::filesystem::path &path,
+    utils::hash::HashT           content_hash);
+
   friend void init_from (
     AudioPool             &obj,
     const AudioPool       &other,
@@ -130,10 +194,28 @@ private:
    */
   utils::IObjectRegistry &registry_;
 
-  /** File hashes, used for checking if a clip is already written to the pool so
-   * we can save time by skipping overwriting it. */
-  boost::unordered::concurrent_flat_map<FileAudioSource::Uuid, utils::hash::HashT>
-    last_known_file_hashes_;
+  /** Hashes of the content (see get_content_hash()) of the clip last written
+   * to each path, used for skipping unchanged clips without reading the files
+   * back. */
+  boost::unordered::concurrent_flat_map<
+    std::filesystem::path,
+    utils::hash::HashT,
+    std::hash<std::filesystem::path>>
+    written_content_hashes_;
+
+  /** A file written with each content, used for copying (or reflinking)
+   * identical clips instead of encoding them again. */
+  boost::unordered::
+    concurrent_flat_map<utils::hash::HashT, std::filesystem::path>
+      files_by_content_hash_;
+
+  std::optional<double> streaming_threshold_seconds_;
+
+  /** Decoded pages of streamed clips. */
+  std::shared_ptr<DecodedPageCache> page_cache_;
+
+  /** Prefetch thread for streamed clips (created on demand). */
+  std::unique_ptr<StreamingPrefetcher> prefetcher_;
 };
 } // namespace zrythm::dsp
 
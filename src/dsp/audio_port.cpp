@@ -46,7 +46,7 @@ AudioPort::add_source_rt (
     [time_nfo, &src, this] (const auto dest_ch, const auto src_ch, float gain) {
       buf_->addFrom (
         static_cast<int> (dest_ch),
-        time_nfo.buffer_offset_.in<int> (units::samples), *src.buf_,
+        time_nfo.buffer_offset_.in<int> (units::samples), *src.buffers (),
         static_cast<int> (src_ch),
         time_nfo.buffer_offset_.in<int> (units::samples),
         time_nfo.nframes_.in<int> (units::samples), gain);
@@ -95,7 +95,7 @@ AudioPort::copy_source_rt (
         {
           buf_->copyFrom (
             static_cast<int> (dest_ch),
-            time_nfo.buffer_offset_.in<int> (units::samples), *src.buf_,
+            time_nfo.buffer_offset_.in<int> (units::samples), *src.buffers (),
             static_cast<int> (src_ch),
             time_nfo.buffer_offset_.in<int> (units::samples),
             time_nfo.nframes_.in<int> (units::samples));
@@ -105,7 +105,7 @@ AudioPort::copy_source_rt (
           buf_->copyFrom (
             static_cast<int> (dest_ch),
             time_nfo.buffer_offset_.in<int> (units::samples),
-            src.buf_->getReadPointer (
+            src.buffers ()->getReadPointer (
               static_cast<int> (src_ch),
               time_nfo.buffer_offset_.in<int> (units::samples)),
             time_nfo.nframes_.in<int> (units::samples), gain);
@@ -143,10 +143,50 @@ AudioPort::copy_source_rt (
     }
 }
 
+bool
+AudioPort::alias_source_rt (const AudioPort &src)
+{
+  const auto &src_buf = src.buffers ();
+  if (
+    requires_limiting_ || src.num_channels_ != num_channels_
+    || alias_buf_ == nullptr || src_buf == nullptr)
+    {
+      aliased_ = false;
+      return false;
+    }
+
+  // doesn't allocate (the channel pointers fit in JUCE's preallocated space)
+  alias_buf_->setDataToReferTo (
+    src_buf->getArrayOfWritePointers (), src_buf->getNumChannels (),
+    src_buf->getNumSamples ());
+  aliased_ = true;
+  return true;
+}
+
+void
+AudioPort::swap_buffer (
+  std::unique_ptr<juce::AudioSampleBuffer> &buffer,
+  bool                                     &pooled) noexcept
+{
+  buf_.swap (buffer);
+  std::swap (pooled_, pooled);
+}
+
 void
 AudioPort::clear_buffer (std::size_t offset, std::size_t nframes)
 {
   assert (buf_ != nullptr);
+
+  // the data belongs to the source port, so only drop the alias (our own
+  // buffer was not written to in the meantime, unless it is pooled storage
+  // that an output port's owner expects to be cleared)
+  if (aliased_)
+    {
+      aliased_ = false;
+      if (!pooled_ || is_input ())
+        return;
+    }
+
   buf_->clear (static_cast<int> (offset), static_cast<int> (nframes));
 }
 
@@ -163,25 +203,45 @@ AudioPort::prepare_for_processing_impl (
 
   if (node != nullptr && flow () == PortFlow::Input)
     {
-      auto source_audio_ports =
-        node->depends () | std::views::transform ([] (const auto &child_node) {
-          return dynamic_cast<AudioPort *> (
-            &child_node.get ().get_processable ());
-        })
-        | utils::views::filter_null;
-      set_port_sources (source_audio_ports);
+      set_port_sources (source_ports_in_node (*node));
     }
 
   auto max = std::max (max_block_length, units::samples (1u));
   buf_ = std::make_unique<juce::AudioSampleBuffer> (
     num_channels_, max.in<int> (units::samples));
   buf_->clear ();
+  alias_buf_ = std::make_unique<juce::AudioSampleBuffer> ();
+  aliased_ = false;
+  silent_ = false;
+  pooled_ = false;
+}
+
+bool
+AudioPort::stage_node_inputs (const graph::GraphNode &node)
+{
+  if (flow () == PortFlow::Input)
+    {
+      stage_port_sources (source_ports_in_node (node));
+    }
+  return true;
+}
+
+void
+AudioPort::commit_node_inputs () noexcept
+{
+  if (flow () == PortFlow::Input)
+    {
+      commit_staged_port_sources ();
+    }
 }
 
 void
 AudioPort::release_resources ()
 {
+  aliased_ = false;
+  alias_buf_.reset ();
   buf_.reset ();
+  pooled_ = false;
 }
 
 void
@@ -193,6 +253,30 @@ AudioPort::process_block (
   /* Input ports: aggregate from sources. */
   if (flow () == PortFlow::Input)
     {
+      // a single source used as is doesn't need to be copied
+      if (source_aliasing_allowed_ && port_sources ().size () == 1)
+        {
+          const auto &[src_port, conn] = port_sources ().front ();
+          if (
+            conn->enabled_ && !conn->source_ch_to_destination_ch_mapping_
+            && utils::math::floats_equal (conn->multiplier_, 1.f)
+            && alias_source_rt (*src_port))
+            {
+              silent_ = src_port->is_silent ();
+              return;
+            }
+        }
+      aliased_ = false;
+      silent_ = true;
+
+      // the storage was used by other ports earlier in the cycle
+      if (pooled_)
+        {
+          buf_->clear (
+            time_nfo.buffer_offset_.in<int> (units::samples),
+            time_nfo.nframes_.in<int> (units::samples));
+        }
+
       for (const auto &[_src_port, conn] : port_sources ())
         {
           if (!conn->enabled_)
@@ -201,6 +285,12 @@ AudioPort::process_block (
           const auto * src_port = dynamic_cast<const AudioPort *> (_src_port);
           const float  multiplier = conn->multiplier_;
 
+          // adding zeros doesn't change anything
+          if (src_port->is_silent ())
+            continue;
+
+          silent_ = false;
+
           if (conn->source_ch_to_destination_ch_mapping_.has_value ())
             {
               const auto [source_ch, dest_ch] =
@@ -210,7 +300,7 @@ AudioPort::process_block (
               buf_->addFrom (
                 static_cast<int> (dest_ch),
                 time_nfo.buffer_offset_.in<int> (units::samples),
-                *src_port->buf_, static_cast<int> (source_ch),
+                *src_port->buffers (), static_cast<int> (source_ch),
                 time_nfo.buffer_offset_.in<int> (units::samples),
                 time_nfo.nframes_.in<int> (units::samples), multiplier);
             }
@@ -222,7 +312,7 @@ AudioPort::process_block (
     }
 
   /* Limiting + ring buffer (both input and output). */
-  if (requires_limiting_)
+  if (requires_limiting_ && !silent_)
     {
       constexpr float max_allowed_peak = 2.f;
       float           abs_peak = buf_->getMagnitude (
@@ -61,10 +61,11 @@ public:
     const dsp::TempoMap         &tempo_map) noexcept override;
 
   void clear_buffer (std::size_t offset, std::size_t nframes) override;
+  bool is_prepared_for_processing () const override { return buf_ != nullptr; }
 
   [[nodiscard]] auto  layout () const { return layout_; }
   [[nodiscard]] auto  purpose () const { return purpose_; }
-  [[nodiscard]] auto &buffers () const { return buf_; }
+  [[nodiscard]] auto &buffers () const { return aliased_ ? alias_buf_ : buf_; }
   auto                num_channels () const { return num_channels_; }
 
   void mark_as_requires_limiting () { requires_limiting_ = true; }
@@ -83,6 +84,72 @@ public:
     dsp::graph::ProcessBlockInfo time_nfo,
     float                        multiplier = 1.f);
 
+  /**
+   * @brief Makes buffers() refer to @p src's buffer instead of copying it.
+   *
+   * This is only done if @p src's data can be used as is (same number of
+   * channels and no limiting). The alias is removed by clear_buffer(), so it
+   * only lasts for the current cycle.
+   *
+   * @note Nothing must write to this port's buffer while it is aliased.
+   *
+   * @return Whether the buffer is aliased.
+   */
+  bool alias_source_rt (const AudioPort &src);
+
+  /**
+   * @brief Whether buffers() currently refers to another port's buffer.
+   */
+  bool is_aliased () const { return aliased_; }
+
+  /**
+   * @brief Allows this (input) port to alias its source instead of copying it
+   * when it has a single source whose data can be used as is.
+   *
+   * Set by the owning processor if it never writes to this port's buffer.
+   */
+  void set_source_aliasing_allowed (bool allowed)
+  {
+    source_aliasing_allowed_ = allowed;
+  }
+  bool source_aliasing_allowed () const { return source_aliasing_allowed_; }
+
+  /**
+   * @brief Whether the port's data for the current cycle is known to be all
+   * zeros.
+   *
+   * Input ports are silent when all their (enabled) sources are. Output ports
+   * are marked by their owning processor (see ProcessorBase), either when it
+   * is skipped or from custom_process_block() when it didn't write anything
+   * (e.g., a track with no clip playing).
+   */
+  bool is_silent () const { return silent_; }
+  void set_silent (bool silent) { silent_ = silent; }
+
+  /**
+   * @brief Swaps the port's buffer with @p buffer.
+   *
+   * Used to make the port use storage shared with other ports (see
+   * PortBufferPool) or to give it its own storage back.
+   *
+   * Must be called while the port is not being processed. This lasts until
+   * the port is prepared again or released.
+   *
+   * @param pooled Whether @p buffer's storage is shared with other ports (in
+   * which case it is cleared whenever it may hold another port's data, e.g.
+   * before summing the sources). Receives the previous value.
+   */
+  void swap_buffer (
+    std::unique_ptr<juce::AudioSampleBuffer> &buffer,
+    bool                                     &pooled) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Whether the port's storage is shared with other ports (see
+   * swap_buffer()).
+   */
+  bool is_pooled () const { return pooled_; }
+
   friend void init_from (
     AudioPort             &obj,
     const AudioPort       &other,
@@ -93,6 +160,8 @@ public:
     units::sample_rate_t     sample_rate,
     units::sample_u32_t      max_block_length) override;
   void release_resources () override;
+  bool stage_node_inputs (const graph::GraphNode &node) override;
+  void commit_node_inputs () noexcept [[clang::nonblocking]] override;
 
 private:
   static constexpr auto kBusLayoutId = "busLayout"sv;
@@ -121,6 +190,23 @@ private:
    */
   std::unique_ptr<juce::AudioSampleBuffer> buf_;
 
+  /**
+   * @brief Buffer referring to another port's data (used instead of buf_
+   * while aliased).
+   *
+   * buf_ is left untouched while aliased.
+   */
+  std::unique_ptr<juce::AudioSampleBuffer> alias_buf_;
+
+  bool aliased_{};
+  bool source_aliasing_allowed_{};
+
+  /** Unknown (false) unless set by the port or its owner. */
+  bool silent_{};
+
+  /** Whether buf_ refers to storage shared with other ports. */
+  bool pooled_{};
+
   BOOST_DESCRIBE_CLASS (
     AudioPort,
     (Port),
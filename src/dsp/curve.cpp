@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: © 2020-2021, 2023-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <algorithm>
 #include <cmath>
 
 #include "dsp/curve.h"
@@ -244,4 +245,158 @@ evaluate_curve (
            : value_a + std::abs (diff) * static_cast<float> (curve_val);
 }
 
+namespace
+{
+/**
+ * @brief Writes the scaled curve value for each ratio.
+ *
+ * @param normalized_y Maps a ratio to the normalized curve value.
+ */
+template <typename NormalizedYFunc>
+[[gnu::always_inline]] inline void
+fill_curve (
+  float            value_a,
+  float            value_b,
+  double           ratio_start,
+  double           ratio_step,
+  std::span<float> out,
+  NormalizedYFunc  normalized_y) noexcept
+{
+  const float diff = value_b - value_a;
+  const float base = diff < 0.f ? value_b : value_a;
+  const float scale = std::abs (diff);
+  for (size_t i = 0; i < out.size (); ++i)
+    {
+      const double x = std::clamp (
+        ratio_start + (ratio_step * static_cast<double> (i)), 0.0, 1.0);
+      const double y = std::clamp (normalized_y (x), 0.0, 1.0);
+      out[i] = base + (scale * static_cast<float> (y));
+    }
+}
+}
+
+void
+evaluate_curve_block (
+  float                   value_a,
+  float                   value_b,
+  CurveOptions::Algorithm algo,
+  float                   curviness,
+  double                  ratio_start,
+  double                  ratio_step,
+  std::span<float>        out) noexcept
+{
+  const float diff = value_b - value_a;
+  if (std::abs (diff) < 1e-5f)
+    {
+      std::ranges::fill (out, value_a); // flat segment — no curve needed
+      return;
+    }
+
+  // The branches in CurveOptions::get_normalized_y() are resolved here once,
+  // as affine transforms of x and y
+  const bool   start_higher = diff < 0.0f;
+  const bool   curve_up = curviness >= 0.f;
+  const bool   flip_x = (!start_higher) != curve_up;
+  const double x_offset = flip_x ? 1.0 : 0.0;
+  const double x_sign = flip_x ? -1.0 : 1.0;
+  const auto   fill = [&] (auto normalized_y) {
+    fill_curve (value_a, value_b, ratio_start, ratio_step, out, normalized_y);
+  };
+
+  // Straight lines (the default curve)
+  if (
+    algo != CurveOptions::Algorithm::Pulse
+    && algo != CurveOptions::Algorithm::Logarithmic
+    && utils::math::floats_equal (curviness, 0.f))
+    {
+      const double y_offset = start_higher ? 1.0 : 0.0;
+      const double y_sign = start_higher ? -1.0 : 1.0;
+      fill ([=] (double x) { return y_offset + (y_sign * x); });
+      return;
+    }
+
+  switch (algo)
+    {
+    case CurveOptions::Algorithm::Exponent:
+      {
+        const double exponent =
+          1.0
+          - std::fabs (
+            static_cast<double> (curviness)
+            * CurveOptions::EXPONENT_CURVINESS_BOUND);
+        const double y_offset = curve_up ? 0.0 : 1.0;
+        const double y_sign = curve_up ? 1.0 : -1.0;
+        fill ([=] (double x) {
+          return y_offset
+                 + (y_sign * std::pow (x_offset + (x_sign * x), exponent));
+        });
+      }
+      break;
+    case CurveOptions::Algorithm::SuperEllipse:
+      {
+        const double exponent =
+          1.0
+          - std::fabs (
+            static_cast<double> (curviness)
+            * CurveOptions::SUPERELLIPSE_CURVINESS_BOUND);
+        const double inv_exponent = 1.0 / exponent;
+        const double y_offset = curve_up ? 1.0 : 0.0;
+        const double y_sign = curve_up ? -1.0 : 1.0;
+        fill ([=] (double x) {
+          return y_offset
+                 + (y_sign
+                    * std::pow (
+                      1.0 - std::pow (x_offset + (x_sign * x), exponent),
+                      inv_exponent));
+        });
+      }
+      break;
+    case CurveOptions::Algorithm::Vital:
+      {
+        const double k =
+          -static_cast<double> (curviness) * CurveOptions::VITAL_CURVINESS_BOUND
+          * 10.0;
+        const double inv_denominator = 1.0 / std::expm1 (k);
+        const double vital_x_offset = start_higher ? 1.0 : 0.0;
+        const double vital_x_sign = start_higher ? -1.0 : 1.0;
+        fill ([=] (double x) {
+          return std::expm1 (k * (vital_x_offset + (vital_x_sign * x)))
+                 * inv_denominator;
+        });
+      }
+      break;
+    case CurveOptions::Algorithm::Pulse:
+      {
+        const double threshold = (1.0 + static_cast<double> (curviness)) / 2.0;
+        const double low = start_higher ? 1.0 : 0.0;
+        const double high = start_higher ? 0.0 : 1.0;
+        fill ([=] (double x) { return threshold > x ? low : high; });
+      }
+      break;
+    case CurveOptions::Algorithm::Logarithmic:
+      {
+        // Same constants as CurveOptions::get_normalized_y()
+        constexpr float bound = 1e-12f;
+        const float     s =
+          std::clamp (std::fabs (curviness), 0.01f, 1.f - bound) * 10.f;
+        const float n =
+          std::clamp ((10.f - s) / (std::pow (s, s)), bound, 10.f);
+        const bool  precise = n >= 0.02f;
+        const auto  log_fn = [precise] (float v) {
+          return precise ? logf (v) : utils::math::fast_log (v);
+        };
+        const float  a = log_fn (n);
+        const float  b = 1.f / log_fn (1.f + (1.f / n));
+        const double y_offset = curve_up ? 0.0 : 1.0;
+        const float  y_sign = curve_up ? 1.f : -1.f;
+        fill ([=] (double x) {
+          const auto xf = static_cast<float> (x_offset + (x_sign * x));
+          return y_offset
+                 + static_cast<double> (y_sign * (log_fn (xf + n) - a) * b);
+        });
+      }
+      break;
+    }
+}
+
 } // namespace zrythm::dsp
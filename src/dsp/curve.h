@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <QObject>
 #include <QtQmlIntegration/qqmlintegration.h>
 
@@ -193,6 +195,32 @@ evaluate_curve (
   float                   curviness,
   double                  ratio) noexcept [[clang::nonblocking]];
 
+/**
+ * @brief Evaluates an automation curve at evenly spaced ratios.
+ *
+ * Block variant of evaluate_curve() used for sample-accurate automation:
+ * @p out[i] is set to the value at `ratio_start + i * ratio_step` (clamped to
+ * [0, 1]). The curve constants are computed once per call and the per-sample
+ * loop is branch-free, so that it can be vectorized.
+ *
+ * @param value_a Value at the start of the curve segment.
+ * @param value_b Value at the end of the curve segment.
+ * @param algo    Curve algorithm from the driving automation point.
+ * @param curviness Curviness from the driving automation point.
+ * @param ratio_start Position within the curve of the first value.
+ * @param ratio_step Distance between consecutive positions.
+ * @param out     Output values.
+ */
+void
+evaluate_curve_block (
+  float                   value_a,
+  float                   value_b,
+  CurveOptions::Algorithm algo,
+  float                   curviness,
+  double                  ratio_start,
+  double                  ratio_step,
+  std::span<float>        out) noexcept [[clang::nonblocking]];
+
 } // namespace zrythm::dsp
 
 // These may be used in the UI eventually, but it's probably better to have a
@@ -27,22 +27,47 @@ CVPort::prepare_for_processing_impl (
 {
   if (node != nullptr && flow () == PortFlow::Input)
     {
-      auto source_ports =
-        node->depends () | std::views::transform ([] (const auto &child_node) {
-          return dynamic_cast<CVPort *> (&child_node.get ().get_processable ());
-        })
-        | utils::views::filter_null;
-      set_port_sources (source_ports);
+      set_port_sources (source_ports_in_node (*node));
     }
 
   size_t max = std::max (max_block_length.in (units::samples), 1u);
-  buf_.resize (max);
+  own_buf_.resize (max);
+  buf_ = own_buf_;
+  pooled_ = false;
+}
+
+void
+CVPort::set_pooled_buffer (std::span<float> buffer) noexcept
+{
+  pooled_ = !buffer.empty ();
+  buf_ = pooled_ ? buffer : std::span (own_buf_);
+}
+
+bool
+CVPort::stage_node_inputs (const graph::GraphNode &node)
+{
+  if (flow () == PortFlow::Input)
+    {
+      stage_port_sources (source_ports_in_node (node));
+    }
+  return true;
+}
+
+void
+CVPort::commit_node_inputs () noexcept
+{
+  if (flow () == PortFlow::Input)
+    {
+      commit_staged_port_sources ();
+    }
 }
 
 void
 CVPort::release_resources ()
 {
-  buf_.clear ();
+  buf_ = {};
+  own_buf_.clear ();
+  pooled_ = false;
 }
 
 void
@@ -56,6 +81,12 @@ CVPort::process_block (
   /* Input ports: aggregate from sources. */
   if (flow () == PortFlow::Input)
     {
+      // the storage was used by other ports earlier in the cycle
+      if (pooled_)
+        {
+          clear_buffer (sub_offset, sub_nframes);
+        }
+
       for (const auto &[src_port, conn] : port_sources ())
         {
           if (!conn->enabled_)
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "dsp/port.h"
 #include "utils/icloneable.h"
 
@@ -32,6 +35,24 @@ public:
     const dsp::TempoMap         &tempo_map) noexcept override;
 
   void clear_buffer (std::size_t offset, std::size_t nframes) override;
+  bool is_prepared_for_processing () const override { return !buf_.empty (); }
+
+  /**
+   * @brief Makes buf_ refer to @p buffer (storage shared with other ports, see
+   * PortBufferPool) instead of the port's own storage, or to the port's own
+   * storage again if @p buffer is empty.
+   *
+   * Must be called while the port is not being processed. This lasts until
+   * the port is prepared again or released.
+   */
+  void set_pooled_buffer (std::span<float> buffer) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Whether buf_ refers to storage shared with other ports (see
+   * set_pooled_buffer()).
+   */
+  bool is_pooled () const { return pooled_; }
 
   friend void
   init_from (CVPort &obj, const CVPort &other, utils::ObjectCloneType clone_type);
@@ -41,6 +62,8 @@ public:
     units::sample_rate_t     sample_rate,
     units::sample_u32_t      max_block_length) override;
   void release_resources () override;
+  bool stage_node_inputs (const graph::GraphNode &node) override;
+  void commit_node_inputs () noexcept [[clang::nonblocking]] override;
 
 private:
   static constexpr std::string_view kRangeKey = "range";
@@ -54,9 +77,19 @@ private:
   }
 
 public:
-  std::vector<float> buf_;
+  /**
+   * @brief The port's data.
+   *
+   * Refers to the port's own storage unless pooled (see set_pooled_buffer()).
+   */
+  std::span<float> buf_;
 
 private:
+  std::vector<float> own_buf_;
+
+  /** Whether buf_ refers to storage shared with other ports. */
+  bool pooled_{};
+
   BOOST_DESCRIBE_CLASS (CVPort, (Port), (), (), ())
 };
 
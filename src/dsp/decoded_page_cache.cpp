@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <vector>
+
+#include "dsp/decoded_page_cache.h"
+
+namespace zrythm::dsp
+{
+
+DecodedPageCache::DecodedPageCache (size_t capacity_bytes)
+    : capacity_bytes_ (capacity_bytes)
+{
+}
+
+DecodedPageCache::PagePtr
+DecodedPageCache::find (const SourceId &source, size_t page_index)
+{
+  PagePtr ret;
+  pages_.visit (Key{ source, page_index }, [&] (auto &kv) {
+    kv.second.last_used = clock_.fetch_add (1) + 1;
+    ret = kv.second.page;
+  });
+  if (ret != nullptr)
+    {
+      hits_.fetch_add (1, std::memory_order_relaxed);
+    }
+  return ret;
+}
+
+DecodedPageCache::PagePtr
+DecodedPageCache::get_or_load (
+  const SourceId   &source,
+  size_t            page_index,
+  const PageLoader &loader)
+{
+  if (auto page = find (source, page_index))
+    return page;
+
+  misses_.fetch_add (1, std::memory_order_relaxed);
+
+  // decode without holding any lock
+  auto page = loader ();
+  if (page == nullptr)
+    return nullptr;
+
+  const auto inserted = pages_.try_emplace_or_visit (
+    Key{ source, page_index }, Entry{ page, clock_.fetch_add (1) + 1 },
+    [&] (auto &kv) {
+      // another thread cached it in the meantime
+      kv.second.last_used = clock_.fetch_add (1) + 1;
+      page = kv.second.page;
+    });
+  if (inserted)
+    {
+      size_bytes_.fetch_add (page_size_bytes (*page));
+      evict_if_needed ();
+    }
+  return page;
+}
+
+void
+DecodedPageCache::remove_source (const SourceId &source)
+{
+  size_t freed = 0;
+  pages_.erase_if ([&] (const auto &kv) {
+    if (kv.first.source != source)
+      return false;
+    freed += page_size_bytes (*kv.second.page);
+    return true;
+  });
+  size_bytes_.fetch_sub (freed);
+}
+
+void
+DecodedPageCache::set_capacity (size_t capacity_bytes)
+{
+  capacity_bytes_.store (capacity_bytes);
+  evict_if_needed ();
+}
+
+void
+DecodedPageCache::evict_if_needed ()
+{
+  if (size_bytes_.load () <= capacity_bytes_.load ())
+    return;
+
+  std::lock_guard lock (eviction_mutex_);
+
+  // evict down to 90% of the capacity so that we don't need to go through all
+  // the pages on every insertion once the cache is full
+  const auto target = capacity_bytes_.load () / 10 * 9;
+  if (size_bytes_.load () <= target)
+    return;
+
+  std::vector<std::pair<uint64_t, Key>> candidates;
+  candidates.reserve (pages_.size ());
+  pages_.cvisit_all ([&] (const auto &kv) {
+    candidates.emplace_back (kv.second.last_used, kv.first);
+  });
+  std::ranges::sort (candidates, {}, &std::pair<uint64_t, Key>::first);
+
+  for (const auto &[_, key] : candidates)
+    {
+      if (size_bytes_.load () <= target)
+        break;
+
+      size_t freed = 0;
+      const auto erased = pages_.erase_if (key, [&] (const auto &kv) {
+        freed = page_size_bytes (*kv.second.page);
+        return true;
+      });
+      if (erased > 0)
+        {
+          size_bytes_.fetch_sub (freed);
+          evictions_.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
+}
+
+DecodedPageCache::Stats
+DecodedPageCache::stats () const
+{
+  return {
+    .hits = hits_.load (std::memory_order_relaxed),
+    .misses = misses_.load (std::memory_order_relaxed),
+    .evictions = evictions_.load (std::memory_order_relaxed),
+    .num_pages = pages_.size (),
+    .size_bytes = size_bytes_.load (),
+    .capacity_bytes = capacity_bytes_.load (),
+  };
+}
+
+void
+DecodedPageCache::reset_stats ()
+{
+  hits_.store (0, std::memory_order_relaxed);
+  misses_.store (0, std::memory_order_relaxed);
+  evictions_.store (0, std::memory_order_relaxed);
+}
+
+} // namespace zrythm::dsp
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "utils/types.h"
+#include "utils/uuid_identifiable_object.h"
+
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace zrythm::dsp
+{
+
+class FileAudioSource;
+
+/**
+ * @brief Memory-budgeted cache of decoded audio pages, shared by everything
+ * that reads audio files from the pool.
+ *
+ * Pages are identified by the FileAudioSource they belong to and their index
+ * in the file (the page size is up to the caller, see StreamingSampleStore).
+ * When the total size of the cached pages exceeds the capacity, the least
+ * recently used pages are evicted.
+ *
+ * Pages are handed out as shared pointers, so an evicted page stays alive
+ * until its last user releases it. The capacity only bounds the memory held
+ * by the cache itself.
+ *
+ * All methods are thread-safe. None are realtime-safe.
+ */
+class DecodedPageCache final
+{
+public:
+  using SourceId = utils::UuidIdentifiableObject<FileAudioSource>::Uuid;
+  using PagePtr = std::shared_ptr<const juce::AudioSampleBuffer>;
+
+  /**
+   * @brief Decodes a page (may throw).
+   */
+  using PageLoader = std::function<PagePtr ()>;
+
+  struct Stats
+  {
+    /** Number of lookups that found the page in the cache. */
+    uint64_t hits{};
+
+    /** Number of lookups that had to decode the page. */
+    uint64_t misses{};
+
+    /** Number of pages evicted to stay within the capacity. */
+    uint64_t evictions{};
+
+    /** Number of pages currently cached. */
+    size_t num_pages{};
+
+    /** Total size of the currently cached pages. */
+    size_t size_bytes{};
+
+    size_t capacity_bytes{};
+  };
+
+  explicit DecodedPageCache (size_t capacity_bytes);
+  Z_DISABLE_COPY_MOVE (DecodedPageCache)
+
+  /**
+   * @brief Returns the given page, decoding it with @p loader and caching it
+   * if it is not cached.
+   *
+   * If multiple threads miss the same page at the same time, each decodes it
+   * but only one copy is cached.
+   *
+   * @throw Whatever @p loader throws.
+   */
+  PagePtr get_or_load (
+    const SourceId   &source,
+    size_t            page_index,
+    const PageLoader &loader);
+
+  /**
+   * @brief Returns the given page if it is cached, or nullptr.
+   */
+  PagePtr find (const SourceId &source, size_t page_index);
+
+  /**
+   * @brief Drops all pages of the given source (e.g., when its file changes).
+   */
+  void remove_source (const SourceId &source);
+
+  /**
+   * @brief Sets the capacity, evicting pages if needed.
+   */
+  void set_capacity (size_t capacity_bytes);
+
+  Stats stats () const;
+
+  void reset_stats ();
+
+  static size_t page_size_bytes (const juce::AudioSampleBuffer &page)
+  {
+    return static_cast<size_t> (page.getNumChannels ())
+           * static_cast<size_t> (page.getNumSamples ()) * sizeof (float);
+  }
+
+private:
+  struct Key
+  {
+    SourceId source;
+    size_t   page_index{};
+
+    bool operator== (const Key &other) const = default;
+
+    friend size_t hash_value (const Key &key)
+    {
+      size_t seed = key.source.hash ();
+      boost::hash_combine (seed, key.page_index);
+      return seed;
+    }
+  };
+
+  struct Entry
+  {
+    PagePtr page;
+
+    /** Value of @ref clock_ when the page was last used. */
+    uint64_t last_used{};
+  };
+
+  /**
+   * @brief Evicts the least recently used pages until the cache is within
+   * its capacity.
+   */
+  void evict_if_needed ();
+
+private:
+  boost::unordered::concurrent_flat_map<Key, Entry> pages_;
+
+  std::atomic<uint64_t> clock_{ 0 };
+  std::atomic<size_t>   size_bytes_{ 0 };
+  std::atomic<size_t>   capacity_bytes_;
+
+  /** Serializes evictions. */
+  std::mutex eviction_mutex_;
+
+  std::atomic<uint64_t> hits_{ 0 };
+  std::atomic<uint64_t> misses_{ 0 };
+  std::atomic<uint64_t> evictions_{ 0 };
+};
+
+} // namespace zrythm::dsp
@@ -83,6 +83,8 @@ AudioEngine::AudioEngine (
         std::make_unique<dsp::MidiPort> (u8"MIDI in", dsp::PortFlow::Input)),
       midi_panic_processor_ (
         utils::make_qobject_unique<dsp::MidiPanicProcessor> (local_registry_)),
+      node_timings_ (
+        utils::make_qobject_unique<GraphNodeTimingModel> (graph_dispatcher, this)),
       audio_callback_ (
         std::make_unique<AudioCallback> (
           [this] (
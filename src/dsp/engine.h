@@ -9,6 +9,7 @@
 #include "dsp/audio_input_processor.h"
 #include "dsp/audio_port.h"
 #include "dsp/graph_dispatcher.h"
+#include "dsp/graph_node_timing_model.h"
 #include "dsp/hardware_audio_interface.h"
 #include "dsp/hardware_midi_interface.h"
 #include "dsp/midi_input_processor.h"
@@ -29,6 +30,8 @@ class AudioEngine : public QObject
   Q_OBJECT
   Q_PROPERTY (int sampleRate READ sampleRate NOTIFY sampleRateChanged)
   Q_PROPERTY (int blockLength READ blockLength NOTIFY blockLengthChanged)
+  Q_PROPERTY (
+    zrythm::dsp::GraphNodeTimingModel * nodeTimings READ nodeTimings CONSTANT)
   QML_ELEMENT
   QML_UNCREATABLE ("")
 
@@ -80,6 +83,12 @@ public:
     return load_measurer_.getLoadAsPercentage ();
   }
 
+  /**
+   * @brief Per-node processing time statistics (to find out which node is
+   * responsible for high load).
+   */
+  GraphNodeTimingModel * nodeTimings () const { return node_timings_.get (); }
+
   /**
    * @brief Current sample rate from the hardware interface (QML-friendly).
    */
@@ -322,6 +331,8 @@ private:
 
   utils::QObjectUniquePtr<dsp::MidiPanicProcessor> midi_panic_processor_;
 
+  utils::QObjectUniquePtr<GraphNodeTimingModel> node_timings_;
+
   std::unique_ptr<AudioCallback> audio_callback_;
 
   utils::QObjectUniquePtr<AudioInputProcessor> audio_input_processor_;
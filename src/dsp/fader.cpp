@@ -222,6 +222,7 @@ Fader::init_param_caches ()
       if (id_str == amp_id_str)
         {
           amp_id_ = param_ref.id ();
+          param_ref.get ()->set_sample_accurate_automation (is_audio ());
         }
       else if (id_str == balance_id_str)
         {
@@ -272,6 +273,43 @@ Fader::calculate_target_gain_rt () const
   return gain_from_param;
 }
 
+std::span<const float>
+Fader::calculate_sample_accurate_gains_rt (
+  const dsp::graph::ProcessBlockInfo &time_nfo)
+{
+  // Largest gain difference to the previous block that is applied without
+  // smoothing
+  constexpr float kMaxGainJump = 0.001f;
+
+  const auto * amp_param = processing_caches_->amp_param_;
+  if (
+    amp_param == nullptr || effectively_muted_rt ()
+    || current_gain_.isSmoothing ())
+    return {};
+
+  const auto offset = time_nfo.buffer_offset_.in (units::samples);
+  const auto nframes = time_nfo.nframes_.in (units::samples);
+  const auto values = amp_param->block_values ();
+  if (values.empty () || nframes == 0)
+    return {};
+
+  auto gains =
+    std::span (processing_caches_->gain_buf_).subspan (offset, nframes);
+  std::ranges::transform (
+    values.subspan (offset, nframes), gains.begin (),
+    [&range = amp_param->range ()] (float value) {
+      return range.convertFrom0To1 (value);
+    });
+
+  // Ramp to the new gain instead (e.g., after unmuting)
+  if (
+    std::abs (gains.front () - current_gain_.getCurrentValue ()) > kMaxGainJump)
+    return {};
+
+  current_gain_.setCurrentAndTargetValue (gains.back ());
+  return gains;
+}
+
 // ============================================================================
 // ProcessorBase Interface
 // ============================================================================
@@ -288,8 +326,20 @@ Fader::custom_prepare_for_processing (
 
   processing_caches_->amp_param_ =
     amp_id_.has_value () ? &get_amp_param () : nullptr;
+  processing_caches_->gain_buf_.resize (
+    max_block_length.in (units::samples));
+  processing_caches_->gain_l_buf_.resize (
+    max_block_length.in (units::samples));
+  processing_caches_->gain_r_buf_.resize (
+    max_block_length.in (units::samples));
   processing_caches_->balance_param_ =
     balance_id_.has_value () ? &get_balance_param () : nullptr;
+  if (const auto * balance_param = processing_caches_->balance_param_)
+    {
+      // ramp balance changes to prevent zipper noise
+      enable_parameter_ramp (
+        *balance_param, ParameterChangeTracker::RampShape::Linear);
+    }
   processing_caches_->mute_param_ =
     mute_id_.has_value () ? &get_mute_param () : nullptr;
   processing_caches_->solo_param_ =
@@ -313,6 +363,10 @@ Fader::custom_prepare_for_processing (
       processing_caches_->audio_ins_rt_.push_back (&stereo_in);
       auto &stereo_out = get_stereo_out_port ();
       processing_caches_->audio_outs_rt_.push_back (&stereo_out);
+
+      // also read by the control room (listening) and the engine (monitor
+      // output)
+      stereo_out.mark_as_read_outside_graph ();
     }
   else if (is_midi ())
     {
@@ -329,13 +383,27 @@ Fader::custom_release_resources ()
   processing_caches_.reset ();
 }
 
+bool
+Fader::inputs_unused_rt () const noexcept
+{
+  // only once fully faded out, so that muting doesn't click
+  return is_audio () && effectively_muted_rt () && !current_gain_.isSmoothing ()
+         && current_gain_.getCurrentValue () == 0.f;
+}
+
 void
 Fader::custom_process_block (
   dsp::graph::ProcessBlockInfo time_nfo,
   const dsp::ITransport       &transport,
   const dsp::TempoMap         &tempo_map) noexcept
 {
-  current_gain_.setTargetValue (calculate_target_gain_rt ());
+  const auto sample_accurate_gains =
+    is_audio () ? calculate_sample_accurate_gains_rt (time_nfo)
+                : std::span<const float>{};
+  if (sample_accurate_gains.empty ())
+    {
+      current_gain_.setTargetValue (calculate_target_gain_rt ());
+    }
 
   if (is_audio ())
     {
@@ -363,84 +431,60 @@ Fader::custom_process_block (
       const auto &mono_compat_param =
         processing_caches_->mono_compat_enabled_param_;
       const auto &swap_phase_param = processing_caches_->swap_phase_param_;
-      const float pan = balance_param->range ().convertFrom0To1 (
-        balance_param->currentValue ());
+      const auto &balance = parameter_ramp (*balance_param);
       const bool mono_compat_enabled = mono_compat_param->range ().isToggled (
         mono_compat_param->currentValue ());
       const bool swap_phase = swap_phase_param->range ().isToggled (
         swap_phase_param->currentValue ());
 
-      // apply gain
-      const auto &out_buf =
-        processing_caches_->audio_outs_rt_.front ()->buffers ();
-      {
-        for (
-          const auto i : std::views::iota (
-            time_nfo.buffer_offset_.in<int> (units::samples),
-            out_buf->getNumSamples ()))
-          {
-            const auto gain = current_gain_.getCurrentValue ();
-            for (
-              const auto ch : std::views::iota (0, out_buf->getNumChannels ()))
-              {
-                out_buf->applyGain (ch, i, 1, gain);
-              }
-            current_gain_.skip (1);
-          }
-      }
-
-      // apply pan
-      {
-        auto [calc_l, calc_r] = dsp::calculate_balance_control (
-          dsp::BalanceControlAlgorithm::Linear, pan);
-        out_buf->applyGain (
-          0, time_nfo.buffer_offset_.in<int> (units::samples),
-          time_nfo.nframes_.in<int> (units::samples), calc_l);
-        out_buf->applyGain (
-          1, time_nfo.buffer_offset_.in<int> (units::samples),
-          time_nfo.nframes_.in<int> (units::samples), calc_r);
-      }
-
-      /* make mono if mono compat enabled */
-      if (mono_compat_enabled)
+      const auto offset = time_nfo.buffer_offset_.in (units::samples);
+      const auto nframes = time_nfo.nframes_.in (units::samples);
+      auto       gains =
+        std::span (processing_caches_->gain_buf_).subspan (offset, nframes);
+      if (sample_accurate_gains.empty ())
         {
-          utils::float_ranges::make_mono (
-            { out_buf->getWritePointer (
-                0, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            { out_buf->getWritePointer (
-                1, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            false);
-        }
-
-      /* swap phase if need */
-      if (swap_phase)
-        {
-          utils::float_ranges::mul_k2 (
-            { out_buf->getWritePointer (
-                0, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            -1.f);
-          utils::float_ranges::mul_k2 (
-            { out_buf->getWritePointer (
-                1, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            -1.f);
+          for (auto &gain : gains)
+            {
+              gain = current_gain_.getCurrentValue ();
+              current_gain_.skip (1);
+            }
         }
 
-      // hard-limit output if requested
-      if (hard_limit_output_)
+      // fold balance and phase into the gains of each channel
+      auto gains_l =
+        std::span (processing_caches_->gain_l_buf_).subspan (offset, nframes);
+      auto gains_r =
+        std::span (processing_caches_->gain_r_buf_).subspan (offset, nframes);
+      const float polarity = swap_phase ? -1.f : 1.f;
+      if (!balance.is_constant ())
         {
-          for (const auto ch : std::views::iota (0, out_buf->getNumChannels ()))
+          for (const auto i : std::views::iota (0zu, gains.size ()))
             {
-              utils::float_ranges::clip (
-                { out_buf->getWritePointer (
-                    ch, time_nfo.buffer_offset_.in<int> (units::samples)),
-                  time_nfo.nframes_.in (units::samples) },
-                -2.f, 2.f);
+              const auto [calc_l, calc_r] = dsp::calculate_balance_control (
+                dsp::BalanceControlAlgorithm::Linear, balance.values[i]);
+              gains_l[i] = gains[i] * calc_l * polarity;
+              gains_r[i] = gains[i] * calc_r * polarity;
             }
         }
+      else
+        {
+          const auto [calc_l, calc_r] = dsp::calculate_balance_control (
+            dsp::BalanceControlAlgorithm::Linear, balance.value);
+          utils::float_ranges::product (gains_l, gains, calc_l * polarity);
+          utils::float_ranges::product (gains_r, gains, calc_r * polarity);
+        }
+
+      // apply gain, balance, mono compatibility, phase and the hard limit in
+      // a single pass
+      const auto &out_buf =
+        processing_caches_->audio_outs_rt_.front ()->buffers ();
+
+      juce::ScopedNoDenormals no_denormals;
+      utils::float_ranges::stereo_fader (
+        { out_buf->getWritePointer (0, static_cast<int> (offset)), nframes },
+        { out_buf->getWritePointer (1, static_cast<int> (offset)), nframes },
+        gains_l, gains_r, mono_compat_enabled,
+        hard_limit_output_ ? 2.f : std::numeric_limits<float>::infinity ());
     } // endif is_audio()
   else if (is_midi ())
     {
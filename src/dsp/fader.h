@@ -45,6 +45,13 @@ class Fader : public QObject, public dsp::ProcessorBase
     dsp::MidiPort *               midi_in_rt_{};
     dsp::MidiPort *               midi_out_rt_{};
     dsp::MidiEventBuffer          midi_temp_buf_;
+
+    /** Per-sample gains (from sample-accurate automation or smoothing). */
+    std::vector<float> gain_buf_;
+
+    /** Per-sample gains of each channel (including balance and phase). */
+    std::vector<float> gain_l_buf_;
+    std::vector<float> gain_r_buf_;
   };
 
 public:
@@ -237,6 +244,16 @@ public:
 
   void custom_release_resources () override;
 
+  // silence in, silence out
+  std::optional<units::sample_u32_t> get_tail_length () const noexcept override
+  {
+    return units::samples (0u);
+  }
+
+  bool can_ignore_inputs () const override { return true; }
+
+  bool inputs_unused_rt () const noexcept override;
+
   [[gnu::hot]] void custom_process_block (
     dsp::graph::ProcessBlockInfo time_nfo,
     const dsp::ITransport       &transport,
@@ -296,6 +313,10 @@ public:
     return listened_param->range ().isToggled (listened_param->currentValue ());
   }
 
+protected:
+  // the input is only copied to the output
+  bool can_alias_audio_inputs () const override { return true; }
+
 private:
   static constexpr auto kMidiModeKey = "midiMode"sv;
   friend void           to_json (nlohmann::json &j, const Fader &fader);
@@ -315,6 +336,17 @@ private:
    */
   float calculate_target_gain_rt () const;
 
+  /**
+   * @brief Calculates the gain for each sample of the block from the gain
+   * parameter's sample-accurate automation values.
+   *
+   * @return The gains (one per sample in the block), or an empty span if the
+   * smoothed gain should be used instead (no sample-accurate values, muted,
+   * or the gain would jump).
+   */
+  std::span<const float> calculate_sample_accurate_gains_rt (
+    const dsp::graph::ProcessBlockInfo &time_nfo);
+
   bool effectively_muted () const
   {
     return currently_muted () || should_be_muted_cb_ (currently_soloed ());
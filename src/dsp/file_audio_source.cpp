@@ -59,7 +59,7 @@ FileAudioSource::FileAudioSource (
   assert (samplerate_ > units::sample_rate (0));
   name_ = name;
   bit_depth_ = bit_depth;
-  ch_frames_ = buf;
+  ch_frames_ = std::make_shared<utils::audio::AudioBuffer> (buf);
   convert_mono_to_stereo ();
   bpm_ = source_bpm;
 }
@@ -87,11 +87,14 @@ FileAudioSource::init_from_file (
     }
   bit_depth_ = utils::audio::bit_depth_int_to_enum (md.bit_depth);
   bpm_ = units::bpm (md.bpm);
+  streaming_store_.reset ();
 
   try
     {
       /* read frames into project's samplerate */
-      file.read_full (ch_frames_, samplerate_.in (units::sample_rate));
+      auto frames = std::make_shared<utils::audio::AudioBuffer> ();
+      file.read_full (*frames, samplerate_.in (units::sample_rate));
+      ch_frames_ = std::move (frames);
       convert_mono_to_stereo ();
     }
   catch (ZrythmException &e)
@@ -111,7 +114,8 @@ FileAudioSource::init_from_file (
       /* no BPM in metadata and no override: attempt to estimate the tempo
        * (only done on fresh imports - the stored value is authoritative when
        * reloading) */
-      if (const auto estimated_bpm = estimate_loop_bpm (ch_frames_, samplerate_))
+      if (
+        const auto estimated_bpm = estimate_loop_bpm (*ch_frames_, samplerate_))
         {
           z_debug (
             "estimated BPM of '{}' as {}", full_path,
@@ -120,9 +124,72 @@ FileAudioSource::init_from_file (
         }
     }
 
+  ++samples_version_;
   Q_EMIT samplesChanged ();
 }
 
+void
+FileAudioSource::init_streaming_from_file (
+  std::shared_ptr<StreamingSampleStore> store,
+  std::optional<units::bpm_t>           bpm_to_set)
+{
+  const auto &full_path = store->path ();
+  samplerate_ = store->sample_rate ();
+
+  AudioFile                       file (full_path);
+  utils::audio::AudioFileMetadata md;
+  try
+    {
+      md = file.read_metadata ();
+    }
+  catch (ZrythmException &e)
+    {
+      throw ZrythmException (
+        fmt::format ("Failed to read metadata from file '{}'", full_path));
+    }
+  bit_depth_ = utils::audio::bit_depth_int_to_enum (md.bit_depth);
+  bpm_ = units::bpm (md.bpm);
+  if (bpm_to_set.has_value () && bpm_to_set.value () > units::bpm (0.0))
+    {
+      bpm_ = bpm_to_set.value ();
+    }
+
+  name_ = utils::Utf8String::from_path (
+    utils::io::path_get_basename_without_ext (full_path));
+
+  /* release the in-memory frames */
+  ch_frames_ = std::make_shared<utils::audio::AudioBuffer> (2, 0);
+  streaming_store_ = std::move (store);
+
+  ++samples_version_;
+  Q_EMIT samplesChanged ();
+}
+
+void
+FileAudioSource::read_frames (
+  units::sample_t          start_frame,
+  int                      num_frames,
+  juce::AudioSampleBuffer &dest,
+  int                      dest_offset) const
+{
+  if (streaming_store_ != nullptr)
+    {
+      streaming_store_->read_blocking (
+        start_frame, num_frames, dest, dest_offset);
+      return;
+    }
+
+  for (
+    int ch = 0;
+    ch < std::min (ch_frames_->getNumChannels (), dest.getNumChannels ());
+    ++ch)
+    {
+      dest.copyFrom (
+        ch, dest_offset, *ch_frames_, ch, start_frame.in<int> (units::samples),
+        num_frames);
+    }
+}
+
 void
 init_from (
   FileAudioSource       &obj,
@@ -135,9 +202,11 @@ init_from (
     clone_type);
   obj.name_ = other.name_;
   obj.ch_frames_ = other.ch_frames_;
+  obj.streaming_store_ = other.streaming_store_;
   obj.bpm_ = other.bpm_;
   obj.samplerate_ = other.samplerate_;
   obj.bit_depth_ = other.bit_depth_;
+  obj.samples_version_ = other.samples_version_;
 }
 
 void
@@ -160,26 +229,30 @@ FileAudioSource::replace_frames (
   const utils::audio::AudioBuffer &src_frames,
   units::sample_u64_t              start_frame)
 {
+  z_return_if_fail (!is_streaming ());
   z_return_if_fail_cmp (
-    src_frames.getNumChannels (), ==, ch_frames_.getNumChannels ());
+    src_frames.getNumChannels (), ==, ch_frames_->getNumChannels ());
 
+  detach_frames ();
   for (int i = 0; i < src_frames.getNumChannels (); ++i)
     {
-      ch_frames_.copyFrom (
+      ch_frames_->copyFrom (
         i, start_frame.in<int> (units::samples),
         src_frames.getReadPointer (i, 0), src_frames.getNumSamples ());
     }
 
+  ++samples_version_;
   Q_EMIT samplesChanged ();
 }
 
 void
 FileAudioSource::expand_with_frames (const utils::audio::AudioBuffer &frames)
 {
-  z_return_if_fail (frames.getNumChannels () == ch_frames_.getNumChannels ());
+  z_return_if_fail (!is_streaming ());
+  z_return_if_fail (frames.getNumChannels () == ch_frames_->getNumChannels ());
   z_return_if_fail (frames.getNumSamples () > 0);
 
-  const auto current = static_cast<int64_t> (ch_frames_.getNumSamples ());
+  const auto current = static_cast<int64_t> (ch_frames_->getNumSamples ());
   const auto added = static_cast<int64_t> (frames.getNumSamples ());
   const auto needed = std::min (
     current + added, static_cast<int64_t> (std::numeric_limits<int>::max ()));
@@ -194,34 +267,47 @@ FileAudioSource::expand_with_frames (const utils::audio::AudioBuffer &frames)
   // but never shrink it, so we first grow to `grown` (expanding the underlying
   // allocation), then shrink the logical size back to `needed` while keeping
   // the larger allocation intact.
-  ch_frames_.setSize (ch_frames_.getNumChannels (), grown, true, false, true);
-  ch_frames_.setSize (ch_frames_.getNumChannels (), needed, true, false, true);
+  detach_frames ();
+  const auto num_channels = ch_frames_->getNumChannels ();
+  ch_frames_->setSize (num_channels, grown, true, false, true);
+  ch_frames_->setSize (num_channels, needed, true, false, true);
   replace_frames (frames, prev_end);
 }
 
 void
 FileAudioSource::convert_mono_to_stereo ()
 {
-  if (ch_frames_.getNumChannels () != 1)
+  if (ch_frames_->getNumChannels () != 1)
     {
       return;
     }
 
+  detach_frames ();
   const auto [left_gain, _] =
     calculate_panning (PanLaw::Minus3dB, PanAlgorithm::SquareRoot, 0.5f);
-  const auto num_samples = ch_frames_.getNumSamples ();
+  const auto num_samples = ch_frames_->getNumSamples ();
   assert (num_samples >= 0);
   const auto samples = static_cast<size_t> (num_samples);
 
-  ch_frames_.setSize (2, num_samples, true);
+  ch_frames_->setSize (2, num_samples, true);
 
-  auto * left = ch_frames_.getWritePointer (0);
-  auto * right = ch_frames_.getWritePointer (1);
+  auto * left = ch_frames_->getWritePointer (0);
+  auto * right = ch_frames_->getWritePointer (1);
 
   utils::float_ranges::mul_k2 ({ left, samples }, left_gain);
   utils::float_ranges::copy ({ right, samples }, { left, samples });
 }
 
+void
+FileAudioSource::detach_frames ()
+{
+  // the frames may be referenced by clones or by clips cached for playback
+  if (ch_frames_.use_count () > 1)
+    {
+      ch_frames_ = std::make_shared<utils::audio::AudioBuffer> (*ch_frames_);
+    }
+}
+
 // ========================================================================
 
 FileAudioSourceWriter::FileAudioSourceWriter (
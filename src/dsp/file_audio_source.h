@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "dsp/streaming_sample_store.h"
 #include "utils/audio.h"
 #include "utils/audio_file.h"
 #include "utils/icloneable.h"
@@ -103,6 +104,15 @@ public:
 
   // ========================================================================
 
+  /**
+   * @brief Returns a number that changes whenever samplesChanged() is
+   * emitted.
+   *
+   * Lets renders of the samples be reused as long as the samples don't
+   * change.
+   */
+  uint64_t samples_version () const { return samples_version_; }
+
   auto get_bit_depth () const { return bit_depth_; }
   auto get_name () const { return name_; }
   /**
@@ -113,9 +123,53 @@ public:
    *
    * @see bpm_ for how this is initialized.
    */
-  auto        source_bpm () const { return bpm_; }
-  const auto &get_samples () const { return ch_frames_; }
-  auto        get_samplerate () const { return samplerate_; }
+  auto source_bpm () const { return bpm_; }
+
+  /**
+   * @brief Returns the in-memory frames.
+   *
+   * These are empty if the clip is streamed from disk (see is_streaming()).
+   * Use read_frames() to read frames regardless of the backing mode.
+   */
+  const utils::audio::AudioBuffer &get_samples () const { return *ch_frames_; }
+  auto get_samplerate () const { return samplerate_; }
+
+  /**
+   * @brief Returns a reference to the in-memory frames that stays valid (and
+   * unchanged) while the frames are held, even if the clip's frames change.
+   *
+   * Lets the frames be played back without copying them.
+   */
+  std::shared_ptr<const juce::AudioSampleBuffer> get_shared_samples () const
+  {
+    return ch_frames_;
+  }
+
+  /**
+   * @brief Whether the clip's frames are streamed from disk instead of being
+   * held in memory.
+   */
+  bool is_streaming () const { return streaming_store_ != nullptr; }
+
+  /**
+   * @brief Returns the store the frames are streamed from, or nullptr if the
+   * frames are held in memory.
+   */
+  const auto &streaming_store () const { return streaming_store_; }
+
+  /**
+   * @brief Copies @p num_frames frames starting at @p start_frame to @p dest.
+   *
+   * Works for both in-memory and streamed clips.
+   *
+   * @warning Not realtime safe (use the streaming store directly from realtime
+   * threads).
+   */
+  void read_frames (
+    units::sample_t          start_frame,
+    int                      num_frames,
+    juce::AudioSampleBuffer &dest,
+    int                      dest_offset) const;
 
   void set_name (const utils::Utf8String &name) { name_ = name; }
 
@@ -160,12 +214,20 @@ public:
    */
   void clear_frames ()
   {
-    ch_frames_.setSize (ch_frames_.getNumChannels (), 0, false, true);
+    streaming_store_.reset ();
+    ch_frames_ = std::make_shared<utils::audio::AudioBuffer> (
+      ch_frames_->getNumChannels (), 0);
+    ++samples_version_;
     Q_EMIT samplesChanged ();
   }
 
-  auto get_num_channels () const { return ch_frames_.getNumChannels (); };
-  auto get_num_frames () const { return ch_frames_.getNumSamples (); };
+  auto get_num_channels () const { return ch_frames_->getNumChannels (); };
+  int  get_num_frames () const
+  {
+    return streaming_store_ != nullptr
+             ? streaming_store_->num_frames ().in<int> (units::samples)
+             : ch_frames_->getNumSamples ();
+  };
 
   /**
    * @brief Initializes members from an audio file.
@@ -183,6 +245,21 @@ public:
     units::sample_rate_t         project_sample_rate,
     std::optional<units::bpm_t>  bpm_to_set);
 
+  /**
+   * @brief Initializes members from an audio file that will be streamed from
+   * @p store instead of being loaded into memory.
+   *
+   * Unlike init_from_file(), the tempo is not estimated if the file has no
+   * BPM metadata (this would require decoding the whole file).
+   *
+   * @param bpm_to_set See init_from_file().
+   *
+   * @throw ZrythmException on I/O error.
+   */
+  void init_streaming_from_file (
+    std::shared_ptr<StreamingSampleStore> store,
+    std::optional<units::bpm_t>           bpm_to_set);
+
 private:
   friend void init_from (
     FileAudioSource       &obj,
@@ -191,6 +268,12 @@ private:
 
   void convert_mono_to_stereo ();
 
+  /**
+   * @brief Makes the frames unshared before changing them, so that references
+   * from get_shared_samples() keep seeing the previous frames.
+   */
+  void detach_frames ();
+
   friend void to_json (nlohmann::json &j, const FileAudioSource &clip);
   friend void from_json (const nlohmann::json &j, FileAudioSource &clip);
 
@@ -200,8 +283,19 @@ private:
 
   /**
    * Per-channel frames.
+   *
+   * Never null. Shared with clones of the clip and with get_shared_samples()
+   * (copied on write, see detach_frames()).
    */
-  utils::audio::AudioBuffer ch_frames_;
+  std::shared_ptr<utils::audio::AudioBuffer> ch_frames_ =
+    std::make_shared<utils::audio::AudioBuffer> ();
+
+  /**
+   * Store to stream the frames from, if the clip is streamed from disk.
+   *
+   * Shared between clones of the clip.
+   */
+  std::shared_ptr<StreamingSampleStore> streaming_store_;
 
   /**
    * The clip's permanent source BPM — its intrinsic musical tempo.
@@ -225,6 +319,9 @@ private:
    * Bit depth of the clip when the clip was imported into the project.
    */
   utils::audio::BitDepth bit_depth_{};
+
+  /** See samples_version(). */
+  uint64_t samples_version_{};
 };
 
 // ========================================================================
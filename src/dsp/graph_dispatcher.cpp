@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: © 2019-2022, 2024-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <algorithm>
+#include <unordered_map>
 #include <utility>
 
+#include "dsp/audio_port.h"
 #include "dsp/graph.h"
 #include "dsp/graph_dispatcher.h"
 #include "dsp/graph_export.h"
@@ -27,6 +30,18 @@ DspGraphDispatcher::DspGraphDispatcher (
 {
 }
 
+DspGraphDispatcher::~DspGraphDispatcher ()
+{
+  if (deferred_retirement_.has_value ())
+    {
+      // no cycle can start anymore, so swap in the new graph ourselves
+      scheduler_->terminate_threads ();
+      scheduler_->adopt_pending_node_collection ();
+      retire_node_collection (std::move (*deferred_retirement_));
+      deferred_retirement_.reset ();
+    }
+}
+
 units::sample_u32_t
 DspGraphDispatcher::get_max_route_playback_latency ()
 {
@@ -130,62 +145,286 @@ DspGraphDispatcher::start_cycle (
     time_nfo, remaining_latency_preroll, current_transport_state, tempo_map);
 }
 
-void
-DspGraphDispatcher::recalc_graph (bool soft)
+std::unique_ptr<graph::GraphNodeCollection>
+DspGraphDispatcher::build_node_collection ()
 {
-  z_info ("Recalculating processing graph{}...", soft ? " (soft)" : "");
+  graph::Graph graph;
 
-  const auto device_info = hw_interface_.get_device_info ();
-  const auto sample_rate = device_info.sample_rate;
-  const auto buffer_size = device_info.block_length;
-
-  const auto rebuild_graph = [&] () {
-    graph::Graph graph;
+  // Build graph
+  graph_builder_->build_graph (graph);
+  z_debug (
+    "Built graph (before pruning): {}",
+    graph::GraphExport::export_to_dot (graph, true));
 
-    // Build graph
-    graph_builder_->build_graph (graph);
+  // Prune graph
+  {
+    std::vector<std::reference_wrapper<graph::GraphNode>> terminals;
+    for (const auto &processable : terminal_processables_provider_ ())
+      {
+        auto * node = graph.get_nodes ().find_node_for_processable (*processable);
+        terminals.emplace_back (*node);
+      }
+    graph::GraphPruner::prune_graph_to_terminals (graph, terminals);
     z_debug (
-      "Built graph (before pruning): {}",
+      "Built graph (pruned): {}",
       graph::GraphExport::export_to_dot (graph, true));
+  }
 
-    // Prune graph
+  return std::make_unique<graph::GraphNodeCollection> (graph.steal_nodes ());
+}
+
+void
+DspGraphDispatcher::hot_swap_node_collection (
+  std::unique_ptr<graph::GraphNodeCollection> nodes)
+{
+  const auto sample_rate = scheduler_->get_sample_rate ();
+  const auto block_length = scheduler_->get_max_block_length ();
+
+  // leftovers from a previous swap
+  scheduler_->take_retired_node_collection ().reset ();
+
+  std::unordered_map<graph::IProcessable *, const graph::GraphNode *>
+    live_nodes;
+  for (const auto &node : scheduler_->get_nodes ().graph_nodes_)
     {
-      std::vector<std::reference_wrapper<graph::GraphNode>> terminals;
-      for (const auto &processable : terminal_processables_provider_ ())
+      live_nodes.emplace (
+        std::addressof (node->get_processable ()), node.get ());
+    }
+
+  // Processables not used by the live graph can be prepared while it keeps
+  // running. Shared ones keep their state unless their inputs changed, in
+  // which case the change is staged and applied when the new graph is
+  // adopted.
+  std::vector<graph::IProcessable *> staged_processables;
+  std::vector<graph::GraphNode *>    nodes_to_reprepare;
+  for (auto &node : nodes->graph_nodes_)
+    {
+      auto      &processable = node->get_processable ();
+      const auto it = live_nodes.find (std::addressof (processable));
+      if (it == live_nodes.end ())
+        {
+          // ports are also prepared by the processor owning them, which may be
+          // live
+          const auto * port = dynamic_cast<const Port *> (&processable);
+          if (
+            port != nullptr && port->is_prepared_for_processing ()
+            && processable.stage_node_inputs (*node))
+            {
+              staged_processables.push_back (std::addressof (processable));
+            }
+          else
+            {
+              processable.prepare_for_processing (
+                node.get (), sample_rate, block_length);
+            }
+          continue;
+        }
+
+      const auto * live_node = it->second;
+      live_nodes.erase (it);
+      const auto parent_processable = [] (const auto &parent) {
+        return std::addressof (parent.get ().get_processable ());
+      };
+      if (std::ranges::is_permutation (
+            live_node->depends (), node->depends (), {}, parent_processable,
+            parent_processable))
+        continue;
+
+      if (processable.stage_node_inputs (*node))
+        {
+          staged_processables.push_back (std::addressof (processable));
+        }
+      else
         {
-          auto * node =
-            graph.get_nodes ().find_node_for_processable (*processable);
-          terminals.emplace_back (*node);
+          nodes_to_reprepare.push_back (node.get ());
         }
-      graph::GraphPruner::prune_graph_to_terminals (graph, terminals);
-      z_debug (
-        "Built graph (pruned): {}",
-        graph::GraphExport::export_to_dot (graph, true));
     }
 
-    scheduler_->rechain_from_node_collection (
-      graph.steal_nodes (), sample_rate, buffer_size);
+  // ports are released by the processor owning them, which may still be live
+  std::vector<Port *>                leaving_ports;
+  std::vector<graph::IProcessable *> leaving_processables;
+  for (const auto &[processable, _] : live_nodes)
+    {
+      if (auto * port = dynamic_cast<Port *> (processable))
+        leaving_ports.push_back (port);
+      else
+        leaving_processables.push_back (processable);
+    }
+  auto port_buffers =
+    PortBufferPool::assign (*nodes, block_length, leaving_ports);
+  log_port_buffer_pool_stats (port_buffers->stats ());
+  nodes->update_latencies ();
+
+  auto on_adopt = [staged_processables = std::move (staged_processables),
+                   port_buffers = port_buffers.get ()] () noexcept {
+    for (auto * processable : staged_processables)
+      {
+        processable->commit_node_inputs ();
+      }
+    port_buffers->bind ();
   };
 
+  if (
+    nodes_to_reprepare.empty ()
+    && !scheduler_->requires_pause_to_publish (*nodes))
+    {
+      scheduler_->publish_node_collection (
+        std::move (nodes), std::move (on_adopt));
+      if (
+        !scheduler_->wait_for_adoption (ADOPTION_TIMEOUT)
+        && !scheduler_->is_idle ())
+        {
+          // a cycle is stuck (e.g., in a plugin), so don't block on it: the
+          // previous graph stays live until a cycle adopts the new one
+          z_warning (
+            "Graph threads did not adopt the new graph within {} ms, "
+            "deferring the release of the previous graph",
+            ADOPTION_TIMEOUT.count ());
+          deferred_retirement_ = DeferredRetirement{
+            .leaving_processables = std::move (leaving_processables),
+            .port_buffers = std::move (port_buffers)
+          };
+          return;
+        }
+      if (scheduler_->has_pending_node_collection ())
+        {
+          // the engine is not running cycles, so swap it ourselves
+          run_function_with_engine_lock_ ([&] () {
+            scheduler_->wait_until_idle ();
+            scheduler_->adopt_pending_node_collection ();
+          });
+        }
+    }
+  else
+    {
+      // only processables that can't stage their input changes are handled
+      // while paused
+      run_function_with_engine_lock_ ([&] () {
+        scheduler_->wait_until_idle ();
+        for (auto * node : nodes_to_reprepare)
+          {
+            auto &processable = node->get_processable ();
+            processable.release_resources ();
+            processable.prepare_for_processing (node, sample_rate, block_length);
+          }
+        scheduler_->publish_node_collection (
+          std::move (nodes), std::move (on_adopt));
+        scheduler_->adopt_pending_node_collection ();
+      });
+    }
+
+  retire_node_collection (
+    { .leaving_processables = std::move (leaving_processables),
+      .port_buffers = std::move (port_buffers) });
+}
+
+void
+DspGraphDispatcher::retire_node_collection (DeferredRetirement retirement)
+{
+  // the previous graph will never run again, so clean up after it
+  auto retired = scheduler_->take_retired_node_collection ();
+  assert (retired != nullptr);
+  for (auto * processable : retirement.leaving_processables)
+    {
+      processable->release_resources ();
+    }
+  retired.reset ();
+
+  // no port refers to the previous arena anymore
+  port_buffers_ = std::move (retirement.port_buffers);
+}
+
+void
+DspGraphDispatcher::settle_deferred_retirement ()
+{
+  if (!deferred_retirement_.has_value ())
+    return;
+
+  if (!scheduler_->wait_for_adoption (ADOPTION_TIMEOUT))
+    {
+      z_warning ("Graph threads still did not adopt the new graph, pausing");
+      run_function_with_engine_lock_ ([&] () {
+        scheduler_->wait_until_idle ();
+        scheduler_->adopt_pending_node_collection ();
+      });
+    }
+  retire_node_collection (std::move (*deferred_retirement_));
+  deferred_retirement_.reset ();
+}
+
+void
+DspGraphDispatcher::pool_port_buffers (const graph::GraphNodeCollection &nodes)
+{
+  auto port_buffers =
+    PortBufferPool::assign (nodes, scheduler_->get_max_block_length ());
+  log_port_buffer_pool_stats (port_buffers->stats ());
+  port_buffers->bind ();
+  port_buffers_ = std::move (port_buffers);
+}
+
+void
+DspGraphDispatcher::log_port_buffer_pool_stats (
+  const PortBufferPool::Stats &stats)
+{
+  z_info (
+    "Pooled {} port buffers into {} shared buffers ({} KiB "
+    "instead of {} KiB)",
+    stats.num_ports, stats.num_slots, stats.pooled_bytes / 1024,
+    stats.unpooled_bytes / 1024);
+}
+
+void
+DspGraphDispatcher::recalc_graph (bool soft)
+{
+  z_info ("Recalculating processing graph{}...", soft ? " (soft)" : "");
+
+  const auto device_info = hw_interface_.get_device_info ();
+  const auto sample_rate = device_info.sample_rate;
+  const auto buffer_size = device_info.block_length;
+
   if (!scheduler_ && !soft)
     {
       scheduler_ = std::make_unique<graph::GraphScheduler> (
         run_on_main_thread_, sample_rate, buffer_size, true, workgroup_);
-      rebuild_graph ();
+      scheduler_->set_node_timing_enabled (node_timing_enabled_);
+      scheduler_->rechain_from_node_collection (
+        std::move (*build_node_collection ()), sample_rate, buffer_size);
+      pool_port_buffers (scheduler_->get_nodes ());
       scheduler_->start_threads ();
       return;
     }
 
-  run_function_with_engine_lock_ ([&] () {
-    if (soft)
-      {
+  if (soft)
+    {
+      run_function_with_engine_lock_ ([&] () {
         scheduler_->get_nodes ().update_latencies ();
-      }
-    else
-      {
-        rebuild_graph ();
-      }
-  });
+      });
+      z_info ("Processing graph ready");
+      return;
+    }
+
+  // building/pruning doesn't touch the live graph, so keep it out of the
+  // paused section
+  auto nodes = build_node_collection ();
+
+  // finish the previous swap before starting a new one
+  settle_deferred_retirement ();
+
+  if (
+    scheduler_->get_sample_rate () != sample_rate
+    || scheduler_->get_max_block_length () != buffer_size)
+    {
+      // everything needs to be re-prepared anyway
+      run_function_with_engine_lock_ ([&] () {
+        scheduler_->rechain_from_node_collection (
+          std::move (*nodes), sample_rate, buffer_size);
+        pool_port_buffers (scheduler_->get_nodes ());
+      });
+    }
+  else
+    {
+      hot_swap_node_collection (std::move (nodes));
+    }
 
   z_info ("Processing graph ready");
 }
@@ -198,10 +437,64 @@ DspGraphDispatcher::clear_graph ()
 
   const auto device_info = hw_interface_.get_device_info ();
 
+  settle_deferred_retirement ();
   run_function_with_engine_lock_ ([&] () {
     scheduler_->rechain_from_node_collection (
       graph::GraphNodeCollection{}, device_info.sample_rate,
       device_info.block_length);
   });
+  port_buffers_.reset ();
+}
+
+void
+DspGraphDispatcher::set_node_timing_enabled (bool enabled)
+{
+  node_timing_enabled_ = enabled;
+  if (scheduler_)
+    {
+      scheduler_->set_node_timing_enabled (enabled);
+    }
+}
+
+std::vector<DspGraphDispatcher::NodeTiming>
+DspGraphDispatcher::collect_node_timings () const
+{
+  std::vector<NodeTiming> ret;
+  if (!scheduler_)
+    return ret;
+
+  const auto &nodes = scheduler_->get_nodes ().graph_nodes_;
+  ret.reserve (nodes.size ());
+  for (const auto &node : nodes)
+    {
+      ret.push_back (
+        NodeTiming{
+          .node_id = node->get_id (),
+          .name = node->get_processable ().get_node_name (),
+          .stats = node->timing_stats ().snapshot () });
+    }
+  return ret;
+}
+
+void
+DspGraphDispatcher::reset_node_timings ()
+{
+  if (!scheduler_)
+    return;
+
+  for (const auto &node : scheduler_->get_nodes ().graph_nodes_)
+    {
+      node->timing_stats ().reset ();
+    }
+}
+
+utils::Utf8String
+DspGraphDispatcher::export_node_timings_to_dot () const
+{
+  if (!scheduler_)
+    return graph::GraphExport::export_to_dot (graph::GraphNodeCollection{});
+
+  return graph::GraphExport::export_to_dot (
+    scheduler_->get_nodes (), true, true);
 }
 }
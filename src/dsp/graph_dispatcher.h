@@ -6,6 +6,7 @@
 #include "dsp/graph_builder.h"
 #include "dsp/graph_scheduler.h"
 #include "dsp/hardware_audio_interface.h"
+#include "dsp/port_buffer_pool.h"
 #include "utils/rt_thread_id.h"
 
 #include <juce_audio_basics/juce_audio_basics.h>
@@ -38,10 +39,25 @@ public:
     RunFunctionWithEngineLock                  run_function_with_engine_lock,
     graph::GraphScheduler::RunOnMainThreadFunc run_on_main_thread,
     std::optional<juce::AudioWorkgroup>        workgroup = std::nullopt);
+  ~DspGraphDispatcher ();
 
   /**
    * Recalculates the process acyclic directed graph.
    *
+   * The new graph is built, pruned and (for processables not in the current
+   * graph) prepared while the current graph keeps processing. Processables
+   * shared by both graphs are left alone unless their inputs changed, in
+   * which case the change is staged (see IProcessable::stage_node_inputs())
+   * and applied when the graph threads swap in the new graph at the next
+   * cycle boundary. Processing is only paused for processables that can't
+   * stage their changes. Resources only used by the old graph are released
+   * afterwards.
+   *
+   * If the graph threads are stuck in a cycle and don't adopt the new graph
+   * in time, this returns without waiting for them: the old graph stays live
+   * until the next cycle adopts the new one, and its resources are released
+   * by the next call (see DeferredRetirement).
+   *
    * @param soft If true, only readjusts latencies.
    */
   void recalc_graph (bool soft);
@@ -129,6 +145,58 @@ public:
     return scheduler_->get_nodes ().trigger_nodes_;
   }
 
+  /**
+   * @brief Processing time statistics of a node in the current graph.
+   */
+  struct NodeTiming
+  {
+    graph::GraphNode::NodeId              node_id{};
+    utils::Utf8String                     name;
+    graph::GraphNodeTimingStats::Snapshot stats;
+  };
+
+  /**
+   * @brief Enables/disables per-node processing time statistics.
+   *
+   * Disabled by default. Statistics are carried over to the recalculated
+   * graph for the processables that are still in it.
+   */
+  void set_node_timing_enabled (bool enabled);
+  bool node_timing_enabled () const { return node_timing_enabled_; }
+
+  /**
+   * @brief Returns the statistics collected for the nodes in the current
+   * graph.
+   *
+   * @note Must be called from the same thread as recalc_graph().
+   */
+  std::vector<NodeTiming> collect_node_timings () const;
+
+  /**
+   * @brief Clears the statistics of all nodes in the current graph.
+   *
+   * @note Must be called from the same thread as recalc_graph().
+   */
+  void reset_node_timings ();
+
+  /**
+   * @brief Exports the current graph to DOT format with nodes colored by
+   * their processing cost.
+   *
+   * @note Must be called from the same thread as recalc_graph().
+   */
+  utils::Utf8String export_node_timings_to_dot () const;
+
+  /**
+   * @brief Returns how the port buffers of the current graph were pooled.
+   *
+   * @see PortBufferPool.
+   */
+  PortBufferPool::Stats port_buffer_pool_stats () const
+  {
+    return port_buffers_ ? port_buffers_->stats () : PortBufferPool::Stats{};
+  }
+
 private:
   /**
    * @brief Global cycle pre-processing logic that does not require rebuilding
@@ -149,6 +217,64 @@ private:
     const dsp::graph::ProcessBlockInfo &time_nfo) noexcept
     [[clang::nonblocking]];
 
+  /**
+   * @brief Builds and prunes a new node collection (not prepared yet).
+   */
+  std::unique_ptr<graph::GraphNodeCollection> build_node_collection ();
+
+  /**
+   * @brief Replaces the live node collection with @p nodes, pausing
+   * processing only while processables shared with the live graph that can't
+   * stage their input changes are re-prepared.
+   */
+  void
+  hot_swap_node_collection (std::unique_ptr<graph::GraphNodeCollection> nodes);
+
+  /**
+   * @brief Makes the ports in @p nodes share buffers (see PortBufferPool).
+   *
+   * To be called after preparing all the nodes, while they are not being
+   * processed.
+   */
+  void pool_port_buffers (const graph::GraphNodeCollection &nodes);
+
+  static void log_port_buffer_pool_stats (const PortBufferPool::Stats &stats);
+
+  /**
+   * @brief Cleanup of a replaced graph, done once the graph threads adopted
+   * its replacement.
+   */
+  struct DeferredRetirement
+  {
+    /** Processables that are only in the replaced graph. */
+    std::vector<graph::IProcessable *> leaving_processables;
+
+    /** Port buffers of the new graph (bound when it's adopted). */
+    std::unique_ptr<PortBufferPool::Assignment> port_buffers;
+  };
+
+  /**
+   * @brief Releases what only the replaced graph used.
+   *
+   * Must only be called after the new graph was adopted.
+   */
+  void retire_node_collection (DeferredRetirement retirement);
+
+  /**
+   * @brief Finishes a swap whose adoption timed out (if any).
+   *
+   * Waits for the graph threads to adopt the new graph, and adopts it while
+   * holding the engine lock if they still don't.
+   */
+  void settle_deferred_retirement ();
+
+private:
+  /**
+   * @brief How long to wait for the graph threads to adopt a new graph before
+   * assuming the engine is not running cycles.
+   */
+  static constexpr auto ADOPTION_TIMEOUT = std::chrono::milliseconds (100);
+
 private:
   std::unique_ptr<graph::IGraphBuilder> graph_builder_;
   const IHardwareAudioInterface        &hw_interface_;
@@ -165,8 +291,25 @@ private:
    */
   TerminalProcessablesProvider terminal_processables_provider_;
 
+  /**
+   * @brief Storage assigned to the ports of the live graph.
+   *
+   * Declared before the scheduler so that it outlives the graph threads.
+   */
+  std::unique_ptr<PortBufferPool::Assignment> port_buffers_;
+
+  /**
+   * @brief Cleanup of the graph replaced by the last swap, if the graph threads
+   * had not adopted its replacement when recalc_graph() returned.
+   *
+   * Declared before the scheduler for the same reason as port_buffers_.
+   */
+  std::optional<DeferredRetirement> deferred_retirement_;
+
   std::unique_ptr<graph::GraphScheduler> scheduler_;
 
+  bool node_timing_enabled_{ false };
+
   /** Stored for the currently processing cycle */
   units::sample_u32_t max_route_playback_latency_;
 
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: © 2025 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <algorithm>
 #include <sstream>
 
 #include "dsp/graph_export.h"
@@ -15,11 +16,33 @@ namespace zrythm::dsp::graph
 utils::Utf8String
 GraphExport::export_to_dot (const graph::Graph &graph, bool include_class_names)
 {
+  return export_to_dot (graph.setup_nodes_, include_class_names, false);
+}
+
+utils::Utf8String
+GraphExport::export_to_dot (
+  const GraphNodeCollection &nodes,
+  bool                       include_class_names,
+  bool                       color_by_cost)
+{
+  std::vector<GraphNodeTimingStats::Snapshot> timings;
+  double                                      max_mean_ns = 0.0;
+  if (color_by_cost)
+    {
+      timings.reserve (nodes.graph_nodes_.size ());
+      for (const auto &node : nodes.graph_nodes_)
+        {
+          timings.push_back (node->timing_stats ().snapshot ());
+          max_mean_ns = std::max (max_mean_ns, timings.back ().mean_ns);
+        }
+    }
+
   std::stringstream ss;
   ss << "digraph G {\n";
 
-  for (const auto &node : graph.setup_nodes_.graph_nodes_)
+  for (size_t index = 0; index < nodes.graph_nodes_.size (); ++index)
     {
+      const auto &node = nodes.graph_nodes_[index];
       const auto &processable = node->get_processable ();
 
       // Node definition
@@ -43,7 +66,22 @@ GraphExport::export_to_dot (const graph::Graph &graph, bool include_class_names)
             }
         }
 
-      ss << "\"];\n";
+      if (color_by_cost && timings[index].count > 0)
+        {
+          const auto &timing = timings[index];
+          ss << "\\nmean " << (timing.mean_ns / 1000.0) << " us, p99 "
+             << (static_cast<double> (timing.p99_ns) / 1000.0) << " us\"";
+
+          // hue 0.333 (green) for free nodes, 0 (red) for the most expensive one
+          const double relative_cost =
+            max_mean_ns > 0.0 ? timing.mean_ns / max_mean_ns : 0.0;
+          ss << ", style=filled, fillcolor=\"" << (0.333 * (1.0 - relative_cost))
+             << " 0.6 1.0\"];\n";
+        }
+      else
+        {
+          ss << "\"];\n";
+        }
 
       // Connections
       for (const auto &child : node->feeds ())
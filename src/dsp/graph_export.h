@@ -37,6 +37,20 @@ public:
    */
   static utils::Utf8String
   export_to_dot (const Graph &graph, bool include_class_names = false);
+
+  /**
+   * @brief Export a node collection to DOT format.
+   *
+   * @param color_by_cost Whether to add the collected processing time
+   * statistics (see GraphNode::timing_stats()) to the node labels and fill
+   * the nodes with a color ranging from green (cheap) to red (most
+   * expensive by mean processing time). Nodes without statistics are left
+   * unfilled.
+   */
+  static utils::Utf8String export_to_dot (
+    const GraphNodeCollection &nodes,
+    bool                       include_class_names = false,
+    bool                       color_by_cost = false);
 };
 
 } // namespace zrythm::dsp::graph
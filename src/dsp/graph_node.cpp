@@ -27,7 +27,11 @@
  */
 
 #include <algorithm>
+#include <memory>
+#include <ranges>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "dsp/graph_node.h"
@@ -356,6 +360,201 @@ GraphNodeCollection::set_initial_and_terminal_nodes ()
     }
 }
 
+void
+GraphNodeCollection::update_topological_order ()
+{
+  // Kahn's algorithm
+  topological_order_.clear ();
+  topological_order_.reserve (graph_nodes_.size ());
+
+  std::unordered_map<const GraphNode *, int> remaining;
+  remaining.reserve (graph_nodes_.size ());
+  for (const auto &node : graph_nodes_)
+    {
+      remaining.emplace (node.get (), node->init_refcount_);
+      if (node->init_refcount_ == 0)
+        {
+          topological_order_.push_back (node.get ());
+        }
+    }
+
+  for (size_t i = 0; i < topological_order_.size (); ++i)
+    {
+      for (const auto child : topological_order_[i]->feeds ())
+        {
+          if (--remaining[std::addressof (child.get ())] == 0)
+            {
+              topological_order_.push_back (std::addressof (child.get ()));
+            }
+        }
+    }
+
+  for (const auto i : std::views::iota (0zu, topological_order_.size ()))
+    {
+      topological_order_[i]->topological_index_ = i;
+    }
+  critical_path_worklist_.resize (topological_order_.size ());
+
+  prioritized_trigger_nodes_.clear ();
+  prioritized_trigger_nodes_.reserve (trigger_nodes_.size ());
+  for (const auto node : trigger_nodes_)
+    {
+      prioritized_trigger_nodes_.push_back (std::addressof (node.get ()));
+    }
+}
+
+void
+GraphNodeCollection::update_prunable_subgraphs ()
+{
+  prunable_subgraphs_.clear ();
+  for (const auto &gate : graph_nodes_)
+    {
+      if (!gate->get_processable ().can_ignore_inputs ())
+        continue;
+
+      // walk up from the gate, adding each node once all its children were
+      // added
+      PrunableSubgraph subgraph{ .gate = gate.get () };
+      std::unordered_set<const GraphNode *>         upstream;
+      std::unordered_map<const GraphNode *, size_t> added_children;
+      std::vector<GraphNode *>                      pending{ gate.get () };
+      while (!pending.empty ())
+        {
+          auto * node = pending.back ();
+          pending.pop_back ();
+          for (const auto parent_ref : node->depends ())
+            {
+              auto &parent = parent_ref.get ();
+              if (
+                ++added_children[&parent] == parent.feeds ().size ()
+                && parent.get_processable ().can_be_pruned ())
+                {
+                  subgraph.upstream.push_back (&parent);
+                  upstream.insert (&parent);
+                  pending.push_back (&parent);
+                }
+            }
+        }
+      if (subgraph.upstream.empty ())
+        continue;
+
+      subgraph.num_upstream_gate_parents = static_cast<int> (
+        std::ranges::count_if (gate->depends (), [&] (const auto &parent) {
+          return upstream.contains (std::addressof (parent.get ()));
+        }));
+      prunable_subgraphs_.push_back (std::move (subgraph));
+    }
+}
+
+void
+GraphNodeCollection::update_critical_paths () noexcept
+{
+  // children come after parents, so walk backwards
+  for (auto * node : std::views::reverse (topological_order_))
+    {
+      float max_child_cost = 0.f;
+      for (const auto child : node->feeds ())
+        {
+          max_child_cost =
+            std::max (max_child_cost, child.get ().critical_path_cost_ns_);
+        }
+      node->critical_path_process_cost_ns_ = node->get_process_cost ();
+      node->process_cost_change_reported_ = false;
+      node->critical_path_cost_ns_ =
+        node->critical_path_process_cost_ns_ + max_child_cost;
+    }
+
+  std::ranges::sort (
+    prioritized_trigger_nodes_, std::ranges::greater{},
+    &GraphNode::get_critical_path_cost);
+}
+
+void
+GraphNodeCollection::update_critical_paths (
+  std::span<GraphNode * const> changed_nodes) noexcept
+{
+  // visit the deepest node first, so that each node is only visited after all
+  // of its descendants that changed
+  const auto heap_begin = critical_path_worklist_.begin ();
+  auto       heap_end = heap_begin;
+  const auto shallower = [] (const GraphNode * a, const GraphNode * b) {
+    return a->topological_index_ < b->topological_index_;
+  };
+  const auto enqueue = [&] (GraphNode &node) {
+    if (node.critical_path_update_queued_)
+      return;
+    node.critical_path_update_queued_ = true;
+    *heap_end++ = std::addressof (node);
+    std::push_heap (heap_begin, heap_end, shallower);
+  };
+
+  for (auto * node : changed_nodes)
+    {
+      node->critical_path_process_cost_ns_ = node->get_process_cost ();
+      node->process_cost_change_reported_ = false;
+      enqueue (*node);
+    }
+
+  bool trigger_costs_changed = false;
+  while (heap_end != heap_begin)
+    {
+      std::pop_heap (heap_begin, heap_end, shallower);
+      auto * node = *--heap_end;
+      node->critical_path_update_queued_ = false;
+
+      float max_child_cost = 0.f;
+      for (const auto child : node->feeds ())
+        {
+          max_child_cost =
+            std::max (max_child_cost, child.get ().critical_path_cost_ns_);
+        }
+      const auto cost = node->critical_path_process_cost_ns_ + max_child_cost;
+      if (cost == node->critical_path_cost_ns_)
+        continue;
+
+      node->critical_path_cost_ns_ = cost;
+      trigger_costs_changed |= node->depends ().empty ();
+      for (const auto parent : node->depends ())
+        {
+          enqueue (parent.get ());
+        }
+    }
+
+  if (trigger_costs_changed)
+    {
+      std::ranges::sort (
+        prioritized_trigger_nodes_, std::ranges::greater{},
+        &GraphNode::get_critical_path_cost);
+    }
+}
+
+void
+GraphNodeCollection::inherit_measurements (const GraphNodeCollection &other)
+{
+  std::unordered_map<const IProcessable *, const GraphNode *> other_nodes;
+  other_nodes.reserve (other.graph_nodes_.size ());
+  for (const auto &node : other.graph_nodes_)
+    {
+      other_nodes.emplace (
+        std::addressof (node->get_processable ()), node.get ());
+    }
+
+  for (auto &node : graph_nodes_)
+    {
+      const auto it =
+        other_nodes.find (std::addressof (node->get_processable ()));
+      if (it == other_nodes.end ())
+        continue;
+
+      const auto &other_node = *it->second;
+      node->process_cost_ns_.store (
+        other_node.get_process_cost (), std::memory_order_relaxed);
+      node->timing_stats_.copy_from (other_node.timing_stats_);
+    }
+
+  update_critical_paths ();
+}
+
 GraphNode *
 GraphNodeCollection::find_node_for_processable (
   const IProcessable &processable) const
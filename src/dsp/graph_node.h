@@ -28,6 +28,10 @@
 
 #pragma once
 
+#include <cmath>
+#include <span>
+
+#include "dsp/graph_node_timing.h"
 #include "dsp/itransport.h"
 #include "dsp/tempo_map.h"
 #include "utils/units.h"
@@ -148,6 +152,59 @@ public:
    * This may be called multiple times.
    */
   virtual void release_resources () { }
+
+  /**
+   * @brief Called instead of prepare_for_processing() when the processable
+   * stays in the graph across a rebuild but its node's inputs changed.
+   *
+   * The processable is being processed by the live graph while this is
+   * called, so only state that is not used during processing may be touched.
+   * The staged state is applied by commit_node_inputs().
+   *
+   * @return Whether the change was staged. If not, the processable is prepared
+   * again while processing is paused.
+   */
+  virtual bool stage_node_inputs (const GraphNode &node) { return false; }
+
+  /**
+   * @brief Applies what was staged by stage_node_inputs().
+   *
+   * Called between cycles, right before the rebuilt graph runs for the first
+   * time.
+   */
+  virtual void commit_node_inputs () noexcept [[clang::nonblocking]] { }
+
+  /**
+   * @brief Whether ignore_inputs_in_next_cycle() may return true.
+   *
+   * The nodes that only feed such nodes are found when the graph is built
+   * (see GraphNodeCollection::prunable_subgraphs_).
+   */
+  virtual bool can_ignore_inputs () const { return false; }
+
+  /**
+   * @brief Called before each cycle (while no node is being processed) on
+   * nodes whose can_ignore_inputs() returns true.
+   *
+   * @param allowed Whether the node may ignore its inputs in the cycle.
+   * @return Whether the node will ignore its inputs in the cycle. If so, the
+   * node must not access its input ports at all, and nodes that can be pruned
+   * and only feed this node are not processed.
+   */
+  virtual bool ignore_inputs_in_next_cycle (bool allowed) noexcept
+    [[clang::nonblocking]]
+  {
+    return false;
+  }
+
+  /**
+   * @brief Whether the node may be left out of cycles in which nothing uses
+   * its output (see ignore_inputs_in_next_cycle()).
+   *
+   * Nodes that do more than produce their output (e.g., recording) must
+   * return false.
+   */
+  virtual bool can_be_pruned () const { return false; }
 };
 
 class InitialProcessor final : public QObject, public IProcessable
@@ -252,6 +309,55 @@ public:
   bool remove_feed (const GraphNode &feed);
   bool remove_depend (const GraphNode &depend);
 
+  /**
+   * @brief Adds a measured processing time to the smoothed cost of this node.
+   *
+   * Realtime-safe. Called by the graph thread that processed the node.
+   *
+   * @return Whether the cost moved past @ref PROCESS_COST_CHANGE_THRESHOLD
+   * from the one the critical paths were last computed with (only returned
+   * once until the critical paths are updated).
+   */
+  bool record_process_time (float nanoseconds) noexcept [[clang::nonblocking]]
+  {
+    const auto prev = process_cost_ns_.load (std::memory_order_relaxed);
+    const auto cost =
+      prev == 0.f
+        ? nanoseconds
+        : prev + (PROCESS_COST_SMOOTHING * (nanoseconds - prev));
+    process_cost_ns_.store (cost, std::memory_order_relaxed);
+
+    if (
+      process_cost_change_reported_
+      || std::abs (cost - critical_path_process_cost_ns_)
+           <= PROCESS_COST_CHANGE_THRESHOLD * critical_path_process_cost_ns_)
+      return false;
+
+    process_cost_change_reported_ = true;
+    return true;
+  }
+
+  float get_process_cost () const
+  {
+    return process_cost_ns_.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Cost of the most expensive path from this node (inclusive) to a
+   * terminal node, in nanoseconds.
+   *
+   * Used as the dispatch priority of the node. Updated by
+   * GraphNodeCollection::update_critical_paths().
+   */
+  float get_critical_path_cost () const { return critical_path_cost_ns_; }
+
+  /**
+   * @brief Processing time statistics (only collected while node timing is
+   * enabled on the scheduler).
+   */
+  auto &timing_stats () { return timing_stats_; }
+  const auto &timing_stats () const { return timing_stats_; }
+
 private:
   void add_feeds (GraphNode &dest);
   void add_depends (GraphNode &src);
@@ -310,6 +416,15 @@ public:
   /** Initial incoming node count. */
   int init_refcount_{};
 
+  /**
+   * @brief Number of pruned subgraphs containing this node (see
+   * GraphNodeCollection::PrunableSubgraph).
+   *
+   * Pruned nodes are not processed. Only modified while no node is being
+   * processed.
+   */
+  int prune_count_{};
+
   /** The route's playback latency so far. */
   units::sample_u32_t route_playback_latency_;
 
@@ -319,6 +434,50 @@ public:
   bool initial_{ false };
 
 private:
+  friend class GraphNodeCollection;
+
+  /** Weight of a new measurement in the smoothed process cost. */
+  static constexpr float PROCESS_COST_SMOOTHING = 0.1f;
+
+  /**
+   * @brief Relative change of the process cost after which the critical paths
+   * through the node are updated.
+   */
+  static constexpr float PROCESS_COST_CHANGE_THRESHOLD = 0.1f;
+
+  /**
+   * @brief Smoothed processing time of this node, in nanoseconds.
+   */
+  std::atomic<float> process_cost_ns_{ 0.f };
+
+  /**
+   * @brief See get_critical_path_cost().
+   *
+   * Only written while no node is being processed.
+   */
+  float critical_path_cost_ns_{};
+
+  /**
+   * @brief Process cost that @ref critical_path_cost_ns_ was computed with.
+   *
+   * Only written while no node is being processed.
+   */
+  float critical_path_process_cost_ns_{};
+
+  /**
+   * @brief Whether record_process_time() reported a change that the critical
+   * paths were not updated with yet.
+   */
+  bool process_cost_change_reported_{};
+
+  /** Index in GraphNodeCollection::topological_order_. */
+  size_t topological_index_{};
+
+  /** Used by GraphNodeCollection::update_critical_paths(). */
+  bool critical_path_update_queued_{};
+
+  GraphNodeTimingStats timing_stats_;
+
   NodeId node_id_ = 0;
 
   /**
@@ -371,15 +530,82 @@ public:
   void set_initial_and_terminal_nodes ();
 
   /**
-   * @brief Sets the initial/terminal nodes.
+   * @brief Sets the initial/terminal nodes and the processing order used for
+   * prioritization.
    *
    * To be called when all nodes have been added.
    */
-  void finalize_nodes () { set_initial_and_terminal_nodes (); }
+  void finalize_nodes ()
+  {
+    set_initial_and_terminal_nodes ();
+    update_topological_order ();
+    update_prunable_subgraphs ();
+  }
+
+  /**
+   * @brief Recomputes the critical path cost of every node from the current
+   * process costs and re-sorts @ref prioritized_trigger_nodes_.
+   *
+   * Does not allocate, but must only be called while no node is being
+   * processed.
+   */
+  void update_critical_paths () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Updates the critical path costs affected by the process costs of
+   * @p changed_nodes (see GraphNode::record_process_time()).
+   *
+   * Only the changed nodes and the ancestors whose critical path cost changed
+   * as a result are visited, each once. Does not allocate, but must only be
+   * called while no node is being processed.
+   */
+  void
+  update_critical_paths (std::span<GraphNode * const> changed_nodes) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Copies the measured process costs and timing statistics of nodes
+   * in @p other to the nodes in this collection that share the same
+   * processable, so that priorities and statistics survive graph rebuilds.
+   */
+  void inherit_measurements (const GraphNodeCollection &other);
 
   GraphNode * find_node_for_processable (const IProcessable &processable) const;
 
+private:
+  void update_topological_order ();
+  void update_prunable_subgraphs ();
+
+  /**
+   * @brief Max-heap (by topological index) of the nodes to visit in
+   * update_critical_paths().
+   *
+   * Sized to fit every node so that updates don't allocate.
+   */
+  std::vector<GraphNode *> critical_path_worklist_;
+
 public:
+  /**
+   * @brief A node that can ignore its inputs (the gate) along with the nodes
+   * whose output is only used by it.
+   */
+  struct PrunableSubgraph
+  {
+    GraphNode * gate{};
+
+    /**
+     * @brief Nodes that can be pruned and whose every path to a terminal node
+     * goes through the gate.
+     */
+    std::vector<GraphNode *> upstream;
+
+    /** Number of the gate's parents in @ref upstream. */
+    int num_upstream_gate_parents{};
+
+    /** Whether @ref upstream is currently pruned. */
+    bool pruned{};
+  };
+
   /**
    * @brief All nodes in the graph.
    */
@@ -400,6 +626,26 @@ public:
    */
   std::vector<std::reference_wrapper<GraphNode>> terminal_nodes_;
 
+  /**
+   * @brief All nodes in topological order (parents before children).
+   */
+  std::vector<GraphNode *> topological_order_;
+
+  /**
+   * @brief @ref trigger_nodes_ sorted by descending critical path cost.
+   *
+   * This is the order trigger nodes are dispatched in at the start of each
+   * cycle.
+   */
+  std::vector<GraphNode *> prioritized_trigger_nodes_;
+
+  /**
+   * @brief Subgraphs that are pruned while their gate ignores its inputs.
+   *
+   * Only contains subgraphs with at least one upstream node.
+   */
+  std::vector<PrunableSubgraph> prunable_subgraphs_;
+
   std::unique_ptr<InitialProcessor> initial_processor_;
 };
 
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+
+#include "dsp/graph_node_timing.h"
+
+namespace zrythm::dsp::graph
+{
+
+GraphNodeTimingStats::Snapshot
+GraphNodeTimingStats::snapshot () const
+{
+  Snapshot ret;
+  ret.count = count_.load (std::memory_order_relaxed);
+  if (ret.count == 0)
+    return ret;
+
+  ret.min_ns = min_ns_.load (std::memory_order_relaxed);
+  ret.max_ns = max_ns_.load (std::memory_order_relaxed);
+  ret.mean_ns =
+    static_cast<double> (sum_ns_.load (std::memory_order_relaxed))
+    / static_cast<double> (ret.count);
+  ret.last_thread_id = last_thread_id_.load (std::memory_order_relaxed);
+
+  // the buckets may have been updated after reading count_, so sum them
+  // instead
+  std::array<uint32_t, NUM_BUCKETS> buckets{};
+  uint64_t                          total = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      buckets[i] = buckets_[i].load (std::memory_order_relaxed);
+      total += buckets[i];
+    }
+
+  const auto threshold = ((total * 99) + 99) / 100;
+  uint64_t   seen = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      seen += buckets[i];
+      if (seen >= threshold)
+        {
+          ret.p99_ns = std::min (bucket_upper_bound (i), ret.max_ns);
+          break;
+        }
+    }
+
+  return ret;
+}
+
+void
+GraphNodeTimingStats::reset ()
+{
+  for (auto &bucket : buckets_)
+    {
+      bucket.store (0, std::memory_order_relaxed);
+    }
+  count_.store (0, std::memory_order_relaxed);
+  sum_ns_.store (0, std::memory_order_relaxed);
+  min_ns_.store (
+    std::numeric_limits<uint64_t>::max (), std::memory_order_relaxed);
+  max_ns_.store (0, std::memory_order_relaxed);
+  last_thread_id_.store (-1, std::memory_order_relaxed);
+}
+
+void
+GraphNodeTimingStats::copy_from (const GraphNodeTimingStats &other)
+{
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+    {
+      buckets_[i].store (
+        other.buckets_[i].load (std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    }
+  count_.store (
+    other.count_.load (std::memory_order_relaxed), std::memory_order_relaxed);
+  sum_ns_.store (
+    other.sum_ns_.load (std::memory_order_relaxed), std::memory_order_relaxed);
+  min_ns_.store (
+    other.min_ns_.load (std::memory_order_relaxed), std::memory_order_relaxed);
+  max_ns_.store (
+    other.max_ns_.load (std::memory_order_relaxed), std::memory_order_relaxed);
+  last_thread_id_.store (
+    other.last_thread_id_.load (std::memory_order_relaxed),
+    std::memory_order_relaxed);
+}
+
+} // namespace zrythm::dsp::graph
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace zrythm::dsp::graph
+{
+
+/**
+ * @brief Lock-free processing time statistics of a single graph node.
+ *
+ * Durations are collected in a log-linear histogram (4 buckets per power of
+ * 2, so percentiles are accurate to within ~20%) plus exact min/max/sum.
+ *
+ * record() is realtime-safe and may be called concurrently from any graph
+ * thread. snapshot() and reset() may be called from any other thread while
+ * recording is in progress; the returned values are then only approximately
+ * consistent with each other.
+ */
+class GraphNodeTimingStats final
+{
+public:
+  static constexpr size_t NUM_BUCKETS = 128;
+
+  struct Snapshot
+  {
+    uint64_t count{};
+    uint64_t min_ns{};
+    uint64_t max_ns{};
+    double   mean_ns{};
+
+    /** Upper bound of the histogram bucket containing the 99th percentile. */
+    uint64_t p99_ns{};
+
+    /**
+     * @brief ID of the GraphThread that last processed the node (-1 for the
+     * main graph thread).
+     */
+    int last_thread_id{ -1 };
+  };
+
+  /**
+   * @brief Records a processing time.
+   *
+   * @param thread_id ID of the graph thread that processed the node.
+   */
+  void record (uint64_t nanoseconds, int thread_id) noexcept
+    [[clang::nonblocking]]
+  {
+    buckets_[bucket_index (nanoseconds)].fetch_add (
+      1, std::memory_order_relaxed);
+    sum_ns_.fetch_add (nanoseconds, std::memory_order_relaxed);
+    count_.fetch_add (1, std::memory_order_relaxed);
+
+    auto cur_min = min_ns_.load (std::memory_order_relaxed);
+    while (
+      nanoseconds < cur_min
+      && !min_ns_.compare_exchange_weak (
+        cur_min, nanoseconds, std::memory_order_relaxed))
+      {
+      }
+    auto cur_max = max_ns_.load (std::memory_order_relaxed);
+    while (
+      nanoseconds > cur_max
+      && !max_ns_.compare_exchange_weak (
+        cur_max, nanoseconds, std::memory_order_relaxed))
+      {
+      }
+
+    last_thread_id_.store (thread_id, std::memory_order_relaxed);
+  }
+
+  Snapshot snapshot () const;
+
+  void reset ();
+
+  /**
+   * @brief Replaces the statistics with the ones in @p other.
+   *
+   * Must not be called while recording into this instance.
+   */
+  void copy_from (const GraphNodeTimingStats &other);
+
+  /**
+   * @brief Returns the histogram bucket that @p nanoseconds falls in.
+   */
+  static constexpr size_t bucket_index (uint64_t nanoseconds)
+  {
+    if (nanoseconds < 4)
+      return static_cast<size_t> (nanoseconds);
+
+    const auto octave = static_cast<size_t> (std::bit_width (nanoseconds) - 1);
+    const auto sub = static_cast<size_t> ((nanoseconds >> (octave - 2)) & 3u);
+    const auto index = ((octave - 1) * 4) + sub;
+    return index < NUM_BUCKETS ? index : NUM_BUCKETS - 1;
+  }
+
+  /**
+   * @brief Returns the largest value that falls in the given bucket.
+   */
+  static constexpr uint64_t bucket_upper_bound (size_t index)
+  {
+    if (index < 4)
+      return index;
+    if (index == NUM_BUCKETS - 1)
+      return std::numeric_limits<uint64_t>::max ();
+
+    const auto octave = (index / 4) + 1;
+    const auto sub = index % 4;
+    return ((uint64_t{ 4 } + sub + 1) << (octave - 2)) - 1;
+  }
+
+private:
+  std::array<std::atomic<uint32_t>, NUM_BUCKETS> buckets_{};
+  std::atomic<uint64_t>                          count_{ 0 };
+  std::atomic<uint64_t>                          sum_ns_{ 0 };
+  std::atomic<uint64_t> min_ns_{ std::numeric_limits<uint64_t>::max () };
+  std::atomic<uint64_t> max_ns_{ 0 };
+  std::atomic<int>      last_thread_id_{ -1 };
+};
+
+} // namespace zrythm::dsp::graph
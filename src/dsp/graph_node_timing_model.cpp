@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+
+#include "dsp/graph_node_timing_model.h"
+
+namespace zrythm::dsp
+{
+
+GraphNodeTimingModel::GraphNodeTimingModel (
+  DspGraphDispatcher &dispatcher,
+  QObject *           parent)
+    : QAbstractListModel (parent), dispatcher_ (dispatcher)
+{
+}
+
+bool
+GraphNodeTimingModel::enabled () const
+{
+  return dispatcher_.node_timing_enabled ();
+}
+
+void
+GraphNodeTimingModel::setEnabled (bool enabled)
+{
+  if (dispatcher_.node_timing_enabled () == enabled)
+    return;
+
+  dispatcher_.set_node_timing_enabled (enabled);
+  Q_EMIT enabledChanged (enabled);
+}
+
+void
+GraphNodeTimingModel::refresh ()
+{
+  beginResetModel ();
+  timings_ = dispatcher_.collect_node_timings ();
+  std::ranges::sort (timings_, std::ranges::greater{}, [] (const auto &timing) {
+    return timing.stats.mean_ns;
+  });
+  endResetModel ();
+}
+
+void
+GraphNodeTimingModel::reset ()
+{
+  dispatcher_.reset_node_timings ();
+  refresh ();
+}
+
+QString
+GraphNodeTimingModel::exportToDot () const
+{
+  return dispatcher_.export_node_timings_to_dot ().to_qstring ();
+}
+
+int
+GraphNodeTimingModel::rowCount (const QModelIndex &parent) const
+{
+  if (parent.isValid ())
+    return 0;
+  return static_cast<int> (timings_.size ());
+}
+
+QVariant
+GraphNodeTimingModel::data (const QModelIndex &index, int role) const
+{
+  if (!index.isValid () || index.row () >= rowCount ())
+    return {};
+
+  const auto &timing = timings_.at (static_cast<size_t> (index.row ()));
+  const auto  to_us = [] (auto ns) { return static_cast<double> (ns) / 1000.0; };
+
+  switch (role)
+    {
+    case NodeIdRole:
+      return timing.node_id;
+    case Qt::DisplayRole:
+    case NameRole:
+      return timing.name.to_qstring ();
+    case CountRole:
+      return QVariant::fromValue (timing.stats.count);
+    case MinMicrosecondsRole:
+      return to_us (timing.stats.min_ns);
+    case MeanMicrosecondsRole:
+      return to_us (timing.stats.mean_ns);
+    case P99MicrosecondsRole:
+      return to_us (timing.stats.p99_ns);
+    case MaxMicrosecondsRole:
+      return to_us (timing.stats.max_ns);
+    case ThreadIdRole:
+      return timing.stats.last_thread_id;
+    default:
+      return {};
+    }
+}
+
+QHash<int, QByteArray>
+GraphNodeTimingModel::roleNames () const
+{
+  QHash<int, QByteArray> roles;
+  roles[NodeIdRole] = "nodeId";
+  roles[NameRole] = "name";
+  roles[CountRole] = "count";
+  roles[MinMicrosecondsRole] = "minUs";
+  roles[MeanMicrosecondsRole] = "meanUs";
+  roles[P99MicrosecondsRole] = "p99Us";
+  roles[MaxMicrosecondsRole] = "maxUs";
+  roles[ThreadIdRole] = "threadId";
+  return roles;
+}
+
+} // namespace zrythm::dsp
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include "dsp/graph_dispatcher.h"
+
+#include <QAbstractListModel>
+#include <QtQmlIntegration/qqmlintegration.h>
+
+namespace zrythm::dsp
+{
+
+/**
+ * @brief List model exposing per-node processing time statistics of the
+ * current processing graph to QML.
+ *
+ * The model is a snapshot: call refresh() (e.g., from a QML Timer) to
+ * re-read the statistics. Rows are sorted by descending mean processing
+ * time.
+ */
+class GraphNodeTimingModel : public QAbstractListModel
+{
+  Q_OBJECT
+  Q_PROPERTY (
+    bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged FINAL)
+  QML_ELEMENT
+  QML_UNCREATABLE ("")
+
+public:
+  enum Roles
+  {
+    NodeIdRole = Qt::UserRole + 1,
+    NameRole,
+    CountRole,
+    MinMicrosecondsRole,
+    MeanMicrosecondsRole,
+    P99MicrosecondsRole,
+    MaxMicrosecondsRole,
+    ThreadIdRole,
+  };
+
+  explicit GraphNodeTimingModel (
+    DspGraphDispatcher &dispatcher,
+    QObject *           parent = nullptr);
+
+  // ========================================================================
+  // QML Interface
+  // ========================================================================
+
+  bool          enabled () const;
+  void          setEnabled (bool enabled);
+  Q_SIGNAL void enabledChanged (bool enabled);
+
+  /**
+   * @brief Re-reads the statistics from the current graph.
+   */
+  Q_INVOKABLE void refresh ();
+
+  /**
+   * @brief Clears the collected statistics.
+   */
+  Q_INVOKABLE void reset ();
+
+  /**
+   * @brief Returns the current graph in DOT format, colored by node cost.
+   */
+  Q_INVOKABLE QString exportToDot () const;
+
+  int rowCount (const QModelIndex &parent = QModelIndex ()) const override;
+  QVariant
+  data (const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames () const override;
+
+  // ========================================================================
+
+private:
+  DspGraphDispatcher                         &dispatcher_;
+  std::vector<DspGraphDispatcher::NodeTiming> timings_;
+};
+
+} // namespace zrythm::dsp
@@ -1,31 +1,62 @@
-// SPDX-FileCopyrightText: © 2025 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-FileCopyrightText: © 2025-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <chrono>
+#include <thread>
 #include <utility>
 
 #include "dsp/audio_port.h"
+#include "dsp/ditherer.h"
+#include "dsp/graph_pruner.h"
 #include "dsp/graph_renderer.h"
 #include "dsp/graph_scheduler.h"
 #include "dsp/transport.h"
 #include "utils/audio.h"
 #include "utils/format.h"
 #include "utils/logger.h"
+#include "utils/mpmc_queue.h"
+
+#include <fmt/std.h>
 
 #include <QtConcurrentRun>
 
+#include <moodycamel/lightweightsemaphore.h>
+
 namespace zrythm::dsp
 {
-void
-GraphRenderer::render (
-  QPromise<juce::AudioSampleBuffer> &promise,
-  RenderOptions                      options,
-  graph::GraphNodeCollection       &&nodes,
-  RunOnMainThread                    run_on_main_thread,
-  SampleRange                        range,
-  const dsp::TempoMap               &tempo_map)
+namespace
+{
+/**
+ * @brief Renders the graph for the given range block by block.
+ *
+ * @param on_started Called with the total number of frames (including latency
+ * preroll) once rendering is about to start.
+ * @param mix_terminal_outputs Whether to mix the audio of the terminal nodes
+ * into the block passed to @p consume_block. If false, the block is empty
+ * (e.g., when the caller reads the ports it needs directly).
+ * @param consume_block Called with each rendered (stereo) block and the number
+ * of valid frames in it. Returning false stops the render.
+ * @return Render statistics, or nullopt if the render was canceled or stopped.
+ * @throw std::runtime_error if the range is empty.
+ */
+template <typename ResultT>
+std::optional<GraphRenderer::RenderStats>
+render_blocks (
+  QPromise<ResultT>                   &promise,
+  GraphRenderer::RenderOptions         options,
+  graph::GraphNodeCollection         &&nodes,
+  GraphRenderer::RunOnMainThread       run_on_main_thread,
+  GraphRenderer::SampleRange           range,
+  const dsp::TempoMap                 &tempo_map,
+  std::function<void (units::sample_t)> on_started,
+  bool                                  mix_terminal_outputs,
+  std::function<bool (const utils::audio::AudioBuffer &, units::sample_t)>
+    consume_block)
 {
   z_debug ("Rendering range {}...", range);
 
+  const auto start_time = std::chrono::steady_clock::now ();
+
   graph::GraphScheduler graph_scheduler (
     std::move (run_on_main_thread), options.sample_rate_, options.block_length_,
     false);
@@ -45,22 +76,16 @@ GraphRenderer::render (
   // Handle empty range case
   if (num_samples <= units::samples (0))
     {
-      promise.setException (
-        std::make_exception_ptr (
-          std::runtime_error ("Cannot render empty range")));
-      return;
+      throw std::runtime_error ("Cannot render empty range");
     }
 
-  // Initialize output buffer with latency preroll added
   const auto total_samples_with_latency = num_samples + max_latency_frames;
-  juce::AudioSampleBuffer output{
-    2, total_samples_with_latency.in<int> (units::samples)
-  };
-  output.clear ();
+  on_started (total_samples_with_latency);
 
   // Create temporary buffer for processing each block
   utils::audio::AudioBuffer temp_buffer{
-    2, options.block_length_.in<int> (units::samples)
+    mix_terminal_outputs ? 2 : 0,
+    mix_terminal_outputs ? options.block_length_.in<int> (units::samples) : 0
   };
 
   // Setup transport snapshot for rendering
@@ -82,14 +107,24 @@ GraphRenderer::render (
   auto            latency_preroll_frames = max_latency_frames;
 
   // Prepare for progress reporting
-  promise.setProgressRange (0, output.getNumSamples ());
+  promise.setProgressRange (
+    0, total_samples_with_latency.in<int> (units::samples));
+
+  const auto realtime_factor = [&] () {
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now () - start_time;
+    const auto rendered_seconds =
+      covered_frames.in<double> (units::samples)
+      / options.sample_rate_.in<double> (units::sample_rate);
+    return elapsed.count () > 0.0 ? rendered_seconds / elapsed.count () : 0.0;
+  };
 
   while (current_pos < range.second)
     {
       promise.suspendIfRequested ();
       if (promise.isCanceled ())
         {
-          return;
+          return std::nullopt;
         }
 
       // Calculate number of frames to process in this block
@@ -118,12 +153,16 @@ GraphRenderer::render (
         time_nfo, latency_preroll_frames, transport_snapshot, tempo_map);
 
       // Collect audio from terminal nodes
-      temp_buffer.clear ();
-      for (const auto &node : graph_scheduler.get_nodes ().terminal_nodes_)
+      if (mix_terminal_outputs)
         {
-          auto &processable = node.get ().get_processable ();
-          if (auto * audio_port = dynamic_cast<dsp::AudioPort *> (&processable))
+          temp_buffer.clear ();
+          for (const auto &node : graph_scheduler.get_nodes ().terminal_nodes_)
             {
+              auto &processable = node.get ().get_processable ();
+              auto * audio_port = dynamic_cast<dsp::AudioPort *> (&processable);
+              if (audio_port == nullptr)
+                continue;
+
               for (
                 const auto channel_index : std::views::iota (
                   0,
@@ -132,22 +171,15 @@ GraphRenderer::render (
                     static_cast<int> (audio_port->num_channels ()))))
                 {
                   temp_buffer.addFrom (
-                    channel_index, 0, *audio_port->buffers (), channel_index, 0,
-                    nframes.in<int> (units::samples));
+                    channel_index, 0, *audio_port->buffers (), channel_index,
+                    0, nframes.in<int> (units::samples));
                 }
             }
         }
 
-      // Copy to output buffer
-      const auto output_offset = covered_frames;
-      for (int ch = 0; ch < output.getNumChannels (); ++ch)
+      if (!consume_block (temp_buffer, nframes))
         {
-          if (ch < temp_buffer.getNumChannels ())
-            {
-              output.copyFrom (
-                ch, output_offset.in<int> (units::samples), temp_buffer, ch, 0,
-                nframes.in<int> (units::samples));
-            }
+          return std::nullopt;
         }
 
       // Update position and counters
@@ -167,14 +199,442 @@ GraphRenderer::render (
       // Update progress
       promise.setProgressValueAndText (
         covered_frames.in<int> (units::samples),
-        QObject::tr ("Rendering to audio..."));
+        QObject::tr ("Rendering to audio... (%1x realtime)")
+          .arg (realtime_factor (), 0, 'f', 1));
     }
 
   z_debug ("Rendered range {}", range);
 
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now () - start_time;
+  return GraphRenderer::RenderStats{
+    .frames_rendered_ = covered_frames,
+    .elapsed_seconds_ = elapsed.count (),
+    .realtime_factor_ = realtime_factor (),
+  };
+}
+
+/**
+ * @brief Writes rendered blocks to a file from a separate thread.
+ *
+ * Blocks are handed to the writer thread through a fixed pool of
+ * preallocated buffers, so memory usage is bounded by
+ * GraphRenderer::StreamingOptions::max_queued_blocks_. If the writer falls
+ * behind, push() blocks until a buffer is free.
+ */
+class StreamingFileWriter
+{
+public:
+  /**
+   * @throw std::runtime_error if the file could not be created.
+   */
+  StreamingFileWriter (
+    GraphRenderer::StreamingOptions options,
+    int                             block_length)
+      : options_ (std::move (options)),
+        blocks_ (std::max<size_t> (options_.max_queued_blocks_, 2)),
+        free_blocks_ (blocks_.size ()), filled_blocks_ (blocks_.size () + 1),
+        free_blocks_sem_ (static_cast<ssize_t> (blocks_.size ()))
+  {
+    writer_ = utils::AudioFileWriter::create_writer (
+      options_.write_options_, options_.file_path_);
+
+    for (auto &block : blocks_)
+      {
+        block.buffer.setSize (
+          static_cast<int> (writer_->getNumChannels ()), block_length);
+        free_blocks_.push_back (&block);
+      }
+
+    thread_ = std::jthread ([this] () { write_blocks (); });
+  }
+
+  ~StreamingFileWriter ()
+  {
+    try
+      {
+        finish ();
+      }
+    catch (const std::exception &e)
+      {
+        z_warning ("{}", e.what ());
+      }
+  }
+
+  Z_DISABLE_COPY_MOVE (StreamingFileWriter)
+
+  /**
+   * @brief Queues the first @p num_frames frames of @p block for writing.
+   *
+   * @return False if writing failed (the error is thrown by finish()).
+   */
+  bool push (const juce::AudioSampleBuffer &block, int num_frames)
+  {
+    if (failed_.load ())
+      {
+        return false;
+      }
+
+    // wait for the writer to catch up if the queue is full
+    free_blocks_sem_.wait ();
+    QueuedBlock * queued_block = nullptr;
+    free_blocks_.pop_front (queued_block);
+    queued_block->num_frames = num_frames;
+    queued_block->buffer.clear ();
+    for (
+      int ch = 0; ch < std::min (
+                    queued_block->buffer.getNumChannels (),
+                    block.getNumChannels ());
+      ++ch)
+      {
+        queued_block->buffer.copyFrom (ch, 0, block, ch, 0, num_frames);
+      }
+    filled_blocks_.push_back (queued_block);
+    filled_blocks_sem_.signal ();
+    return true;
+  }
+
+  /**
+   * @brief Writes the remaining queued blocks and closes the file.
+   *
+   * @throw std::runtime_error if writing failed.
+   */
+  void finish ()
+  {
+    if (!thread_.joinable ())
+      {
+        return;
+      }
+
+    // nullptr marks the end
+    filled_blocks_.push_back (nullptr);
+    filled_blocks_sem_.signal ();
+    thread_.join ();
+    writer_.reset ();
+
+    if (exception_)
+      {
+        std::rethrow_exception (std::exchange (exception_, nullptr));
+      }
+  }
+
+  /**
+   * @brief Finishes writing and deletes the file (e.g., on cancellation).
+   */
+  void remove_file ()
+  {
+    try
+      {
+        finish ();
+      }
+    catch (const std::exception &)
+      {
+      }
+    std::error_code ec;
+    std::filesystem::remove (options_.file_path_, ec);
+  }
+
+private:
+  struct QueuedBlock
+  {
+    juce::AudioSampleBuffer buffer;
+    int                     num_frames{};
+  };
+
+  void write_blocks ()
+  {
+    std::vector<Ditherer> ditherers (
+      static_cast<size_t> (writer_->getNumChannels ()));
+    if (options_.dither_bits_.has_value ())
+      {
+        for (auto &ditherer : ditherers)
+          {
+            ditherer.reset (*options_.dither_bits_);
+          }
+      }
+
+    for (;;)
+      {
+        filled_blocks_sem_.wait ();
+        QueuedBlock * block = nullptr;
+        filled_blocks_.pop_front (block);
+        if (block == nullptr)
+          {
+            return;
+          }
+
+        if (!failed_.load ())
+          {
+            try
+              {
+                if (options_.dither_bits_.has_value ())
+                  {
+                    for (size_t ch = 0; ch < ditherers.size (); ++ch)
+                      {
+                        ditherers[ch].process (
+                          block->buffer.getWritePointer (static_cast<int> (ch)),
+                          block->num_frames);
+                      }
+                  }
+                if (!writer_->writeFromAudioSampleBuffer (
+                      block->buffer, 0, block->num_frames))
+                  {
+                    throw std::runtime_error (utils::to_std_string (
+                      QObject::tr ("Failed to write audio data to %1")
+                        .arg (options_.file_path_.string ())));
+                  }
+              }
+            catch (const std::exception &)
+              {
+                exception_ = std::current_exception ();
+                failed_.store (true);
+              }
+          }
+
+        free_blocks_.push_back (block);
+        free_blocks_sem_.signal ();
+      }
+  }
+
+private:
+  GraphRenderer::StreamingOptions          options_;
+  std::unique_ptr<juce::AudioFormatWriter> writer_;
+  std::vector<QueuedBlock>                 blocks_;
+
+  // blocks are handed back and forth between the render and writer threads
+  // through these
+  MPMCQueue<QueuedBlock *>         free_blocks_;
+  MPMCQueue<QueuedBlock *>         filled_blocks_;
+  moodycamel::LightweightSemaphore free_blocks_sem_;
+  moodycamel::LightweightSemaphore filled_blocks_sem_{ 0 };
+
+  std::exception_ptr exception_;
+  std::atomic<bool>  failed_{ false };
+  std::jthread       thread_;
+};
+
+/**
+ * @brief Runs render_blocks() while streaming to the given writers.
+ *
+ * All writers are finished before this returns. The files are removed if the
+ * render is canceled or stopped, or if rendering or writing fails.
+ *
+ * @param mix_terminal_outputs See render_blocks().
+ * @throw std::runtime_error if rendering or writing failed.
+ */
+template <typename ResultT>
+std::optional<GraphRenderer::RenderStats>
+render_to_writers (
+  QPromise<ResultT>                                 &promise,
+  GraphRenderer::RenderOptions                       options,
+  graph::GraphNodeCollection                       &&nodes,
+  GraphRenderer::RunOnMainThread                     run_on_main_thread,
+  GraphRenderer::SampleRange                         range,
+  const dsp::TempoMap                               &tempo_map,
+  std::vector<std::unique_ptr<StreamingFileWriter>> &writers,
+  bool                                               mix_terminal_outputs,
+  std::function<bool (const utils::audio::AudioBuffer &, units::sample_t)>
+    consume_block)
+{
+  std::optional<GraphRenderer::RenderStats> stats;
+  std::exception_ptr                        exception;
+  try
+    {
+      stats = render_blocks (
+        promise, options, std::move (nodes), std::move (run_on_main_thread),
+        range, tempo_map, [] (units::sample_t) { }, mix_terminal_outputs,
+        std::move (consume_block));
+    }
+  catch (const std::exception &)
+    {
+      exception = std::current_exception ();
+    }
+
+  // finish all writers before reporting any error so that no writer thread
+  // is left waiting
+  for (auto &writer : writers)
+    {
+      try
+        {
+          writer->finish ();
+        }
+      catch (const std::exception &)
+        {
+          if (!exception)
+            {
+              exception = std::current_exception ();
+            }
+        }
+    }
+
+  if (exception || !stats.has_value ())
+    {
+      for (auto &writer : writers)
+        {
+          writer->remove_file ();
+        }
+      if (exception)
+        {
+          std::rethrow_exception (exception);
+        }
+    }
+  return stats;
+}
+}
+
+void
+GraphRenderer::render (
+  QPromise<juce::AudioSampleBuffer> &promise,
+  RenderOptions                      options,
+  graph::GraphNodeCollection       &&nodes,
+  RunOnMainThread                    run_on_main_thread,
+  SampleRange                        range,
+  const dsp::TempoMap               &tempo_map)
+{
+  juce::AudioSampleBuffer output;
+  units::sample_t         output_offset;
+  try
+    {
+      const auto stats = render_blocks (
+        promise, options, std::move (nodes), std::move (run_on_main_thread),
+        range, tempo_map,
+        [&] (units::sample_t total_frames) {
+          // Initialize output buffer with latency preroll added
+          output.setSize (2, total_frames.in<int> (units::samples));
+          output.clear ();
+        },
+        true,
+        [&] (const utils::audio::AudioBuffer &block, units::sample_t nframes) {
+          // Copy to output buffer
+          for (int ch = 0; ch < output.getNumChannels (); ++ch)
+            {
+              if (ch < block.getNumChannels ())
+                {
+                  output.copyFrom (
+                    ch, output_offset.in<int> (units::samples), block, ch, 0,
+                    nframes.in<int> (units::samples));
+                }
+            }
+          output_offset += nframes;
+          return true;
+        });
+      if (!stats.has_value ())
+        {
+          return;
+        }
+    }
+  catch (const std::exception &)
+    {
+      promise.setException (std::current_exception ());
+      return;
+    }
+
   promise.addResult (output);
 }
 
+void
+GraphRenderer::render_to_file (
+  QPromise<RenderStats>       &promise,
+  RenderOptions                options,
+  StreamingOptions             streaming_options,
+  graph::GraphNodeCollection &&nodes,
+  RunOnMainThread              run_on_main_thread,
+  SampleRange                  range,
+  const dsp::TempoMap         &tempo_map)
+{
+  try
+    {
+      const auto file_path = streaming_options.file_path_;
+      std::vector<std::unique_ptr<StreamingFileWriter>> writers;
+      writers.push_back (
+        std::make_unique<StreamingFileWriter> (
+          std::move (streaming_options),
+          options.block_length_.in<int> (units::samples)));
+      auto &writer = *writers.front ();
+
+      const auto stats = render_to_writers (
+        promise, options, std::move (nodes), std::move (run_on_main_thread),
+        range, tempo_map, writers, true,
+        [&] (const utils::audio::AudioBuffer &block, units::sample_t nframes) {
+          return writer.push (block, nframes.in<int> (units::samples));
+        });
+      if (!stats.has_value ())
+        {
+          return;
+        }
+
+      z_debug (
+        "Rendered {} frames to {} ({:.1f}x realtime)", stats->frames_rendered_,
+        file_path, stats->realtime_factor_);
+      promise.addResult (*stats);
+    }
+  catch (const std::exception &e)
+    {
+      z_warning ("Render to file failed: {}", e.what ());
+      promise.setException (std::current_exception ());
+    }
+}
+
+void
+GraphRenderer::render_stems_to_files (
+  QPromise<RenderStats>       &promise,
+  RenderOptions                options,
+  std::vector<StemOutput>      stems,
+  graph::GraphNodeCollection &&nodes,
+  RunOnMainThread              run_on_main_thread,
+  SampleRange                  range,
+  const dsp::TempoMap         &tempo_map)
+{
+  std::vector<std::unique_ptr<StreamingFileWriter>> writers;
+  try
+    {
+      for (auto &stem : stems)
+        {
+          writers.push_back (
+            std::make_unique<StreamingFileWriter> (
+              std::move (stem.streaming_options_),
+              options.block_length_.in<int> (units::samples)));
+        }
+
+      const auto stats = render_to_writers (
+        promise, options, std::move (nodes), std::move (run_on_main_thread),
+        range, tempo_map, writers, false,
+        [&] (const utils::audio::AudioBuffer &, units::sample_t nframes) {
+          // each stem is written from its own port's buffer instead of the
+          // mixed terminal output
+          for (const auto &[stem, writer] : std::views::zip (stems, writers))
+            {
+              if (!writer->push (
+                    *stem.port_->buffers (), nframes.in<int> (units::samples)))
+                {
+                  return false;
+                }
+            }
+          return true;
+        });
+      if (!stats.has_value ())
+        {
+          return;
+        }
+
+      z_debug (
+        "Rendered {} stems of {} frames ({:.1f}x realtime)", stems.size (),
+        stats->frames_rendered_, stats->realtime_factor_);
+      promise.addResult (*stats);
+    }
+  catch (const std::exception &e)
+    {
+      z_warning ("Stem render failed: {}", e.what ());
+
+      // remove the files created before a writer failed to be created
+      for (auto &writer : writers)
+        {
+          writer->remove_file ();
+        }
+      promise.setException (std::current_exception ());
+    }
+}
+
 QFuture<juce::AudioSampleBuffer>
 GraphRenderer::render_async (
   RenderOptions                options,
@@ -199,4 +659,78 @@ GraphRenderer::render_async (
     },
     options, std::move (run_on_main_thread), range, tempo_map);
 }
+
+QFuture<GraphRenderer::RenderStats>
+GraphRenderer::render_to_file_async (
+  RenderOptions                options,
+  StreamingOptions             streaming_options,
+  graph::GraphNodeCollection &&nodes,
+  RunOnMainThread              run_on_main_thread,
+  SampleRange                  range,
+  const dsp::TempoMap         &tempo_map)
+{
+  // See render_async()
+  return QtConcurrent::run (
+    [inner_nodes = std::move (nodes)] (
+      QPromise<RenderStats>       &promise,
+      GraphRenderer::RenderOptions inner_options,
+      StreamingOptions             inner_streaming_options,
+      RunOnMainThread              inner_run_on_main_thread,
+      GraphRenderer::SampleRange   inner_range,
+      const dsp::TempoMap         &inner_tempo_map) {
+      GraphRenderer::render_to_file (
+        promise, inner_options, std::move (inner_streaming_options),
+        std::move (const_cast<graph::GraphNodeCollection &> (inner_nodes)),
+        std::move (inner_run_on_main_thread), inner_range, inner_tempo_map);
+    },
+    options, std::move (streaming_options), std::move (run_on_main_thread),
+    range, tempo_map);
+}
+
+QFuture<GraphRenderer::RenderStats>
+GraphRenderer::render_stems_to_files_async (
+  RenderOptions           options,
+  std::vector<StemOutput> stems,
+  graph::Graph           &graph,
+  RunOnMainThread         run_on_main_thread,
+  SampleRange             range,
+  const dsp::TempoMap    &tempo_map)
+{
+  if (stems.empty ())
+    {
+      throw std::invalid_argument ("No stems to render");
+    }
+
+  // Prune the graph to the union of the stem ports so that shared upstream
+  // nodes are only processed once
+  std::vector<std::reference_wrapper<graph::GraphNode>> terminals;
+  for (const auto &stem : stems)
+    {
+      auto * node = graph.get_nodes ().find_node_for_processable (*stem.port_);
+      if (node == nullptr)
+        {
+          throw std::invalid_argument (fmt::format (
+            "Stem port {} is not in the graph", stem.port_->get_node_name ()));
+        }
+      terminals.emplace_back (*node);
+    }
+  graph::GraphPruner::prune_graph_to_terminals (graph, terminals);
+
+  // See render_async()
+  return QtConcurrent::run (
+    [inner_nodes = graph.steal_nodes ()] (
+      QPromise<RenderStats>       &promise,
+      GraphRenderer::RenderOptions inner_options,
+      std::vector<StemOutput>      inner_stems,
+      RunOnMainThread              inner_run_on_main_thread,
+      GraphRenderer::SampleRange   inner_range,
+      const dsp::TempoMap         &inner_tempo_map) {
+      GraphRenderer::render_stems_to_files (
+        promise, inner_options, std::move (inner_stems),
+        std::move (const_cast<graph::GraphNodeCollection &> (inner_nodes)),
+        std::move (inner_run_on_main_thread), inner_range, inner_tempo_map);
+    },
+    options, std::move (stems), std::move (run_on_main_thread), range,
+    tempo_map);
+}
 }
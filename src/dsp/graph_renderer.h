@@ -3,7 +3,10 @@
 
 #pragma once
 
-#include "dsp/graph_node.h"
+#include <filesystem>
+
+#include "dsp/graph.h"
+#include "utils/audio_file_writer.h"
 #include "utils/units.h"
 
 #include <QPromise>
@@ -12,6 +15,8 @@
 
 namespace zrythm::dsp
 {
+class AudioPort;
+
 class GraphRenderer
 {
 public:
@@ -26,6 +31,52 @@ public:
       std::max (5u, std::thread::hardware_concurrency ()) - 4;
   };
 
+  /**
+   * @brief Options for render_to_file_async().
+   */
+  struct StreamingOptions
+  {
+    utils::AudioFileWriter::WriteOptions write_options_;
+    std::filesystem::path                file_path_;
+
+    /**
+     * @brief Bit depth to dither to before writing, or nullopt to not dither
+     * (e.g., when writing floating point files).
+     */
+    std::optional<int> dither_bits_;
+
+    /**
+     * @brief Maximum number of rendered blocks waiting to be written.
+     *
+     * This (times the render block length) bounds the memory used by the
+     * render, regardless of the length of the range.
+     */
+    size_t max_queued_blocks_ = 32;
+  };
+
+  /**
+   * @brief A stem to write in render_stems_to_files_async().
+   */
+  struct StemOutput
+  {
+    /** Port whose output is written to the stem file. */
+    const dsp::AudioPort * port_;
+
+    StreamingOptions streaming_options_;
+  };
+
+  struct RenderStats
+  {
+    /** Number of frames written (including latency preroll). */
+    units::sample_t frames_rendered_;
+
+    /** Wall-clock time the render took. */
+    double elapsed_seconds_{};
+
+    /** Duration of the rendered audio divided by @ref elapsed_seconds_. */
+    double realtime_factor_{};
+  };
+
   /**
    * @brief Executes render() asynchronously and returns a QFuture to control
    * the task.
@@ -44,6 +95,47 @@ public:
     SampleRange                  range,
     const dsp::TempoMap         &tempo_map);
 
+  /**
+   * @brief Renders the graph for the given range directly to a file.
+   *
+   * Unlike render_async(), the rendered audio is never held in memory as a
+   * whole: each rendered block is pushed through a bounded queue to a writer
+   * thread that dithers it (if requested) and writes it to the file.
+   *
+   * The progress text of the returned future includes the current render
+   * speed (realtime factor). The file is removed if the render is canceled
+   * or fails.
+   */
+  static QFuture<RenderStats> render_to_file_async (
+    RenderOptions                options,
+    StreamingOptions             streaming_options,
+    graph::GraphNodeCollection &&nodes,
+    RunOnMainThread              run_on_main_thread,
+    SampleRange                  range,
+    const dsp::TempoMap         &tempo_map);
+
+  /**
+   * @brief Renders multiple stems in a single pass.
+   *
+   * The graph is pruned to the stem ports, so work shared by multiple stems
+   * (e.g., a bus feeding several stems) is only processed once per block and
+   * independent subgraphs are processed in parallel. Each stem is streamed to
+   * its own file as in render_to_file_async().
+   *
+   * The graph is pruned and its nodes are stolen before this returns. All
+   * stem files are removed if the render is canceled or fails.
+   *
+   * @throw std::invalid_argument if @p stems is empty or a stem port is not
+   * in the graph.
+   */
+  static QFuture<RenderStats> render_stems_to_files_async (
+    RenderOptions           options,
+    std::vector<StemOutput> stems,
+    graph::Graph           &graph,
+    RunOnMainThread         run_on_main_thread,
+    SampleRange             range,
+    const dsp::TempoMap    &tempo_map);
+
 private:
   /**
    * @brief Renders the graph for the given range.
@@ -59,5 +151,23 @@ private:
     RunOnMainThread                    run_on_main_thread,
     SampleRange                        range,
     const dsp::TempoMap               &tempo_map);
+
+  static void render_to_file (
+    QPromise<RenderStats>       &promise,
+    RenderOptions                options,
+    StreamingOptions             streaming_options,
+    graph::GraphNodeCollection &&nodes,
+    RunOnMainThread              run_on_main_thread,
+    SampleRange                  range,
+    const dsp::TempoMap         &tempo_map);
+
+  static void render_stems_to_files (
+    QPromise<RenderStats>       &promise,
+    RenderOptions                options,
+    std::vector<StemOutput>      stems,
+    graph::GraphNodeCollection &&nodes,
+    RunOnMainThread              run_on_main_thread,
+    SampleRange                  range,
+    const dsp::TempoMap         &tempo_map);
 };
 }
@@ -47,6 +47,14 @@ struct GraphScheduler::ThreadSet
   boost::concurrent_flat_set<GraphThreadPtr> threads_;
   GraphThreadPtr                             main_thread_;
   std::atomic<size_t>                        num_threads_{ 0 };
+
+  /**
+   * @brief All threads (including the main one) in a plain vector so that
+   * they can be iterated on without locking when stealing.
+   *
+   * Only modified while the threads are not running.
+   */
+  std::vector<GraphThread *> stealable_threads_;
 };
 
 size_t
@@ -77,23 +85,138 @@ GraphScheduler::GraphScheduler (
     }
 }
 
-void
-GraphScheduler::trigger_node (GraphNode &node)
+bool
+GraphScheduler::claim_ready_node (GraphNode &node) noexcept
 {
   /* check if we can run */
   if (node.refcount_.fetch_sub (1) == 1)
     {
       /* reset reference count for next cycle */
       node.refcount_.store (node.init_refcount_);
+      return node.prune_count_ == 0;
+    }
+  return false;
+}
 
-      // FIXME: is the code below correct? seems like it would cause data
-      // races since we are increasing the size but the pointer might not be
-      // pushed in the queue yet?
+bool
+GraphScheduler::steal_node (const GraphThread &thief, GraphNode *&node) noexcept
+{
+  const auto &threads = thread_set_->stealable_threads_;
+  const auto  num = threads.size ();
+  // start from a different victim on each thread to spread contention
+  const auto start = static_cast<size_t> (thief.id_ + 1);
+  for (size_t i = 0; i < num; ++i)
+    {
+      auto * victim = threads[(start + i) % num];
+      if (victim == &thief)
+        continue;
+      if (victim->ready_nodes_.steal (node))
+        return true;
+    }
+  return false;
+}
 
-      /* all nodes that feed this node have completed, so this node be
-       * processed now. */
-      /*z_info ("triggering node, pushing back");*/
-      trigger_queue_.push_back (&node);
+void
+GraphScheduler::reserve_ready_queues (size_t num_nodes)
+{
+  trigger_queue_.reserve (num_nodes);
+  cost_changed_nodes_.resize (trigger_queue_.capacity ());
+  for (auto * thread : thread_set_->stealable_threads_)
+    {
+      thread->ready_nodes_.reserve (trigger_queue_.capacity ());
+    }
+}
+
+void
+GraphScheduler::set_dispatch_strategy (DispatchStrategy strategy)
+{
+  assert (thread_set_->stealable_threads_.empty ());
+  dispatch_strategy_ = strategy;
+}
+
+void
+GraphScheduler::set_critical_path_prioritization (bool enabled)
+{
+  assert (thread_set_->stealable_threads_.empty ());
+  prioritize_critical_path_ = enabled;
+}
+
+void
+GraphScheduler::report_process_cost_change (GraphNode &node) noexcept
+{
+  // each node is reported at most once between updates, so this always fits
+  const auto index =
+    num_cost_changed_nodes_.fetch_add (1, std::memory_order_relaxed);
+  if (index < cost_changed_nodes_.size ()) [[likely]]
+    {
+      cost_changed_nodes_[index] = std::addressof (node);
+    }
+}
+
+void
+GraphScheduler::update_critical_paths () noexcept
+{
+  const auto num_changed = std::min (
+    num_cost_changed_nodes_.exchange (0, std::memory_order_relaxed),
+    cost_changed_nodes_.size ());
+  if (num_changed == 0)
+    return;
+
+  graph_nodes_->update_critical_paths (
+    std::span (cost_changed_nodes_).first (num_changed));
+}
+
+void
+GraphScheduler::update_pruned_subgraphs () noexcept
+{
+  const bool enabled = subgraph_pruning_enabled ();
+  for (auto &subgraph : graph_nodes_->prunable_subgraphs_)
+    {
+      const bool prune =
+        subgraph.gate->get_processable ().ignore_inputs_in_next_cycle (enabled);
+      if (prune == subgraph.pruned)
+        continue;
+
+      subgraph.pruned = prune;
+      const int delta = prune ? 1 : -1;
+      for (auto * node : subgraph.upstream)
+        {
+          node->prune_count_ += delta;
+        }
+
+      // the gate no longer waits for (or again waits for) its pruned parents
+      subgraph.gate->init_refcount_ -=
+        delta * subgraph.num_upstream_gate_parents;
+
+      // counts may have been left partially decremented by parents outside
+      // the subgraph
+      subgraph.gate->refcount_.store (subgraph.gate->init_refcount_);
+      for (auto * node : subgraph.upstream)
+        {
+          node->refcount_.store (node->init_refcount_);
+        }
+    }
+}
+
+void
+GraphScheduler::push_trigger_nodes () noexcept
+{
+  update_pruned_subgraphs ();
+
+  /* longest chains first */
+  for (auto * node : graph_nodes_->prioritized_trigger_nodes_)
+    {
+      if (node->prune_count_ == 0)
+        trigger_queue_.push_back (node);
+    }
+
+  /* gates whose parents were all pruned */
+  for (const auto &subgraph : graph_nodes_->prunable_subgraphs_)
+    {
+      auto * gate = subgraph.gate;
+      if (
+        subgraph.pruned && gate->init_refcount_ == 0 && gate->prune_count_ == 0)
+        trigger_queue_.push_back (gate);
     }
 }
 
@@ -105,17 +228,29 @@ GraphScheduler::rechain_from_node_collection (
 {
   z_debug ("rechaining graph...");
 
+  // threads still finishing up the last cycle may be reading the nodes
+  wait_until_idle ();
+
   // cleanup previous graph nodes
   release_node_resources ();
 
+  // anything published but not adopted yet is superseded by this collection
+  delete pending_nodes_.exchange (nullptr);
+
+  // reported nodes are about to be freed
+  num_cost_changed_nodes_.store (0, std::memory_order_relaxed);
+
   /* --- swap setup nodes with graph nodes --- */
 
-  graph_nodes_ = std::move (nodes);
+  // keep priorities and statistics from the previous graph
+  nodes.inherit_measurements (*graph_nodes_);
+
+  graph_nodes_ = std::make_unique<GraphNodeCollection> (std::move (nodes));
 
   terminal_refcnt_.store (
-    static_cast<int> (graph_nodes_.terminal_nodes_.size ()));
+    static_cast<int> (graph_nodes_->terminal_nodes_.size ()));
 
-  trigger_queue_.reserve (graph_nodes_.graph_nodes_.size ());
+  reserve_ready_queues (graph_nodes_->graph_nodes_.size ());
 
   sample_rate_ = sample_rate;
   max_block_length_ = max_block_length;
@@ -124,6 +259,123 @@ GraphScheduler::rechain_from_node_collection (
   z_debug ("rechaining done");
 }
 
+void
+GraphScheduler::publish_node_collection (
+  std::unique_ptr<GraphNodeCollection> nodes,
+  AdoptFunc                            on_adopt)
+{
+  assert (nodes != nullptr);
+
+  if (requires_pause_to_publish (*nodes))
+    {
+      reserve_ready_queues (nodes->graph_nodes_.size ());
+    }
+
+  // keep priorities and statistics from the live graph (anything it measures
+  // until the new collection is adopted is lost)
+  nodes->inherit_measurements (*graph_nodes_);
+
+  auto * replaced = pending_nodes_.exchange (
+    new PublishedNodeCollection{
+      .nodes = std::move (nodes), .on_adopt = std::move (on_adopt) },
+    std::memory_order_acq_rel);
+  if (replaced != nullptr)
+    {
+      // never adopted - retire it directly (we are not on the audio thread)
+      delete retired_nodes_.exchange (replaced, std::memory_order_acq_rel);
+    }
+}
+
+bool
+GraphScheduler::requires_pause_to_publish (
+  const GraphNodeCollection &nodes) const
+{
+  return nodes.graph_nodes_.size () > trigger_queue_.capacity ();
+}
+
+bool
+GraphScheduler::wait_for_adoption (std::chrono::milliseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now () + timeout;
+  while (has_pending_node_collection ())
+    {
+      const auto remaining =
+        std::chrono::duration_cast<std::chrono::microseconds> (
+          deadline - std::chrono::steady_clock::now ());
+      // signals may be left over from previous adoptions, so check again
+      if (remaining.count () <= 0 || !adopted_sem_.wait (remaining.count ()))
+        {
+          return !has_pending_node_collection ();
+        }
+    }
+  return true;
+}
+
+bool
+GraphScheduler::adopt_pending_node_collection () noexcept
+{
+  if (pending_nodes_.load (std::memory_order_acquire) == nullptr)
+    {
+      return false;
+    }
+
+  // the previously retired collection must be taken first (we can't free it
+  // here)
+  if (retired_nodes_.load (std::memory_order_acquire) != nullptr)
+    {
+      return false;
+    }
+
+  auto * adopted = pending_nodes_.exchange (nullptr, std::memory_order_acq_rel);
+  if (adopted == nullptr)
+    {
+      return false;
+    }
+
+  if (adopted->on_adopt)
+    {
+      adopted->on_adopt ();
+    }
+
+  // the published wrapper now carries the retired collection (the new one
+  // inherited its costs, so reported nodes are dropped)
+  adopted->nodes.swap (graph_nodes_);
+  num_cost_changed_nodes_.store (0, std::memory_order_relaxed);
+  retired_nodes_.store (adopted, std::memory_order_release);
+
+  terminal_refcnt_.store (
+    static_cast<int> (graph_nodes_->terminal_nodes_.size ()));
+
+  adopted_sem_.signal ();
+  return true;
+}
+
+std::unique_ptr<GraphNodeCollection>
+GraphScheduler::take_retired_node_collection ()
+{
+  std::unique_ptr<PublishedNodeCollection> retired (
+    retired_nodes_.exchange (nullptr, std::memory_order_acq_rel));
+  if (retired == nullptr)
+    {
+      return nullptr;
+    }
+  return std::move (retired->nodes);
+}
+
+void
+GraphScheduler::wait_until_idle () const
+{
+  for (;;)
+    {
+      const auto finished = cycles_finished_.load (std::memory_order_acquire);
+      if (finished == cycles_started_.load (std::memory_order_acquire))
+        {
+          return;
+        }
+      cycles_finished_.wait (finished, std::memory_order_acquire);
+    }
+}
+
 void
 GraphScheduler::start_threads (std::optional<int> num_threads)
 {
@@ -166,6 +418,13 @@ GraphScheduler::start_threads (std::optional<int> num_threads)
 
       thread_set_->num_threads_.store (
         thread_set_->threads_.size (), std::memory_order_relaxed);
+
+      thread_set_->threads_.cvisit_all ([&] (const auto &thread) {
+        thread_set_->stealable_threads_.push_back (thread.get ());
+      });
+      thread_set_->stealable_threads_.push_back (
+        thread_set_->main_thread_.get ());
+      reserve_ready_queues (trigger_queue_.capacity ());
     }
   catch (const std::exception &e)
     {
@@ -279,6 +538,7 @@ GraphScheduler::terminate_threads ()
   thread_set_->main_thread_->waitForThreadToExit (-1);
 
   /* Clear threads only after all threads have been joined */
+  thread_set_->stealable_threads_.clear ();
   thread_set_->threads_.clear ();
   thread_set_->main_thread_.reset ();
   thread_set_->num_threads_.store (0, std::memory_order_relaxed);
@@ -321,6 +581,7 @@ GraphScheduler::run_cycle (
   current_transport_ = transport;
   current_tempo_map_ = tempo_map;
 
+  cycles_started_.fetch_add (1, std::memory_order_release);
   callback_start_sem_.signal ();
   callback_done_sem_.wait ();
 
@@ -335,21 +596,21 @@ GraphScheduler::prepare_nodes_for_processing ()
     "preparing nodes for processing with sample rate {} and max block length {}",
     sample_rate_, max_block_length_);
   run_on_main_thread_func_ ([&] () {
-    for (auto &node : graph_nodes_.graph_nodes_)
+    for (auto &node : graph_nodes_->graph_nodes_)
       {
         node->get_processable ().prepare_for_processing (
           node.get (), sample_rate_, max_block_length_);
       }
   });
 
-  graph_nodes_.update_latencies ();
+  graph_nodes_->update_latencies ();
 }
 
 void
 GraphScheduler::release_node_resources ()
 {
   run_on_main_thread_func_ ([&] () {
-    for (auto &node : graph_nodes_.graph_nodes_)
+    for (auto &node : graph_nodes_->graph_nodes_)
       {
         node->get_processable ().release_resources ();
       }
@@ -369,6 +630,11 @@ GraphScheduler::~GraphScheduler ()
     }
 
   release_node_resources ();
+
+  // collections that never went live own no prepared resources we are
+  // responsible for
+  delete pending_nodes_.exchange (nullptr);
+  delete retired_nodes_.exchange (nullptr);
 }
 
 } // namespace zrythm::dsp::graph
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "dsp/graph_node.h"
 #include "utils/mpmc_queue.h"
 #include "utils/rt_thread_id.h"
@@ -66,6 +68,27 @@ public:
    */
   using RunOnMainThreadFunc = std::function<void (std::function<void ()>)>;
 
+  /**
+   * @brief How ready nodes are handed to the graph threads.
+   */
+  enum class DispatchStrategy : std::uint8_t
+  {
+    /**
+     * @brief All ready nodes go through a single shared MPMC queue and
+     * semaphore.
+     */
+    SharedQueue,
+
+    /**
+     * @brief Each thread has its own Chase-Lev deque.
+     *
+     * A thread keeps running one ready child of the node it just processed
+     * instead of enqueueing it, and idle threads steal from the other threads'
+     * deques. This avoids contention on the shared queue with many threads.
+     */
+    WorkStealing,
+  };
+
   /**
    * @brief Construct a new Graph Scheduler.
    *
@@ -108,6 +131,176 @@ public:
     units::sample_rate_t  sample_rate,
     units::sample_u32_t   max_block_length);
 
+  /**
+   * @brief Called by the graph thread that adopts a published collection,
+   * right before the collection runs for the first time.
+   *
+   * Must be realtime-safe.
+   */
+  using AdoptFunc = std::function<void ()>;
+
+  /**
+   * @brief Hands over an already prepared node collection to be swapped in at
+   * the start of the next cycle.
+   *
+   * Unlike rechain_from_node_collection(), this does not prepare or release
+   * anything and does not require processing to be paused: the collection is
+   * published through an atomic pointer and adopted by the graph thread that
+   * starts the next cycle, while all the other graph threads are idle. The
+   * previously live collection is handed back through
+   * take_retired_node_collection() so that it can be destroyed outside the
+   * audio thread.
+   *
+   * If a previously published collection has not been adopted yet, it is
+   * replaced and moved to the retired slot instead (its @p on_adopt is not
+   * called).
+   *
+   * @param on_adopt Optional function to apply state staged for the new
+   * collection (see IProcessable::stage_node_inputs()).
+   *
+   * @warning If requires_pause_to_publish() returns true for @p nodes, this must
+   * be called while no cycle is running.
+   */
+  void publish_node_collection (
+    std::unique_ptr<GraphNodeCollection> nodes,
+    AdoptFunc                            on_adopt = {});
+
+  /**
+   * @brief Returns whether publishing @p nodes needs processing to be paused.
+   *
+   * This is the case when the trigger queue needs to grow to fit the new
+   * collection (the queue cannot be resized while in use).
+   */
+  bool requires_pause_to_publish (const GraphNodeCollection &nodes) const;
+
+  /**
+   * @brief Returns whether a published collection is waiting to be adopted.
+   */
+  bool has_pending_node_collection () const
+  {
+    return pending_nodes_.load (std::memory_order_acquire) != nullptr;
+  }
+
+  /**
+   * @brief Blocks until the published collection is adopted.
+   *
+   * @return False if the collection was not adopted within @p timeout (e.g.,
+   * because no cycles are running).
+   */
+  bool wait_for_adoption (std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Adopts a pending node collection, if any.
+   *
+   * Called by the graph thread starting a cycle, while the other graph threads
+   * are idle. May also be called from a non-realtime thread while no cycle can
+   * start (e.g., when the engine is paused), after wait_until_idle().
+   *
+   * The swap is deferred to a later cycle if the previously retired
+   * collection has not been taken yet, so that nothing is ever freed here.
+   *
+   * @return Whether a collection was adopted.
+   */
+  bool adopt_pending_node_collection () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Takes ownership of the last collection swapped out by
+   * adopt_pending_node_collection(), if any.
+   *
+   * The graph threads no longer access the returned collection, so it can be
+   * destroyed right away. To be called from a non-realtime thread. The caller
+   * is responsible for releasing resources of processables that are no longer
+   * in the live collection.
+   */
+  std::unique_ptr<GraphNodeCollection> take_retired_node_collection ();
+
+  /**
+   * @brief Blocks until the graph threads are done with the last cycle that
+   * was started.
+   *
+   * run_cycle() returns as soon as the terminal nodes are processed, while
+   * other graph threads may still be finishing up. This waits for them.
+   *
+   * To be called while no new cycle can start.
+   */
+  void wait_until_idle () const;
+
+  /**
+   * @brief Returns whether the graph threads are done with the last cycle that
+   * was started (i.e., wait_until_idle() would not block).
+   */
+  bool is_idle () const
+  {
+    return cycles_finished_.load (std::memory_order_acquire)
+           == cycles_started_.load (std::memory_order_acquire);
+  }
+
+  units::sample_rate_t get_sample_rate () const { return sample_rate_; }
+  units::sample_u32_t  get_max_block_length () const
+  {
+    return max_block_length_;
+  }
+
+  /**
+   * @brief Sets the strategy used to dispatch ready nodes.
+   *
+   * Must be called while the threads are not running.
+   */
+  void set_dispatch_strategy (DispatchStrategy strategy);
+
+  DispatchStrategy get_dispatch_strategy () const { return dispatch_strategy_; }
+
+  /**
+   * @brief Enables/disables critical-path-aware dispatching.
+   *
+   * When enabled (default), per-node processing times are measured and ready
+   * nodes are dispatched in order of descending downstream critical path cost,
+   * so that long chains start as early as possible. At the start of each
+   * cycle, the critical paths through the nodes whose cost changed noticeably
+   * are updated (see GraphNodeCollection::update_critical_paths()).
+   *
+   * Must be called while the threads are not running.
+   */
+  void set_critical_path_prioritization (bool enabled);
+
+  bool critical_path_prioritization_enabled () const
+  {
+    return prioritize_critical_path_;
+  }
+
+  /**
+   * @brief Enables/disables collection of per-node processing time
+   * statistics (see GraphNode::timing_stats()).
+   *
+   * Disabled by default. Can be toggled at any time.
+   */
+  void set_node_timing_enabled (bool enabled)
+  {
+    node_timing_enabled_.store (enabled, std::memory_order_relaxed);
+  }
+
+  bool node_timing_enabled () const
+  {
+    return node_timing_enabled_.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Enables/disables pruning of the nodes that only feed a node
+   * ignoring its inputs (e.g., the plugins of a muted track).
+   *
+   * Enabled by default. Can be toggled at any time (takes effect in the next
+   * cycle).
+   */
+  void set_subgraph_pruning_enabled (bool enabled)
+  {
+    subgraph_pruning_enabled_.store (enabled, std::memory_order_relaxed);
+  }
+
+  bool subgraph_pruning_enabled () const
+  {
+    return subgraph_pruning_enabled_.load (std::memory_order_relaxed);
+  }
+
   /**
    * Starts the threads that will be processing the graph.
    *
@@ -123,7 +316,7 @@ public:
    */
   void terminate_threads ();
 
-  auto &get_nodes () { return graph_nodes_; }
+  auto &get_nodes () { return *graph_nodes_; }
 
   /**
    * @brief To be called repeatedly by a system audio callback thread.
@@ -176,9 +369,53 @@ public:
 
 private:
   /**
-   * Called when an upstream (parent) node has completed processing.
+   * @brief Decrements the node's reference count and returns whether it
+   * became ready (in which case the count is reset for the next cycle).
+   *
+   * Pruned nodes never become ready.
+   */
+  [[gnu::hot]] static bool claim_ready_node (GraphNode &node) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Attempts to steal a ready node from another thread's deque.
+   */
+  [[gnu::hot]] bool
+  steal_node (const GraphThread &thief, GraphNode *&node) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Grows the trigger queue and the per-thread deques to fit
+   * @p num_nodes.
+   *
+   * Must only be called while no cycle is running.
+   */
+  void reserve_ready_queues (size_t num_nodes);
+
+  /**
+   * @brief Called by the graph thread that processed @p node when its process
+   * cost changed noticeably (see GraphNode::record_process_time()).
    */
-  [[gnu::hot]] void trigger_node (GraphNode &node);
+  void report_process_cost_change (GraphNode &node) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Called at the start of each cycle (while all threads are idle) to
+   * update the node priorities affected by the reported cost changes.
+   */
+  void update_critical_paths () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Called at the start of each cycle (while all threads are idle) to
+   * prune or restore the nodes of each prunable subgraph, depending on
+   * whether its gate ignores its inputs in the cycle.
+   */
+  void update_pruned_subgraphs () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Pushes the nodes that start the cycle to the trigger queue.
+   */
+  void push_trigger_nodes () noexcept [[clang::nonblocking]];
 
   /**
    * @brief Called before calling run_cycle() to make sure each node has
@@ -228,13 +465,73 @@ private:
   // This is not a std::counting_semaphore due to issues on MSVC/Windows.
   moodycamel::LightweightSemaphore trigger_sem_{ 0 };
 
-  /** Queue containing nodes that can be processed. */
+  /**
+   * @brief Queue containing nodes that can be processed.
+   *
+   * In work-stealing mode this only receives the trigger nodes at the start of
+   * each cycle (and nodes that don't fit in a thread's deque).
+   */
   MPMCQueue<GraphNode *> trigger_queue_;
 
+  DispatchStrategy dispatch_strategy_{ DispatchStrategy::SharedQueue };
+
+  bool prioritize_critical_path_{ true };
+
+  std::atomic<bool> node_timing_enabled_{ false };
+
+  std::atomic<bool> subgraph_pruning_enabled_{ true };
+
+  /**
+   * @brief Nodes of the live collection reported by
+   * report_process_cost_change() since the last critical path update.
+   *
+   * Sized like the trigger queue, so that every node fits.
+   */
+  std::vector<GraphNode *> cost_changed_nodes_;
+
+  /** Number of valid entries in @ref cost_changed_nodes_. */
+  std::atomic<size_t> num_cost_changed_nodes_{ 0 };
+
   /**
    * @brief Live graph nodes.
+   *
+   * Only swapped while all graph threads are idle (see
+   * adopt_pending_node_collection()).
+   */
+  std::unique_ptr<GraphNodeCollection> graph_nodes_ =
+    std::make_unique<GraphNodeCollection> ();
+
+  struct PublishedNodeCollection
+  {
+    std::unique_ptr<GraphNodeCollection> nodes;
+    AdoptFunc                            on_adopt;
+  };
+
+  /**
+   * @brief Collection published by publish_node_collection() and not yet
+   * adopted (owning).
+   */
+  std::atomic<PublishedNodeCollection *> pending_nodes_{ nullptr };
+
+  /**
+   * @brief Collection swapped out at the cycle boundary, waiting to be taken
+   * and destroyed by a non-realtime thread (owning).
+   */
+  std::atomic<PublishedNodeCollection *> retired_nodes_{ nullptr };
+
+  /** Signaled whenever a published collection is adopted. */
+  moodycamel::LightweightSemaphore adopted_sem_{ 0 };
+
+  /** Number of cycles started by run_cycle(). */
+  std::atomic<uint64_t> cycles_started_{ 0 };
+
+  /**
+   * @brief Number of cycles after which all the graph threads went idle.
+   *
+   * The graph is idle while this equals cycles_started_. Waited on by
+   * wait_until_idle().
    */
-  GraphNodeCollection graph_nodes_;
+  std::atomic<uint64_t> cycles_finished_{ 0 };
 
   /** Remaining unprocessed terminal nodes in this cycle. */
   std::atomic<int> terminal_refcnt_ = 0;
@@ -69,6 +69,8 @@
  * ---
  */
 
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 #include "utils/dsp_context.h"
@@ -130,6 +132,16 @@ GraphThread::on_reached_terminal_node ()
           yield ();
         }
 
+      /* nothing touches the nodes anymore (see
+       * GraphScheduler::wait_until_idle()) */
+      scheduler_.cycles_finished_.fetch_add (1, std::memory_order_release);
+      {
+#if defined(__has_feature) && __has_feature(realtime_sanitizer)
+        __rtsan::ScopedDisabler d;
+#endif
+        scheduler_.cycles_finished_.notify_all ();
+      }
+
       if (threadShouldExit ())
         return;
 
@@ -139,15 +151,17 @@ GraphThread::on_reached_terminal_node ()
       if (threadShouldExit ())
         return;
 
+      /* all threads are idle, so the graph can be swapped and node priorities
+       * can be safely updated */
+      scheduler_.adopt_pending_node_collection ();
+      scheduler_.update_critical_paths ();
+
       /* reset terminal reference count */
       scheduler_.terminal_refcnt_.store (
-        static_cast<int> (scheduler_.graph_nodes_.terminal_nodes_.size ()));
+        static_cast<int> (scheduler_.graph_nodes_->terminal_nodes_.size ()));
 
       /* and start the initial nodes */
-      for (auto node : scheduler_.graph_nodes_.trigger_nodes_)
-        {
-          scheduler_.trigger_queue_.push_back (std::addressof (node.get ()));
-        }
+      scheduler_.push_trigger_nodes ();
       /* continue in worker-thread */
     }
 }
@@ -233,10 +247,7 @@ GraphThread::run_worker () noexcept
           z_info ("[{}]: running node", id_);
         }
 
-      to_run->process (
-        scheduler_.get_time_nfo (), scheduler_.get_remaining_preroll_frames (),
-        scheduler_.get_transport_for_this_cycle (),
-        scheduler_.get_tempo_map_for_this_cycle ());
+      process_node (*to_run);
 
       /* if there are no outgoing edges, this is a terminal node */
       if (to_run->feeds ().empty ())
@@ -246,12 +257,186 @@ GraphThread::run_worker () noexcept
         }
       else
         {
-          /* notify downstream nodes that depend on this node */
-          for (const auto child_node : to_run->feeds ())
+          /* notify downstream nodes that depend on this node (most critical
+           * first) */
+          ReadyNodeBatch batch;
+          const auto     num_ready = collect_ready_children (*to_run, batch);
+          for (size_t i = 0; i < num_ready; ++i)
+            {
+              scheduler->trigger_queue_.push_back (batch[i]);
+            }
+        }
+    }
+}
+
+GraphNode *
+GraphThread::find_work () noexcept
+{
+  GraphNode * node = nullptr;
+  if (ready_nodes_.pop (node))
+    {
+      return node;
+    }
+
+  if (scheduler_.trigger_queue_.pop_front (node))
+    {
+      /* same as the shared-queue mode: wake up another thread to look for
+       * more work */
+      scheduler_.trigger_sem_.signal ();
+      return node;
+    }
+
+  if (scheduler_.steal_node (*this, node))
+    {
+      return node;
+    }
+
+  return nullptr;
+}
+
+void
+GraphThread::push_ready_node (GraphNode &node) noexcept
+{
+  if (!ready_nodes_.push (&node)) [[unlikely]]
+    {
+      scheduler_.trigger_queue_.push_back (&node);
+    }
+
+  /* wake up an idle thread to steal it (if nobody is idle, we'll get to it
+   * ourselves) */
+  if (scheduler_.idle_thread_cnt_.load () > 0)
+    {
+      scheduler_.trigger_sem_.signal ();
+    }
+}
+
+void
+GraphThread::process_node (GraphNode &node) noexcept
+{
+  const auto process = [&] () {
+    node.process (
+      scheduler_.get_time_nfo (), scheduler_.get_remaining_preroll_frames (),
+      scheduler_.get_transport_for_this_cycle (),
+      scheduler_.get_tempo_map_for_this_cycle ());
+  };
+
+  const bool measure_cost = scheduler_.critical_path_prioritization_enabled ();
+  const bool collect_stats = scheduler_.node_timing_enabled ();
+  if (!measure_cost && !collect_stats)
+    {
+      process ();
+      return;
+    }
+
+  const auto start = std::chrono::steady_clock::now ();
+  process ();
+  const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds> (
+                            std::chrono::steady_clock::now () - start)
+                            .count ();
+  if (
+    measure_cost && node.record_process_time (static_cast<float> (elapsed_ns)))
+    {
+      scheduler_.report_process_cost_change (node);
+    }
+  if (collect_stats)
+    {
+      node.timing_stats ().record (static_cast<uint64_t> (elapsed_ns), id_);
+    }
+}
+
+size_t
+GraphThread::collect_ready_children (
+  const GraphNode &node,
+  ReadyNodeBatch  &batch) noexcept
+{
+  size_t num_ready = 0;
+  for (const auto child_node : node.feeds ())
+    {
+      if (!GraphScheduler::claim_ready_node (child_node))
+        {
+          continue;
+        }
+      if (num_ready < batch.size ()) [[likely]]
+        {
+          batch[num_ready++] = std::addressof (child_node.get ());
+        }
+      else if (
+        scheduler_.get_dispatch_strategy ()
+        == GraphScheduler::DispatchStrategy::WorkStealing)
+        {
+          push_ready_node (child_node);
+        }
+      else
+        {
+          scheduler_.trigger_queue_.push_back (std::addressof (child_node.get ()));
+        }
+    }
+
+  if (scheduler_.critical_path_prioritization_enabled () && num_ready > 1)
+    {
+      std::sort (
+        batch.begin (), batch.begin () + static_cast<ptrdiff_t> (num_ready),
+        [] (const GraphNode * a, const GraphNode * b) {
+          return a->get_critical_path_cost () > b->get_critical_path_cost ();
+        });
+    }
+
+  return num_ready;
+}
+
+void
+GraphThread::run_worker_work_stealing () noexcept
+{
+  auto *      scheduler = &scheduler_;
+  GraphNode * to_run = nullptr;
+
+  for (;;)
+    {
+      if (threadShouldExit ()) [[unlikely]]
+        {
+          return;
+        }
+
+      if (to_run == nullptr)
+        {
+          to_run = find_work ();
+        }
+
+      while (to_run == nullptr)
+        {
+          /* wait for work, fall asleep */
+          scheduler->idle_thread_cnt_.fetch_add (1);
+          scheduler->trigger_sem_.wait ();
+
+          if (threadShouldExit ()) [[unlikely]]
             {
-              scheduler->trigger_node (child_node);
+              return;
             }
+
+          scheduler->idle_thread_cnt_.fetch_sub (1);
+          to_run = find_work ();
         }
+
+      process_node (*to_run);
+
+      /* if there are no outgoing edges, this is a terminal node */
+      if (to_run->feeds ().empty ())
+        {
+          to_run = nullptr;
+          on_reached_terminal_node ();
+          continue;
+        }
+
+      /* keep the most critical ready child for ourselves (its input is hot in
+       * our cache) and hand out the rest. they are pushed least critical
+       * first so that our next pop() returns the next most critical one */
+      ReadyNodeBatch batch;
+      const auto     num_ready = collect_ready_children (*to_run, batch);
+      for (size_t i = num_ready; i > 1; --i)
+        {
+          push_ready_node (*batch[i - 1]);
+        }
+      to_run = num_ready > 0 ? batch[0] : nullptr;
     }
 }
 
@@ -284,14 +469,11 @@ GraphThread::run ()
       graph->callback_start_sem_.wait ();
 
       /* first time setup */
+      graph->adopt_pending_node_collection ();
 
       /* bootstrap trigger-list.
        * (later this is done by Graph.reached_terminal_node())*/
-      for (const auto node : graph->graph_nodes_.trigger_nodes_)
-        {
-          /*z_info ("[main] pushing back node {} during bootstrap", i);*/
-          graph->trigger_queue_.push_back (std::addressof (node.get ()));
-        }
+      graph->push_trigger_nodes ();
 
       /* after setup, the main-thread just becomes a normal worker */
     }
@@ -310,7 +492,16 @@ GraphThread::run ()
       yield ();
     }
 
-  run_worker ();
+  if (
+    scheduler_.get_dispatch_strategy ()
+    == GraphScheduler::DispatchStrategy::WorkStealing)
+    {
+      run_worker_work_stealing ();
+    }
+  else
+    {
+      run_worker ();
+    }
 
   if (id_ == -1)
     {
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <array>
+
 #include "zrythm-config.h"
 
 #include "utils/rt_thread_id.h"
+#include "utils/work_stealing_deque.h"
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_core/juce_core.h>
@@ -13,6 +16,7 @@
 namespace zrythm::dsp::graph
 {
 
+class GraphNode;
 class GraphScheduler;
 
 /**
@@ -54,6 +58,53 @@ private:
    */
   void run_worker () noexcept [[clang::nonblocking]];
 
+  /**
+   * @brief Worker loop used with GraphScheduler::DispatchStrategy::WorkStealing.
+   *
+   * The first child that becomes ready after processing a node is run
+   * directly by this thread; the rest go to this thread's deque, where idle
+   * threads can steal them.
+   */
+  void run_worker_work_stealing () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Returns a node to process from (in order) this thread's deque, the
+   * scheduler's shared queue or another thread's deque.
+   */
+  [[gnu::hot]] GraphNode * find_work () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Makes a ready node available to this and other threads.
+   */
+  [[gnu::hot]] void push_ready_node (GraphNode &node) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Processes the given node, measuring its processing time if
+   * critical path prioritization or node timing is enabled.
+   */
+  [[gnu::hot]] void process_node (GraphNode &node) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Children of a processed node that became ready, sorted by
+   * descending critical path cost.
+   */
+  using ReadyNodeBatch = std::array<GraphNode *, 32>;
+
+  /**
+   * @brief Claims the children of @p node that became ready and stores them in
+   * @p batch in priority order.
+   *
+   * Ready children that don't fit in @p batch are dispatched directly
+   * (unprioritized).
+   *
+   * @return The number of nodes stored in @p batch.
+   */
+  [[gnu::hot]] size_t
+  collect_ready_children (const GraphNode &node, ReadyNodeBatch &batch) noexcept
+    [[clang::nonblocking]];
+
 public:
   /**
    * Thread index in zrythm.
@@ -79,6 +130,13 @@ public:
    */
   std::optional<juce::AudioWorkgroup> audio_workgroup_;
 
+  /**
+   * @brief Ready nodes owned by this thread (work-stealing mode only).
+   *
+   * Only this thread pushes/pops; other threads steal.
+   */
+  WorkStealingDeque<GraphNode *> ready_nodes_;
+
 private:
   /**
    * @brief Flag to indicate the thread has completely finished execution.
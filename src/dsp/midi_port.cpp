@@ -32,21 +32,36 @@ MidiPort::prepare_for_processing_impl (
 
   if (node != nullptr && flow () == PortFlow::Input)
     {
-      auto source_ports =
-        node->depends () | std::views::transform ([] (const auto &child_node) {
-          return dynamic_cast<MidiPort *> (
-            &child_node.get ().get_processable ());
-        })
-        | utils::views::filter_null;
-      set_port_sources (source_ports);
+      set_port_sources (source_ports_in_node (*node));
     }
 
   buffer_.reserve (dsp::MidiEventBuffer::kMaxReserveBytes);
+  prepared_ = true;
+}
+
+bool
+MidiPort::stage_node_inputs (const graph::GraphNode &node)
+{
+  if (flow () == PortFlow::Input)
+    {
+      stage_port_sources (source_ports_in_node (node));
+    }
+  return true;
+}
+
+void
+MidiPort::commit_node_inputs () noexcept
+{
+  if (flow () == PortFlow::Input)
+    {
+      commit_staged_port_sources ();
+    }
 }
 
 void
 MidiPort::release_resources ()
 {
+  prepared_ = false;
 }
 
 void
@@ -30,8 +30,11 @@ public:
     units::sample_u32_t      max_block_length) override;
 
   void release_resources () override;
+  bool stage_node_inputs (const graph::GraphNode &node) override;
+  void commit_node_inputs () noexcept [[clang::nonblocking]] override;
 
   void clear_buffer (std::size_t offset, std::size_t nframes) override;
+  bool is_prepared_for_processing () const override { return prepared_; }
 
   friend void init_from (
     MidiPort              &obj,
@@ -52,6 +55,10 @@ public:
   dsp::MidiEventBuffer buffer_;
 
   BOOST_DESCRIBE_CLASS (MidiPort, (Port), (), (), ())
+
+private:
+  /** Whether prepare_for_processing() was called (and not released since). */
+  bool prepared_{};
 };
 
 } // namespace zrythm::dsp
@@ -6,6 +6,7 @@
 #include "dsp/parameter.h"
 #include "dsp/port_all.h"
 #include "utils/enum_utils.h"
+#include "utils/float_ranges.h"
 #include "utils/registry_utils.h"
 #include "utils/serialization.h"
 #include "utils/utf8_string.h"
@@ -148,6 +149,7 @@ ProcessorParameter::process_block (
   const dsp::TempoMap         &tempo_map) noexcept
 {
   float current_val = base_value_.load ();
+  block_values_valid_ = false;
 
   if (during_gesture_.load ())
     {
@@ -156,8 +158,31 @@ ProcessorParameter::process_block (
       return;
     }
 
+  // Only the samples of this block are written to
+  std::span<float> block_values;
+  if (
+    automation_block_provider_ && !block_values_.empty ()
+    && transport.get_play_state () == dsp::ITransport::PlayState::Rolling)
+    {
+      block_values = std::span (block_values_)
+                       .subspan (
+                         time_nfo.buffer_offset_.in (units::samples),
+                         time_nfo.nframes_.in (units::samples));
+    }
+
   /* calculate value from automation track */
-  if (automation_value_provider_)
+  if (!block_values.empty ())
+    {
+      utils::float_ranges::fill (block_values, current_val);
+      std::invoke (
+        automation_block_provider_.value (), time_nfo.transport_position_,
+        block_values);
+      utils::float_ranges::clip (block_values, 0.f, 1.f);
+      current_val = block_values.back ();
+      last_automated_value_.store (current_val);
+      block_values_valid_ = true;
+    }
+  else if (automation_value_provider_)
     {
       const auto val = std::invoke (
         automation_value_provider_.value (), time_nfo.transport_position_);
@@ -189,8 +214,12 @@ ProcessorParameter::process_block (
           modulation_base_val = modulation_base_val * 2.f - 1.f;
         }
 
-      current_val = std::clamp<float> (
-        current_val + (modulation_base_val * conn->multiplier_), 0.f, 1.f);
+      const auto modulation = modulation_base_val * conn->multiplier_;
+      current_val = std::clamp<float> (current_val + modulation, 0.f, 1.f);
+      for (auto &val : block_values)
+        {
+          val = std::clamp (val + modulation, 0.f, 1.f);
+        }
     }
 
   last_modulated_value_.store (current_val);
@@ -203,11 +232,18 @@ ProcessorParameter::prepare_for_processing_impl (
   units::sample_u32_t      max_block_length)
 {
   modulation_input_ = modulation_input_uuid_.get_object_as<dsp::CVPort> ();
+  if (sample_accurate_automation_)
+    {
+      block_values_.resize (max_block_length.in (units::samples));
+    }
 }
 void
 ProcessorParameter::release_resources ()
 {
   modulation_input_ = nullptr;
+  block_values_.clear ();
+  block_values_.shrink_to_fit ();
+  block_values_valid_ = false;
 }
 
 utils::Utf8String
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <span>
+#include <vector>
+
 #include "dsp/audio_port.h"
 #include "dsp/cv_port.h"
 #include "dsp/graph_node.h"
@@ -305,6 +308,19 @@ public:
   using AutomationValueProvider =
     std::function<std::optional<float> (units::sample_t sample_position)>;
 
+  /**
+   * @brief Provides the automation values for each sample of a block.
+   *
+   * @param start_position The timeline position of the first sample.
+   * @param values The (normalized) values to fill. They are pre-filled with
+   * the base value; samples without automation should be left untouched.
+   *
+   * Used instead of AutomationValueProvider when sample-accurate automation
+   * is enabled.
+   */
+  using AutomationBlockProvider = std::function<
+    void (units::sample_t start_position, std::span<float> values)>;
+
   // ========================================================================
   // QML Interface
   // ========================================================================
@@ -391,7 +407,43 @@ public:
   {
     automation_value_provider_ = provider;
   }
-  void unset_automation_provider () { automation_value_provider_.reset (); }
+  void set_automation_block_provider (AutomationBlockProvider provider)
+  {
+    automation_block_provider_ = provider;
+  }
+  void unset_automation_provider ()
+  {
+    automation_value_provider_.reset ();
+    automation_block_provider_.reset ();
+  }
+
+  /**
+   * @brief Sets whether automation is evaluated for each sample instead of
+   * once per block.
+   *
+   * To be enabled by processors that can consume per-sample values (see
+   * block_values()). Must be called before prepare_for_processing().
+   */
+  void set_sample_accurate_automation (bool enabled)
+  {
+    sample_accurate_automation_ = enabled;
+  }
+
+  /**
+   * @brief Returns the (normalized) value of each sample in the last
+   * processed block, after automation and modulation.
+   *
+   * Indexed by buffer position (only the samples of the block are valid).
+   * Empty unless sample-accurate automation is enabled and automation was
+   * applied during the last block - in that case use currentValue() for
+   * the whole block.
+   */
+  std::span<const float> block_values () const
+  {
+    if (!block_values_valid_)
+      return {};
+    return block_values_;
+  }
 
   PortUuidReference get_modulation_input_port_ref () const
   {
@@ -492,6 +544,23 @@ private:
    */
   std::optional<AutomationValueProvider> automation_value_provider_;
 
+  /**
+   * @brief Automation block provider, used for sample-accurate automation.
+   */
+  std::optional<AutomationBlockProvider> automation_block_provider_;
+
+  /** Whether automation is evaluated for each sample. */
+  bool sample_accurate_automation_{};
+
+  /**
+   * @brief Per-sample values of the last block (allocated during
+   * prepare_for_processing() if sample-accurate automation is enabled).
+   */
+  std::vector<float> block_values_;
+
+  /** Whether @ref block_values_ were filled during the last block. */
+  bool block_values_valid_{};
+
   /** Unique symbol. */
   std::optional<utils::Utf8String> symbol_;
 
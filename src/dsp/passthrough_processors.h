@@ -27,6 +27,15 @@ public:
   {
     return *get_output_ports ().at (index).get_object_as<dsp::MidiPort> ();
   }
+
+  // only produces its output
+  bool can_be_pruned () const override { return true; }
+
+protected:
+  std::optional<units::sample_u32_t> get_tail_length () const noexcept override
+  {
+    return units::samples (0u);
+  }
 };
 
 /**
@@ -50,6 +59,17 @@ public:
   {
     return *get_output_ports ().at (0).get_object_as<dsp::AudioPort> ();
   }
+
+  // only produces its output
+  bool can_be_pruned () const override { return true; }
+
+protected:
+  bool can_alias_audio_inputs () const override { return true; }
+
+  std::optional<units::sample_u32_t> get_tail_length () const noexcept override
+  {
+    return units::samples (0u);
+  }
 };
 
 class StereoPassthroughProcessor : public AudioPassthroughProcessor
@@ -13,6 +13,7 @@
 #include "utils/typed_uuid_reference.h"
 #include "utils/utf8_string.h"
 #include "utils/uuid_identifiable_object.h"
+#include "utils/views.h"
 
 #include <fmt/format.h>
 
@@ -83,6 +84,8 @@ public:
     return get_full_designation ();
   }
 
+  bool can_be_pruned () const override { return true; }
+
   // ========================================================================
 
   /**
@@ -90,6 +93,26 @@ public:
    */
   virtual void clear_buffer (std::size_t offset, std::size_t nframes) = 0;
 
+  /**
+   * @brief Whether the port currently holds its processing resources.
+   *
+   * Ports are also prepared and released by the processor owning them, so
+   * this may be true while the port is not in the graph (e.g., an output port
+   * that is not connected anywhere).
+   */
+  virtual bool is_prepared_for_processing () const = 0;
+
+  /**
+   * @brief Marks the port's data as read by something that is not a
+   * descendant of the port in the graph (e.g., the engine reading a fader's
+   * output after the cycle).
+   *
+   * Such ports never share storage with other ports (see PortBufferPool).
+   * Set by the owner when preparing for processing.
+   */
+  void mark_as_read_outside_graph () { read_outside_graph_ = true; }
+  bool read_outside_graph () const { return read_outside_graph_; }
+
   /**
    * Gets a full designation of the port in the format "Track/Port" or
    * "Track/Plugin/Port".
@@ -143,6 +166,9 @@ private:
   /** Port group this port is part of (only applicable for LV2 plugin ports). */
   std::optional<utils::Utf8String> port_group_;
 
+  /** See mark_as_read_outside_graph(). */
+  bool read_outside_graph_{};
+
   BOOST_DESCRIBE_CLASS (
     Port,
     (utils::UuidIdentifiableObject<Port>),
@@ -165,7 +191,20 @@ public:
   set_port_sources (this auto &self, utils::RangeOf<PortT *> auto source_ports)
     [[clang::blocking]]
   {
-    self.port_sources_.clear ();
+    self.stage_port_sources (source_ports);
+    self.commit_staged_port_sources ();
+    self.staged_port_sources_.clear ();
+  }
+
+  /**
+   * @brief Same as set_port_sources(), except that the sources used during
+   * processing are left untouched until commit_staged_port_sources().
+   */
+  void
+  stage_port_sources (this auto &self, utils::RangeOf<PortT *> auto source_ports)
+    [[clang::blocking]]
+  {
+    self.staged_port_sources_.clear ();
     if (self.flow () != PortFlow::Input)
       {
         throw std::runtime_error (
@@ -185,7 +224,7 @@ public:
                 source_port->flow () == PortFlow::Input ? "Input" : "Unknown",
                 self.get_full_designation ()));
           }
-        self.port_sources_.push_back (
+        self.staged_port_sources_.push_back (
           std::make_pair (
             source_port,
             std::make_unique<dsp::PortConnection> (
@@ -193,6 +232,30 @@ public:
       }
   }
 
+  /**
+   * @brief Makes the sources staged by stage_port_sources() the ones used
+   * during processing.
+   *
+   * The previous sources are kept (and freed) until the next call to
+   * stage_port_sources().
+   */
+  void commit_staged_port_sources () noexcept [[clang::nonblocking]]
+  {
+    port_sources_.swap (staged_port_sources_);
+  }
+
+protected:
+  /**
+   * @brief Returns the ports of type PortT among the parents of @p node.
+   */
+  static auto source_ports_in_node (const graph::GraphNode &node)
+  {
+    return node.depends () | std::views::transform ([] (const auto &parent) {
+             return dynamic_cast<PortT *> (&parent.get ().get_processable ());
+           })
+           | utils::views::filter_null;
+  }
+
 private:
   /**
    * @brief Caches filled when recalculating the graph.
@@ -201,6 +264,9 @@ private:
    */
   std::vector<ElementType> port_sources_;
   // std::vector<ElementType> port_destinations_;
+
+  /** See stage_port_sources(). */
+  std::vector<ElementType> staged_port_sources_;
 };
 
 using PortUuidReference = utils::TypedUuidReference<Port>;
@@ -0,0 +1,346 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dsp/audio_port.h"
+#include "dsp/cv_port.h"
+#include "dsp/port_buffer_pool.h"
+
+namespace zrythm::dsp
+{
+
+namespace
+{
+/** Channels start at cache line boundaries. */
+constexpr size_t kAlignment = 64;
+constexpr size_t kAlignmentFloats = kAlignment / sizeof (float);
+
+/**
+ * @brief A set of reader indices.
+ */
+class ReaderSet
+{
+public:
+  explicit ReaderSet (size_t size) : words_ ((size + 63) / 64) { }
+
+  void insert (size_t i) { words_[i / 64] |= uint64_t{ 1 } << (i % 64); }
+  bool contains (size_t i) const
+  {
+    return (words_[i / 64] & (uint64_t{ 1 } << (i % 64))) != 0;
+  }
+  void merge (const ReaderSet &other)
+  {
+    for (const auto i : std::views::iota (0zu, words_.size ()))
+      {
+        words_[i] |= other.words_[i];
+      }
+  }
+
+private:
+  std::vector<uint64_t> words_;
+};
+
+/**
+ * @brief Indices of the nodes reading pooled ports.
+ */
+class ReaderIndices
+{
+public:
+  size_t index (const graph::GraphNode &node)
+  {
+    return indices_.try_emplace (&node, indices_.size ()).first->second;
+  }
+  std::optional<size_t> find (const graph::GraphNode &node) const
+  {
+    const auto it = indices_.find (&node);
+    if (it == indices_.end ())
+      return std::nullopt;
+    return it->second;
+  }
+  size_t size () const { return indices_.size (); }
+
+private:
+  std::unordered_map<const graph::GraphNode *, size_t> indices_;
+};
+
+/**
+ * @brief Collects the nodes reading the data of the output port in @p node,
+ * including the ones reading it through aliases.
+ *
+ * @return Whether the data is only read inside the graph (i.e., the port can
+ * be pooled).
+ */
+bool
+collect_output_readers (
+  const graph::GraphNode &node,
+  ReaderIndices          &reader_indices,
+  std::vector<size_t>    &readers)
+{
+  const auto &port = dynamic_cast<const Port &> (node.get_processable ());
+  if (node.feeds ().empty () || port.read_outside_graph ())
+    return false;
+
+  for (const auto &feed_ref : node.feeds ())
+    {
+      const auto &feed = feed_ref.get ();
+      readers.push_back (reader_indices.index (feed));
+
+      // an input port with a single source may refer to the source's data
+      // instead of copying it, so its readers also read our data
+      const auto * input =
+        dynamic_cast<const AudioPort *> (&feed.get_processable ());
+      if (
+        input == nullptr || !input->source_aliasing_allowed ()
+        || feed.depends ().size () != 1)
+        continue;
+      if (feed.feeds ().empty () || input->read_outside_graph ())
+        return false;
+      for (const auto &processor_ref : feed.feeds ())
+        {
+          const auto &processor = processor_ref.get ();
+          readers.push_back (reader_indices.index (processor));
+
+          // the default passthrough makes outputs alias aliased inputs
+          for (const auto &output_ref : processor.feeds ())
+            {
+              const auto * output = dynamic_cast<const AudioPort *> (
+                &output_ref.get ().get_processable ());
+              if (
+                output != nullptr && output->is_output ()
+                && !collect_output_readers (
+                  output_ref.get (), reader_indices, readers))
+                return false;
+            }
+        }
+    }
+  return true;
+}
+
+struct PooledPort
+{
+  AudioPort * audio_port{};
+  CVPort *    cv_port{};
+
+  uint8_t num_channels{};
+
+  /**
+   * @brief Node where the port's data starts to live (the port's node for
+   * inputs, the owning processor's node for outputs).
+   */
+  const graph::GraphNode * start{};
+
+  /** Indices of the nodes reading the port (where its data stops living). */
+  std::vector<size_t> readers;
+
+  size_t slot{};
+};
+
+struct Slot
+{
+  uint8_t num_channels{};
+
+  /** Readers of the port that used the slot last. */
+  const std::vector<size_t> * last_readers{};
+
+  /** Offset in the arena, in floats. */
+  size_t offset{};
+};
+}
+
+void
+PortBufferPool::Assignment::bind () noexcept
+{
+  for (auto &binding : bindings_)
+    {
+      binding.port->swap_buffer (binding.buffer, binding.pooled);
+    }
+  for (auto &binding : cv_bindings_)
+    {
+      binding.port->set_pooled_buffer (binding.buffer);
+    }
+}
+
+std::unique_ptr<PortBufferPool::Assignment>
+PortBufferPool::assign (
+  const graph::GraphNodeCollection &nodes,
+  units::sample_u32_t               max_block_length,
+  std::span<Port * const>           leaving_ports)
+{
+  auto  ret = std::make_unique<Assignment> ();
+  auto &stats = ret->stats_;
+
+  // floats per channel
+  const auto stride =
+    ((std::max (max_block_length.in<size_t> (units::samples), size_t{ 1 })
+      + kAlignmentFloats - 1)
+     / kAlignmentFloats)
+    * kAlignmentFloats;
+
+  // collect the ports (in topological order) and the nodes reading them
+  std::vector<PooledPort> ports;
+  std::vector<Port *>     unpooled_ports;
+  ReaderIndices           reader_indices;
+  for (auto * node : nodes.topological_order_)
+    {
+      auto * port = dynamic_cast<Port *> (&node->get_processable ());
+      if (port == nullptr)
+        continue;
+
+      PooledPort pooled{ .audio_port = dynamic_cast<AudioPort *> (port),
+                         .cv_port = dynamic_cast<CVPort *> (port) };
+      if (pooled.audio_port != nullptr)
+        pooled.num_channels = pooled.audio_port->num_channels ();
+      else if (pooled.cv_port != nullptr)
+        pooled.num_channels = 1;
+
+      // terminal ports are read after the cycle
+      bool poolable =
+        pooled.num_channels > 0 && port->is_prepared_for_processing ()
+        && !node->feeds ().empty () && !port->read_outside_graph ();
+      if (poolable && port->is_input ())
+        {
+          pooled.start = node;
+          for (const auto &child : node->feeds ())
+            {
+              pooled.readers.push_back (reader_indices.index (child.get ()));
+            }
+        }
+      else if (poolable)
+        {
+          // the owning processor writes the data
+          poolable =
+            node->depends ().size () == 1
+            && collect_output_readers (*node, reader_indices, pooled.readers);
+          if (poolable)
+            pooled.start = &node->depends ().front ().get ();
+        }
+
+      if (!poolable)
+        {
+          unpooled_ports.push_back (port);
+          continue;
+        }
+      ports.push_back (std::move (pooled));
+    }
+  std::ranges::copy (leaving_ports, std::back_inserter (unpooled_ports));
+
+  // give ports pooled by a previous assignment their own storage back
+  const auto block_length =
+    std::max (max_block_length, units::samples (1u)).in<int> (units::samples);
+  for (auto * port : unpooled_ports)
+    {
+      if (auto * audio_port = dynamic_cast<AudioPort *> (port))
+        {
+          if (!audio_port->is_pooled ())
+            continue;
+          auto buffer = std::make_unique<juce::AudioSampleBuffer> (
+            audio_port->num_channels (), block_length);
+          buffer->clear ();
+          ret->bindings_.push_back (
+            { .port = audio_port,
+              .buffer = std::move (buffer),
+              .pooled = false });
+        }
+      else if (auto * cv_port = dynamic_cast<CVPort *> (port))
+        {
+          if (cv_port->is_pooled ())
+            ret->cv_bindings_.push_back ({ .port = cv_port });
+        }
+    }
+  if (ports.empty ())
+    return ret;
+
+  // for each node, the readers guaranteed to have finished before it starts
+  std::unordered_map<const graph::GraphNode *, ReaderSet> finished_readers;
+  finished_readers.reserve (nodes.topological_order_.size ());
+  for (const auto * node : nodes.topological_order_)
+    {
+      ReaderSet finished (reader_indices.size ());
+      for (const auto &parent : node->depends ())
+        {
+          finished.merge (finished_readers.at (&parent.get ()));
+          if (const auto index = reader_indices.find (parent.get ()))
+            {
+              finished.insert (*index);
+            }
+        }
+      finished_readers.emplace (node, std::move (finished));
+    }
+
+  // first fit, like register allocation
+  std::vector<Slot> slots;
+  size_t            arena_size = 0;
+  for (auto &pooled : ports)
+    {
+      const auto &finished = finished_readers.at (pooled.start);
+      const auto  is_finished = [&] (size_t reader) {
+        return finished.contains (reader);
+      };
+      const auto it = std::ranges::find_if (slots, [&] (const Slot &slot) {
+        return slot.num_channels == pooled.num_channels
+               && std::ranges::all_of (*slot.last_readers, is_finished);
+      });
+      if (it != slots.end ())
+        {
+          pooled.slot =
+            static_cast<size_t> (std::distance (slots.begin (), it));
+        }
+      else
+        {
+          pooled.slot = slots.size ();
+          slots.push_back (
+            { .num_channels = pooled.num_channels, .offset = arena_size });
+          arena_size += stride * pooled.num_channels;
+        }
+      slots[pooled.slot].last_readers = &pooled.readers;
+      stats.unpooled_bytes += size_t{ pooled.num_channels }
+                              * static_cast<size_t> (block_length)
+                              * sizeof (float);
+    }
+
+  // the first channel is aligned manually
+  ret->arena_ = std::make_unique<float[]> (arena_size + kAlignmentFloats);
+  void * aligned = ret->arena_.get ();
+  size_t space = (arena_size + kAlignmentFloats) * sizeof (float);
+  std::align (kAlignment, arena_size * sizeof (float), aligned, space);
+  auto * const base = static_cast<float *> (aligned);
+  for (const auto &pooled : ports)
+    {
+      auto * const storage = base + slots[pooled.slot].offset;
+      if (pooled.cv_port != nullptr)
+        {
+          ret->cv_bindings_.push_back (
+            { .port = pooled.cv_port,
+              .buffer = { storage, static_cast<size_t> (block_length) } });
+          continue;
+        }
+
+      std::vector<float *> channels;
+      for (const auto ch :
+           std::views::iota (0zu, size_t{ pooled.num_channels }))
+        {
+          channels.push_back (storage + (ch * stride));
+        }
+      ret->bindings_.push_back (
+        { .port = pooled.audio_port,
+          .buffer = std::make_unique<juce::AudioSampleBuffer> (
+            channels.data (), pooled.num_channels, block_length),
+          .pooled = true });
+    }
+
+  stats.num_ports = ports.size ();
+  stats.num_slots = slots.size ();
+  stats.pooled_bytes = arena_size * sizeof (float);
+  return ret;
+}
+
+} // namespace zrythm::dsp
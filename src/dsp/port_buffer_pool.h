@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "dsp/graph_node.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace zrythm::dsp
+{
+
+class AudioPort;
+class CVPort;
+class Port;
+
+/**
+ * @brief Makes audio and CV ports whose buffers are never in use at the same
+ * time share storage from one contiguous arena.
+ *
+ * The data of a port only lives from the node writing it (the port's node for
+ * inputs, which sums their sources, and the owning processor for outputs)
+ * until the nodes reading it are done. A port can therefore take over the
+ * storage of another port if all of the other port's readers are ancestors of
+ * the node writing the port in the graph. Nodes in parallel branches may run
+ * at the same time, so they never share storage.
+ *
+ * The readers of an output port also include the readers of the input ports
+ * that may alias it (see AudioPort::alias_source_rt()) and, since the default
+ * passthrough makes outputs alias aliased inputs, the readers of the outputs
+ * of their processors.
+ *
+ * Terminal ports and ports read outside the graph (see
+ * Port::mark_as_read_outside_graph()) keep their own buffers, including when
+ * they may alias another port's data.
+ */
+class PortBufferPool
+{
+public:
+  struct Stats
+  {
+    /** Number of ports using the arena. */
+    size_t num_ports{};
+
+    /** Number of distinct buffers shared by the ports. */
+    size_t num_slots{};
+
+    /** Size of the ports' own buffers (what they would use without the
+     * pool). */
+    size_t unpooled_bytes{};
+
+    /** Size of the arena. */
+    size_t pooled_bytes{};
+  };
+
+  /**
+   * @brief Storage assigned to the ports of a node collection.
+   *
+   * The assignment owns the arena, so it must outlive the ports' use of it
+   * (i.e., until the ports are bound to another assignment, prepared again or
+   * released).
+   */
+  class Assignment
+  {
+  public:
+    /**
+     * @brief Makes the ports use their assigned storage.
+     *
+     * Ports that are no longer pooled get their own storage back. The
+     * buffers replaced are kept (and freed) with the assignment.
+     *
+     * Must be called while the ports are not being processed.
+     */
+    void bind () noexcept [[clang::nonblocking]];
+
+    const Stats &stats () const { return stats_; }
+
+  private:
+    friend class PortBufferPool;
+
+    struct Binding
+    {
+      AudioPort *                              port{};
+      std::unique_ptr<juce::AudioSampleBuffer> buffer;
+      bool                                     pooled{};
+    };
+
+    struct CVBinding
+    {
+      CVPort * port{};
+
+      /** Empty to give the port its own storage back. */
+      std::span<float> buffer;
+    };
+
+    std::unique_ptr<float[]> arena_;
+    std::vector<Binding>     bindings_;
+    std::vector<CVBinding>   cv_bindings_;
+    Stats                    stats_;
+  };
+
+  /**
+   * @brief Assigns storage from a new arena to the audio and CV ports in
+   * @p nodes.
+   *
+   * Must be called after all the nodes were prepared for processing. Nothing
+   * used during processing is touched, so this may be called while the ports
+   * are being processed by another graph. Storage is only used after calling
+   * Assignment::bind().
+   *
+   * @param leaving_ports Ports of the graph being replaced that are not in
+   * @p nodes. They may still be used by the processor owning them, so the
+   * pooled ones get their own storage back.
+   */
+  static std::unique_ptr<Assignment> assign (
+    const graph::GraphNodeCollection &nodes,
+    units::sample_u32_t               max_block_length,
+    std::span<Port * const>           leaving_ports = {});
+};
+
+} // namespace zrythm::dsp
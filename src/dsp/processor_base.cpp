@@ -18,6 +18,48 @@ ProcessorBase::ParameterChangeTracker::prepare (size_t count)
   prev_values_.assign (count, -1.f);
   changes_.clear ();
   changes_.reserve (count);
+  ramps_.clear ();
+}
+
+void
+ProcessorBase::ParameterChangeTracker::update_ramps (size_t nframes)
+{
+  for (auto &state : ramps_)
+    {
+      const auto value = state.param->range ().convertFrom0To1 (
+        state.param->currentValue ());
+      const auto start = state.prev_value.value_or (value);
+      state.prev_value = value;
+      if (nframes == 0 || utils::math::floats_equal (start, value))
+        {
+          state.ramp = { .values = {}, .value = value };
+          continue;
+        }
+
+      const auto values = std::span (state.values).first (nframes);
+      if (state.shape == RampShape::Exponential && start > 0.f && value > 0.f)
+        {
+          const double ratio = std::pow (
+            static_cast<double> (value) / static_cast<double> (start),
+            1.0 / static_cast<double> (nframes));
+          double cur = start;
+          for (auto &v : values)
+            {
+              cur *= ratio;
+              v = static_cast<float> (cur);
+            }
+        }
+      else
+        {
+          const float step = (value - start) / static_cast<float> (nframes);
+          for (const auto i : std::views::iota (0zu, nframes))
+            {
+              values[i] = start + (step * static_cast<float> (i + 1));
+            }
+        }
+      values.back () = value;
+      state.ramp = { .values = values, .value = value };
+    }
 }
 
 ProcessorBase::ProcessorBase (
@@ -67,6 +109,26 @@ ProcessorBase::add_parameter (const dsp::ProcessorParameterUuidReference &uuid)
   params_.push_back (uuid);
 }
 
+void
+ProcessorBase::enable_parameter_ramp (
+  const dsp::ProcessorParameter    &param,
+  ParameterChangeTracker::RampShape shape)
+{
+  assert (processing_caches_ != nullptr);
+  assert (std::ranges::contains (processing_caches_->live_params_, &param));
+  auto &ramps = processing_caches_->change_tracker_.ramps_;
+  if (
+    std::ranges::contains (
+      ramps, &param, &ParameterChangeTracker::RampState::param))
+    return;
+
+  ramps.push_back (
+    { .param = &param,
+      .shape = shape,
+      .values = std::vector<float> (
+        processing_caches_->max_block_length_.in (units::samples)) });
+}
+
 void
 ProcessorBase::prepare_for_processing_impl (
   const graph::GraphNode * node,
@@ -86,6 +148,10 @@ ProcessorBase::prepare_for_processing_impl (
       auto * raw = in_ref.get ();
       auto   var = utils::convert_to_variant_qobj<dsp::PortPtrVariant> (raw);
       raw->prepare_for_processing (nullptr, sample_rate, max_block_length);
+      if (auto * const * audio_in = std::get_if<dsp::AudioPort *> (&var))
+        {
+          (*audio_in)->set_source_aliasing_allowed (can_alias_audio_inputs ());
+        }
       processing_caches_->live_input_ports_.push_back (var);
     }
   for (const auto &out_ref : output_ports_)
@@ -167,6 +233,8 @@ ProcessorBase::process_block (
       param->process_block (time_nfo, transport, tempo_map);
       processing_caches_->change_tracker_.record_if_changed (i, param);
     }
+  processing_caches_->change_tracker_.update_ramps (
+    time_nfo.nframes_.in (units::samples));
 
   // clear output ports before processing
   for (const auto &out_var : processing_caches_->live_output_ports_)
@@ -180,13 +248,48 @@ ProcessorBase::process_block (
         out_var);
     }
 
+  // skip the processor logic if it would only output silence
+  bool skip = false;
+  if (processing_caches_->ignoring_inputs_)
+    {
+      skip = true;
+      processing_caches_->silent_input_length_ = units::samples (0);
+    }
+  else if (const auto tail = get_tail_length (); tail && inputs_silent_rt ())
+    {
+      skip =
+        processing_caches_->silent_input_length_ >= *tail
+        && processing_caches_->change_tracker_.changes ().empty ();
+      processing_caches_->silent_input_length_ += time_nfo.nframes_;
+    }
+  else
+    {
+      processing_caches_->silent_input_length_ = units::samples (0);
+    }
+
+  // let the readers of the outputs know whether they can skip them
+  // (custom_process_block() may also mark the outputs it left silent)
+  for (const auto &out_var : processing_caches_->live_output_ports_)
+    {
+      if (auto * const * audio_out = std::get_if<dsp::AudioPort *> (&out_var))
+        {
+          (*audio_out)->set_silent (skip);
+        }
+    }
+
   // do processor logic
-  custom_process_block (time_nfo, transport, tempo_map);
+  if (!skip)
+    {
+      custom_process_block (time_nfo, transport, tempo_map);
+    }
 
   // clear changes for next cycle
   processing_caches_->change_tracker_.clear ();
 
-  // clear input ports for next cycle
+  // clear input ports for next cycle (ignored inputs were not written to and
+  // their storage may be pooled with ports in use)
+  if (processing_caches_->ignoring_inputs_)
+    return;
   for (const auto &in_var : processing_caches_->live_input_ports_)
     {
       std::visit (
@@ -199,6 +302,36 @@ ProcessorBase::process_block (
     }
 }
 
+bool
+ProcessorBase::ignore_inputs_in_next_cycle (bool allowed) noexcept
+{
+  if (processing_caches_ == nullptr) [[unlikely]]
+    return false;
+
+  processing_caches_->ignoring_inputs_ = allowed && inputs_unused_rt ();
+  return processing_caches_->ignoring_inputs_;
+}
+
+bool
+ProcessorBase::inputs_silent_rt () const noexcept
+{
+  return std::ranges::all_of (
+    processing_caches_->live_input_ports_, [] (const auto &in_var) {
+      return std::visit (
+        [] (const auto * in_port) {
+          using T = std::remove_cvref_t<decltype (*in_port)>;
+          if constexpr (std::is_same_v<T, AudioPort>)
+            return in_port->is_silent ();
+          else if constexpr (std::is_same_v<T, MidiPort>)
+            return in_port->buffer_.empty ();
+          // CV is not tracked
+          else
+            return false;
+        },
+        in_var);
+    });
+}
+
 void
 ProcessorBase::custom_process_block (
   dsp::graph::ProcessBlockInfo time_nfo,
@@ -228,7 +361,14 @@ ProcessorBase::custom_process_block (
             std::is_same_v<InT, dsp::AudioPort *>
             && std::is_same_v<OutT, dsp::AudioPort *>)
             {
-              out_port->copy_source_rt (*in_port, time_nfo);
+              // an aliased input already refers to its source's data (while
+              // our own input buffer is cleared after processing)
+              if (
+                !in_port->is_aliased ()
+                || !out_port->alias_source_rt (*in_port))
+                {
+                  out_port->copy_source_rt (*in_port, time_nfo);
+                }
             }
           else if constexpr (
             std::is_same_v<InT, dsp::CVPort *>
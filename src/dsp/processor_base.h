@@ -42,12 +42,78 @@ public:
       dsp::ProcessorParameter * param{};
     };
 
+    /**
+     * @brief Shape of a per-block parameter ramp.
+     */
+    enum class RampShape : uint8_t
+    {
+      /** Same difference between consecutive samples. */
+      Linear,
+
+      /**
+       * Same ratio between consecutive samples (suitable for gains).
+       *
+       * Falls back to linear if either end of the ramp is not positive.
+       */
+      Exponential,
+    };
+
+    /**
+     * @brief The (non-normalized) value of a parameter across the block.
+     *
+     * If the value changed since the previous block, @ref values ramps from
+     * the previous value to the current one. Otherwise, @ref values is empty
+     * so that kernels can use their constant (scalar) variant.
+     */
+    struct Ramp
+    {
+      /**
+       * Value for each frame of the block (index 0 corresponds to the
+       * block's buffer offset), or empty if the value didn't change.
+       */
+      std::span<const float> values;
+
+      /** Value at the end of the block. */
+      float value{};
+
+      bool is_constant () const { return values.empty (); }
+    };
+
     /** Returns the changes accumulated during the current cycle. */
     const auto &changes () const { return changes_; }
 
+    /**
+     * @brief Returns the ramp of @p param for the current cycle.
+     *
+     * @pre A ramp was enabled for @p param with enable_parameter_ramp().
+     */
+    const Ramp &ramp (const dsp::ProcessorParameter &param) const
+    {
+      const auto it = std::ranges::find (ramps_, &param, &RampState::param);
+      assert (it != ramps_.end ());
+      return it->ramp;
+    }
+
   private:
     friend class ProcessorBase;
 
+    struct RampState
+    {
+      const dsp::ProcessorParameter * param{};
+      RampShape                       shape{};
+
+      /** Buffer for the ramp values (max block length). */
+      std::vector<float> values;
+
+      /** Value at the end of the previous cycle. */
+      std::optional<float> prev_value;
+
+      Ramp ramp;
+    };
+
+    /** Ramps requested by the processor. */
+    std::vector<RampState> ramps_;
+
     /** Changes accumulated during the current cycle's parameter loop. */
     std::vector<Change> changes_;
 
@@ -74,6 +140,10 @@ public:
 
     /** Clears the change list after custom_process_block() returns. */
     void clear () { changes_.clear (); }
+
+    /** Calculates the ramps for the current cycle (after processing all
+     * parameters). */
+    void update_ramps (size_t nframes);
   };
 
 private:
@@ -88,6 +158,13 @@ private:
 
     ParameterChangeTracker change_tracker_;
 
+    /** For how long all the inputs have been silent. */
+    units::sample_u64_t silent_input_length_{};
+
+    /** Whether the inputs are ignored in the current cycle (see
+     * ignore_inputs_in_next_cycle()). */
+    bool ignoring_inputs_{};
+
     /**
      * @brief True while inside process_block(), false otherwise.
      *
@@ -130,6 +207,29 @@ public:
     return processing_caches_->change_tracker_;
   }
 
+  /**
+   * @brief Enables a per-block ramp for @p param (one of this processor's
+   * parameters).
+   *
+   * The ramp can then be obtained with parameter_ramp() during
+   * custom_process_block(). Ramps are reset by prepare_for_processing(), so
+   * this is typically called from custom_prepare_for_processing().
+   */
+  void enable_parameter_ramp (
+    const dsp::ProcessorParameter    &param,
+    ParameterChangeTracker::RampShape shape);
+
+  /**
+   * @brief Returns the ramp of @p param for the current cycle.
+   *
+   * Only valid to call during custom_process_block().
+   */
+  const ParameterChangeTracker::Ramp &
+  parameter_ramp (const dsp::ProcessorParameter &param) const noexcept
+  {
+    return change_tracker ().ramp (param);
+  }
+
   // ============================================================================
   // IProcessable Interface
   // ============================================================================
@@ -154,6 +254,15 @@ public:
     units::sample_u32_t      max_block_length) final;
   void release_resources () final;
 
+  /**
+   * @brief Processors are connected through their ports, so nothing needs to
+   * be staged when the processor's own node inputs change.
+   */
+  bool stage_node_inputs (const graph::GraphNode &node) final { return true; }
+
+  bool ignore_inputs_in_next_cycle (bool allowed) noexcept
+    [[clang::nonblocking]] final;
+
   // ============================================================================
 
 protected:
@@ -176,8 +285,49 @@ protected:
 
   virtual void custom_release_resources () { }
 
+  /**
+   * @brief Whether the audio input ports may refer to their source's buffer
+   * instead of copying it (see AudioPort::alias_source_rt()).
+   *
+   * Only return true if custom_process_block() never writes to the audio
+   * input buffers.
+   */
+  virtual bool can_alias_audio_inputs () const { return false; }
+
+  /**
+   * @brief For how long the processor keeps producing output once all its
+   * inputs are silent, or nullopt if its output doesn't only depend on its
+   * inputs (the default).
+   *
+   * Processors returning a length are skipped (and their outputs marked
+   * silent) once their inputs were silent for that long, unless a parameter
+   * changed. Called on the audio thread.
+   */
+  virtual std::optional<units::sample_u32_t> get_tail_length () const noexcept
+  {
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Whether the processor's output doesn't currently depend on its
+   * inputs (e.g., a fully muted fader).
+   *
+   * Only called at the cycle boundary if can_ignore_inputs() returns true. If
+   * this returns true, the processor is skipped (and its outputs marked
+   * silent) in the next cycle, and the nodes that only feed it may be left
+   * out of the cycle.
+   */
+  virtual bool inputs_unused_rt () const noexcept { return false; }
+
   auto registry () const -> utils::IObjectRegistry & { return registry_; }
 
+private:
+  /**
+   * @brief Whether all the live input ports are known to be silent for the
+   * current cycle.
+   */
+  bool inputs_silent_rt () const noexcept;
+
 private:
   static constexpr auto kProcessorNameKey = "processorName"sv;
   static constexpr auto kInputPortsKey = "inputPorts"sv;
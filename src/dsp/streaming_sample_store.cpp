@@ -0,0 +1,455 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <cassert>
+
+#include <fmt/std.h>
+
+#include "dsp/panning.h"
+#include "dsp/streaming_sample_store.h"
+#include "utils/exceptions.h"
+#include "utils/float_ranges.h"
+#include "utils/logger.h"
+#include "utils/utf8_string.h"
+
+using zrythm::utils::exceptions::ZrythmException;
+
+namespace zrythm::dsp
+{
+
+StreamingSampleStore::StreamingSampleStore (
+  std::filesystem::path path,
+  units::sample_rate_t  sample_rate,
+  Options               options)
+    : path_ (std::move (path)), sample_rate_ (sample_rate), options_ (options),
+      current_pass_ (options.keep_passes_ + 1)
+{
+  assert (options_.page_frames_ > 0);
+
+  juce::AudioFormatManager format_mgr;
+  format_mgr.registerBasicFormats ();
+  reader_ = std::unique_ptr<juce::AudioFormatReader> (
+    format_mgr.createReaderFor (
+      utils::Utf8String::from_path (path_).to_juce_file ()));
+  if (reader_ == nullptr)
+    {
+      throw ZrythmException (
+        fmt::format ("Failed to create reader for file '{}'", path_));
+    }
+  if (
+    static_cast<int> (reader_->sampleRate)
+    != sample_rate_.in<int> (units::sample_rate))
+    {
+      throw ZrythmException (
+        fmt::format (
+          "Cannot stream '{}': sample rate {} does not match {}", path_,
+          reader_->sampleRate, sample_rate_));
+    }
+
+  num_frames_ = units::samples (reader_->lengthInSamples);
+  bit_depth_ = static_cast<int> (reader_->bitsPerSample);
+  file_channels_ = static_cast<int> (reader_->numChannels);
+
+  num_pages_ =
+    num_frames_ > units::samples (0)
+      ? page_index (num_frames_ - units::samples (1)) + 1
+      : 0;
+  pages_ = std::make_unique<PageSlot[]> (num_pages_);
+  loaded_pages_.resize (num_pages_);
+
+  // keep the first page loaded (never unloaded by prefetch())
+  if (num_pages_ > 0)
+    {
+      loaded_pages_.front () = load_page (0);
+      pages_[0].page.store (loaded_pages_.front ().get ());
+      resident_pages_.store (1);
+    }
+
+  z_debug (
+    "opened '{}' for streaming ({} frames in {} pages)", path_, num_frames_,
+    num_pages_);
+}
+
+StreamingSampleStore::~StreamingSampleStore () = default;
+
+StreamingSampleStore::PagePtr
+StreamingSampleStore::load_page (size_t index) const
+{
+  if (options_.page_cache_ == nullptr)
+    return decode_page (index);
+
+  return options_.page_cache_->get_or_load (
+    options_.cache_source_id_, index, [&] { return decode_page (index); });
+}
+
+StreamingSampleStore::PagePtr
+StreamingSampleStore::decode_page (size_t index) const
+{
+  const auto start =
+    static_cast<int64_t> (index) * static_cast<int64_t> (options_.page_frames_);
+  const auto len = static_cast<int> (std::min (
+    static_cast<int64_t> (options_.page_frames_),
+    num_frames_.in (units::samples) - start));
+
+  auto page = std::make_shared<juce::AudioSampleBuffer> (2, len);
+  {
+    std::lock_guard lock (reader_mutex_);
+    if (!reader_->read (page.get (), 0, len, start, true, true))
+      {
+        throw ZrythmException (
+          fmt::format ("Failed to read frames from file '{}'", path_));
+      }
+  }
+
+  // convert mono to stereo like FileAudioSource does
+  if (file_channels_ == 1)
+    {
+      const auto [left_gain, _] =
+        calculate_panning (PanLaw::Minus3dB, PanAlgorithm::SquareRoot, 0.5f);
+      const auto samples = static_cast<size_t> (len);
+      auto *     left = page->getWritePointer (0);
+      auto *     right = page->getWritePointer (1);
+      utils::float_ranges::mul_k2 ({ left, samples }, left_gain);
+      utils::float_ranges::copy ({ right, samples }, { left, samples });
+    }
+
+  pages_loaded_.fetch_add (1, std::memory_order_relaxed);
+  return page;
+}
+
+void
+StreamingSampleStore::mark_needed (size_t first_page, size_t num_pages) noexcept
+{
+  const auto pass = current_pass_.load (std::memory_order_relaxed);
+  const auto last_page = std::min (first_page + num_pages, num_pages_);
+  for (size_t i = first_page; i < last_page; ++i)
+    {
+      pages_[i].needed_pass.store (pass, std::memory_order_relaxed);
+    }
+}
+
+void
+StreamingSampleStore::request (units::sample_t frame) noexcept
+{
+  if (frame < units::samples (0) || frame >= num_frames_)
+    return;
+
+  mark_needed (
+    page_index (frame), static_cast<size_t> (options_.read_ahead_pages_) + 1);
+}
+
+bool
+StreamingSampleStore::read (
+  units::sample_t  start_frame,
+  std::span<float> left,
+  std::span<float> right) noexcept
+{
+  assert (left.size () == right.size ());
+
+  // see prefetch() for how this protects the pages from being freed while we
+  // read them
+  active_readers_.fetch_add (1);
+
+  const auto pass = current_pass_.load (std::memory_order_relaxed);
+  const auto total = static_cast<int64_t> (left.size ());
+  const auto start = start_frame.in (units::samples);
+  const auto end = num_frames_.in (units::samples);
+  int64_t    missing_frames = 0;
+  int64_t    done = 0;
+  while (done < total)
+    {
+      const auto pos = start + done;
+      const auto dest_offset = static_cast<size_t> (done);
+      if (pos < 0 || pos >= end)
+        {
+          // outside the file: silence until the file starts (or to the end)
+          const auto len =
+            pos < 0 ? std::min (total - done, -pos) : total - done;
+          utils::float_ranges::fill (
+            left.subspan (dest_offset, static_cast<size_t> (len)), 0.f);
+          utils::float_ranges::fill (
+            right.subspan (dest_offset, static_cast<size_t> (len)), 0.f);
+          done += len;
+          continue;
+        }
+
+      const auto index = static_cast<size_t> (pos / options_.page_frames_);
+      const auto page_offset = pos % options_.page_frames_;
+      const auto len = std::min (
+        { total - done, options_.page_frames_ - page_offset, end - pos });
+      const auto dest_left =
+        left.subspan (dest_offset, static_cast<size_t> (len));
+      const auto dest_right =
+        right.subspan (dest_offset, static_cast<size_t> (len));
+
+      auto &slot = pages_[index];
+      slot.needed_pass.store (pass, std::memory_order_relaxed);
+      if (const auto * page = slot.page.load ())
+        {
+          utils::float_ranges::copy (
+            dest_left,
+            { page->getReadPointer (0, static_cast<int> (page_offset)),
+              static_cast<size_t> (len) });
+          utils::float_ranges::copy (
+            dest_right,
+            { page->getReadPointer (1, static_cast<int> (page_offset)),
+              static_cast<size_t> (len) });
+        }
+      else
+        {
+          utils::float_ranges::fill (dest_left, 0.f);
+          utils::float_ranges::fill (dest_right, 0.f);
+          missing_frames += len;
+        }
+      done += len;
+    }
+
+  // request read-ahead after the last frame read
+  if (total > 0 && start + total > 0 && start + total < end)
+    {
+      mark_needed (
+        page_index (units::samples (start + total)),
+        static_cast<size_t> (options_.read_ahead_pages_));
+    }
+
+  active_readers_.fetch_sub (1);
+
+  if (missing_frames > 0)
+    {
+      underruns_.fetch_add (1, std::memory_order_relaxed);
+      underrun_frames_.fetch_add (
+        static_cast<uint64_t> (missing_frames), std::memory_order_relaxed);
+      return false;
+    }
+  return true;
+}
+
+void
+StreamingSampleStore::read_blocking (
+  units::sample_t          start_frame,
+  int                      num_frames,
+  juce::AudioSampleBuffer &dest,
+  int                      dest_offset) const
+{
+  assert (dest.getNumChannels () >= 2);
+  assert (dest_offset + num_frames <= dest.getNumSamples ());
+
+  const auto start = start_frame.in (units::samples);
+  const auto end = num_frames_.in (units::samples);
+  int64_t    done = 0;
+  while (done < num_frames)
+    {
+      const auto pos = start + done;
+      const auto out = dest_offset + static_cast<int> (done);
+      if (pos < 0 || pos >= end)
+        {
+          const auto len = static_cast<int> (
+            pos < 0 ? std::min (num_frames - done, -pos) : num_frames - done);
+          dest.clear (out, len);
+          done += len;
+          continue;
+        }
+
+      const auto index = static_cast<size_t> (pos / options_.page_frames_);
+      const auto page_offset = static_cast<int> (pos % options_.page_frames_);
+      const auto len = static_cast<int> (std::min (
+        { num_frames - done,
+          static_cast<int64_t> (options_.page_frames_ - page_offset),
+          end - pos }));
+
+      // use the loaded page if there is one, otherwise load it temporarily
+      PagePtr temp_page;
+      active_readers_.fetch_add (1);
+      const auto * page = pages_[index].page.load ();
+      if (page == nullptr)
+        {
+          active_readers_.fetch_sub (1);
+          temp_page = load_page (index);
+          page = temp_page.get ();
+        }
+      for (int ch = 0; ch < 2; ++ch)
+        {
+          dest.copyFrom (ch, out, *page, ch, page_offset, len);
+        }
+      if (temp_page == nullptr)
+        {
+          active_readers_.fetch_sub (1);
+        }
+      done += len;
+    }
+}
+
+void
+StreamingSampleStore::wait_for_readers () const
+{
+  while (active_readers_.load () > 0)
+    {
+      std::this_thread::yield ();
+    }
+}
+
+void
+StreamingSampleStore::prefetch ()
+{
+  std::lock_guard lock (prefetch_mutex_);
+
+  // readers mark the pages they need with the current pass, so advance it
+  // before looking at the marks
+  const auto pass = current_pass_.fetch_add (1) + 1;
+  const auto recently_needed = [&] (const PageSlot &slot) {
+    return slot.needed_pass.load (std::memory_order_relaxed)
+             + options_.keep_passes_
+           >= pass;
+  };
+
+  // unload pages that were not needed for a while (the first page is always
+  // kept)
+  std::vector<size_t> unloaded;
+  for (size_t i = 1; i < num_pages_; ++i)
+    {
+      auto &slot = pages_[i];
+      if (loaded_pages_[i] != nullptr && !recently_needed (slot))
+        {
+          slot.page.store (nullptr);
+          unloaded.push_back (i);
+        }
+    }
+  if (!unloaded.empty ())
+    {
+      // a reader may have loaded a page pointer before we cleared it, so wait
+      // for in-progress reads before freeing the pages
+      wait_for_readers ();
+      for (const auto i : unloaded)
+        {
+          loaded_pages_[i].reset ();
+        }
+      resident_pages_.fetch_sub (unloaded.size ());
+    }
+
+  // load pages that are needed
+  for (size_t i = 1; i < num_pages_; ++i)
+    {
+      auto &slot = pages_[i];
+      if (loaded_pages_[i] == nullptr && recently_needed (slot))
+        {
+          try
+            {
+              loaded_pages_[i] = load_page (i);
+            }
+          catch (const ZrythmException &e)
+            {
+              z_warning ("{}", e.what ());
+              continue;
+            }
+          slot.page.store (loaded_pages_[i].get ());
+          resident_pages_.fetch_add (1);
+        }
+    }
+}
+
+StreamingSampleStore::Stats
+StreamingSampleStore::stats () const
+{
+  return {
+    .underruns = underruns_.load (std::memory_order_relaxed),
+    .underrun_frames = underrun_frames_.load (std::memory_order_relaxed),
+    .pages_loaded = pages_loaded_.load (std::memory_order_relaxed),
+    .resident_pages = resident_pages_.load (std::memory_order_relaxed),
+  };
+}
+
+void
+StreamingSampleStore::reset_stats ()
+{
+  underruns_.store (0, std::memory_order_relaxed);
+  underrun_frames_.store (0, std::memory_order_relaxed);
+}
+
+// ========================================================================
+
+StreamingPrefetcher::StreamingPrefetcher (std::chrono::milliseconds interval)
+    : interval_ (interval)
+{
+  thread_ = std::jthread ([this] () {
+    while (!quit_.load ())
+      {
+        wake_sem_.wait (
+          std::chrono::duration_cast<std::chrono::microseconds> (interval_)
+            .count ());
+        if (quit_.load ())
+          break;
+
+        prefetch_now ();
+      }
+  });
+}
+
+StreamingPrefetcher::~StreamingPrefetcher ()
+{
+  quit_.store (true);
+  wake_sem_.signal ();
+  thread_.join ();
+}
+
+void
+StreamingPrefetcher::add_store (
+  const std::shared_ptr<StreamingSampleStore> &store)
+{
+  {
+    std::lock_guard lock (stores_mutex_);
+    stores_.emplace_back (store);
+  }
+  wake ();
+}
+
+void
+StreamingPrefetcher::wake () noexcept
+{
+  wake_sem_.signal ();
+}
+
+void
+StreamingPrefetcher::prefetch_now ()
+{
+  std::vector<std::shared_ptr<StreamingSampleStore>> stores;
+  {
+    std::lock_guard lock (stores_mutex_);
+    std::erase_if (stores_, [] (const auto &store) {
+      return store.expired ();
+    });
+    for (const auto &store : stores_)
+      {
+        if (auto locked = store.lock ())
+          {
+            stores.push_back (std::move (locked));
+          }
+      }
+  }
+
+  for (const auto &store : stores)
+    {
+      store->prefetch ();
+    }
+}
+
+StreamingSampleStore::Stats
+StreamingPrefetcher::stats () const
+{
+  StreamingSampleStore::Stats ret;
+  std::lock_guard             lock (stores_mutex_);
+  for (const auto &store : stores_)
+    {
+      if (const auto locked = store.lock ())
+        {
+          const auto stats = locked->stats ();
+          ret.underruns += stats.underruns;
+          ret.underrun_frames += stats.underrun_frames;
+          ret.pages_loaded += stats.pages_loaded;
+          ret.resident_pages += stats.resident_pages;
+        }
+    }
+  return ret;
+}
+
+} // namespace zrythm::dsp
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "dsp/decoded_page_cache.h"
+#include "utils/types.h"
+#include "utils/units.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+namespace zrythm::dsp
+{
+
+/**
+ * @brief Paged, disk-backed storage for the frames of an audio file.
+ *
+ * Instead of decoding the whole file into memory, the file is split into
+ * fixed-size pages that are decoded on demand by a StreamingPrefetcher. Only
+ * the pages around the positions that are being played (plus a read-ahead
+ * window) are kept in memory.
+ *
+ * Frames are always provided in stereo (mono files are converted the same way
+ * FileAudioSource converts them).
+ *
+ * read() is realtime-safe: pages are looked up through a lock-free page table,
+ * and frames whose page is not loaded yet are output as silence and counted
+ * as an underrun.
+ */
+class StreamingSampleStore final
+{
+public:
+  struct Options
+  {
+    /** Number of frames per page. */
+    int page_frames_ = 1 << 16;
+
+    /** Number of pages to keep loaded after the page being read. */
+    int read_ahead_pages_ = 4;
+
+    /**
+     * @brief Number of prefetch passes a page stays loaded for after it was
+     * last needed.
+     */
+    uint32_t keep_passes_ = 64;
+
+    /**
+     * @brief Cache to share decoded pages through (optional).
+     *
+     * Pages are looked up in the cache before decoding them, and decoded
+     * pages are added to it.
+     */
+    std::shared_ptr<DecodedPageCache> page_cache_;
+
+    /** Source the file's pages are cached under in @ref page_cache_. */
+    DecodedPageCache::SourceId cache_source_id_;
+  };
+
+  struct Stats
+  {
+    /** Number of read() calls that hit a page that was not loaded. */
+    uint64_t underruns{};
+
+    /** Number of frames output as silence because of underruns. */
+    uint64_t underrun_frames{};
+
+    /** Number of pages decoded so far. */
+    uint64_t pages_loaded{};
+
+    /** Number of pages currently in memory. */
+    size_t resident_pages{};
+  };
+
+  /**
+   * @brief Opens the given file for streaming.
+   *
+   * The first page is loaded immediately and always kept in memory so that
+   * playback from the start of the file never underruns.
+   *
+   * @param sample_rate Sample rate the frames are needed in. Streaming does
+   * not resample, so this must match the file's sample rate.
+   * @throw ZrythmException if the file could not be opened or its sample rate
+   * does not match.
+   */
+  StreamingSampleStore (
+    std::filesystem::path path,
+    units::sample_rate_t  sample_rate,
+    Options               options);
+  StreamingSampleStore (
+    std::filesystem::path path,
+    units::sample_rate_t  sample_rate)
+      : StreamingSampleStore (std::move (path), sample_rate, Options{})
+  {
+  }
+  ~StreamingSampleStore ();
+  Z_DISABLE_COPY_MOVE (StreamingSampleStore)
+
+  const auto &path () const { return path_; }
+  auto        num_frames () const { return num_frames_; }
+  auto        sample_rate () const { return sample_rate_; }
+  auto        bit_depth () const { return bit_depth_; }
+
+  /**
+   * @brief Copies frames starting at @p start_frame to @p left and @p right.
+   *
+   * Both spans must have the same size. Frames past the end of the file are
+   * output as silence. The pages after the read range are requested for
+   * prefetching.
+   *
+   * @return Whether all requested frames were available (false on underrun).
+   */
+  bool read (
+    units::sample_t  start_frame,
+    std::span<float> left,
+    std::span<float> right) noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Requests the pages starting at @p frame to be prefetched.
+   *
+   * To be called ahead of time (e.g., for clips that are about to start
+   * playing) so that the first read() does not underrun.
+   */
+  void request (units::sample_t frame) noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Reads frames into @p dest, decoding any pages that are not loaded.
+   *
+   * Pages decoded by this method are not kept loaded (but are added to the
+   * page cache, if any).
+   *
+   * @warning Not realtime safe.
+   */
+  void read_blocking (
+    units::sample_t          start_frame,
+    int                      num_frames,
+    juce::AudioSampleBuffer &dest,
+    int                      dest_offset) const;
+
+  /**
+   * @brief Loads the pages that were requested and unloads the pages that
+   * were not needed for a while.
+   *
+   * Called periodically by StreamingPrefetcher.
+   */
+  void prefetch ();
+
+  Stats stats () const;
+
+  void reset_stats ();
+
+private:
+  using PagePtr = DecodedPageCache::PagePtr;
+
+  struct PageSlot
+  {
+    std::atomic<const juce::AudioSampleBuffer *> page{};
+
+    /** Prefetch pass during which the page was last needed. */
+    std::atomic<uint32_t> needed_pass{};
+  };
+
+  size_t page_index (units::sample_t frame) const
+  {
+    return static_cast<size_t> (
+      frame.in (units::samples) / static_cast<int64_t> (options_.page_frames_));
+  }
+
+  void mark_needed (size_t first_page, size_t num_pages) noexcept
+    [[clang::nonblocking]];
+
+  /**
+   * @brief Returns the given page from the page cache, decoding it if needed.
+   */
+  PagePtr load_page (size_t index) const;
+
+  /**
+   * @brief Decodes the given page.
+   */
+  PagePtr decode_page (size_t index) const;
+
+  /**
+   * @brief Waits until no reader holds a pointer to an unloaded page.
+   */
+  void wait_for_readers () const;
+
+private:
+  std::filesystem::path                    path_;
+  units::sample_rate_t                     sample_rate_;
+  Options                                  options_;
+  units::sample_t                          num_frames_;
+  int                                      bit_depth_{};
+  int                                      file_channels_{};
+  std::unique_ptr<juce::AudioFormatReader> reader_;
+
+  /** Protects @ref reader_, which is not thread-safe. */
+  mutable std::mutex reader_mutex_;
+
+  /** Serializes prefetch() calls. */
+  std::mutex prefetch_mutex_;
+
+  std::unique_ptr<PageSlot[]> pages_;
+  size_t                      num_pages_{};
+
+  /** Owning storage for loaded pages (only touched by prefetch()). */
+  std::vector<PagePtr> loaded_pages_;
+
+  std::atomic<uint32_t> current_pass_;
+
+  /** Number of read() calls in progress. */
+  mutable std::atomic<int> active_readers_{ 0 };
+
+  std::atomic<uint64_t>         underruns_{ 0 };
+  std::atomic<uint64_t>         underrun_frames_{ 0 };
+  mutable std::atomic<uint64_t> pages_loaded_{ 0 };
+  std::atomic<size_t>           resident_pages_{ 0 };
+};
+
+/**
+ * @brief Background thread that keeps StreamingSampleStore pages loaded ahead
+ * of playback.
+ */
+class StreamingPrefetcher final
+{
+public:
+  /**
+   * @param interval Time between prefetch passes.
+   */
+  explicit StreamingPrefetcher (
+    std::chrono::milliseconds interval = std::chrono::milliseconds (10));
+  ~StreamingPrefetcher ();
+  Z_DISABLE_COPY_MOVE (StreamingPrefetcher)
+
+  /**
+   * @brief Starts prefetching for the given store until it is destroyed.
+   */
+  void add_store (const std::shared_ptr<StreamingSampleStore> &store);
+
+  /**
+   * @brief Runs a prefetch pass immediately (e.g., after seeking).
+   *
+   * Does not wait for the pass to finish.
+   */
+  void wake () noexcept [[clang::nonblocking]];
+
+  /**
+   * @brief Runs a prefetch pass on the calling thread.
+   */
+  void prefetch_now ();
+
+  /**
+   * @brief Returns the accumulated statistics of all stores.
+   */
+  StreamingSampleStore::Stats stats () const;
+
+private:
+  std::chrono::milliseconds                        interval_;
+  mutable std::mutex                               stores_mutex_;
+  std::vector<std::weak_ptr<StreamingSampleStore>> stores_;
+  moodycamel::LightweightSemaphore                 wake_sem_;
+  std::atomic<bool>                                quit_{ false };
+  std::jthread                                     thread_;
+};
+
+} // namespace zrythm::dsp
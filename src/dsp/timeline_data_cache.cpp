@@ -2,9 +2,13 @@
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
 #include <algorithm>
+#include <array>
+#include <numeric>
+#include <ranges>
 #include <set>
 
 #include "dsp/timeline_data_cache.h"
+#include "utils/float_ranges.h"
 #include "utils/logger.h"
 
 namespace zrythm::dsp
@@ -12,11 +16,47 @@ namespace zrythm::dsp
 
 // ========== MidiTimelineDataCache Implementation ==========
 
+namespace
+{
+/**
+ * @brief Orders events by timestamp, then note-offs (and other events) before
+ * note-ons at the same timestamp.
+ */
+bool
+midi_event_less (const SampleBasedMidiEvent &a, const SampleBasedMidiEvent &b)
+{
+  if (a.time_ != b.time_)
+    return a.time_ < b.time_;
+  return !utils::midi::midi_is_note_on (a.data ())
+         && utils::midi::midi_is_note_on (b.data ());
+}
+
+/**
+ * @brief Orders merged events, breaking ties by the interval of the sequence
+ * they come from.
+ */
+bool
+merged_midi_event_less (
+  const SampleBasedMidiEvent            &a,
+  const TimelineDataCache::IntervalType &a_interval,
+  const SampleBasedMidiEvent            &b,
+  const TimelineDataCache::IntervalType &b_interval)
+{
+  if (midi_event_less (a, b))
+    return true;
+  if (midi_event_less (b, a))
+    return false;
+  return a_interval < b_interval;
+}
+}
+
 void
 MidiTimelineDataCache::clear_impl ()
 {
   midi_sequences_.clear ();
   merged_midi_events_.clear ();
+  merged_event_intervals_.clear ();
+  dirty_intervals_.clear ();
 }
 
 void
@@ -26,7 +66,10 @@ MidiTimelineDataCache::remove_sequences_matching_interval (IntervalType interval
 
   // Strict overlap: adjacent intervals are not considered overlapping.
   std::erase_if (midi_sequences_, [&] (const auto &entry) {
-    return intervals_overlap (entry.first, interval);
+    if (!intervals_overlap (entry.first, interval))
+      return false;
+    dirty_intervals_.insert (entry.first);
+    return true;
   });
 }
 
@@ -89,34 +132,172 @@ MidiTimelineDataCache::add_midi_sequence (
         midi_event::make_note_off (key.first, key.second, time));
     }
 
+  // Keep each sequence sorted so that finalize_changes() only needs to merge
+  std::ranges::stable_sort (validated, midi_event_less);
+
   z_trace (
     "{} events, interval=[{}, {}]", validated.size (), start_time, end_time);
   midi_sequences_[interval] = std::move (validated);
+  dirty_intervals_.insert (interval);
 }
 
 void
 MidiTimelineDataCache::finalize_changes_impl ()
 {
-  merged_midi_events_.clear ();
+  if (dirty_intervals_.empty ())
+    return;
+
+  const auto event_index = [this] (auto it) {
+    return static_cast<size_t> (it - merged_midi_events_.begin ());
+  };
+
+  // A sequence's events lie within its interval, so only the merged events
+  // inside the dirty intervals need to be looked at
+  const auto window_start = dirty_intervals_.begin ()->first;
+  auto       window_end = window_start;
+  for (const auto &interval : dirty_intervals_)
+    {
+      window_end = std::max (window_end, interval.second);
+    }
 
-  // Concatenate all events from all intervals into one vector
-  for (const auto &[interval, seq] : midi_sequences_)
+  // Remove the events of the dirty sequences (they are re-added below if
+  // the sequence still exists)
+  {
+    const auto lower = event_index (std::ranges::lower_bound (
+      merged_midi_events_, window_start, {}, &SampleBasedMidiEvent::time_));
+    const auto upper = event_index (std::ranges::upper_bound (
+      merged_midi_events_, window_end, {}, &SampleBasedMidiEvent::time_));
+    auto write = lower;
+    for (auto read = lower; read < upper; ++read)
+      {
+        if (dirty_intervals_.contains (merged_event_intervals_[read]))
+          continue;
+
+        if (write != read)
+          {
+            merged_midi_events_[write] = merged_midi_events_[read];
+            merged_event_intervals_[write] = merged_event_intervals_[read];
+          }
+        ++write;
+      }
+    const auto erase_range = [write, upper] (auto &vec) {
+      vec.erase (
+        vec.begin () + static_cast<ptrdiff_t> (write),
+        vec.begin () + static_cast<ptrdiff_t> (upper));
+    };
+    erase_range (merged_midi_events_);
+    erase_range (merged_event_intervals_);
+  }
+
+  // K-way merge the events of the dirty sequences that still exist (each
+  // sequence is already sorted)
+  struct Run
+  {
+    const IntervalType                   *interval;
+    std::span<const SampleBasedMidiEvent> events;
+    size_t                                pos{};
+  };
+  std::vector<Run> runs;
+  size_t           num_added_events = 0;
+  for (const auto &interval : dirty_intervals_)
     {
-      merged_midi_events_.insert (
-        merged_midi_events_.end (), seq.begin (), seq.end ());
+      const auto it = midi_sequences_.find (interval);
+      if (it == midi_sequences_.end () || it->second.empty ())
+        continue;
+
+      runs.push_back ({ &it->first, it->second });
+      num_added_events += it->second.size ();
+    }
+  dirty_intervals_.clear ();
+
+  if (runs.empty ())
+    return;
+
+  std::vector<SampleBasedMidiEvent> added_events;
+  std::vector<IntervalType>         added_intervals;
+  added_events.reserve (num_added_events);
+  added_intervals.reserve (num_added_events);
+
+  // Heap of run indices with the run with the earliest next event on top
+  const auto run_after = [&runs] (size_t a, size_t b) {
+    const auto &run_a = runs[a];
+    const auto &run_b = runs[b];
+    return merged_midi_event_less (
+      run_b.events[run_b.pos], *run_b.interval, run_a.events[run_a.pos],
+      *run_a.interval);
+  };
+  auto heap = std::views::iota (0zu, runs.size ())
+              | std::ranges::to<std::vector<size_t>> ();
+  std::ranges::make_heap (heap, run_after);
+  while (!heap.empty ())
+    {
+      std::ranges::pop_heap (heap, run_after);
+      auto &run = runs[heap.back ()];
+      added_events.push_back (run.events[run.pos]);
+      added_intervals.push_back (*run.interval);
+      if (++run.pos < run.events.size ())
+        {
+          std::ranges::push_heap (heap, run_after);
+        }
+      else
+        {
+          heap.pop_back ();
+        }
     }
 
-  // Sort once: by timestamp, then noteOff before noteOn at same timestamp
-  std::ranges::stable_sort (
-    merged_midi_events_,
-    [] (const SampleBasedMidiEvent &a, const SampleBasedMidiEvent &b) {
-      if (a.time_ != b.time_)
-        return a.time_ < b.time_;
-      const auto ad = a.data ();
-      const auto bd = b.data ();
-      return !utils::midi::midi_is_note_on (ad)
-             && utils::midi::midi_is_note_on (bd);
-    });
+  // Merge the added events with the existing events in their time range and
+  // splice the result in
+  const auto lower = event_index (std::ranges::lower_bound (
+    merged_midi_events_, added_events.front ().time_, {},
+    &SampleBasedMidiEvent::time_));
+  const auto upper = event_index (std::ranges::upper_bound (
+    merged_midi_events_, added_events.back ().time_, {},
+    &SampleBasedMidiEvent::time_));
+
+  std::vector<SampleBasedMidiEvent> spliced_events;
+  std::vector<IntervalType>         spliced_intervals;
+  spliced_events.reserve (upper - lower + added_events.size ());
+  spliced_intervals.reserve (upper - lower + added_events.size ());
+  {
+    auto existing = lower;
+    auto added = 0zu;
+    while (existing < upper || added < added_events.size ())
+      {
+        const bool take_existing =
+          added == added_events.size ()
+          || (existing < upper
+              && !merged_midi_event_less (
+                added_events[added], added_intervals[added],
+                merged_midi_events_[existing],
+                merged_event_intervals_[existing]));
+        if (take_existing)
+          {
+            spliced_events.push_back (merged_midi_events_[existing]);
+            spliced_intervals.push_back (merged_event_intervals_[existing]);
+            ++existing;
+          }
+        else
+          {
+            spliced_events.push_back (added_events[added]);
+            spliced_intervals.push_back (added_intervals[added]);
+            ++added;
+          }
+      }
+  }
+
+  // Overwrite [lower, upper) and insert the rest after it, so that the
+  // events after the range are only moved once
+  const auto splice = [lower, upper] (auto &vec, const auto &replacement) {
+    const auto num_replaced = static_cast<ptrdiff_t> (upper - lower);
+    std::ranges::copy (
+      replacement.begin (), replacement.begin () + num_replaced,
+      vec.begin () + static_cast<ptrdiff_t> (lower));
+    vec.insert (
+      vec.begin () + static_cast<ptrdiff_t> (upper),
+      replacement.begin () + num_replaced, replacement.end ());
+  };
+  splice (merged_midi_events_, spliced_events);
+  splice (merged_event_intervals_, spliced_intervals);
 }
 
 bool
@@ -171,6 +352,24 @@ AudioTimelineDataCache::add_audio_clip (
   audio_clips_.push_back (entry);
 }
 
+void
+AudioTimelineDataCache::add_lazy_audio_clip (
+  IntervalType  interval,
+  LazyAudioClip clip)
+{
+  const auto [start_sample, end_sample] = interval;
+
+  validate_interval (interval);
+  z_return_if_fail (clip.frames != nullptr || clip.stream != nullptr);
+
+  AudioClipEntry entry;
+  entry.start_sample = start_sample;
+  entry.end_sample = end_sample;
+  entry.lazy = std::move (clip);
+
+  audio_clips_.push_back (std::move (entry));
+}
+
 void
 AudioTimelineDataCache::finalize_changes_impl ()
 {
@@ -195,6 +394,359 @@ AudioTimelineDataCache::compute_cached_sample_ranges () const
          | std::ranges::to<std::vector<IntervalType>> ();
 }
 
+// ========== LazyAudioClip Implementation ==========
+
+std::optional<units::sample_t>
+AudioTimelineDataCache::LazyAudioClip::source_position (
+  units::sample_t clip_pos) const noexcept
+{
+  if (clip_pos < units::samples (0) || clip_pos >= content_length)
+    return std::nullopt;
+
+  // the first leg plays clip_start -> loop_end, subsequent legs loop
+  // loop_start -> loop_end (same as ClipRenderer)
+  auto pos = clip_start + clip_pos;
+  if (looped)
+    {
+      const auto first_leg = loop_end - clip_start;
+      if (clip_pos >= first_leg)
+        {
+          const auto loop_len =
+            au::max (units::samples (1), loop_end - loop_start);
+          pos = loop_start + ((clip_pos - first_leg) % loop_len);
+        }
+    }
+  else if (pos >= loop_end)
+    return std::nullopt;
+
+  if (pos >= source_length)
+    return std::nullopt;
+
+  return pos;
+}
+
+int64_t
+AudioTimelineDataCache::LazyAudioClip::contiguous_length (
+  units::sample_t clip_pos,
+  units::sample_t source_pos) const noexcept
+{
+  const auto source_end = au::min (loop_end, source_length);
+  return std::min (
+    (source_end - source_pos).in (units::samples),
+    (content_length - clip_pos).in (units::samples));
+}
+
+bool
+AudioTimelineDataCache::LazyAudioClip::compute_gains (
+  units::sample_t  clip_pos,
+  std::span<float> gains) const noexcept
+{
+  const auto start = clip_pos.in (units::samples);
+  const auto end = start + static_cast<int64_t> (gains.size ());
+  const auto content_len = content_length.in (units::samples);
+  const auto builtin_len =
+    std::min (static_cast<int64_t> (builtin_fade_frames), content_len);
+  const auto builtin_out_start = content_len - builtin_len;
+  const auto fade_in_len = fade_in_length.in (units::samples);
+  const auto fade_out_len = fade_out_length.in (units::samples);
+  const auto fade_out_begin = fade_out_start.in (units::samples);
+
+  const bool in_builtin_fade =
+    builtin_len > 0 && (start < builtin_len || end > builtin_out_start);
+  const bool in_fade_in = fade_in_len > 0 && start < fade_in_len;
+  const bool in_fade_out =
+    fade_out_len > 0 && end > fade_out_begin
+    && start <= fade_out_begin + fade_out_len;
+  if (!in_builtin_fade && !in_fade_in && !in_fade_out)
+    {
+      gains[0] = gain;
+      return true;
+    }
+
+  std::ranges::fill (gains, gain);
+
+  // built-in fades are linear ramps matching juce's applyGainRamp()
+  if (in_builtin_fade)
+    {
+      const auto step = 1.f / static_cast<float> (builtin_len);
+      for (size_t i = 0; i < gains.size (); ++i)
+        {
+          const auto frame = start + static_cast<int64_t> (i);
+          if (frame < builtin_len)
+            gains[i] *= static_cast<float> (frame) * step;
+          if (frame >= builtin_out_start)
+            gains[i] *=
+              1.f - static_cast<float> (frame - builtin_out_start) * step;
+        }
+    }
+
+  if (in_fade_in)
+    {
+      const auto last = std::min (end, fade_in_len);
+      for (auto frame = start; frame < last; ++frame)
+        {
+          gains[static_cast<size_t> (frame - start)] *=
+            static_cast<float> (fade_in_opts.get_normalized_y (
+              static_cast<double> (frame) / static_cast<double> (fade_in_len),
+              false));
+        }
+    }
+
+  if (in_fade_out)
+    {
+      const auto first = std::max (start, fade_out_begin);
+      const auto last = std::min (end, fade_out_begin + fade_out_len + 1);
+      for (auto frame = first; frame < last; ++frame)
+        {
+          gains[static_cast<size_t> (frame - start)] *=
+            static_cast<float> (fade_out_opts.get_normalized_y (
+              static_cast<double> (frame - fade_out_begin)
+                / static_cast<double> (fade_out_len),
+              true));
+        }
+    }
+
+  return false;
+}
+
+void
+AudioTimelineDataCache::LazyAudioClip::mix (
+  units::sample_t  clip_offset,
+  std::span<float> output_left,
+  std::span<float> output_right) const noexcept
+{
+  static constexpr size_t CHUNK_FRAMES = 256;
+
+  std::array<float, CHUNK_FRAMES> gains;
+  std::array<float, CHUNK_FRAMES> left_chunk;
+  std::array<float, CHUNK_FRAMES> right_chunk;
+
+  const auto num_frames = std::min (output_left.size (), output_right.size ());
+  size_t     done = 0;
+  while (done < num_frames)
+    {
+      const auto clip_pos =
+        clip_offset + units::samples (static_cast<int64_t> (done));
+      const auto source_pos = source_position (clip_pos);
+
+      // once silent, the clip stays silent
+      if (!source_pos.has_value ())
+        break;
+
+      const auto len = static_cast<size_t> (std::min (
+        static_cast<int64_t> (std::min (CHUNK_FRAMES, num_frames - done)),
+        contiguous_length (clip_pos, *source_pos)));
+      if (len == 0)
+        break;
+
+      std::span<const float> left;
+      std::span<const float> right;
+      if (frames != nullptr)
+        {
+          const auto start = source_pos->in<int> (units::samples);
+          left = { frames->getReadPointer (0, start), len };
+          right = {
+            frames->getReadPointer (
+              std::min (1, frames->getNumChannels () - 1), start),
+            len
+          };
+        }
+      else
+        {
+          stream->read (
+            *source_pos, { left_chunk.data (), len },
+            { right_chunk.data (), len });
+          left = { left_chunk.data (), len };
+          right = { right_chunk.data (), len };
+        }
+
+      const auto out_left = output_left.subspan (done, len);
+      const auto out_right = output_right.subspan (done, len);
+      if (compute_gains (clip_pos, { gains.data (), len }))
+        {
+          utils::float_ranges::mix_product (out_left, left, gains[0]);
+          utils::float_ranges::mix_product (out_right, right, gains[0]);
+        }
+      else
+        {
+          const std::span<const float> gain_span{ gains.data (), len };
+          utils::float_ranges::mix_product (out_left, left, gain_span);
+          utils::float_ranges::mix_product (out_right, right, gain_span);
+        }
+      done += len;
+    }
+}
+
+juce::Range<float>
+AudioTimelineDataCache::LazyAudioClip::find_source_min_and_max (
+  const AudioPeakSummary &source_peaks,
+  int                     channel,
+  units::sample_t         clip_begin,
+  units::sample_t         clip_end) const
+{
+  std::optional<juce::Range<float>> ret;
+  auto                              clip_pos = clip_begin;
+  while (clip_pos < clip_end)
+    {
+      const auto source_pos = source_position (clip_pos);
+
+      // once silent, the clip stays silent
+      if (!source_pos.has_value ())
+        break;
+
+      const auto len = std::min (
+        (clip_end - clip_pos).in (units::samples),
+        contiguous_length (clip_pos, *source_pos));
+      if (len <= 0)
+        break;
+
+      const auto range = source_peaks.find_min_and_max (
+        channel, *source_pos, *source_pos + units::samples (len));
+      ret = ret.has_value () ? ret->getUnionWith (range) : range;
+      clip_pos += units::samples (len);
+    }
+
+  // silent frames count as 0
+  if (clip_pos < clip_end)
+    ret = ret.has_value () ? ret->getUnionWith (0.f) : juce::Range<float>{};
+
+  return ret.value_or (juce::Range<float>{});
+}
+
+float
+AudioTimelineDataCache::LazyAudioClip::max_gain (
+  units::sample_t clip_begin,
+  units::sample_t clip_end) const
+{
+  if (clip_end <= clip_begin)
+    return 0.f;
+
+  float first{};
+  float last{};
+  compute_gains (clip_begin, { &first, 1 });
+  compute_gains (clip_end - units::samples (1), { &last, 1 });
+  return std::max (first, last);
+}
+
+// ========== AudioClipIntervalIndex Implementation ==========
+
+AudioClipIntervalIndex::AudioClipIntervalIndex (std::span<const Entry> clips)
+    : clips_ (clips.begin (), clips.end ())
+{
+  std::ranges::stable_sort (clips_, {}, &Entry::start_sample);
+
+  clip_indices_.resize (clips_.size ());
+  std::iota (clip_indices_.begin (), clip_indices_.end (), uint32_t{ 0 });
+  if (clips_.empty ())
+    return;
+
+  const auto timeline_end = std::ranges::max (
+    clips_ | std::views::transform ([] (const Entry &clip) {
+      return clip.end_sample.in (units::samples);
+    }));
+  if (timeline_end <= 0)
+    return;
+
+  // a few buckets per clip at most, so the index stays small on long sparse
+  // timelines
+  const auto max_buckets = static_cast<int64_t> (clips_.size ()) * 4 + 64;
+  bucket_frames_ = std::max (
+    MIN_BUCKET_FRAMES, (timeline_end + max_buckets - 1) / max_buckets);
+  const auto num_buckets =
+    static_cast<size_t> ((timeline_end + bucket_frames_ - 1) / bucket_frames_);
+
+  const auto bucket_range = [&] (const Entry &clip) {
+    const auto first = std::max (
+      int64_t{ 0 }, clip.start_sample.in (units::samples) / bucket_frames_);
+    const auto last =
+      (clip.end_sample.in (units::samples) - 1) / bucket_frames_;
+    return std::views::iota (first, std::max (first, last + 1));
+  };
+
+  // count the clips of each bucket, then fill the lists in start order so
+  // that each list is sorted by start position
+  bucket_offsets_.assign (num_buckets + 1, 0);
+  for (const auto &clip : clips_)
+    {
+      if (clip.end_sample <= clip.start_sample)
+        continue;
+      for (const auto bucket : bucket_range (clip))
+        ++bucket_offsets_[static_cast<size_t> (bucket) + 1];
+    }
+  std::partial_sum (
+    bucket_offsets_.begin (), bucket_offsets_.end (), bucket_offsets_.begin ());
+
+  bucket_clip_indices_.resize (bucket_offsets_.back ());
+  auto next_slots = bucket_offsets_;
+  for (const auto index : clip_indices_)
+    {
+      const auto &clip = clips_[index];
+      if (clip.end_sample <= clip.start_sample)
+        continue;
+      for (const auto bucket : bucket_range (clip))
+        {
+          bucket_clip_indices_[next_slots[static_cast<size_t> (bucket)]++] =
+            index;
+        }
+    }
+}
+
+size_t
+AudioClipIntervalIndex::first_starting_at_or_after (
+  units::sample_t pos) const noexcept
+{
+  return static_cast<size_t> (std::ranges::distance (
+    clips_.begin (),
+    std::ranges::lower_bound (clips_, pos, {}, &Entry::start_sample)));
+}
+
+std::array<std::span<const uint32_t>, 2>
+AudioClipIntervalIndex::overlap_candidate_indices (
+  units::sample_t start,
+  units::sample_t end) const noexcept
+{
+  const auto first_frame = std::max (int64_t{ 0 }, start.in (units::samples));
+  const auto bucket = static_cast<size_t> (first_frame / bucket_frames_);
+  if (end <= start || bucket + 1 >= bucket_offsets_.size ())
+    return {};
+
+  // clips overlapping the bucket, up to the first one starting after the range
+  const auto list_begin = bucket_offsets_[bucket];
+  const auto list_size = bucket_offsets_[bucket + 1] - list_begin;
+  auto       overlapping =
+    std::span (bucket_clip_indices_).subspan (list_begin, list_size);
+  const auto overlapping_end = std::ranges::lower_bound (
+    overlapping, end, {},
+    [this] (uint32_t index) { return clips_[index].start_sample; });
+  overlapping = overlapping.first (static_cast<size_t> (
+    std::ranges::distance (overlapping.begin (), overlapping_end)));
+
+  // clips starting after the bucket, if the range continues past it
+  const auto bucket_end = units::samples (
+    (static_cast<int64_t> (bucket) + 1) * bucket_frames_);
+  if (end <= bucket_end)
+    return { overlapping, {} };
+
+  const auto first = first_starting_at_or_after (bucket_end);
+  const auto last = first_starting_at_or_after (end);
+  return {
+    overlapping, std::span (clip_indices_).subspan (first, last - first)
+  };
+}
+
+std::span<const AudioClipIntervalIndex::Entry>
+AudioClipIntervalIndex::clips_starting_in (
+  units::sample_t start,
+  units::sample_t end) const noexcept
+{
+  const auto first = first_starting_at_or_after (start);
+  const auto last = first_starting_at_or_after (end);
+  if (first >= last)
+    return {};
+
+  return std::span (clips_).subspan (first, last - first);
+}
+
 // ========== AutomationTimelineDataCache Implementation ==========
 
 void
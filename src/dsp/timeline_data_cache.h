@@ -3,10 +3,19 @@
 
 #pragma once
 
+#include <array>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <set>
 #include <span>
+#include <vector>
 
+#include "dsp/audio_peak_summary.h"
 #include "dsp/curve.h"
 #include "dsp/midi_event.h"
+#include "dsp/streaming_sample_store.h"
 #include "utils/units.h"
 
 #include <QObject>
@@ -83,6 +92,9 @@ public:
    *
    * Carries the current list of sample intervals that are cached.
    * Used for debug visualization of cache coverage.
+   *
+   * May be emitted from a background thread (see
+   * structure::arrangement::TimelineDataProvider::generate_events()).
    */
   Q_SIGNAL void cachedRangesChanged (std::vector<IntervalType> ranges) const;
 
@@ -173,10 +185,28 @@ private:
   /**
    * @brief Merged MIDI events ready for real-time access.
    *
-   * This is populated during finalize_changes() and contains all MIDI events
+   * This is updated during finalize_changes() and contains all MIDI events
    * from all sequences, properly merged and sorted.
    */
   std::vector<SampleBasedMidiEvent> merged_midi_events_;
+
+  /**
+   * @brief Interval of the sequence each event in @ref merged_midi_events_
+   * comes from.
+   *
+   * Used to remove a sequence's events and to order events at the same
+   * position.
+   */
+  std::vector<IntervalType> merged_event_intervals_;
+
+  /**
+   * @brief Intervals of the sequences added or removed since the last
+   * finalize_changes().
+   *
+   * Only the events of these sequences are spliced into (or out of) the
+   * merged events.
+   */
+  std::set<IntervalType> dirty_intervals_;
 };
 
 /**
@@ -193,6 +223,130 @@ public:
   {
   }
 
+  /**
+   * @brief Describes how to render an audio clip from its source frames
+   * during playback.
+   *
+   * This lets the cache hold only the source material referenced by the clip
+   * instead of the rendered clip, whose size depends on how long the clip is
+   * on the timeline (e.g., a short loop stretched over several minutes).
+   *
+   * All positions are in frames. Positions in the source are relative to the
+   * start of @ref frames (or of the streamed file), positions in the clip are
+   * relative to the clip start.
+   */
+  struct LazyAudioClip
+  {
+    /**
+     * Source frames held in memory.
+     *
+     * Shared with the source (e.g., FileAudioSource::get_shared_samples()),
+     * so the clip positions below are positions in these frames.
+     */
+    std::shared_ptr<const juce::AudioSampleBuffer> frames;
+
+    /** Store to stream the source frames from (if @ref frames is nullptr). */
+    std::shared_ptr<StreamingSampleStore> stream;
+
+    /** Source frame played at the clip start. */
+    units::sample_t clip_start;
+
+    /** Source loop range (only used if @ref looped). */
+    units::sample_t loop_start;
+    units::sample_t loop_end;
+    bool            looped = false;
+
+    /**
+     * Number of source frames available (frames past this are silent).
+     */
+    units::sample_t source_length;
+
+    /**
+     * Length of the rendered content (frames past this are silent).
+     *
+     * Built-in fades are applied at the edges of the content.
+     */
+    units::sample_t content_length;
+
+    float gain = 1.f;
+
+    /** Number of frames of linear fade at each edge of the content. */
+    int builtin_fade_frames = 0;
+
+    /** Object fade in, over the first @ref fade_in_length frames. */
+    units::sample_t fade_in_length;
+    CurveOptions    fade_in_opts;
+
+    /**
+     * Object fade out, from @ref fade_out_start for @ref fade_out_length
+     * frames.
+     */
+    units::sample_t fade_out_start;
+    units::sample_t fade_out_length;
+    CurveOptions    fade_out_opts;
+
+    /**
+     * @brief Renders the clip frames starting at @p clip_offset and adds them
+     * to the outputs.
+     *
+     * Streamed frames that are not loaded yet are silent (see
+     * StreamingSampleStore::read()).
+     */
+    void mix (
+      units::sample_t  clip_offset,
+      std::span<float> output_left,
+      std::span<float> output_right) const noexcept [[clang::nonblocking]];
+
+    /**
+     * @brief Returns the minimum and maximum of channel @p channel of the
+     * source frames played in [@p clip_begin, @p clip_end), looked up in
+     * @p source_peaks instead of reading the source frames.
+     *
+     * Gain and fades are not applied (see max_gain()).
+     */
+    juce::Range<float> find_source_min_and_max (
+      const AudioPeakSummary &source_peaks,
+      int                     channel,
+      units::sample_t         clip_begin,
+      units::sample_t         clip_end) const;
+
+    /**
+     * @brief Returns the largest gain applied to the clip frames in
+     * [@p clip_begin, @p clip_end).
+     *
+     * The range is assumed to be short enough for fades to be monotonic
+     * over it.
+     */
+    float max_gain (units::sample_t clip_begin, units::sample_t clip_end) const;
+
+  private:
+    /**
+     * @brief Returns the source frame for the given clip frame, or nullopt if
+     * the clip frame is silent.
+     */
+    std::optional<units::sample_t>
+    source_position (units::sample_t clip_pos) const noexcept
+      [[clang::nonblocking]];
+
+    /**
+     * @brief Returns the number of clip frames from @p clip_pos that map to
+     * consecutive source frames.
+     */
+    int64_t contiguous_length (
+      units::sample_t clip_pos,
+      units::sample_t source_pos) const noexcept [[clang::nonblocking]];
+
+    /**
+     * @brief Fills @p gains with the gain of each clip frame starting at
+     * @p clip_pos.
+     *
+     * @return Whether the gain is constant over @p gains (in which case only
+     * the first element is written).
+     */
+    bool compute_gains (units::sample_t clip_pos, std::span<float> gains)
+      const noexcept [[clang::nonblocking]];
+  };
+
   /**
    * @brief Audio clip entry for caching.
    *
@@ -202,7 +356,7 @@ public:
    */
   struct AudioClipEntry
   {
-    /** Copy of the audio sample buffer. */
+    /** Copy of the rendered audio (empty for lazy clips). */
     juce::AudioSampleBuffer audio_buffer;
 
     /** Start position in samples. */
@@ -210,6 +364,18 @@ public:
 
     /** End position in samples. */
     units::sample_t end_sample;
+
+    /** Source and parameters of lazy clips. */
+    LazyAudioClip lazy;
+
+    /**
+     * @brief Whether the clip is rendered during playback from @ref lazy
+     * instead of being stored in @ref audio_buffer.
+     */
+    bool is_lazy () const
+    {
+      return lazy.frames != nullptr || lazy.stream != nullptr;
+    }
   };
 
   /**
@@ -222,6 +388,15 @@ public:
     IntervalType                   interval,
     const juce::AudioSampleBuffer &audio_buffer);
 
+  /**
+   * @brief Adds an audio clip that is rendered from its source frames during
+   * playback.
+   *
+   * @param interval The time interval (in samples).
+   * @param clip The clip's source and parameters.
+   */
+  void add_lazy_audio_clip (IntervalType interval, LazyAudioClip clip);
+
   /**
    * @brief Gets the cached audio clips.
    *
@@ -245,6 +420,96 @@ private:
   std::vector<AudioClipEntry> audio_clips_;
 };
 
+/**
+ * @brief Realtime lookup structure for the audio clips overlapping a block.
+ *
+ * The timeline is split into fixed-size buckets, and each bucket keeps the
+ * list of the clips overlapping it (sorted by start position). The clips
+ * overlapping a block are found in the list of the bucket containing the
+ * block start, plus the clips starting in the rest of the block, so the
+ * per-block cost only depends on the number of clips around the block,
+ * regardless of how long the clips before it are.
+ */
+class AudioClipIntervalIndex
+{
+public:
+  using Entry = AudioTimelineDataCache::AudioClipEntry;
+
+  /**
+   * @brief Minimum number of frames covered by each bucket.
+   *
+   * Buckets get longer on long timelines with few clips, so the index size
+   * stays proportional to the number of clips.
+   */
+  static constexpr int64_t MIN_BUCKET_FRAMES = 2048;
+
+  AudioClipIntervalIndex () = default;
+
+  /**
+   * @brief Builds the index from the given clips (in any order).
+   */
+  explicit AudioClipIntervalIndex (std::span<const Entry> clips);
+
+  /**
+   * @brief Returns the clips (sorted by start position).
+   */
+  std::span<const Entry> clips () const { return clips_; }
+
+  /**
+   * @brief Returns the clips that may overlap [@p start, @p end).
+   *
+   * The returned range contains all the overlapping clips (each once), but
+   * may also contain clips that end before @p start in the same bucket, so
+   * callers still need to check each clip.
+   */
+  auto find_overlap_candidates (
+    units::sample_t start,
+    units::sample_t end) const noexcept [[clang::nonblocking]]
+  {
+    return overlap_candidate_indices (start, end) | std::views::join
+           | std::views::transform ([this] (uint32_t index) -> const Entry & {
+               return clips_[index];
+             });
+  }
+
+  /**
+   * @brief Returns the clips starting in [@p start, @p end).
+   */
+  std::span<const Entry>
+  clips_starting_in (units::sample_t start, units::sample_t end) const noexcept
+    [[clang::nonblocking]];
+
+private:
+  /**
+   * @brief Indices of the clips that may overlap [@p start, @p end): the
+   * clips overlapping the bucket containing @p start, followed by the clips
+   * starting after that bucket.
+   */
+  std::array<std::span<const uint32_t>, 2> overlap_candidate_indices (
+    units::sample_t start,
+    units::sample_t end) const noexcept [[clang::nonblocking]];
+
+  /** Index of the first clip starting at or after @p pos. */
+  size_t first_starting_at_or_after (units::sample_t pos) const noexcept
+    [[clang::nonblocking]];
+
+  std::vector<Entry> clips_;
+
+  /** Indices of all the clips (0, 1, 2, ...). */
+  std::vector<uint32_t> clip_indices_;
+
+  /** Number of frames covered by each bucket. */
+  int64_t bucket_frames_ = MIN_BUCKET_FRAMES;
+
+  /**
+   * Indices of the clips overlapping each bucket, sorted by start position.
+   *
+   * The list of bucket `i` is in [bucket_offsets_[i], bucket_offsets_[i + 1]).
+   */
+  std::vector<uint32_t> bucket_clip_indices_;
+  std::vector<uint32_t> bucket_offsets_;
+};
+
 /**
  * @brief Automation-specific timeline data cache.
  *
@@ -16,154 +16,131 @@
 using namespace zrythm;
 using namespace std::chrono_literals;
 
-gui::qquick::QFutureQmlWrapper *
-ProjectExporter::exportAudio (
-  structure::project::Project * project,
-  const QString                &exportDirectory,
-  const QString                &projectTitle)
+namespace
 {
-  dsp::GraphRenderer::RenderOptions options{
-    .sample_rate_ = project->engine ()->sample_rate (),
-    .block_length_ = project->engine ()->block_length ()
+constexpr auto kBitDepth = zrythm::utils::audio::BitDepth::BIT_DEPTH_16;
+
+juce::AudioFormatWriterOptions
+make_writer_options (
+  const structure::project::Project &project,
+  const QString                     &projectTitle)
+{
+  std::unordered_map<juce::String, juce::String> metadata;
+  metadata.emplace (
+    juce::String ("title"),
+    utils::Utf8String::from_qstring (projectTitle).to_juce_string ());
+  metadata.emplace (juce::String ("software"), juce::String (PROGRAM_NAME));
+
+  juce::AudioFormatWriterOptions juce_writer_options;
+  return juce_writer_options
+    .withSampleRate (project.engine ()->sampleRate ())
+    .withNumChannels (2)
+    .withBitsPerSample (utils::audio::bit_depth_enum_to_int (kBitDepth))
+    .withMetadataValues (metadata)
+    .withQualityOptionIndex (0);
+}
+
+dsp::GraphRenderer::StreamingOptions
+make_streaming_options (
+  const juce::AudioFormatWriterOptions &writer_options,
+  std::filesystem::path                 path)
+{
+  return {
+    .write_options_ = { .writer_options_ = writer_options },
+    .file_path_ = std::move (path),
+    .dither_bits_ = utils::audio::bit_depth_enum_to_int (kBitDepth),
   };
-  dsp::AudioEngine::EngineState state{};
-  project->engine ()->wait_for_pause (state, false, true);
-  structure::project::ProjectGraphBuilder builder (
-    *project, project->metronome (), project->monitor_fader ());
-  dsp::graph::Graph graph;
-  builder.build_graph (graph);
+}
 
-  // Prune graph to master output
-  {
-    std::vector<std::reference_wrapper<dsp::graph::GraphNode>> terminals;
-    auto * node = graph.get_nodes ().find_node_for_processable (
-      *project->tracklist ()
-         ->singletonTracks ()
-         ->masterTrack ()
-         ->channel ()
-         ->audioOutPort ());
-    terminals.emplace_back (*node);
-    dsp::graph::GraphPruner::prune_graph_to_terminals (graph, terminals);
-  }
+std::filesystem::path
+make_export_path (
+  const QString           &exportDirectory,
+  const utils::Utf8String &file_name)
+{
+  return utils::Utf8String::from_qstring (exportDirectory).to_path ()
+         / utils::Utf8String::from_juce_string (
+             juce::File::createLegalFileName (file_name.to_juce_string ()))
+             .to_path ();
+}
+
+dsp::GraphRenderer::RunOnMainThread
+run_on_project_thread (structure::project::Project * project)
+{
+  return [context = project] (std::function<void ()> func) {
+    QMetaObject::invokeMethod (context, func, Qt::BlockingQueuedConnection);
+  };
+}
 
+dsp::GraphRenderer::SampleRange
+get_export_range (const structure::project::Project &project)
+{
   const auto * marker_track =
-    project->tracklist ()->singletonTracks ()->markerTrack ();
-  auto graph_render_future = dsp::GraphRenderer::render_async (
-    options, graph.steal_nodes (),
-    [context = project] (std::function<void ()> func) {
-      QMetaObject::invokeMethod (context, func, Qt::BlockingQueuedConnection);
+    project.tracklist ()->singletonTracks ()->markerTrack ();
+  return std::make_pair (
+    project.tempo_map ().tick_to_samples_rounded (
+      marker_track->get_start_marker ()->position ()->asTick ()),
+    project.tempo_map ().tick_to_samples_rounded (
+      marker_track->get_end_marker ()->position ()->asTick ()));
+}
+
+/**
+ * @brief Forwards the progress of @p graph_render_future to the returned
+ * wrapper (whose result is the list of written files) and resumes the engine
+ * once the render is over.
+ */
+gui::qquick::QFutureQmlWrapper *
+wrap_render_future (
+  structure::project::Project             *project,
+  dsp::AudioEngine::EngineState            state,
+  QFuture<dsp::GraphRenderer::RenderStats> graph_render_future,
+  QStringList                              paths)
+{
+  auto combined_future = QtConcurrent::run (
+    [paths] (
+      QPromise<QStringList>                   &promise,
+      QFuture<dsp::GraphRenderer::RenderStats> inner_graph_render_future) {
+      // Wait for task to establish its progress min/max
+      while (
+        inner_graph_render_future.progressMaximum () <= 0
+        && !inner_graph_render_future.isFinished ())
+        {
+          std::this_thread::sleep_for (1ms);
+        }
+
+      promise.setProgressRange (
+        inner_graph_render_future.progressMinimum (),
+        inner_graph_render_future.progressMaximum ());
+      while (!inner_graph_render_future.isFinished ())
+        {
+          std::this_thread::sleep_for (5ms);
+          promise.setProgressValueAndText (
+            inner_graph_render_future.progressValue (),
+            inner_graph_render_future.progressText ());
+          if (promise.isCanceled ())
+            {
+              inner_graph_render_future.cancel ();
+            }
+        }
+
+      if (
+        inner_graph_render_future.isValid ()
+        && inner_graph_render_future.isResultReadyAt (0))
+        {
+          const auto stats = inner_graph_render_future.result ();
+          z_info (
+            "Exported {} file(s) of {} frames in {:.2f} seconds ({:.1f}x "
+            "realtime)",
+            paths.size (), stats.frames_rendered_, stats.elapsed_seconds_,
+            stats.realtime_factor_);
+          promise.addResult (paths);
+        }
+      else
+        {
+          z_debug ("cancelled or failed");
+          promise.future ().cancel ();
+        }
     },
-    std::make_pair (
-      project->tempo_map ().tick_to_samples_rounded (
-        marker_track->get_start_marker ()->position ()->asTick ()),
-      project->tempo_map ().tick_to_samples_rounded (
-        marker_track->get_end_marker ()->position ()->asTick ())),
-    project->tempo_map ());
-
-  auto combined_future =
-    QtConcurrent::run (
-      [title = projectTitle, sample_rate = project->engine ()->sampleRate (),
-       exports_path =
-         utils::Utf8String::from_qstring (exportDirectory).to_path ()] (
-        QPromise<QStringList>           &promise,
-        QFuture<juce::AudioSampleBuffer> inner_graph_render_future) {
-        // Wait for task to establish its progress min/max
-        while (inner_graph_render_future.progressMaximum () <= 0)
-          {
-            std::this_thread::sleep_for (1ms);
-          }
-
-        const auto render_task_progress_range = std::make_pair (
-          inner_graph_render_future.progressMinimum (),
-          inner_graph_render_future.progressMaximum ());
-        const auto write_to_file_task_additional_progress = static_cast<int> (
-          (render_task_progress_range.second - render_task_progress_range.first)
-          * 0.1);
-        promise.setProgressRange (
-          inner_graph_render_future.progressMinimum (),
-          inner_graph_render_future.progressMaximum ()
-            + write_to_file_task_additional_progress);
-        while (!inner_graph_render_future.isFinished ())
-          {
-            std::this_thread::sleep_for (5ms);
-            promise.setProgressValueAndText (
-              inner_graph_render_future.progressValue (),
-              inner_graph_render_future.progressText ());
-            if (promise.isCanceled ())
-              {
-                inner_graph_render_future.cancel ();
-              }
-          }
-
-        if (
-          inner_graph_render_future.isValid ()
-          && inner_graph_render_future.isResultReadyAt (0))
-          {
-            std::unordered_map<juce::String, juce::String> metadata;
-            metadata.emplace (
-              juce::String ("title"),
-              utils::Utf8String::from_qstring (title).to_juce_string ());
-            metadata.emplace (
-              juce::String ("software"), juce::String (PROGRAM_NAME));
-
-            juce::AudioFormatWriterOptions juce_writer_options;
-            juce_writer_options =
-              juce_writer_options.withSampleRate (sample_rate)
-                .withNumChannels (2)
-                .withBitsPerSample (
-                  utils::audio::bit_depth_enum_to_int (
-                    zrythm::utils::audio::BitDepth::BIT_DEPTH_16))
-                .withMetadataValues (metadata)
-                .withQualityOptionIndex (0);
-            utils::AudioFileWriter::WriteOptions write_options{
-              .writer_options_ = juce_writer_options,
-              .block_length_ = units::samples (4096)
-            };
-            const auto path =
-              exports_path
-              / (utils::Utf8String::from_qstring (title) + u8"- Mixdown.wav")
-                  .to_path ();
-            auto file_write_future = utils::AudioFileWriter::write_async (
-              write_options, path, inner_graph_render_future.takeResult ());
-
-            // Wait for task to establish its progress min/max
-            while (file_write_future.progressMaximum () <= 0)
-              {
-                std::this_thread::sleep_for (1ms);
-              }
-
-            const auto file_write_progress_range = std::make_pair (
-              file_write_future.progressMinimum (),
-              file_write_future.progressMaximum ());
-            while (!file_write_future.isFinished ())
-              {
-                std::this_thread::sleep_for (5ms);
-                const auto progress_in_file_write =
-                  file_write_future.progressValue ();
-                const auto current_progress_ratio_in_file_write =
-                  static_cast<double>(progress_in_file_write - file_write_progress_range.first) / (file_write_progress_range.second - file_write_progress_range.first);
-                promise.setProgressValueAndText (
-                  render_task_progress_range.second
-                    + static_cast<int> (
-                      write_to_file_task_additional_progress
-                      * current_progress_ratio_in_file_write),
-                  file_write_future.progressText ());
-                if (promise.isCanceled ())
-                  {
-                    file_write_future.cancel ();
-                    return;
-                  }
-              }
-            promise.addResult (
-              QStringList{ utils::Utf8String::from_path (path).to_qstring () });
-          }
-        else
-          {
-            z_debug ("cancelled or failed");
-            promise.future ().cancel ();
-          }
-      },
-      graph_render_future);
+    graph_render_future);
 
   const auto resume_engine = [engine = project->engine (), state] () {
     // FIXME: this is needed because node caches are not per-graph and
@@ -197,3 +174,114 @@ ProjectExporter::exportAudio (
 
   return future_qml_wrapper;
 }
+}
+
+gui::qquick::QFutureQmlWrapper *
+ProjectExporter::exportAudio (
+  structure::project::Project * project,
+  const QString                &exportDirectory,
+  const QString                &projectTitle)
+{
+  dsp::GraphRenderer::RenderOptions options{
+    .sample_rate_ = project->engine ()->sample_rate (),
+    .block_length_ = project->engine ()->block_length ()
+  };
+  dsp::AudioEngine::EngineState state{};
+  project->engine ()->wait_for_pause (state, false, true);
+  structure::project::ProjectGraphBuilder builder (
+    *project, project->metronome (), project->monitor_fader ());
+  dsp::graph::Graph graph;
+  builder.build_graph (graph);
+
+  // Prune graph to master output
+  {
+    std::vector<std::reference_wrapper<dsp::graph::GraphNode>> terminals;
+    auto * node = graph.get_nodes ().find_node_for_processable (
+      *project->tracklist ()
+         ->singletonTracks ()
+         ->masterTrack ()
+         ->channel ()
+         ->audioOutPort ());
+    terminals.emplace_back (*node);
+    dsp::graph::GraphPruner::prune_graph_to_terminals (graph, terminals);
+  }
+
+  // Output file setup
+  const auto path = make_export_path (
+    exportDirectory,
+    utils::Utf8String::from_qstring (projectTitle) + u8"- Mixdown.wav");
+
+  // Render directly to the file
+  auto graph_render_future = dsp::GraphRenderer::render_to_file_async (
+    options,
+    make_streaming_options (make_writer_options (*project, projectTitle), path),
+    graph.steal_nodes (), run_on_project_thread (project),
+    get_export_range (*project), project->tempo_map ());
+
+  return wrap_render_future (
+    project, state, graph_render_future,
+    { utils::Utf8String::from_path (path).to_qstring () });
+}
+
+gui::qquick::QFutureQmlWrapper *
+ProjectExporter::exportStems (
+  structure::project::Project * project,
+  const QString                &exportDirectory,
+  const QString                &projectTitle)
+{
+  dsp::GraphRenderer::RenderOptions options{
+    .sample_rate_ = project->engine ()->sample_rate (),
+    .block_length_ = project->engine ()->block_length ()
+  };
+  dsp::AudioEngine::EngineState state{};
+  project->engine ()->wait_for_pause (state, false, true);
+  structure::project::ProjectGraphBuilder builder (
+    *project, project->metronome (), project->monitor_fader ());
+  dsp::graph::Graph graph;
+  builder.build_graph (graph);
+
+  // One file per track with an audio output (the master track is the
+  // mixdown)
+  const auto writer_options = make_writer_options (*project, projectTitle);
+  const auto * master_track =
+    project->tracklist ()->singletonTracks ()->masterTrack ();
+  std::vector<dsp::GraphRenderer::StemOutput> stems;
+  QStringList                                 paths;
+  for (const auto &track_ref : project->tracklist ()->collection ()->tracks ())
+    {
+      const auto * track = track_ref.get ();
+      if (
+        track == master_track || track->channel () == nullptr
+        || track->channel ()->audioOutPort () == nullptr)
+        continue;
+
+      const auto path = make_export_path (
+        exportDirectory,
+        utils::Utf8String::from_qstring (projectTitle) + u8" - "
+          + track->get_name () + u8".wav");
+      stems.push_back (
+        { .port_ = track->channel ()->audioOutPort (),
+          .streaming_options_ =
+            make_streaming_options (writer_options, path) });
+      paths.append (utils::Utf8String::from_path (path).to_qstring ());
+    }
+
+  // Render all stems in one pass (this prunes the graph to the stem ports)
+  QFuture<dsp::GraphRenderer::RenderStats> graph_render_future;
+  try
+    {
+      graph_render_future = dsp::GraphRenderer::render_stems_to_files_async (
+        options, std::move (stems), graph, run_on_project_thread (project),
+        get_export_range (*project), project->tempo_map ());
+    }
+  catch (const std::invalid_argument &e)
+    {
+      z_warning ("Cannot export stems: {}", e.what ());
+      graph_render_future =
+        QtFuture::makeExceptionalFuture<dsp::GraphRenderer::RenderStats> (
+          std::current_exception ());
+    }
+
+  return wrap_render_future (
+    project, state, graph_render_future, std::move (paths));
+}
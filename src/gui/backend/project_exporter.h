@@ -21,4 +21,14 @@ public:
     zrythm::structure::project::Project * project,
     const QString                        &exportDirectory,
     const QString                        &projectTitle);
+
+  /**
+   * @brief Exports each track (except the master track) to its own file.
+   *
+   * All the tracks are rendered in a single pass.
+   */
+  Q_INVOKABLE static zrythm::gui::qquick::QFutureQmlWrapper * exportStems (
+    zrythm::structure::project::Project * project,
+    const QString                        &exportDirectory,
+    const QString                        &projectTitle);
 };
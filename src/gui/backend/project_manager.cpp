@@ -229,7 +229,8 @@ ProjectManager::createNewProject (
             project_dir_path] (utils::QObjectUniquePtr<ProjectSession> session) {
       auto future = controllers::ProjectSaver::save (
         *session->project (), *session->uiState (), *session->undoStack (),
-        zrythm::Zrythm::get_app_version (), project_dir_path, false);
+        zrythm::Zrythm::get_app_version (), project_dir_path, false,
+        session->file_encoding ());
       try
         {
           // This will throw on failure
@@ -369,10 +370,12 @@ ProjectManager::loadProject (const QString &filepath)
               auto project_session = utils::make_qobject_unique<ProjectSession> (
                 app_settings_, std::move (prj));
 
-              // Deserialize JSON into Project, ProjectUiState, and UndoStack
+              // Deserialize JSON into Project, ProjectUiState, and UndoStack.
+              // Plugins are instantiated after the project is shown.
               controllers::ProjectLoader::deserialize (
                 load_result.json, *project_session->project (),
-                *project_session->uiState (), *project_session->undoStack ());
+                *project_session->uiState (), *project_session->undoStack (),
+                controllers::ProjectLoader::PluginInstantiation::Deferred);
 
               promise.setProgressValueAndText (
                 kStage3End, tr ("Setting up project..."));
@@ -380,6 +383,9 @@ ProjectManager::loadProject (const QString &filepath)
               // Set title from loaded project
               project_session->setTitle (load_result.title.to_qstring ());
 
+              // Keep saving in the encoding of the loaded file
+              project_session->set_file_encoding (load_result.encoding);
+
               // Initialize clip editor
               project_session->uiState ()->clipEditor ()->init ();
 
@@ -389,6 +395,10 @@ ProjectManager::loadProject (const QString &filepath)
               session->setProjectDirectory (
                 utils::Utf8String::from_path (project_dir).to_qstring ());
 
+              // Journal changes on top of the loaded file
+              session->start_journal (
+                load_result.file_hash, load_result.num_journal_entries > 0);
+
               // Set as active project
               setActiveSession (session);
 
@@ -420,6 +430,11 @@ ProjectManager::loadProject (const QString &filepath)
 
               session->project ()->engine ()->set_running (true);
 
+              // Instantiate plugins in the background (they pass their input
+              // through until ready)
+              session->pluginInstantiationQueue ()->enqueue_deferred_plugins (
+                *session->project ());
+
               // Add to recent projects
               recent_projects_model_->addRecentProject (
                 utils::Utf8String::from_path (project_dir).to_qstring ());
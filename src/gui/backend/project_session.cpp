@@ -14,6 +14,7 @@
 
 #include <QPointer>
 #include <QQmlEngine>
+#include <QThread>
 
 namespace zrythm::gui
 {
@@ -124,6 +125,13 @@ ProjectSession::ProjectSession (
   recording_coordinator_ =
     utils::make_qobject_unique<controllers::RecordingCoordinator> (this);
 
+  plugin_instantiation_queue_ =
+    utils::make_qobject_unique<controllers::PluginInstantiationQueue> (
+      QThread::idealThreadCount (), this);
+  QObject::connect (
+    plugin_instantiation_queue_.get (),
+    &controllers::PluginInstantiationQueue::pluginsReady, this, recalc_graph);
+
   // The recording callback captures a raw pointer to the coordinator.
   // This is safe because ~ProjectSession() deactivates the engine (stopping
   // all audio callbacks) before member destruction begins, so the coordinator
@@ -379,10 +387,43 @@ ProjectSession::ProjectSession (
         static_cast<int> (RecordingMode::TakesMuted)));
     },
     this);
+
+  journal_timer_ = utils::make_qobject_unique<QTimer> (this);
+  QObject::connect (
+    journal_timer_.get (), &QTimer::timeout, this,
+    &ProjectSession::write_journal_entry);
+  QObject::connect (
+    undo_stack_.get (), &undo::UndoStack::indexChanged, this,
+    [this] () { has_unjournaled_changes_ = true; });
+  const auto set_journal_interval = [this] (int seconds) {
+    if (seconds > 0)
+      journal_timer_->start (std::chrono::seconds (seconds));
+    else
+      journal_timer_->stop ();
+  };
+  set_journal_interval (app_settings_.journalInterval ());
+  QObject::connect (
+    &app_settings_, &utils::AppSettings::journalIntervalChanged, this,
+    set_journal_interval);
+
+  setFileEncoding (app_settings_.projectFileEncoding ());
 }
 
 ProjectSession::~ProjectSession ()
 {
+  // changes that were not saved are discarded when the project is closed
+  if (journal_ != nullptr)
+    {
+      try
+        {
+          journal_->remove ();
+        }
+      catch (const ZrythmException &e)
+        {
+          z_warning ("{}", e.what ());
+        }
+    }
+
   project_->engine ()->deactivate ();
   recording_materializer_.reset ();
 }
@@ -421,6 +462,38 @@ ProjectSession::setProjectDirectory (const QString &directory)
   Q_EMIT projectDirectoryChanged (directory);
 }
 
+int
+ProjectSession::fileEncoding () const
+{
+  return static_cast<int> (file_encoding_);
+}
+
+void
+ProjectSession::setFileEncoding (int encoding)
+{
+  using Encoding = controllers::ProjectJsonSerializer::Encoding;
+  if (
+    encoding < static_cast<int> (Encoding::Json)
+    || encoding > static_cast<int> (Encoding::Cbor))
+    {
+      z_warning ("Invalid project file encoding {}", encoding);
+      return;
+    }
+
+  set_file_encoding (static_cast<Encoding> (encoding));
+}
+
+void
+ProjectSession::set_file_encoding (
+  controllers::ProjectJsonSerializer::Encoding encoding)
+{
+  if (file_encoding_ == encoding)
+    return;
+
+  file_encoding_ = encoding;
+  Q_EMIT fileEncodingChanged (fileEncoding ());
+}
+
 structure::project::Project *
 ProjectSession::project () const
 {
@@ -499,6 +572,12 @@ ProjectSession::recordingCoordinator () const
   return recording_coordinator_.get ();
 }
 
+controllers::PluginInstantiationQueue *
+ProjectSession::pluginInstantiationQueue () const
+{
+  return plugin_instantiation_queue_.get ();
+}
+
 actions::ArrangerObjectSelectionOperator *
 ProjectSession::createArrangerObjectSelectionOperator (
   QItemSelectionModel * selectionModel) const
@@ -606,14 +685,83 @@ ProjectSession::get_newer_backup ()
   return result;
 }
 
+std::filesystem::path
+ProjectSession::journal_path (
+  const std::filesystem::path &project_directory) const
+{
+  return project_directory
+         / structure::project::ProjectPathProvider::get_path (
+           structure::project::ProjectPathProvider::ProjectPath::JournalFile);
+}
+
+void
+ProjectSession::create_journal (const std::filesystem::path &project_directory)
+{
+  journal_ = std::make_shared<controllers::ProjectJournal> (
+    journal_path (project_directory));
+  project_->get_project_registry ().start_change_tracking ();
+}
+
+void
+ProjectSession::start_journal (utils::hash::HashT file_hash, bool recovered)
+{
+  assert (!project_directory_.empty ());
+
+  create_journal (project_directory_);
+  const auto revision = journal_->next_revision ();
+  if (recovered)
+    {
+      journal_->resume (revision);
+      return;
+    }
+
+  try
+    {
+      journal_->reset (file_hash, revision);
+    }
+  catch (const ZrythmException &e)
+    {
+      z_warning ("Failed to start project journal: {}", e.what ());
+    }
+}
+
+void
+ProjectSession::write_journal_entry ()
+{
+  if (journal_ == nullptr || project_->getTransport ()->isRolling ())
+    return;
+
+  const auto changes = project_->get_project_registry ().take_changes ();
+  if (!has_unjournaled_changes_ && changes.empty ())
+    return;
+
+  has_unjournaled_changes_ = false;
+  try
+    {
+      // the returned future reports errors itself
+      std::ignore = controllers::ProjectSaver::write_journal_entry (
+        *project_, *ui_state_, *undo_stack_, title_.view (), changes,
+        journal_);
+    }
+  catch (const std::exception &e)
+    {
+      z_warning ("Failed to serialize project for journal: {}", e.what ());
+    }
+}
+
 gui::qquick::QFutureQmlWrapper *
 ProjectSession::save ()
 {
   assert (!project_directory_.empty ());
 
+  if (journal_ == nullptr)
+    {
+      create_journal (project_directory_);
+    }
+
   auto future = controllers::ProjectSaver::save (
     *project_, *ui_state_, *undo_stack_, zrythm::Zrythm::get_app_version (),
-    project_directory_, false);
+    project_directory_, false, file_encoding_, journal_);
 
   auto * wrapper = new gui::qquick::QFutureQmlWrapperT<QString> (future);
   QQmlEngine::setObjectOwnership (wrapper, QQmlEngine::JavaScriptOwnership);
@@ -626,9 +774,23 @@ ProjectSession::saveAs (const QString &path)
 {
   auto new_path = utils::Utf8String::from_qstring (path).to_path ();
 
+  // the changes journaled in the old directory end up in the new project
+  if (journal_ != nullptr)
+    {
+      try
+        {
+          journal_->remove ();
+        }
+      catch (const ZrythmException &e)
+        {
+          z_warning ("{}", e.what ());
+        }
+    }
+  create_journal (new_path);
+
   auto future = controllers::ProjectSaver::save (
     *project_, *ui_state_, *undo_stack_, zrythm::Zrythm::get_app_version (),
-    new_path, false);
+    new_path, false, file_encoding_, journal_);
 
   auto * wrapper = new gui::qquick::QFutureQmlWrapperT<QString> (future);
 
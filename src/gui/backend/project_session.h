@@ -11,6 +11,9 @@
 #include "actions/plugin_operator.h"
 #include "actions/track_creator.h"
 #include "actions/uuid_property_operator.h"
+#include "controllers/plugin_instantiation_queue.h"
+#include "controllers/project_journal.h"
+#include "controllers/project_json_serializer.h"
 #include "controllers/recording_coordinator.h"
 #include "controllers/recording_materializer.h"
 #include "controllers/transport_controller.h"
@@ -20,6 +23,7 @@
 #include "structure/project/project_ui_state.h"
 #include "undo/undo_stack.h"
 
+#include <QTimer>
 #include <QtQmlIntegration/qqmlintegration.h>
 
 namespace zrythm::gui::old_dsp
@@ -76,9 +80,15 @@ class ProjectSession : public QObject
   Q_PROPERTY (
     zrythm::controllers::TransportController * transportController READ
       transportController CONSTANT FINAL)
+  Q_PROPERTY (
+    zrythm::controllers::PluginInstantiationQueue * pluginInstantiationQueue
+      READ pluginInstantiationQueue CONSTANT FINAL)
   Q_PROPERTY (
     QString projectDirectory READ projectDirectory WRITE setProjectDirectory
       NOTIFY projectDirectoryChanged FINAL)
+  Q_PROPERTY (
+    int fileEncoding READ fileEncoding WRITE setFileEncoding NOTIFY
+      fileEncodingChanged FINAL)
   QML_ELEMENT
   QML_UNCREATABLE ("")
 
@@ -106,11 +116,37 @@ public:
   actions::UuidPropertyOperator *          uuidPropertyOperator () const;
   controllers::TransportController *       transportController () const;
   controllers::RecordingCoordinator *      recordingCoordinator () const;
+  controllers::PluginInstantiationQueue *  pluginInstantiationQueue () const;
 
   Q_INVOKABLE actions::ArrangerObjectSelectionOperator *
               createArrangerObjectSelectionOperator (
                 QItemSelectionModel * selectionModel) const;
 
+  /**
+   * @brief Encoding the project file (and its backups) are saved in, as a
+   * controllers::ProjectJsonSerializer::Encoding value.
+   *
+   * New projects use the projectFileEncoding setting, loaded projects keep
+   * the encoding of their project file. Changing it converts the project file
+   * on the next save.
+   */
+  int  fileEncoding () const;
+  void setFileEncoding (int encoding);
+
+  auto file_encoding () const { return file_encoding_; }
+  void
+  set_file_encoding (controllers::ProjectJsonSerializer::Encoding encoding);
+
+  /**
+   * @brief Starts journaling changes on top of the loaded project file.
+   *
+   * @param file_hash Hash of the uncompressed project file contents.
+   * @param recovered Whether journal entries were replayed (in which case the
+   * existing journal is continued).
+   * @pre projectDirectory must be set.
+   */
+  void start_journal (utils::hash::HashT file_hash, bool recovered);
+
   /**
    * @brief Saves the project to the current project directory.
    *
@@ -142,6 +178,7 @@ public:
 Q_SIGNALS:
   void titleChanged (const QString &title);
   void projectDirectoryChanged (const QString &directory);
+  void fileEncodingChanged (int encoding);
 
 private:
   /**
@@ -157,12 +194,36 @@ private:
    */
   void wire_chord_track_to_pad_bank ();
 
+  std::filesystem::path
+  journal_path (const std::filesystem::path &project_directory) const;
+
+  /**
+   * @brief Creates the journal in @p project_directory and starts tracking
+   * the registry objects that change.
+   */
+  void create_journal (const std::filesystem::path &project_directory);
+
+  /**
+   * @brief Journals the changes made since the last entry, if any.
+   *
+   * Skipped while the transport is rolling, since most changes during
+   * playback (e.g. automation) are not edits.
+   */
+  void write_journal_entry ();
+
   utils::AppSettings &app_settings_;
 
   // Project title and directory
   utils::Utf8String     title_;
   std::filesystem::path project_directory_;
 
+  controllers::ProjectJsonSerializer::Encoding file_encoding_{};
+
+  // Changes since the last save (for crash recovery)
+  std::shared_ptr<controllers::ProjectJournal> journal_;
+  utils::QObjectUniquePtr<QTimer>              journal_timer_;
+  bool                                         has_unjournaled_changes_{};
+
   // Core project data
   utils::QObjectUniquePtr<structure::project::Project> project_;
 
@@ -192,6 +253,10 @@ private:
     recording_coordinator_;
   utils::QObjectUniquePtr<controllers::RecordingMaterializer>
     recording_materializer_;
+
+  // Instantiates plugins deferred while loading
+  utils::QObjectUniquePtr<controllers::PluginInstantiationQueue>
+    plugin_instantiation_queue_;
 };
 
 } // namespace zrythm::gui
@@ -330,7 +330,7 @@ Control {
         } else {
           c = palette.text;
         }
-        if (!root.pluginEnabled) {
+        if (!root.pluginEnabled || (root.plugin && root.plugin.instantiationStatus === Plugin.Pending)) {
           return ZrythmTheme.getColorBlendedTowardsContrast(c);
         }
         return c;
@@ -340,6 +340,8 @@ Control {
         if (root.plugin) {
           if (root.plugin.instantiationStatus === Plugin.Failed) {
             return "(!) " + root.plugin.configuration.descriptor.name;
+          } else if (root.plugin.instantiationStatus === Plugin.Pending) {
+            return root.plugin.configuration.descriptor.name + "…";
           } else {
             return root.plugin.configuration.descriptor.name;
           }
@@ -351,6 +353,14 @@ Control {
   }
 
   ToolTip {
-    text: root.plugin ? root.plugin.configuration.descriptor.name : ""
+    text: {
+      if (!root.plugin) {
+        return "";
+      }
+      if (root.plugin.instantiationStatus === Plugin.Pending) {
+        return qsTr("%1 (loading)").arg(root.plugin.configuration.descriptor.name);
+      }
+      return root.plugin.configuration.descriptor.name;
+    }
   }
 }
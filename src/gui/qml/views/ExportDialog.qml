@@ -24,8 +24,13 @@ Dialog {
   function startExport() {
     exportProgressDialog.resetValues();
     exportProgressDialog.open();
-    root.exportFuture = ProjectExporter.exportAudio(root.project,
-    exportDirectory, session.title);
+    if (audioMixdownOrStems.currentIndex === 1) {
+      root.exportFuture = ProjectExporter.exportStems(root.project,
+      exportDirectory, session.title);
+    } else {
+      root.exportFuture = ProjectExporter.exportAudio(root.project,
+      exportDirectory, session.title);
+    }
   }
 
   implicitHeight: 500
@@ -202,6 +207,8 @@ Dialog {
             title: qsTr("Mixdown or Stems")
 
             ComboBox {
+              id: audioMixdownOrStems
+
               Layout.fillWidth: true
               model: [qsTr("Mixdown"), qsTr("Stems")]
             }
@@ -1,11 +1,12 @@
 // SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
-#include <algorithm>
-
 #include "gui/qquick/audio_clip_waveform_canvas_item.h"
 #include "structure/arrangement/audio_clip.h"
 #include "structure/arrangement/clip_renderer.h"
+#include "utils/logger.h"
+
+#include <QtConcurrent>
 
 namespace zrythm::gui::qquick
 {
@@ -13,6 +14,7 @@ namespace zrythm::gui::qquick
 AudioClipWaveformCanvasItem::AudioClipWaveformCanvasItem (QQuickItem * parent)
     : WaveformCanvasItem (parent)
 {
+  frames_per_peak_ = dsp::AudioPeakSummary::FRAMES_PER_BLOCK;
 }
 
 auto
@@ -85,62 +87,95 @@ AudioClipWaveformCanvasItem::handle_property_change ()
   if (current == last_snapshot_)
     return;
 
-  const auto prev_samples = audio_buffer_.getNumSamples ();
-  const auto new_samples = static_cast<int> (current.length_samples);
-
-  // Fast path: if only the clip length grew (no structural changes
-  // to loop, fades, or gain), serialize only the new portion and
-  // append it to the existing buffer instead of re-reading the
-  // entire clip.
-  if (
-    current.clip_start_samples == last_snapshot_.clip_start_samples
-    && current.loop_start_samples == last_snapshot_.loop_start_samples
-    && current.loop_end_samples == last_snapshot_.loop_end_samples
-    && current.fade_in_samples == last_snapshot_.fade_in_samples
-    && current.fade_out_samples == last_snapshot_.fade_out_samples
-    && current.gain == last_snapshot_.gain && new_samples > prev_samples)
+  last_snapshot_ = current;
+  update_source_peaks ();
+}
+
+void
+AudioClipWaveformCanvasItem::update_source_peaks ()
+{
+  const auto &source =
+    audio_clip_->get_children_view ().front ()->file_audio_source ();
+  const auto num_frames = units::samples (source.get_num_frames ());
+  const bool same_source =
+    peaks_source_ == &source && source_peaks_ != nullptr
+    && source_peaks_->num_channels () == source.get_num_channels ();
+  if (same_source && peaks_source_version_ == source.samples_version ())
     {
-      // Compute the absolute timeline tick positions at the old and new
-      // buffer ends. prev_samples/new_samples are relative to the clip
-      // start, so we must add the clip's absolute sample position before
-      // converting to ticks.
-      const auto &tempo_map = audio_clip_->get_tempo_map ();
-      const auto  clip_start_samples =
-        tempo_map.tick_to_samples_rounded (audio_clip_->position ()->asTick ())
-          .in (units::samples);
-      const auto prev_end_tick = tempo_map.samples_to_tick (
-        units::precise_sample_t (
-          units::samples (clip_start_samples + prev_samples)));
-      const auto new_end_tick = tempo_map.samples_to_tick (
-        units::precise_sample_t (
-          units::samples (clip_start_samples + new_samples)));
-
-      juce::AudioSampleBuffer new_data;
-      structure::arrangement::ClipRenderer::serialize_to_buffer (
-        *audio_clip_, new_data, std::make_pair (prev_end_tick, new_end_tick));
-
-      audio_buffer_.setSize (2, new_samples, true, true, false);
-
-      const auto new_data_samples = new_data.getNumSamples ();
-      // The delta window above is derived via a samples→tick→samples
-      // round-trip, which can drift by ±1 sample per leg and make
-      // new_data_samples exceed the room left in the buffer. Clamp the copy
-      // length to the available space to avoid overrunning audio_buffer_.
-      const auto to_copy =
-        std::clamp (new_data_samples, 0, new_samples - prev_samples);
-      for (int ch = 0; ch < 2; ++ch)
-        {
-          audio_buffer_.copyFrom (ch, prev_samples, new_data, ch, 0, to_copy);
-        }
+      serialize_peaks ();
+      return;
     }
-  else
+
+  // Streamed sources are summarized on a worker thread (their frames are
+  // decoded from disk)
+  if (source.is_streaming ())
     {
-      // Structural change (loop, fade, gain, or shrink) — full re-serialize.
-      structure::arrangement::ClipRenderer::serialize_to_buffer (
-        *audio_clip_, audio_buffer_);
+      // already being summarized
+      if (peaks_source_ == &source && source_peaks_ == nullptr)
+        return;
+
+      const auto generation = ++source_peaks_generation_;
+      peaks_source_ = &source;
+      peaks_source_version_ = source.samples_version ();
+      source_peaks_.reset ();
+      serialize_peaks ();
+      QtConcurrent::run (
+        [store = source.streaming_store (),
+         num_channels = source.get_num_channels ()] {
+          auto peaks = std::make_shared<dsp::AudioPeakSummary> (num_channels);
+          const auto read =
+            [&] (
+              units::sample_t start, int frames,
+              juce::AudioSampleBuffer &dest) {
+              store->read_blocking (start, frames, dest, 0);
+            };
+          peaks->extend (store->num_frames (), read);
+          return peaks;
+        })
+        .then (this, [this, generation] (
+                       std::shared_ptr<dsp::AudioPeakSummary> peaks) {
+          // superseded by another summary
+          if (generation != source_peaks_generation_)
+            return;
+          source_peaks_ = std::move (peaks);
+          serialize_peaks ();
+        })
+        .onFailed (this, [] (const std::exception &e) {
+          z_warning ("failed to summarize audio source peaks: {}", e.what ());
+        });
+      return;
     }
 
-  last_snapshot_ = current;
+  // In-memory sources only have their new frames summarized when they grew
+  // (e.g., while recording)
+  if (!same_source || num_frames < source_peaks_->num_frames ())
+    {
+      source_peaks_ =
+        std::make_shared<dsp::AudioPeakSummary> (source.get_num_channels ());
+    }
+  ++source_peaks_generation_;
+  peaks_source_ = &source;
+  peaks_source_version_ = source.samples_version ();
+  source_peaks_->extend (
+    num_frames,
+    [&] (units::sample_t start, int frames, juce::AudioSampleBuffer &dest) {
+      source.read_frames (start, frames, dest, 0);
+    });
+  serialize_peaks ();
+}
+
+void
+AudioClipWaveformCanvasItem::serialize_peaks ()
+{
+  if (audio_clip_ != nullptr && source_peaks_ != nullptr)
+    {
+      structure::arrangement::ClipRenderer::serialize_peaks_to_buffer (
+        *audio_clip_, *source_peaks_, frames_per_peak_, audio_buffer_);
+    }
+  else
+    {
+      audio_buffer_ = juce::AudioSampleBuffer ();
+    }
   notifyBufferChanged ();
 }
 
@@ -176,9 +211,7 @@ AudioClipWaveformCanvasItem::setAudioClip (
   if (audio_clip_ != nullptr)
     {
       last_snapshot_ = take_snapshot ();
-      structure::arrangement::ClipRenderer::serialize_to_buffer (
-        *audio_clip_, audio_buffer_);
-      notifyBufferChanged ();
+      update_source_peaks ();
 
       // Re-serialize when loop points or bounds change
       clip_connections_.push_back (
@@ -213,6 +246,9 @@ AudioClipWaveformCanvasItem::setAudioClip (
     {
       audio_buffer_ = juce::AudioSampleBuffer ();
       last_snapshot_ = {};
+      ++source_peaks_generation_;
+      source_peaks_.reset ();
+      peaks_source_ = nullptr;
       notifyBufferChanged ();
     }
 
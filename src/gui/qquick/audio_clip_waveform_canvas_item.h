@@ -4,8 +4,11 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "dsp/audio_peak_summary.h"
+#include "dsp/file_audio_source.h"
 #include "gui/qquick/waveform_canvas_item.h"
 #include "gui/qquick/waveform_canvas_renderer.h"
 #include "structure/arrangement/audio_clip.h"
@@ -27,6 +30,12 @@ namespace zrythm::gui::qquick
  * Handles AudioClip buffer serialization and re-serialization
  * on clip property changes (loop, bounds, fades).
  *
+ * The buffer holds a peak summary of the clip (see
+ * ClipRenderer::serialize_peaks_to_buffer()), derived from a peak summary of
+ * the clip's source, so the clip's audio is never rendered. The source
+ * summary is built one window of frames at a time; streamed sources are
+ * summarized on a worker thread.
+ *
  * Uses a cached snapshot of clip properties to avoid redundant
  * re-serializations when multiple signals fire for the same change.
  */
@@ -108,6 +117,23 @@ private:
 
   ClipSnapshot take_snapshot () const;
 
+  /**
+   * @brief Brings the peaks of the clip's source up to date, then serializes
+   * the clip's peaks.
+   *
+   * In-memory sources are summarized right away (only the frames added since
+   * the last summary if the source grew, e.g. while recording). Streamed
+   * sources are summarized on a worker thread through their page cache, and
+   * the clip's peaks are serialized when done.
+   */
+  void update_source_peaks ();
+
+  /**
+   * @brief Serializes the clip's peaks from @ref source_peaks_ into the
+   * buffer.
+   */
+  void serialize_peaks ();
+
 private Q_SLOTS:
   void handle_property_change ();
 
@@ -117,6 +143,18 @@ private:
   QPointer<QObject>                           tempo_map_;
   std::vector<QMetaObject::Connection>        tempo_map_connections_;
   ClipSnapshot                                last_snapshot_;
+
+  /** Peaks of the clip's source (nullptr while being built). */
+  std::shared_ptr<dsp::AudioPeakSummary> source_peaks_;
+
+  /** Source @ref source_peaks_ summarizes. */
+  QPointer<const dsp::FileAudioSource> peaks_source_;
+
+  /** FileAudioSource::samples_version() of @ref source_peaks_. */
+  uint64_t peaks_source_version_{};
+
+  /** Bumped on each summary started, to drop superseded summaries. */
+  uint64_t source_peaks_generation_{};
 };
 
 } // namespace zrythm::gui::qquick
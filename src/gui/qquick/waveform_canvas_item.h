@@ -47,6 +47,16 @@ public:
     return (audio_buffer_.getNumSamples () > 0) ? &audio_buffer_ : nullptr;
   }
 
+  /**
+   * @brief Number of audio frames summarized by each pair of frames in
+   * audioBuffer().
+   *
+   * 1 if the buffer holds the audio itself. Otherwise each block of this many
+   * frames is stored as its minimum followed by its maximum, which keeps the
+   * buffer small for long clips.
+   */
+  int framesPerPeak () const { return frames_per_peak_; }
+
   /**
    * @brief Monotonically increasing counter bumped on each buffer change.
    *
@@ -65,6 +75,9 @@ protected:
 
   juce::AudioSampleBuffer audio_buffer_;
 
+  /** See framesPerPeak(). */
+  int frames_per_peak_ = 1;
+
 Q_SIGNALS:
   void waveformColorChanged ();
   void outlineColorChanged ();
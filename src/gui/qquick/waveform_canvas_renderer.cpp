@@ -75,10 +75,15 @@ compute_waveform_peaks (
   int                            canvas_width,
   int64_t                        loop_wrap_start,
   int64_t                        loop_wrap_length,
-  bool                           has_loop)
+  bool                           has_loop,
+  int                            frames_per_peak)
 {
   const int     num_channels = buffer.getNumChannels ();
-  const int64_t total_frames = buffer.getNumSamples ();
+  const bool    is_summary = frames_per_peak > 1;
+  const int64_t total_frames =
+    is_summary
+      ? int64_t{ buffer.getNumSamples () / 2 } * frames_per_peak
+      : buffer.getNumSamples ();
 
   if (num_channels == 0 || total_frames == 0 || canvas_width <= 0)
     return {};
@@ -142,12 +147,25 @@ compute_waveform_peaks (
       assert (start_frame >= 0 && start_frame < total_frames);
       assert (start_frame + count <= total_frames);
 
+      // Summaries hold a min/max pair for each block of frames, so the
+      // blocks overlapping the pixel are read instead
+      int64_t first_index = start_frame;
+      int64_t num_indices = count;
+      if (is_summary)
+        {
+          const int64_t first_block = start_frame / frames_per_peak;
+          const int64_t end_block =
+            (start_frame + count + frames_per_peak - 1) / frames_per_peak;
+          first_index = first_block * 2;
+          num_indices = (end_block - first_block) * 2;
+        }
+
       for (const auto ch : std::views::iota (0, num_channels))
         {
           const float * samples =
-            buffer.getReadPointer (ch, static_cast<int> (start_frame));
+            buffer.getReadPointer (ch, static_cast<int> (first_index));
           const auto range = juce::FloatVectorOperations::findMinAndMax (
-            samples, static_cast<int> (count));
+            samples, static_cast<int> (num_indices));
           peaks[ch][px] = {
             .min = (std::clamp (range.getStart (), -1.0f, 1.0f) + 1.0f) * 0.5f,
             .max = (std::clamp (range.getEnd (), -1.0f, 1.0f) + 1.0f) * 0.5f,
@@ -220,6 +238,7 @@ WaveformCanvasRenderer::synchronize (QCanvasPainterItem * item)
   waveform_color_ = waveform_item->waveformColor ();
   outline_color_ = waveform_item->outlineColor ();
   audio_buffer_ = waveform_item->audioBuffer ();
+  frames_per_peak_ = waveform_item->framesPerPeak ();
 
   // Compute per-pixel frame mapping. For audio clips, use non-linear mapping
   // that follows the tempo map's tick-to-sample conversion so the waveform
@@ -264,7 +283,7 @@ WaveformCanvasRenderer::compute_peaks ()
 
   peaks_ = compute_waveform_peaks (
     *audio_buffer_, pixel_frames_, static_cast<int> (canvas_width_),
-    loop_wrap_start_, loop_wrap_length_, has_loop_);
+    loop_wrap_start_, loop_wrap_length_, has_loop_, frames_per_peak_);
   num_channels_ = static_cast<int> (peaks_.size ());
 }
 
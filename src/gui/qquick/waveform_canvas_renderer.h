@@ -89,6 +89,11 @@ compute_timeline_frame_mapping (
 /// @param loop_wrap_length Length of one loop iteration in the buffer.
 /// @param has_loop       Whether to wrap out-of-range pixels into the loop
 ///                         region.
+/// @param frames_per_peak  If greater than 1, @p buffer is a peak summary
+///                         where each block of this many frames is stored as
+///                         its minimum followed by its maximum (see
+///                         WaveformCanvasItem::framesPerPeak()). Frame
+///                         indices and loop positions are still in frames.
 ///
 /// @return Peaks indexed as `[channel][pixel]` — outer dimension is one per
 ///         audio channel, inner dimension is one per pixel column.
@@ -99,7 +104,8 @@ compute_waveform_peaks (
   int                            canvas_width,
   int64_t                        loop_wrap_start,
   int64_t                        loop_wrap_length,
-  bool                           has_loop);
+  bool                           has_loop,
+  int                            frames_per_peak = 1);
 
 /**
  * @brief Renders audio waveform peaks using QCanvasPainter.
@@ -136,6 +142,7 @@ private:
 
   // Cached pointer to the item's serialized audio buffer (owned by the item)
   const juce::AudioSampleBuffer * audio_buffer_ = nullptr;
+  int                             frames_per_peak_ = 1;
 
   // Precomputed per-pixel frame mapping (size = canvas_width + 1)
   std::vector<int64_t> pixel_frames_;
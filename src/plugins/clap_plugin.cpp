@@ -59,6 +59,7 @@
 #include <QSocketNotifier>
 #include <QThread>
 #include <QTimer>
+#include <QtConcurrentRun>
 
 #include <clap/helpers/event-list.hh>
 #include <clap/helpers/host.hxx>
@@ -78,6 +79,20 @@ using ClapPluginProxy = clap::helpers::PluginProxy<
   clap::helpers::MisbehaviourHandler::Terminate,
   clap::helpers::CheckingLevel::Maximal>;
 
+struct ClapPlugin::CreatedPlugin
+{
+  CreatedPlugin () = default;
+  Z_DISABLE_COPY_MOVE (CreatedPlugin)
+  ~CreatedPlugin ();
+
+  std::filesystem::path      path;
+  PluginLibrary              library;
+  const clap_plugin_entry *  entry = nullptr;
+  bool                       entry_initialized = false;
+  const clap_plugin_factory *factory = nullptr;
+  const clap_plugin *        plugin = nullptr;
+};
+
 class ClapPlugin::ClapPluginImpl
 {
   friend class ClapPlugin;
@@ -187,6 +202,15 @@ private:
   const clap_plugin_factory *      pluginFactory_ = nullptr;
   std::unique_ptr<ClapPluginProxy> plugin_;
 
+  /** Plugin creation running on Plugin::instantiation_thread_pool(). */
+  QFuture<std::shared_ptr<CreatedPlugin>> pending_creation_;
+
+  /**
+   * @brief Incremented on each configuration change, so that a creation
+   * superseded before its continuation ran is dropped.
+   */
+  uint64_t creation_generation_ = 0;
+
   /* timers */
   clap_id                                              nextTimerId_ = 0;
   std::unordered_map<clap_id, std::unique_ptr<QTimer>> timers_;
@@ -299,7 +323,12 @@ ClapPlugin::ClapPlugin (
 
 ClapPlugin::~ClapPlugin ()
 {
-  if (pimpl_ && pimpl_->library_.is_loaded ())
+  if (!pimpl_)
+    return;
+
+  // the creation uses our host
+  pimpl_->pending_creation_.waitForFinished ();
+  if (pimpl_->library_.is_loaded ())
     unload_current_plugin ();
 }
 
@@ -311,15 +340,49 @@ ClapPlugin::on_configuration_changed (
   z_debug ("configuration changed");
   const auto &path = std::get<std::filesystem::path> (
     configuration ()->descriptor ()->path_or_id_);
-  auto success = load_plugin (
-    path, configuration ()->descriptor ()->unique_id_,
-    generateNewPluginPortsAndParams);
-  Q_EMIT instantiationFinished (
-    success,
-    success
-      ? QString{}
-      : tr ("Failed to load CLAP plugin from %1")
-          .arg (utils::Utf8String::from_path (path).to_qstring ()));
+  const auto unique_id = configuration ()->descriptor ()->unique_id_;
+  const auto finish = [this, path] (bool success) {
+    Q_EMIT instantiationFinished (
+      success,
+      success
+        ? QString{}
+        : tr ("Failed to load CLAP plugin from %1")
+            .arg (utils::Utf8String::from_path (path).to_qstring ()));
+  };
+
+  // the continuation of a previous creation may still be queued
+  const auto generation = ++pimpl_->creation_generation_;
+  pimpl_->pending_creation_.waitForFinished ();
+  if (pimpl_->library_.is_loaded ())
+    unload_current_plugin ();
+
+  if (configuration ()->requires_main_thread_instantiation ())
+    {
+      finish (load_plugin (path, unique_id, generateNewPluginPortsAndParams));
+      return;
+    }
+
+  // the plugin's init() must be called on the main thread, so only create it
+  // on the pool
+  pimpl_->pending_creation_ = QtConcurrent::run (
+    &instantiation_thread_pool (),
+    [path, unique_id, host = clapHost ()] {
+      return create_plugin_instance (path, unique_id, *host);
+    });
+  pimpl_->pending_creation_.then (
+    this,
+    [this, unique_id, generateNewPluginPortsAndParams, finish,
+     generation] (std::shared_ptr<CreatedPlugin> created) {
+      // superseded by another configuration (the instance is destroyed with
+      // `created`)
+      if (generation != pimpl_->creation_generation_)
+        {
+          z_debug ("dropping stale CLAP plugin instance");
+          return;
+        }
+      finish (init_plugin (
+        std::move (created), unique_id, generateNewPluginPortsAndParams));
+    });
 }
 
 bool
@@ -919,49 +982,108 @@ ClapPlugin::get_single_playback_latency () const
   return pimpl_->latency_;
 }
 
+std::optional<units::sample_u32_t>
+ClapPlugin::get_plugin_tail_length () const noexcept
+{
+  if (
+    !pimpl_->plugin_ || !pimpl_->isPluginActive ()
+    || !pimpl_->plugin_->canUseTail ())
+    return std::nullopt;
+
+  // INT32_MAX or more means infinite
+  const auto tail = pimpl_->plugin_->tailGet ();
+  if (tail >= static_cast<uint32_t> (std::numeric_limits<int32_t>::max ()))
+    return std::nullopt;
+
+  return units::samples (tail);
+}
+
+namespace
+{
+/**
+ * @brief Whether the plugin entry may be initialized from any thread.
+ *
+ * Required as of CLAP 1.2.
+ */
 bool
-ClapPlugin::load_plugin (
-  const std::filesystem::path &path,
-  int64_t                      plugin_unique_id,
-  bool                         generate_new_ports)
+entry_init_is_thread_safe (const clap_version_t &version)
 {
-  assert (is_main_thread);
+  return version.major > 1 || (version.major == 1 && version.minor >= 2);
+}
+}
 
-  if (pimpl_->library_.is_loaded ())
-    unload_current_plugin ();
+ClapPlugin::CreatedPlugin::~CreatedPlugin ()
+{
+  // adopted by a ClapPlugin (or nothing to clean up)
+  if (entry == nullptr)
+    return;
+
+  if (plugin != nullptr)
+    plugin->destroy (plugin);
+  if (entry_initialized)
+    entry->deinit ();
+  library.unload ();
+}
 
-  if (!pimpl_->library_.load (utils::Utf8String::from_path (path)))
+std::shared_ptr<ClapPlugin::CreatedPlugin>
+ClapPlugin::create_plugin_instance (
+  const std::filesystem::path &path,
+  int64_t                      plugin_unique_id,
+  const clap_host_t           &host)
+{
+  auto created = std::make_shared<CreatedPlugin> ();
+  if (!created->library.load (utils::Utf8String::from_path (path)))
     {
       z_warning (
         "Failed to load plugin '{}': {}", path,
-        pimpl_->library_.error_string ());
-      return false;
+        created->library.error_string ());
+      return nullptr;
     }
 
-  pimpl_->pluginEntry_ = reinterpret_cast<const struct clap_plugin_entry *> (
-    pimpl_->library_.resolve ("clap_entry"));
-  if (pimpl_->pluginEntry_ == nullptr)
+  created->entry = reinterpret_cast<const struct clap_plugin_entry *> (
+    created->library.resolve ("clap_entry"));
+  if (created->entry == nullptr)
     {
       z_warning ("Unable to resolve entry point 'clap_entry' in '{}'", path);
-      pimpl_->library_.unload ();
-      return false;
+      created->library.unload ();
+      return nullptr;
     }
+  created->path = path;
+
+  // older plugins are created on the main thread (see create_plugin())
+  if (
+    !is_main_thread
+    && !entry_init_is_thread_safe (created->entry->clap_version))
+    return created;
 
-  if (!pimpl_->pluginEntry_->init (utils::Utf8String::from_path (path).c_str ()))
+  if (!create_plugin (*created, plugin_unique_id, host))
+    return nullptr;
+
+  return created;
+}
+
+bool
+ClapPlugin::create_plugin (
+  CreatedPlugin     &created,
+  int64_t            plugin_unique_id,
+  const clap_host_t &host)
+{
+  const auto &path = created.path;
+  if (!created.entry->init (utils::Utf8String::from_path (path).c_str ()))
     {
       z_warning ("clap_entry->init() failed for '{}'", path);
     }
+  created.entry_initialized = true;
 
-  pimpl_->pluginFactory_ = static_cast<const clap_plugin_factory *> (
-    pimpl_->pluginEntry_->get_factory (CLAP_PLUGIN_FACTORY_ID));
+  const auto * const factory = static_cast<const clap_plugin_factory *> (
+    created.entry->get_factory (CLAP_PLUGIN_FACTORY_ID));
+  created.factory = factory;
 
   const auto * const desc = [&] () -> const clap_plugin_descriptor_t * {
-    const auto count =
-      pimpl_->pluginFactory_->get_plugin_count (pimpl_->pluginFactory_);
+    const auto count = factory->get_plugin_count (factory);
     for (const auto i : std::views::iota (0u, count))
       {
-        const auto * cur_desc = pimpl_->pluginFactory_->get_plugin_descriptor (
-          pimpl_->pluginFactory_, i);
+        const auto * cur_desc = factory->get_plugin_descriptor (factory, i);
         if (
           CLAPPluginFormat::get_hash_for_range (std::string (cur_desc->id))
           == plugin_unique_id)
@@ -990,19 +1112,60 @@ ClapPlugin::load_plugin (
 
   z_info ("Loading plugin with id: {}", desc->id);
 
-  const auto * const plugin = pimpl_->pluginFactory_->create_plugin (
-    pimpl_->pluginFactory_, clapHost (), desc->id);
-  if (plugin == nullptr)
+  created.plugin = factory->create_plugin (factory, &host, desc->id);
+  if (created.plugin == nullptr)
     {
       z_warning ("could not create the plugin with id: {}", desc->id);
       return false;
     }
 
+  return true;
+}
+
+bool
+ClapPlugin::load_plugin (
+  const std::filesystem::path &path,
+  int64_t                      plugin_unique_id,
+  bool                         generate_new_ports)
+{
+  assert (is_main_thread);
+
+  return init_plugin (
+    create_plugin_instance (path, plugin_unique_id, *clapHost ()),
+    plugin_unique_id, generate_new_ports);
+}
+
+bool
+ClapPlugin::init_plugin (
+  std::shared_ptr<CreatedPlugin> created,
+  int64_t                        plugin_unique_id,
+  bool                           generate_new_ports)
+{
+  assert (is_main_thread);
+
+  if (created == nullptr)
+    return false;
+
+  if (
+    !created->entry_initialized
+    && !create_plugin (*created, plugin_unique_id, *clapHost ()))
+    return false;
+
+  if (pimpl_->library_.is_loaded ())
+    unload_current_plugin ();
+
+  // adopt the plugin
+  pimpl_->library_ = std::move (created->library);
+  pimpl_->pluginEntry_ = std::exchange (created->entry, nullptr);
+  pimpl_->pluginFactory_ = created->factory;
+  const auto * const plugin = std::exchange (created->plugin, nullptr);
+  const auto * const plugin_id = plugin->desc->id;
+
   pimpl_->plugin_ = std::make_unique<ClapPluginProxy> (*plugin, *this);
 
   if (!pimpl_->plugin_->init ())
     {
-      z_warning ("could not init the plugin with id: {}", desc->id);
+      z_warning ("could not init the plugin with id: {}", plugin_id);
       return false;
     }
 
@@ -1924,7 +2087,7 @@ void
 to_json (nlohmann::json &j, const ClapPlugin &p)
 {
   to_json (j, static_cast<const Plugin &> (p));
-  auto state = p.save_state_impl ();
+  auto state = p.save_state ();
   if (!state.empty ())
     j[ClapPlugin::kStateKey] = std::move (state);
 }
@@ -1935,7 +2098,7 @@ from_json (const nlohmann::json &j, ClapPlugin &p)
   // State must be deserialized first, because the Plugin deserialization
   // may cause an instantiation
   if (j.contains (ClapPlugin::kStateKey))
-    p.load_state_impl (j[ClapPlugin::kStateKey].get<std::string> ());
+    p.load_state (j[ClapPlugin::kStateKey].get<std::string> ());
 
   from_json (j, static_cast<Plugin &> (p));
 }
@@ -128,6 +128,9 @@ protected:
 
   void release_resources_impl () override;
 
+  std::optional<units::sample_u32_t>
+  get_plugin_tail_length () const noexcept override;
+
 Q_SIGNALS:
   void paramsChanged ();
   void paramAdjusted (clap_id paramId);
@@ -147,6 +150,45 @@ private Q_SLOTS:
   void on_ui_visibility_changed ();
 
 private:
+  /**
+   * @brief A plugin instance created but not yet initialized.
+   *
+   * Cleans up after itself unless adopted by a ClapPlugin.
+   */
+  struct CreatedPlugin;
+
+  /**
+   * @brief Loads the library at @p path and creates the plugin instance.
+   *
+   * May be called from any thread. Off the main thread, plugins older than
+   * CLAP 1.2 (which doesn't require entry initialization to be thread-safe)
+   * only have their library loaded and are created by init_plugin().
+   *
+   * @return The created plugin, or nullptr on failure.
+   */
+  static std::shared_ptr<CreatedPlugin> create_plugin_instance (
+    const std::filesystem::path &path,
+    int64_t                      plugin_unique_id,
+    const clap_host_t           &host);
+
+  /**
+   * @brief Initializes the entry of @p created and creates the plugin.
+   */
+  static bool create_plugin (
+    CreatedPlugin     &created,
+    int64_t            plugin_unique_id,
+    const clap_host_t &host);
+
+  /**
+   * @brief Adopts and initializes a plugin created by create_plugin_instance().
+   *
+   * Must be called on the main thread.
+   */
+  bool init_plugin (
+    std::shared_ptr<CreatedPlugin> created,
+    int64_t                        plugin_unique_id,
+    bool                           generate_new_ports);
+
   /**
    * @brief Loads the plugin with the given unique ID hash at the given path.
    *
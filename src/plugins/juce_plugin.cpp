@@ -415,6 +415,17 @@ JucePlugin::prepare_plugin_for_processing (
 
       // Prepare MIDI buffer
       juce_midi_buffer_.ensureSize (4096);
+
+      // infinite tails are reported as infinity (or as a huge value)
+      constexpr auto max_tail_frames =
+        static_cast<double> (std::numeric_limits<int32_t>::max ());
+      const double tail_frames =
+        std::max (juce_plugin_->getTailLengthSeconds (), 0.0)
+        * sample_rate.in (units::sample_rate);
+      if (tail_frames < max_tail_frames)
+        tail_length_ = units::samples (static_cast<uint32_t> (tail_frames));
+      else
+        tail_length_.reset ();
     }
   catch (const std::exception &e)
     {
@@ -67,6 +67,12 @@ protected:
   std::string save_state_impl () const override;
   void        load_state_impl (const std::string &base64_state) override;
 
+  std::optional<units::sample_u32_t>
+  get_plugin_tail_length () const noexcept override
+  {
+    return tail_length_;
+  }
+
 private Q_SLOTS:
   /**
    * @brief Handle configuration changes.
@@ -138,6 +144,9 @@ private:
   juce::AudioBuffer<float> juce_audio_buffer_;
   juce::MidiBuffer         juce_midi_buffer_;
 
+  /** Tail reported by the plugin when it was prepared. */
+  std::optional<units::sample_u32_t> tail_length_;
+
   class JuceParamListener : public juce::AudioProcessorParameter::Listener
   {
   public:
@@ -1,11 +1,14 @@
 // SPDX-FileCopyrightText: © 2018-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
+#include <ranges>
+
 #include "plugins/plugin.h"
 #include "utils/enum_utils.h"
 #include "utils/logger.h"
 #include "utils/serialization.h"
 #include "utils/tracy.h"
 
+#include <QThreadPool>
 #include <QTimer>
 
 namespace zrythm::plugins
@@ -24,6 +27,23 @@ Plugin::Plugin (utils::IObjectRegistry &registry, QObject * parent)
     this, &Plugin::instantiationFinished, this, [this] (bool successful) {
       instantiation_status_ =
         successful ? InstantiationStatus::Successful : InstantiationStatus::Failed;
+      instantiation_deferred_ = false;
+      if (instantiation_start_.has_value ())
+        {
+          instantiation_duration_ =
+            std::chrono::steady_clock::now () - *instantiation_start_;
+          instantiation_start_.reset ();
+          z_info (
+            "{} {} in {} ms", get_name (),
+            successful ? "instantiated" : "failed to instantiate",
+            std::chrono::duration_cast<std::chrono::milliseconds> (
+              *instantiation_duration_)
+              .count ());
+        }
+      if (successful)
+        {
+          loaded_state_.clear ();
+        }
       Q_EMIT instantiationStatusChanged (instantiation_status_);
     });
 }
@@ -85,14 +105,55 @@ Plugin::set_configuration (const PluginConfiguration &setting)
 
   set_name (get_name ());
 
+  if (instantiation_deferred_)
+    {
+      z_debug ("deferring instantiation of {}", get_name ());
+      return;
+    }
+
+  start_instantiation ();
+}
+
+void
+Plugin::start_instantiation ()
+{
   /* If ports/params were already restored (e.g., from JSON deserialization),
    * tell handlers to skip generation and only reinitialize the underlying
    * plugin instance. */
   const bool generate_new =
     get_input_ports ().empty () && get_output_ports ().empty ();
+  instantiation_start_ = std::chrono::steady_clock::now ();
   Q_EMIT configurationChanged (configuration_.get (), generate_new);
 }
 
+void
+Plugin::defer_instantiation ()
+{
+  assert (!set_configuration_called_);
+  instantiation_deferred_ = true;
+}
+
+void
+Plugin::instantiate ()
+{
+  if (
+    !instantiation_deferred_ || deferred_instantiation_started_
+    || configuration_ == nullptr)
+    return;
+
+  deferred_instantiation_started_ = true;
+  z_debug ("instantiating {}", get_name ());
+  start_instantiation ();
+}
+
+QThreadPool &
+Plugin::instantiation_thread_pool ()
+{
+  // bounded to QThread::idealThreadCount()
+  static QThreadPool pool;
+  return pool;
+}
+
 // ============================================================================
 // IProcessable Interface
 // ============================================================================
@@ -103,6 +164,9 @@ Plugin::custom_prepare_for_processing (
   units::sample_rate_t          sample_rate,
   units::sample_u32_t           max_block_length)
 {
+  awaiting_instantiation_rt_ = instantiation_deferred_;
+  held_notes_.reset ();
+  sustained_channels_.reset ();
   init_param_caches ();
   param_sync_.prepare (get_parameters ().size ());
   prepare_plugin_for_processing (sample_rate, max_block_length);
@@ -121,7 +185,10 @@ Plugin::custom_process_block (
   if (instantiation_failed_)
     return;
 
-  if (!currently_enabled_rt ())
+  if (midi_in_port_ != nullptr)
+    update_held_notes (time_nfo);
+
+  if (awaiting_instantiation_rt_ || !currently_enabled_rt ())
     {
       process_passthrough_impl (time_nfo, transport, tempo_map);
       return;
@@ -130,6 +197,85 @@ Plugin::custom_process_block (
   process_impl (time_nfo);
 }
 
+std::optional<units::sample_u32_t>
+Plugin::get_tail_length () const noexcept
+{
+  if (instantiation_failed_)
+    return std::nullopt;
+
+  // passthrough
+  if (awaiting_instantiation_rt_ || !currently_enabled_rt ())
+    return units::samples (0u);
+
+  const auto tail = get_plugin_tail_length ();
+  if (midi_in_port_ == nullptr)
+    return tail;
+
+  // instruments keep sounding while notes are held, and many of them report
+  // a zero tail regardless of their release time, so only trust a non-zero
+  // tail counted from the release of the last note
+  if (held_notes_.any () || sustained_channels_.any ())
+    return std::nullopt;
+  if (!tail || *tail == units::samples (0u))
+    return std::nullopt;
+  return tail;
+}
+
+void
+Plugin::update_held_notes (
+  const dsp::graph::ProcessBlockInfo &time_nfo) noexcept
+{
+  namespace midi = utils::midi;
+
+  // sustain pedal
+  static constexpr midi_byte_t kSustainController = 64;
+
+  const auto start = time_nfo.buffer_offset_;
+  const auto end = start + time_nfo.nframes_;
+  for (const auto &ev : midi_in_port_->buffer_)
+    {
+      const auto data = ev.data ();
+      if (ev.time () < start || ev.time () >= end || data.size () < 3)
+        continue;
+
+      const auto channel = midi::midi_get_channel_0_to_15 (data);
+      const auto note_index =
+        (size_t{ channel } * 128) + (midi::midi_get_note_number (data) & 0x7f);
+      if (midi::midi_is_note_on (data))
+        {
+          held_notes_.set (note_index);
+        }
+      else if (midi::midi_is_note_off (data))
+        {
+          held_notes_.reset (note_index);
+        }
+      else if (
+        midi::midi_is_all_notes_off (data)
+        || midi::midi_is_all_sound_off (data))
+        {
+          for (const auto note : std::views::iota (0zu, 128zu))
+            {
+              held_notes_.reset ((size_t{ channel } * 128) + note);
+            }
+          sustained_channels_.reset (channel);
+        }
+      else if (
+        midi::midi_is_controller (data)
+        && midi::midi_get_controller_number (data) == kSustainController)
+        {
+          sustained_channels_.set (
+            channel, midi::midi_get_controller_value (data) >= 64);
+        }
+    }
+}
+
+bool
+Plugin::can_be_pruned () const
+{
+  // instruments would miss note-offs sent while pruned
+  return midi_in_port_ == nullptr;
+}
+
 void
 Plugin::custom_release_resources ()
 {
@@ -183,12 +329,22 @@ Plugin::init_param_caches ()
 std::string
 Plugin::save_state () const
 {
-  return save_state_impl ();
+  auto state = save_state_impl ();
+  if (
+    state.empty () && instantiation_status_ != InstantiationStatus::Successful)
+    {
+      return loaded_state_;
+    }
+  return state;
 }
 
 void
 Plugin::load_state (const std::string &base64_state)
 {
+  if (instantiation_status_ != InstantiationStatus::Successful)
+    {
+      loaded_state_ = base64_state;
+    }
   load_state_impl (base64_state);
 }
 
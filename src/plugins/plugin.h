@@ -4,7 +4,10 @@
 #pragma once
 
 #include <atomic>
+#include <bitset>
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "dsp/parameter.h"
@@ -17,6 +20,7 @@
 #include "utils/registry_utils.h"
 #include "utils/variant_helpers.h"
 
+#include <QThreadPool>
 #include <QTimer>
 
 namespace zrythm::plugins
@@ -202,6 +206,42 @@ public:
    */
   void set_configuration (const PluginConfiguration &setting);
 
+  /**
+   * @brief Defers instantiating the underlying plugin until instantiate() is
+   * called.
+   *
+   * Must be called before set_configuration(). Until instantiation finishes,
+   * the plugin is InstantiationStatus::Pending, passes its input through and
+   * saves the state it was loaded with.
+   */
+  void defer_instantiation ();
+
+  /**
+   * @brief Whether instantiation was deferred and hasn't finished yet.
+   */
+  bool instantiation_deferred () const { return instantiation_deferred_; }
+
+  /**
+   * @brief Starts a deferred instantiation.
+   *
+   * Does nothing if instantiation wasn't deferred or was already started.
+   * instantiationFinished() is emitted when done (possibly asynchronously),
+   * after which the plugin must be prepared for processing again.
+   */
+  void instantiate ();
+
+  /**
+   * @brief Time the last instantiation took, if it finished.
+   */
+  auto instantiation_duration () const { return instantiation_duration_; }
+
+  /**
+   * @brief Thread pool for creating plugin instances off the main thread.
+   *
+   * @see PluginConfiguration::requires_main_thread_instantiation().
+   */
+  static QThreadPool &instantiation_thread_pool ();
+
   // ============================================================================
   // IProcessable Interface
   // ============================================================================
@@ -218,6 +258,10 @@ public:
 
   void custom_release_resources () final;
 
+  std::optional<units::sample_u32_t> get_tail_length () const noexcept final;
+
+  bool can_be_pruned () const final;
+
   // ============================================================================
 
   /**
@@ -243,6 +287,9 @@ public:
   /**
    * @brief Serializes the plugin's internal state to a base64-encoded string.
    *
+   * If the plugin isn't instantiated (yet), returns the state it was loaded
+   * with instead.
+   *
    * @return Base64-encoded state, or empty string if no state is available.
    */
   std::string save_state () const;
@@ -272,6 +319,26 @@ private:
 
   virtual void release_resources_impl () { }
 
+  /**
+   * @brief Returns the tail reported by the plugin, or nullopt if infinite or
+   * unknown.
+   *
+   * Called on the audio thread (see ProcessorBase::get_tail_length()).
+   */
+  virtual std::optional<units::sample_u32_t>
+  get_plugin_tail_length () const noexcept
+  {
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Updates the notes held at the MIDI input from its events in the
+   * current block.
+   */
+  void
+  update_held_notes (const dsp::graph::ProcessBlockInfo &time_nfo) noexcept
+    [[clang::nonblocking]];
+
   /**
    * @brief Processes the plugin by passing through the input to its output.
    *
@@ -327,6 +394,12 @@ private:
   friend void           to_json (nlohmann::json &j, const Plugin &p);
   friend void           from_json (const nlohmann::json &j, Plugin &p);
 
+  /**
+   * @brief Emits configurationChanged() to have the implementation instantiate
+   * the plugin.
+   */
+  void start_instantiation ();
+
 protected:
   /** Set to true if instantiation failed and the plugin will be treated as
    * disabled. */
@@ -357,6 +430,15 @@ protected:
   dsp::MidiPort *               midi_out_port_{};
   dsp::ProcessorParameter *     bypass_param_rt_{};
 
+  /**
+   * @brief Notes held at the MIDI input (one bit per note of each channel),
+   * used to tell when an instrument's tail starts.
+   */
+  std::bitset<16 * 128> held_notes_;
+
+  /** Channels whose sustain pedal is down. */
+  std::bitset<16> sustained_channels_;
+
   // ============================================================================
   // Parameter Synchronization
   // ============================================================================
@@ -433,6 +515,27 @@ private:
    */
   bool set_configuration_called_{};
 
+  /** See defer_instantiation(). */
+  bool instantiation_deferred_{};
+
+  /** Whether instantiate() was called on a deferred plugin. */
+  bool deferred_instantiation_started_{};
+
+  std::optional<std::chrono::steady_clock::time_point> instantiation_start_;
+  std::optional<std::chrono::steady_clock::duration>   instantiation_duration_;
+
+  /**
+   * @brief Whether the plugin was waiting for a deferred instantiation when it
+   * was last prepared for processing (realtime cache).
+   */
+  bool awaiting_instantiation_rt_{};
+
+  /**
+   * @brief The state passed to load_state(), kept until the plugin is
+   * instantiated so that saving an uninstantiated plugin doesn't lose it.
+   */
+  std::string loaded_state_;
+
   /**
    * @brief Timer that flushes plugin→host param changes on the main thread.
    * Started in custom_prepare_for_processing(), stopped in
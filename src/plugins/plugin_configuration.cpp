@@ -16,6 +16,7 @@ PluginConfiguration::copy_fields_from (const PluginConfiguration &other)
   hosting_type_ = other.hosting_type_;
   force_generic_ui_ = other.force_generic_ui_;
   bridge_mode_ = other.bridge_mode_;
+  force_main_thread_instantiation_ = other.force_main_thread_instantiation_;
 }
 
 void
@@ -47,6 +48,14 @@ PluginConfiguration::validate ()
     }
 }
 
+bool
+PluginConfiguration::requires_main_thread_instantiation () const
+{
+  // JUCE creates instances on the message thread
+  return force_main_thread_instantiation_
+         || descr_->protocol_ != Protocol::ProtocolType::CLAP;
+}
+
 void
 to_json (nlohmann::json &j, const PluginConfiguration &p)
 {
@@ -55,6 +64,10 @@ to_json (nlohmann::json &j, const PluginConfiguration &p)
     { PluginConfiguration::kForceGenericUIKey, p.force_generic_ui_ },
     { PluginConfiguration::kBridgeModeKey,     p.bridge_mode_      },
   };
+  if (p.force_main_thread_instantiation_)
+    {
+      j[PluginConfiguration::kForceMainThreadInstantiationKey] = true;
+    }
 }
 
 void
@@ -64,5 +77,7 @@ from_json (const nlohmann::json &j, PluginConfiguration &p)
   j.at (PluginConfiguration::kDescriptorKey).get_to (*p.descr_);
   j.at (PluginConfiguration::kForceGenericUIKey).get_to (p.force_generic_ui_);
   j.at (PluginConfiguration::kBridgeModeKey).get_to (p.bridge_mode_);
+  p.force_main_thread_instantiation_ =
+    j.value (PluginConfiguration::kForceMainThreadInstantiationKey, false);
 }
 }
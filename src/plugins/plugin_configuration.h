@@ -77,10 +77,21 @@ public:
 
   void copy_fields_from (const PluginConfiguration &other);
 
+  /**
+   * @brief Whether the plugin instance must be created on the main thread.
+   *
+   * Instances are created concurrently on a worker pool only for formats
+   * whose host allows it (CLAP), unless @ref force_main_thread_instantiation_
+   * is set for this plugin.
+   */
+  bool requires_main_thread_instantiation () const;
+
 private:
   static constexpr auto kDescriptorKey = "descriptor"sv;
   static constexpr auto kForceGenericUIKey = "forceGenericUI"sv;
   static constexpr auto kBridgeModeKey = "bridgeMode"sv;
+  static constexpr auto kForceMainThreadInstantiationKey =
+    "forceMainThreadInstantiation"sv;
   friend void to_json (nlohmann::json &j, const PluginConfiguration &p);
   friend void from_json (const nlohmann::json &j, PluginConfiguration &p);
 
@@ -96,10 +107,20 @@ public:
   /** Requested carla bridge mode. */
   zrythm::plugins::BridgeMode bridge_mode_{};
 
+  /**
+   * @brief Whether to always create the plugin instance on the main thread
+   * (for plugins that misbehave when created on other threads).
+   */
+  bool force_main_thread_instantiation_{};
+
   BOOST_DESCRIBE_CLASS (
     PluginConfiguration,
     (),
-    (descr_, hosting_type_, force_generic_ui_, bridge_mode_),
+    (descr_,
+     hosting_type_,
+     force_generic_ui_,
+     bridge_mode_,
+     force_main_thread_instantiation_),
     (),
     ())
 };
@@ -155,13 +155,24 @@ private:
   }
 
 public:
+  /**
+   * @brief Sets whether external plugins built for deserialization defer
+   * their instantiation (see Plugin::defer_instantiation()).
+   *
+   * Internal plugins are cheap to instantiate so they are never deferred.
+   */
+  void set_defer_instantiation (bool defer) { defer_instantiation_ = defer; }
+
   template <typename PluginT>
   std::unique_ptr<PluginT> build_for_deserialization () const
   {
     if constexpr (std::is_same_v<PluginT, plugins::ClapPlugin>)
       {
-        return std::make_unique<PluginT> (
+        auto plugin = std::make_unique<PluginT> (
           dependencies_.registry, dependencies_.top_level_window_provider_);
+        if (defer_instantiation_)
+          plugin->defer_instantiation ();
+        return plugin;
       }
     else if constexpr (std::derived_from<PluginT, plugins::InternalPluginBase>)
       {
@@ -169,12 +180,15 @@ public:
       }
     else
       {
-        return std::make_unique<PluginT> (
+        auto plugin = std::make_unique<PluginT> (
           dependencies_.registry,
           dependencies_.create_plugin_instance_async_func_,
           dependencies_.sample_rate_provider_,
           dependencies_.buffer_size_provider_,
           dependencies_.top_level_window_provider_);
+        if (defer_instantiation_)
+          plugin->defer_instantiation ();
+        return plugin;
       }
   }
 
@@ -232,5 +246,6 @@ public:
 
 private:
   CommonFactoryDependencies dependencies_;
+  bool                      defer_instantiation_{};
 };
 }
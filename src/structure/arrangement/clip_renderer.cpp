@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
 #include <algorithm>
+#include <cmath>
 #include <ranges>
+#include <stdexcept>
 
 #include <fmt/std.h>
 
@@ -20,6 +22,8 @@
 #include "utils/math_utils.h"
 #include "utils/views.h"
 
+#include <boost/container_hash/hash.hpp>
+
 namespace zrythm::structure::arrangement
 {
 
@@ -394,6 +398,99 @@ ClipRenderer::serialize_to_points (
   std::ranges::sort (points, {}, &RenderedAutomationPoint::position);
 }
 
+void
+ClipRenderer::hash_clip_properties (size_t &seed, const Clip &clip)
+{
+  boost::hash_combine (seed, clip.position ()->ticks ());
+  boost::hash_combine (seed, clip.length ()->ticks ());
+  boost::hash_combine (seed, clip.clipStartPosition ()->ticks ());
+  boost::hash_combine (seed, clip.loopStartPosition ()->ticks ());
+  boost::hash_combine (seed, clip.loopEndPosition ()->ticks ());
+  for (const auto &warp_point : clip.contentWarp ()->warpPoints ())
+    {
+      boost::hash_combine (seed, warp_point.content_ticks.asDouble ());
+      boost::hash_combine (seed, warp_point.timeline_delta_ticks.asDouble ());
+    }
+}
+
+size_t
+ClipRenderer::content_hash (const MidiClip &clip)
+{
+  size_t seed = 0;
+  hash_clip_properties (seed, clip);
+  for (
+    const auto * note : clip.ArrangerObjectOwner<MidiNote>::get_children_view ())
+    {
+      boost::hash_combine (seed, note->mute ()->muted ());
+      boost::hash_combine (seed, note->position ()->ticks ());
+      boost::hash_combine (seed, note->length ()->ticks ());
+      boost::hash_combine (seed, note->pitch ());
+      boost::hash_combine (seed, note->velocity ());
+      boost::hash_combine (seed, note->midiChannel ());
+    }
+  for (
+    const auto * ev :
+    clip.ArrangerObjectOwner<MidiControlEvent>::get_children_view ())
+    {
+      boost::hash_combine (seed, ev->position ()->ticks ());
+      boost::hash_combine (seed, static_cast<int> (ev->controlEventType ()));
+      boost::hash_combine (seed, ev->midiChannel ());
+      boost::hash_combine (seed, ev->midiController ());
+      boost::hash_combine (seed, ev->midiValue ());
+    }
+  return seed;
+}
+
+size_t
+ClipRenderer::content_hash (const ChordClip &clip)
+{
+  size_t seed = 0;
+  hash_clip_properties (seed, clip);
+  for (const auto * chord_object : clip.get_children_view ())
+    {
+      boost::hash_combine (seed, chord_object->mute ()->muted ());
+      boost::hash_combine (seed, chord_object->position ()->ticks ());
+      for (
+        const auto pitch : chord_object->chordDescriptor ()->getMidiPitches ())
+        {
+          boost::hash_combine (seed, pitch);
+        }
+    }
+  return seed;
+}
+
+size_t
+ClipRenderer::content_hash (const AutomationClip &clip)
+{
+  size_t seed = 0;
+  hash_clip_properties (seed, clip);
+  for (const auto * ap : clip.get_children_view ())
+    {
+      boost::hash_combine (seed, ap->position ()->ticks ());
+      boost::hash_combine (seed, ap->value ());
+      boost::hash_combine (
+        seed, static_cast<int> (ap->curveOpts ()->algorithm ()));
+      boost::hash_combine (seed, ap->curveOpts ()->curviness ());
+    }
+  return seed;
+}
+
+size_t
+ClipRenderer::content_hash (const AudioClip &clip)
+{
+  const auto &fs = clip.get_children_view ().front ()->file_audio_source ();
+
+  size_t seed = 0;
+  hash_clip_properties (seed, clip);
+  boost::hash_combine (seed, clip.looped ());
+  boost::hash_combine (
+    seed, static_cast<int> (clip.effectiveStretchAlgorithm ()));
+  boost::hash_combine (seed, fs.get_uuid ());
+  boost::hash_combine (seed, fs.samples_version ());
+  boost::hash_combine (seed, fs.source_bpm ().in (units::bpm));
+  return seed;
+}
+
 /**
  * Serializes an Audio clip to an audio sample buffer.
  *
@@ -406,11 +503,10 @@ ClipRenderer::build_native_looped_buffer (
   units::sample_t  out_start,
   units::sample_t  out_end)
 {
-  auto       &fs = clip.get_children_view ().front ()->file_audio_source ();
-  const auto &samples = fs.get_samples ();
-  const int   channels = samples.getNumChannels ();
-  const auto  clip_frames = units::samples (samples.getNumSamples ());
-  const auto  source_bpm = fs.source_bpm ();
+  auto      &fs = clip.get_children_view ().front ()->file_audio_source ();
+  const int  channels = fs.get_num_channels ();
+  const auto clip_frames = units::samples (fs.get_num_frames ());
+  const auto source_bpm = fs.source_bpm ();
   const auto  sr = clip.get_tempo_map ().get_sample_rate ();
   const auto  effective_bpm =
     source_bpm > units::bpm (0.0)
@@ -474,10 +570,9 @@ ClipRenderer::build_native_looped_buffer (
             }
           break; // past clip / un-looped tail: leave silence
         }
-      for (int c = 0; c < channels; ++c)
-        b1.copyFrom (
-          c, write_pos.in<int> (units::samples), samples, c,
-          read_pos.in<int> (units::samples), this_len.in<int> (units::samples));
+      fs.read_frames (
+        read_pos, this_len.in<int> (units::samples), b1,
+        write_pos.in<int> (units::samples));
       write_pos += this_len;
       read_pos += this_len;
       if (read_pos >= loop_end_s)
@@ -491,6 +586,197 @@ ClipRenderer::build_native_looped_buffer (
   return b1;
 }
 
+void
+ClipRenderer::set_gain_and_fades (
+  const AudioClip                            &clip,
+  dsp::AudioTimelineDataCache::LazyAudioClip &lazy_clip)
+{
+  const auto &tempo_map = clip.get_tempo_map ();
+  lazy_clip.gain = clip.gain ();
+  lazy_clip.builtin_fade_frames = AudioClip::BUILTIN_FADE_FRAMES;
+
+  // object fades (same as apply_clip_fades_pass())
+  const auto offset_to_frames = [&] (const dsp::Position * offset) {
+    return tempo_map.tick_to_samples_rounded (
+      dsp::TimelineTick{ units::ticks (offset->ticks ()) });
+  };
+  const auto clip_length_in_frames =
+    clip.get_end_position_samples (true)
+    - tempo_map.tick_to_samples_rounded (clip.position ()->asTick ());
+  lazy_clip.fade_in_length =
+    offset_to_frames (clip.fadeRange ()->startOffset ());
+  lazy_clip.fade_in_opts = dsp::CurveOptions (
+    clip.fadeRange ()->fadeInCurveOpts ()->curviness (),
+    clip.fadeRange ()->fadeInCurveOpts ()->algorithm ());
+  lazy_clip.fade_out_length =
+    offset_to_frames (clip.fadeRange ()->endOffset ());
+  lazy_clip.fade_out_start = clip_length_in_frames - lazy_clip.fade_out_length;
+  lazy_clip.fade_out_opts = dsp::CurveOptions (
+    clip.fadeRange ()->fadeOutCurveOpts ()->curviness (),
+    clip.fadeRange ()->fadeOutCurveOpts ()->algorithm ());
+}
+
+dsp::AudioTimelineDataCache::LazyAudioClip
+ClipRenderer::get_native_clip (const AudioClip &clip)
+{
+  const auto &fs = clip.get_children_view ().front ()->file_audio_source ();
+
+  // same native position mapping as build_native_looped_buffer()
+  const auto &tempo_map = clip.get_tempo_map ();
+  const auto  source_bpm = fs.source_bpm ();
+  const auto  effective_bpm =
+    source_bpm > units::bpm (0.0)
+      ? source_bpm
+      : tempo_map.tempo_at_tick (
+          units::ticks (static_cast<int64_t> (clip.position ()->ticks ())));
+  const auto native_offset = [&] (const dsp::Position * pos) -> units::sample_t {
+    return au::round_as<int64_t> (
+      units::samples,
+      units::ticks (pos->ticks ()) / effective_bpm
+        * tempo_map.get_sample_rate ());
+  };
+  const auto clip_frames = units::samples (fs.get_num_frames ());
+  const auto loop_start_s = clamp (
+    native_offset (clip.loopStartPosition ()), units::samples (0), clip_frames);
+
+  dsp::AudioTimelineDataCache::LazyAudioClip ret;
+  ret.clip_start = clamp (
+    native_offset (clip.clipStartPosition ()), units::samples (0), clip_frames);
+  ret.loop_start = loop_start_s;
+  ret.loop_end = std::max (
+    clamp (
+      native_offset (clip.loopEndPosition ()), units::samples (0), clip_frames),
+    loop_start_s + units::samples (1));
+  ret.looped = clip.looped ();
+  ret.source_length = clip_frames;
+  ret.content_length = max (units::samples (0), native_offset (clip.length ()));
+  return ret;
+}
+
+std::optional<dsp::TimeWarpMap>
+ClipRenderer::get_warp_map_if_stretched (const AudioClip &clip)
+{
+  const auto &fs = clip.get_children_view ().front ()->file_audio_source ();
+  if (fs.source_bpm () <= units::bpm (0.0))
+    return std::nullopt;
+
+  auto warp = get_stretch_warp_map (clip);
+  if (
+    warp.source_length <= units::samples (0)
+    || dsp::is_sample_space_identity (warp.anchors))
+    return std::nullopt;
+
+  return warp;
+}
+
+std::optional<dsp::AudioTimelineDataCache::LazyAudioClip>
+ClipRenderer::get_lazy_clip (const AudioClip &clip)
+{
+  if (get_warp_map_if_stretched (clip).has_value ())
+    return std::nullopt;
+
+  const auto &fs = clip.get_children_view ().front ()->file_audio_source ();
+  auto        ret = get_native_clip (clip);
+  set_gain_and_fades (clip, ret);
+
+  if (fs.is_streaming ())
+    {
+      ret.stream = fs.streaming_store ();
+      return ret;
+    }
+
+  // reference the source frames (they are copied on write by the source)
+  ret.frames = fs.get_shared_samples ();
+  ret.source_length =
+    min (ret.source_length, units::samples (ret.frames->getNumSamples ()));
+  return ret;
+}
+
+dsp::TimeWarpMap
+ClipRenderer::get_stretch_warp_map (const AudioClip &clip)
+{
+  const auto &fs = clip.get_children_view ().front ()->file_audio_source ();
+  const auto &tempo_map = clip.get_tempo_map ();
+  const auto  source_bpm = fs.source_bpm ();
+  if (source_bpm <= units::bpm (0.0))
+    {
+      throw std::invalid_argument ("Clip source BPM is unknown");
+    }
+
+  // same native length as serialize_to_buffer()
+  const auto native_clip_len = max (
+    units::samples (0),
+    au::round_as<int64_t> (
+      units::samples,
+      units::ticks (clip.length ()->ticks ()) / source_bpm
+        * tempo_map.get_sample_rate ()));
+  auto warp_points = clip.contentWarp ()->warpPoints ();
+  return dsp::to_time_warp_map (
+    warp_points, tempo_map, clip.position ()->asTick (), source_bpm,
+    native_clip_len);
+}
+
+dsp::AudioTimelineDataCache::LazyAudioClip
+ClipRenderer::get_stretched_clip (const AudioClip &clip)
+{
+  const auto warp = get_stretch_warp_map (clip);
+
+  // the stretched frames are played once from the start
+  dsp::AudioTimelineDataCache::LazyAudioClip ret;
+  ret.clip_start = units::samples (0);
+  ret.loop_start = units::samples (0);
+  ret.loop_end = warp.output_length;
+  ret.source_length = warp.output_length;
+  ret.content_length = warp.output_length;
+  set_gain_and_fades (clip, ret);
+  return ret;
+}
+
+std::function<utils::audio::AudioBuffer ()>
+ClipRenderer::prepare_stretched_frames (const AudioClip &clip)
+{
+  auto warp = get_stretch_warp_map (clip);
+
+  // offline RubberBand needs the whole input for a seamless result
+  auto input = std::make_shared<const utils::audio::AudioBuffer> (
+    build_native_looped_buffer (clip, units::samples (0), warp.source_length));
+  dsp::StretchOptions stretch_opts;
+  stretch_opts.algorithm = clip.effectiveStretchAlgorithm ();
+  const auto sample_rate = au::round_as<int> (
+    units::sample_rate, clip.get_tempo_map ().get_sample_rate ());
+
+  return [input = std::move (input), warp = std::move (warp), stretch_opts,
+          sample_rate] () {
+    auto engine =
+      dsp::create_default_timestretch_engine (stretch_opts, sample_rate);
+    return engine->stretch (*input, warp, stretch_opts);
+  };
+}
+
+// Maps an output (stretched) frame to the source frame it is stretched from,
+// interpolating between the warp anchors.
+static units::sample_t
+output_to_source_frame (const dsp::TimeWarpMap &warp, units::sample_t frame)
+{
+  const auto &anchors = warp.anchors;
+  const auto  next = std::ranges::upper_bound (
+    anchors, frame, {}, &dsp::WarpAnchor::output_frame);
+  if (next == anchors.begin ())
+    return anchors.front ().source_frame;
+  if (next == anchors.end ())
+    return anchors.back ().source_frame;
+
+  const auto &prev = *std::prev (next);
+  const auto  ratio =
+    (frame - prev.output_frame).in<double> (units::samples)
+    / (next->output_frame - prev.output_frame).in<double> (units::samples);
+  return prev.source_frame
+         + units::samples (std::llround (
+           ratio
+           * (next->source_frame - prev.source_frame).in<double> (
+             units::samples)));
+}
+
 void
 ClipRenderer::serialize_to_buffer (
   const AudioClip             &clip,
@@ -598,14 +884,7 @@ ClipRenderer::serialize_to_buffer (
           // needs the whole input for a seamless result) then slice the range.
           // Note: unlike the no-stretch branch below, this is O(full clip)
           // even for a sub-range request — unavoidable for offline quality.
-          auto full_b1 = build_native_looped_buffer (
-            clip, units::samples (0), native_clip_len);
-          dsp::StretchOptions stretch_opts;
-          stretch_opts.algorithm = clip.effectiveStretchAlgorithm ();
-          auto engine = dsp::create_default_timestretch_engine (
-            stretch_opts,
-            au::round_as<int> (units::sample_rate, tempo_map.get_sample_rate ()));
-          content = engine->stretch (full_b1, warp, stretch_opts);
+          content = prepare_stretched_frames (clip) ();
           const int chans =
             std::min (buffer.getNumChannels (), content.getNumChannels ());
           for (int c = 0; c < chans; ++c)
@@ -684,6 +963,60 @@ ClipRenderer::serialize_to_buffer (
     }
 }
 
+void
+ClipRenderer::serialize_peaks_to_buffer (
+  const AudioClip             &clip,
+  const dsp::AudioPeakSummary &source_peaks,
+  int                          frames_per_peak,
+  juce::AudioSampleBuffer     &buffer)
+{
+  // positions in the source frames (also used for stretched clips, whose
+  // output frames are mapped back to these)
+  const auto native_clip = get_native_clip (clip);
+  const auto warp = get_warp_map_if_stretched (clip);
+
+  // gain and fades, in output frames
+  auto envelope = native_clip;
+  set_gain_and_fades (clip, envelope);
+  if (warp.has_value ())
+    envelope.content_length = warp->output_length;
+
+  const auto output_length = envelope.content_length.in (units::samples);
+  const auto num_peaks =
+    (output_length + frames_per_peak - 1) / frames_per_peak;
+  buffer.setSize (2, static_cast<int> (num_peaks * 2));
+  buffer.clear ();
+
+  const int channels = std::min (2, source_peaks.num_channels ());
+  for (const auto peak : std::views::iota (int64_t{ 0 }, num_peaks))
+    {
+      const auto output_begin = units::samples (peak * frames_per_peak);
+      const auto output_end = min (
+        output_begin + units::samples (frames_per_peak),
+        envelope.content_length);
+      auto source_begin = output_begin;
+      auto source_end = output_end;
+      if (warp.has_value ())
+        {
+          source_begin = output_to_source_frame (*warp, output_begin);
+          source_end = max (
+            source_begin + units::samples (1),
+            output_to_source_frame (*warp, output_end));
+        }
+
+      const auto gain = envelope.max_gain (output_begin, output_end);
+      for (const auto ch : std::views::iota (0, channels))
+        {
+          const auto range = native_clip.find_source_min_and_max (
+            source_peaks, ch, source_begin, source_end);
+          buffer.setSample (
+            ch, static_cast<int> (peak * 2), range.getStart () * gain);
+          buffer.setSample (
+            ch, static_cast<int> (peak * 2 + 1), range.getEnd () * gain);
+        }
+    }
+}
+
 /**
  * Applies gain to the entire audio buffer as a separate pass.
  */
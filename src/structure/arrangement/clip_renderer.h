@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <functional>
+
+#include "dsp/audio_peak_summary.h"
 #include "dsp/tick_types.h"
+#include "dsp/time_warp_map.h"
+#include "dsp/timeline_data_cache.h"
 #include "structure/arrangement/arranger_object_all.h"
 #include "structure/arrangement/loop_segment_iterator.h"
 #include "utils/audio.h"
@@ -72,6 +77,67 @@ public:
     juce::AudioSampleBuffer     &buffer,
     std::optional<TimelineRange> timeline_range_ticks = std::nullopt);
 
+  /**
+   * @brief Serializes a summary of an Audio clip's audio for drawing
+   * waveforms.
+   *
+   * The summary follows the layout of serialize_to_buffer(), but each block
+   * of @p frames_per_peak frames is stored as its minimum followed by its
+   * maximum. The peaks are looked up in @p source_peaks (the peaks of the
+   * clip's source), so the source frames are not read. Time-stretched clips
+   * use the peaks of the source frames each block is stretched from.
+   *
+   * @param clip The Audio clip to serialize.
+   * @param source_peaks Peaks of the clip's source frames.
+   * @param frames_per_peak Number of clip frames summarized by each pair of
+   * buffer frames.
+   * @param buffer Output audio sample buffer.
+   */
+  static void serialize_peaks_to_buffer (
+    const AudioClip             &clip,
+    const dsp::AudioPeakSummary &source_peaks,
+    int                          frames_per_peak,
+    juce::AudioSampleBuffer     &buffer);
+
+  /**
+   * @brief Returns the parameters to render the clip from its source frames
+   * during playback, if possible.
+   *
+   * This is the case when the clip is not stretched (gain, loops and fades
+   * can be applied during playback). Other clips must be rendered with
+   * serialize_to_buffer() or get_stretched_clip().
+   *
+   * The source frames are referenced, not copied (in-memory frames through
+   * FileAudioSource::get_shared_samples()).
+   */
+  static std::optional<dsp::AudioTimelineDataCache::LazyAudioClip>
+  get_lazy_clip (const AudioClip &clip);
+
+  /**
+   * @brief Returns the parameters to play back a clip that get_lazy_clip()
+   * can't be used for from its time-stretched frames.
+   *
+   * The frames are not set: they must be set to the ones returned by the
+   * function from prepare_stretched_frames().
+   *
+   * @throw std::invalid_argument if the clip's source BPM is unknown.
+   */
+  static dsp::AudioTimelineDataCache::LazyAudioClip
+  get_stretched_clip (const AudioClip &clip);
+
+  /**
+   * @brief Reads what's needed to time-stretch the clip and returns the
+   * function that stretches it.
+   *
+   * The returned function does not access the clip, so it may be called from
+   * any thread. Its result matches serialize_to_buffer() before gain and fades
+   * are applied.
+   *
+   * @throw std::invalid_argument if the clip's source BPM is unknown.
+   */
+  static std::function<utils::audio::AudioBuffer ()>
+  prepare_stretched_frames (const AudioClip &clip);
+
   /**
    * @brief A single control point in a rendered automation curve.
    *
@@ -123,6 +189,33 @@ public:
     std::optional<TimelineRange>          timeline_range_ticks = std::nullopt)
     [[clang::blocking]];
 
+  /**
+   * @brief Returns a hash of everything serialize_to_sequence() reads from the
+   * clip.
+   *
+   * Clips with the same hash serialize to the same events, so a previous
+   * serialization can be reused. The hash does not cover the tempo map.
+   */
+  static size_t content_hash (const MidiClip &clip);
+
+  /**
+   * @brief Returns a hash of everything serialize_to_sequence() reads from the
+   * clip (see the MidiClip overload).
+   */
+  static size_t content_hash (const ChordClip &clip);
+
+  /**
+   * @brief Returns a hash of everything serialize_to_points() reads from the
+   * clip (see the MidiClip overload).
+   */
+  static size_t content_hash (const AutomationClip &clip);
+
+  /**
+   * @brief Returns a hash of everything prepare_stretched_frames() reads from
+   * the clip (see the MidiClip overload).
+   */
+  static size_t content_hash (const AudioClip &clip);
+
 private:
   /**
    * @brief Common loop parameters extracted from a clip.
@@ -139,6 +232,42 @@ private:
     LoopParameters (const Clip &clip);
   };
 
+  /**
+   * @brief Hashes the clip properties that affect all clip types (position,
+   * length, loop range and warp).
+   */
+  static void hash_clip_properties (size_t &seed, const Clip &clip);
+
+  /**
+   * @brief Returns the positions of the clip in its source frames, at the
+   * source's native rate.
+   *
+   * Only the positions are set (no frames, gain or fades).
+   */
+  static dsp::AudioTimelineDataCache::LazyAudioClip
+  get_native_clip (const AudioClip &clip);
+
+  /**
+   * @brief Returns the warp map to stretch the clip with, or nullopt if the
+   * clip plays at its native speed.
+   */
+  static std::optional<dsp::TimeWarpMap>
+  get_warp_map_if_stretched (const AudioClip &clip);
+
+  /**
+   * @brief Sets the gain and fade parameters of @p lazy_clip from the clip.
+   */
+  static void set_gain_and_fades (
+    const AudioClip                            &clip,
+    dsp::AudioTimelineDataCache::LazyAudioClip &lazy_clip);
+
+  /**
+   * @brief Returns the warp map used to stretch the clip.
+   *
+   * @throw std::invalid_argument if the clip's source BPM is unknown.
+   */
+  static dsp::TimeWarpMap get_stretch_warp_map (const AudioClip &clip);
+
   template <ClipObject ClipT, typename EventsT>
   static void serialize_clip (
     const ClipT &clip,
@@ -28,9 +28,17 @@ MidiTimelineDataProvider::set_midi_events (
   rt_events->assign (events.begin (), events.end ());
 }
 
+void
+MidiTimelineDataProvider::publish_cache ()
+{
+  midi_cache_->finalize_changes ();
+  set_midi_events (midi_cache_->midi_events ());
+}
+
 void
 MidiTimelineDataProvider::clear_all_caches ()
 {
+  wait_for_cache_updates ();
   midi_cache_->clear ();
   decltype (active_midi_playback_sequence_)::ScopedAccess<
     farbot::ThreadType::nonRealtime>
@@ -42,12 +50,14 @@ void
 MidiTimelineDataProvider::remove_sequences_matching_interval_from_all_caches (
   IntervalType interval)
 {
+  wait_for_cache_updates ();
   midi_cache_->remove_sequences_matching_interval (interval);
 }
 
 std::span<const dsp::SampleBasedMidiEvent>
 MidiTimelineDataProvider::midi_events () const
 {
+  wait_for_cache_updates ();
   return midi_cache_->midi_events ();
 }
 
@@ -119,51 +129,85 @@ void
 AudioTimelineDataProvider::set_audio_clips (
   std::span<const dsp::AudioTimelineDataCache::AudioClipEntry> clips)
 {
+  dsp::AudioClipIntervalIndex index (clips);
   decltype (active_audio_clips_)::ScopedAccess<farbot::ThreadType::nonRealtime>
     rt_clips{ active_audio_clips_ };
-  rt_clips->assign (clips.begin (), clips.end ());
+  *rt_clips = std::move (index);
+}
+
+void
+AudioTimelineDataProvider::publish_cache ()
+{
+  audio_cache_->finalize_changes ();
+  set_audio_clips (audio_cache_->audio_clips ());
 }
 
 void
 AudioTimelineDataProvider::clear_all_caches ()
 {
+  wait_for_cache_updates ();
   audio_cache_->clear ();
   decltype (active_audio_clips_)::ScopedAccess<farbot::ThreadType::nonRealtime>
     rt_clips{ active_audio_clips_ };
-  rt_clips->clear ();
+  *rt_clips = dsp::AudioClipIntervalIndex{};
 }
 
-void
-AudioTimelineDataProvider::cache_audio_clip (const arrangement::AudioClip &clip)
+TimelineDataProvider::CacheChange
+AudioTimelineDataProvider::cache_audio_clip (
+  const arrangement::AudioClip &clip,
+  size_t                        tempo_hash)
 {
-  // Audio clip processing
-  auto audio_buffer = std::make_unique<juce::AudioSampleBuffer> ();
+  const auto interval = std::make_pair (
+    clip.get_tempo_map ().tick_to_samples_rounded (clip.position ()->asTick ()),
+    clip.get_end_position_samples (true));
 
-  // Serialize the audio clip
-  arrangement::ClipRenderer::serialize_to_buffer (clip, *audio_buffer);
+  // Clips that don't need stretching are rendered during playback from their
+  // source frames
+  if (auto lazy_clip = arrangement::ClipRenderer::get_lazy_clip (clip))
+    {
+      return [this, interval, lazy_clip = std::move (*lazy_clip)] () {
+        audio_cache_->add_lazy_audio_clip (interval, lazy_clip);
+      };
+    }
 
-  // Add to cache with proper timing
-  audio_cache_->add_audio_clip (
-    std::make_pair (
-      clip.get_tempo_map ().tick_to_samples_rounded (clip.position ()->asTick ()),
-      clip.get_end_position_samples (true)),
-    *audio_buffer);
+  // Other clips are rendered during playback from their stretched frames
+  // (gain and fades are not part of the stretched frames, so changing them
+  // doesn't require stretching again)
+  auto hash = arrangement::ClipRenderer::content_hash (clip);
+  boost::hash_combine (hash, tempo_hash);
+  auto stretched = rendered_stretched_clips_.get_or_render (
+    clip.get_uuid (), hash,
+    [&] () {
+      return arrangement::ClipRenderer::prepare_stretched_frames (clip);
+    });
+
+  return [this, interval,
+          stretched_clip = arrangement::ClipRenderer::get_stretched_clip (clip),
+          stretched = std::move (stretched)] () {
+    auto lazy_clip = stretched_clip;
+    // shares ownership of the cached render
+    lazy_clip.frames = std::shared_ptr<const juce::AudioSampleBuffer> (
+      stretched, &stretched->get ());
+    audio_cache_->add_lazy_audio_clip (interval, std::move (lazy_clip));
+  };
 }
 
 void
 AudioTimelineDataProvider::remove_sequences_matching_interval_from_all_caches (
   IntervalType interval)
 {
+  wait_for_cache_updates ();
   audio_cache_->remove_sequences_matching_interval (interval);
 }
 
 std::span<const dsp::AudioTimelineDataCache::AudioClipEntry>
 AudioTimelineDataProvider::audio_clips () const
 {
+  wait_for_cache_updates ();
   return audio_cache_->audio_clips ();
 }
 
-void
+bool
 AudioTimelineDataProvider::process_audio_events (
   const dsp::graph::ProcessBlockInfo &time_nfo,
   dsp::ITransport::PlayState          transport_state,
@@ -183,7 +227,7 @@ AudioTimelineDataProvider::process_audio_events (
       // Update tracking for next time
       next_expected_transport_position_ =
         current_transport_position + time_nfo.nframes_;
-      return;
+      return false;
     }
 
   decltype (active_audio_clips_)::ScopedAccess<farbot::ThreadType::realtime>
@@ -197,11 +241,28 @@ AudioTimelineDataProvider::process_audio_events (
       z_debug (
         "process_audio_events: start_frame={}, end_frame={}, nframes_={}",
         start_frame, end_frame, time_nfo.nframes_);
-      z_debug ("Processing {} audio clips", audio_clips->size ());
+      z_debug ("Processing {} audio clips", audio_clips->clips ().size ());
+    }
+
+  // How far ahead streamed clips get their first frames requested
+  static constexpr auto STREAM_LOOKAHEAD = units::samples (1 << 17);
+
+  // Ask the prefetcher to load the start of upcoming streamed clips
+  for (
+    const auto &clip :
+    audio_clips->clips_starting_in (end_frame, end_frame + STREAM_LOOKAHEAD))
+    {
+      if (clip.lazy.stream != nullptr)
+        {
+          clip.lazy.stream->request (clip.lazy.clip_start);
+        }
     }
 
   // Process each audio clip that overlaps with the current time range
-  for (const auto &clip : *audio_clips)
+  bool wrote_output = false;
+  for (
+    const auto &clip :
+    audio_clips->find_overlap_candidates (start_frame, end_frame))
     {
       if constexpr (TIMELINE_DATA_PROVIDER_DEBUG)
         {
@@ -249,6 +310,28 @@ AudioTimelineDataProvider::process_audio_events (
             output_offset);
         }
 
+      if (clip.is_lazy ())
+        {
+          const auto output_limit = std::min (
+            static_cast<int64_t> (time_nfo.nframes_.in (units::samples)),
+            static_cast<int64_t> (
+              std::min (output_left.size (), output_right.size ())));
+          const auto len = std::min (
+            overlap_length.in (units::samples),
+            output_limit - output_offset.in (units::samples));
+          if (len > 0)
+            {
+              const auto out_offset =
+                static_cast<size_t> (output_offset.in (units::samples));
+              clip.lazy.mix (
+                buffer_offset,
+                output_left.subspan (out_offset, static_cast<size_t> (len)),
+                output_right.subspan (out_offset, static_cast<size_t> (len)));
+              wrote_output = true;
+            }
+          continue;
+        }
+
       // Get the audio buffer from the clip
       const auto &audio_buffer = clip.audio_buffer;
       if (audio_buffer.getNumSamples () == 0)
@@ -303,6 +386,7 @@ AudioTimelineDataProvider::process_audio_events (
                 z_debug ("Non-positive actual overlap length, skipping");
               continue;
             }
+          wrote_output = true;
 
           if (TIMELINE_DATA_PROVIDER_DEBUG)
             {
@@ -375,6 +459,7 @@ AudioTimelineDataProvider::process_audio_events (
   // Update tracking for next time
   next_expected_transport_position_ =
     current_transport_position + time_nfo.nframes_;
+  return wrote_output;
 }
 
 // ========== AutomationTimelineDataProvider Implementation ==========
@@ -390,9 +475,17 @@ AutomationTimelineDataProvider::set_automation_sequences (
   rt_sequences->assign (sequences.begin (), sequences.end ());
 }
 
+void
+AutomationTimelineDataProvider::publish_cache ()
+{
+  automation_cache_->finalize_changes ();
+  set_automation_sequences (automation_cache_->automation_sequences ());
+}
+
 void
 AutomationTimelineDataProvider::clear_all_caches ()
 {
+  wait_for_cache_updates ();
   automation_cache_->clear ();
   decltype (active_automation_sequences_)::ScopedAccess<
     farbot::ThreadType::nonRealtime>
@@ -404,12 +497,14 @@ void
 AutomationTimelineDataProvider::
   remove_sequences_matching_interval_from_all_caches (IntervalType interval)
 {
+  wait_for_cache_updates ();
   automation_cache_->remove_sequences_matching_interval (interval);
 }
 
 std::span<const dsp::AutomationTimelineDataCache::AutomationCacheEntry>
 AutomationTimelineDataProvider::automation_sequences () const
 {
+  wait_for_cache_updates ();
   return automation_cache_->automation_sequences ();
 }
 
@@ -438,15 +533,16 @@ eval_segment (
 }
 } // namespace
 
-std::optional<float>
-AutomationTimelineDataProvider::evaluate_at_sample (
+AutomationTimelineDataProvider::ValueSource
+AutomationTimelineDataProvider::find_value_source (
   const std::vector<dsp::AutomationTimelineDataCache::AutomationCacheEntry>
                  &sequences,
-  units::sample_t sample_position) noexcept [[clang::nonblocking]]
+  units::sample_t sample_position,
+  units::sample_t limit) noexcept [[clang::nonblocking]]
 {
   using Seg = dsp::AutomationTimelineDataCache::CachedAutomationSegment;
 
-  std::optional<float> last_known_value;
+  ValueSource source{ .valid_until = limit };
 
   for (const auto &entry : sequences)
     {
@@ -455,11 +551,15 @@ AutomationTimelineDataProvider::evaluate_at_sample (
         && sample_position < entry.end_sample)
         {
           if (entry.segments.empty ())
-            return std::nullopt;
+            {
+              return { .valid_until = std::min (limit, entry.end_sample) };
+            }
 
           // Binary search: find the last segment whose start_sample <= query.
           auto it = std::ranges::upper_bound (
             entry.segments, sample_position, {}, &Seg::start_sample);
+          const auto next_segment_start =
+            it != entry.segments.end () ? it->start_sample : entry.end_sample;
           if (it != entry.segments.begin ())
             --it;
 
@@ -467,33 +567,54 @@ AutomationTimelineDataProvider::evaluate_at_sample (
             it != entry.segments.end () && sample_position >= it->start_sample
             && sample_position < it->end_sample)
             {
-              const auto &seg = *it;
-              const auto  seg_samples = static_cast<double> (
-                (seg.end_sample - seg.start_sample).in (units::samples));
-              if (seg_samples <= 0.0)
-                return seg.point_a_value;
-
-              const double sub_ratio = std::clamp (
-                static_cast<double> (
-                  (sample_position - seg.start_sample).in (units::samples))
-                  / seg_samples,
-                0.0, 1.0);
-              const double full_ratio =
-                seg.ratio_start + (seg.ratio_end - seg.ratio_start) * sub_ratio;
-
-              return eval_segment (seg, full_ratio);
+              return {
+                .segment = &*it,
+                .valid_until = std::min (limit, it->end_sample),
+              };
             }
+
+          // Between segments: the value changes at the next segment
+          source.valid_until =
+            std::min (source.valid_until, next_segment_start);
         }
 
       // Track last known value for latched hold behavior.
       if (entry.end_sample <= sample_position && !entry.segments.empty ())
         {
           const auto &last_seg = entry.segments.back ();
-          last_known_value = eval_segment (last_seg, last_seg.ratio_end);
+          source.value = eval_segment (last_seg, last_seg.ratio_end);
         }
     }
 
-  return last_known_value;
+  return source;
+}
+
+std::optional<float>
+AutomationTimelineDataProvider::evaluate_at_sample (
+  const std::vector<dsp::AutomationTimelineDataCache::AutomationCacheEntry>
+                 &sequences,
+  units::sample_t sample_position) noexcept [[clang::nonblocking]]
+{
+  const auto source = find_value_source (
+    sequences, sample_position, sample_position + units::samples (1));
+  if (source.segment == nullptr)
+    return source.value;
+
+  const auto &seg = *source.segment;
+  const auto  seg_samples = static_cast<double> (
+    (seg.end_sample - seg.start_sample).in (units::samples));
+  if (seg_samples <= 0.0)
+    return seg.point_a_value;
+
+  const double sub_ratio = std::clamp (
+    static_cast<double> (
+      (sample_position - seg.start_sample).in (units::samples))
+      / seg_samples,
+    0.0, 1.0);
+  const double full_ratio =
+    seg.ratio_start + (seg.ratio_end - seg.ratio_start) * sub_ratio;
+
+  return eval_segment (seg, full_ratio);
 }
 
 std::optional<float>
@@ -506,6 +627,61 @@ AutomationTimelineDataProvider::get_automation_value_rt (
   return evaluate_at_sample (*sequences, sample_position);
 }
 
+void
+AutomationTimelineDataProvider::fill_automation_values_rt (
+  units::sample_t  start_position,
+  std::span<float> values) noexcept
+{
+  decltype (active_automation_sequences_)::ScopedAccess<
+    farbot::ThreadType::realtime>
+              sequences{ active_automation_sequences_ };
+  const auto &seq_ref = *sequences;
+
+  const auto end_position = start_position + units::samples (values.size ());
+  auto       run_start = start_position;
+  while (run_start < end_position)
+    {
+      // The source of the value can only change at the start or end of an
+      // entry or segment
+      auto run_end = end_position;
+      for (const auto &entry : seq_ref)
+        {
+          if (entry.start_sample > run_start)
+            run_end = std::min (run_end, entry.start_sample);
+          if (entry.end_sample > run_start)
+            run_end = std::min (run_end, entry.end_sample);
+        }
+      const auto source = find_value_source (seq_ref, run_start, run_end);
+      run_end = source.valid_until;
+
+      auto run = values.subspan (
+        static_cast<size_t> ((run_start - start_position).in (units::samples)),
+        static_cast<size_t> ((run_end - run_start).in (units::samples)));
+      if (source.segment != nullptr)
+        {
+          const auto  &seg = *source.segment;
+          const auto   seg_samples = static_cast<double> (
+            (seg.end_sample - seg.start_sample).in (units::samples));
+          const double ratio_step =
+            (seg.ratio_end - seg.ratio_start) / seg_samples;
+          const double ratio_start =
+            seg.ratio_start
+            + ratio_step
+                * static_cast<double> (
+                  (run_start - seg.start_sample).in (units::samples));
+          dsp::evaluate_curve_block (
+            seg.point_a_value, seg.point_b_value, seg.curve_algo,
+            seg.curve_curviness, ratio_start, ratio_step, run);
+        }
+      else if (source.value.has_value ())
+        {
+          std::ranges::fill (run, *source.value);
+        }
+
+      run_start = run_end;
+    }
+}
+
 void
 AutomationTimelineDataProvider::process_automation_events (
   const dsp::graph::ProcessBlockInfo &time_nfo,
@@ -535,6 +711,22 @@ AutomationTimelineDataProvider::process_automation_events (
 
 TimelineDataProvider::~TimelineDataProvider () = default;
 
+size_t
+TimelineDataProvider::tempo_map_hash (const dsp::TempoMap &tempo_map)
+{
+  size_t seed = 0;
+  boost::hash_combine (
+    seed, tempo_map.get_sample_rate ().in (units::sample_rate));
+  boost::hash_combine (seed, tempo_map.base_bpm ().in (units::bpm));
+  for (const auto &event : tempo_map.tempo_events ())
+    {
+      boost::hash_combine (seed, event.tick.in (units::ticks));
+      boost::hash_combine (seed, event.bpm.in (units::bpm));
+      boost::hash_combine (seed, static_cast<int> (event.curve));
+    }
+  return seed;
+}
+
 // ========== Constructor Definitions ==========
 
 MidiTimelineDataProvider::MidiTimelineDataProvider (QObject * parent)
@@ -696,57 +888,82 @@ build_segments_for_pair (
 
 } // anonymous namespace
 
-void
+TimelineDataProvider::CacheChange
 AutomationTimelineDataProvider::cache_automation_clip (
-  const arrangement::AutomationClip &clip,
-  const dsp::TempoMap               &tempo_map)
+  const arrangement::AutomationClip   &clip,
+  std::shared_ptr<const dsp::TempoMap> tempo_map,
+  size_t                               tempo_hash)
+{
+  auto hash = arrangement::ClipRenderer::content_hash (clip);
+  boost::hash_combine (hash, tempo_hash);
+  auto rendered = rendered_automation_clips_.get_or_render (
+    clip.get_uuid (), hash, [&] () {
+      return prepare_automation_clip_render (clip, std::move (tempo_map));
+    });
+
+  return [this, rendered = std::move (rendered)] () {
+    const auto &render = rendered->get ();
+    auto        entry = render.entry;
+    automation_cache_->add_automation_sequence (
+      render.interval, std::move (entry));
+  };
+}
+
+DeferredClipRender<
+  AutomationTimelineDataProvider::RenderedAutomationClip>::RenderFunc
+AutomationTimelineDataProvider::prepare_automation_clip_render (
+  const arrangement::AutomationClip   &clip,
+  std::shared_ptr<const dsp::TempoMap> tempo_map)
 {
   const auto start_sample =
-    tempo_map.tick_to_samples_rounded (clip.position ()->asTick ());
+    tempo_map->tick_to_samples_rounded (clip.position ()->asTick ());
   const auto end_sample = clip.get_end_position_samples (true);
-
-  dsp::AutomationTimelineDataCache::AutomationCacheEntry entry;
-
-  std::vector<arrangement::ClipRenderer::RenderedAutomationPoint> rendered_points;
-  arrangement::ClipRenderer::serialize_to_points (clip, rendered_points);
-
-  if (!rendered_points.empty ())
-    {
-      const auto clip_pos = clip.position ()->asTick ();
-
-      // Build constant-tempo segments between adjacent control points.
-      for (size_t i = 0; i + 1 < rendered_points.size (); ++i)
-        {
-          const auto &a = rendered_points[i];
-          const auto &b = rendered_points[i + 1];
-          build_segments_for_pair (
-            entry.segments, tempo_map, clip_pos + a.position,
-            clip_pos + b.position, clip_pos + a.curve_origin_start,
-            clip_pos + a.curve_origin_end, a.curve_origin_value_a,
-            a.curve_origin_value_b, a.curve_algo, a.curve_curviness);
-        }
-
-      // Flat hold after the last point to clip end.
-      const auto &last = rendered_points.back ();
-      const auto  last_sample =
-        tempo_map.tick_to_samples_rounded (clip_pos + last.position);
-      if (end_sample > last_sample)
-        {
-          Seg seg;
-          seg.start_sample = last_sample;
-          seg.end_sample = end_sample;
-          seg.ratio_start = 1.0f;
-          seg.ratio_end = 1.0f;
-          seg.point_a_value = last.value;
-          seg.point_b_value = last.value;
-          seg.curve_algo = dsp::CurveOptions::Algorithm::Exponent;
-          seg.curve_curviness = 0.0f;
-          entry.segments.push_back (std::move (seg));
-        }
-    }
-
-  automation_cache_->add_automation_sequence (
-    std::make_pair (start_sample, end_sample), std::move (entry));
+  const auto clip_pos = clip.position ()->asTick ();
+
+  auto rendered_points = std::make_shared<
+    std::vector<arrangement::ClipRenderer::RenderedAutomationPoint>> ();
+  arrangement::ClipRenderer::serialize_to_points (clip, *rendered_points);
+
+  return [rendered_points = std::move (rendered_points),
+          tempo_map = std::move (tempo_map), start_sample, end_sample,
+          clip_pos] () {
+    RenderedAutomationClip ret;
+    ret.interval = std::make_pair (start_sample, end_sample);
+    auto &entry = ret.entry;
+    if (rendered_points->empty ())
+      return ret;
+
+    // Build constant-tempo segments between adjacent control points.
+    for (size_t i = 0; i + 1 < rendered_points->size (); ++i)
+      {
+        const auto &a = (*rendered_points)[i];
+        const auto &b = (*rendered_points)[i + 1];
+        build_segments_for_pair (
+          entry.segments, *tempo_map, clip_pos + a.position,
+          clip_pos + b.position, clip_pos + a.curve_origin_start,
+          clip_pos + a.curve_origin_end, a.curve_origin_value_a,
+          a.curve_origin_value_b, a.curve_algo, a.curve_curviness);
+      }
+
+    // Flat hold after the last point to clip end.
+    const auto &last = rendered_points->back ();
+    const auto  last_sample =
+      tempo_map->tick_to_samples_rounded (clip_pos + last.position);
+    if (end_sample > last_sample)
+      {
+        Seg seg;
+        seg.start_sample = last_sample;
+        seg.end_sample = end_sample;
+        seg.ratio_start = 1.0f;
+        seg.ratio_end = 1.0f;
+        seg.point_a_value = last.value;
+        seg.point_b_value = last.value;
+        seg.curve_algo = dsp::CurveOptions::Algorithm::Exponent;
+        seg.curve_curviness = 0.0f;
+        entry.segments.push_back (std::move (seg));
+      }
+    return ret;
+  };
 }
 
 } // namespace zrythm::structure::arrangement
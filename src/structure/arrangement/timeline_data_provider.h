@@ -3,19 +3,156 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "dsp/graph_node.h"
 #include "dsp/itransport.h"
 #include "dsp/midi_event_buffer.h"
 #include "dsp/timeline_data_cache.h"
 #include "structure/arrangement/clip_renderer.h"
+#include "utils/coalescing_task_runner.h"
 #include "utils/expandable_tick_range.h"
+#include "utils/logger.h"
 #include "utils/qt.h"
 
+#include <boost/container_hash/hash.hpp>
+
 #include <farbot/RealtimeObject.hpp>
 
 namespace zrythm::structure::arrangement
 {
 
+/**
+ * @brief Statistics about reusing clip renders.
+ */
+struct ClipRenderStats
+{
+  /** Number of clips rendered. */
+  uint64_t renders{};
+
+  /** Number of clips whose previous render was reused. */
+  uint64_t reuses{};
+};
+
+/**
+ * @brief A clip render that is done the first time it's needed.
+ *
+ * The clip is read when creating this (on the thread the clip lives in),
+ * while the render function only uses what it captured, so get() may be
+ * called from any thread.
+ */
+template <typename RenderT> class DeferredClipRender
+{
+public:
+  using RenderFunc = std::function<RenderT ()>;
+
+  explicit DeferredClipRender (RenderFunc render_func)
+      : render_func_ (std::move (render_func))
+  {
+  }
+
+  /**
+   * @brief Renders the clip on the first call and returns the render.
+   *
+   * If the render function throws, the exception is propagated and the next
+   * call renders again.
+   */
+  const RenderT &get () const
+  {
+    std::call_once (rendered_, [this] () {
+      render_.emplace (render_func_ ());
+
+      // release what the function captured
+      render_func_ = nullptr;
+    });
+    return *render_;
+  }
+
+private:
+  mutable std::once_flag         rendered_;
+  mutable RenderFunc             render_func_;
+  mutable std::optional<RenderT> render_;
+};
+
+/**
+ * @brief Clip renders kept between cache regenerations.
+ *
+ * A clip's render is reused as long as its hash (see
+ * ClipRenderer::content_hash() - combined with anything else the render
+ * depends on, like the tempo map) doesn't change.
+ *
+ * Renders are deferred (see DeferredClipRender) so that they are done by the
+ * cache update runner instead of the thread reading the clips.
+ *
+ * Renders of removed clips are dropped on the next full pass.
+ */
+template <typename RenderT> class RenderedClipCache
+{
+public:
+  using Render = DeferredClipRender<RenderT>;
+
+  /**
+   * @brief Returns the cached render of the clip if its hash matches,
+   * otherwise caches a new render.
+   *
+   * @param prepare_render Reads the clip and returns the function that
+   * renders it (only called if the render can't be reused).
+   */
+  std::shared_ptr<const Render> get_or_render (
+    const ArrangerObjectUuid &clip_id,
+    size_t                    hash,
+    std::invocable auto      &&prepare_render)
+  {
+    auto &entry = entries_[clip_id];
+    entry.last_pass = pass_;
+    if (entry.render != nullptr && entry.hash == hash)
+      {
+        ++stats_.reuses;
+        return entry.render;
+      }
+
+    ++stats_.renders;
+    entry.hash = hash;
+    entry.render = std::make_shared<const Render> (prepare_render ());
+    return entry.render;
+  }
+
+  /**
+   * @brief To be called before going through all clips.
+   */
+  void begin_full_pass () { ++pass_; }
+
+  /**
+   * @brief Drops the renders of clips not seen since begin_full_pass().
+   */
+  void end_full_pass ()
+  {
+    std::erase_if (entries_, [this] (const auto &kv) {
+      return kv.second.last_pass != pass_;
+    });
+  }
+
+  size_t          size () const { return entries_.size (); }
+  ClipRenderStats stats () const { return stats_; }
+
+private:
+  struct Entry
+  {
+    size_t                        hash{};
+    std::shared_ptr<const Render> render;
+    uint64_t                      last_pass{};
+  };
+
+  std::unordered_map<ArrangerObjectUuid, Entry> entries_;
+  uint64_t                                      pass_{};
+  ClipRenderStats                               stats_;
+};
+
 /**
  * @brief Base class for timeline data providers.
  *
@@ -41,6 +178,14 @@ public:
    *
    * To be called as needed from the UI thread when a new cache is requested.
    *
+   * Clips are read on the calling thread (reusing the previous render of
+   * clips whose content didn't change). New renders are done and the cache is
+   * updated, finalized and published to the realtime thread in the
+   * background: this returns before the new events are used. Updates queued
+   * while a previous one is in progress are applied together and a
+   * full-content update drops the queued updates it supersedes. See
+   * wait_for_cache_updates().
+   *
    * @tparam ClipType Either MidiClip, AudioClip, ChordClip, or
    * AutomationClip
    * @param self The derived class instance (explicit this parameter)
@@ -71,28 +216,25 @@ public:
         units::samples (static_cast<int64_t> (0)),
         units::samples (std::numeric_limits<int64_t>::max ()));
     }();
+    const bool full_content = affected_range.is_full_content ();
+    const auto tempo_hash = tempo_map_hash (tempo_map);
 
-    // Remove existing caches at given interval (or all caches if no interval
-    // given)
-
-    if (affected_range.is_full_content ())
-      {
-        self.get_base_cache ()->clear ();
-      }
-    else
-      {
-        self.get_base_cache ()->remove_sequences_matching_interval (
-          sample_interval);
-      }
+    // Copy used by the renders (done after this returns)
+    const auto render_tempo_map =
+      std::make_shared<const dsp::TempoMap> (tempo_map);
 
     const auto clips_inside_interval_filter_func =
-      [&affected_range, sample_interval] (const auto &clip) {
-        if (affected_range.is_full_content ())
+      [full_content, sample_interval] (const auto &clip) {
+        if (full_content)
           return true;
 
         return clip->is_hit_by_range (sample_interval);
       };
 
+    // Changes to apply to the cache (clips must only be accessed here, so
+    // these only capture data read from the clips)
+    std::vector<CacheChange> cache_changes;
+
     const auto cache_clip = [&] (const auto * r) {
       // Skip muted clips
       if (r->mute ()->muted ())
@@ -102,26 +244,81 @@ public:
         std::is_same_v<ClipType, arrangement::MidiClip>
         || std::is_same_v<ClipType, arrangement::ChordClip>)
         {
-          self.cache_midi_clip (*r, tempo_map);
+          cache_changes.push_back (
+            self.cache_midi_clip (*r, render_tempo_map, tempo_hash));
         }
       else if constexpr (std::is_same_v<ClipType, arrangement::AudioClip>)
         {
-          self.cache_audio_clip (*r);
+          cache_changes.push_back (self.cache_audio_clip (*r, tempo_hash));
         }
       else if constexpr (std::is_same_v<ClipType, arrangement::AutomationClip>)
         {
-          self.cache_automation_clip (*r, tempo_map);
+          cache_changes.push_back (
+            self.cache_automation_clip (*r, render_tempo_map, tempo_hash));
         }
     };
 
-    // Go through each clip and add a cache
+    // Go through each clip and prepare its render
+    constexpr bool has_rendered_clips =
+      requires { self.template rendered_clips<ClipType> (); };
+    if constexpr (has_rendered_clips)
+      {
+        if (full_content)
+          self.template rendered_clips<ClipType> ().begin_full_pass ();
+      }
     std::ranges::for_each (
       std::views::filter (clips, clips_inside_interval_filter_func), cache_clip);
+    if constexpr (has_rendered_clips)
+      {
+        if (full_content)
+          self.template rendered_clips<ClipType> ().end_full_pass ();
+      }
+
+    // Remove existing caches at given interval (or all caches if no interval
+    // given) and add the new ones in the background. Finalizing and
+    // publishing is done by the runner once no more updates are queued.
+    auto update_cache = [cache = self.get_base_cache (), full_content,
+                         sample_interval,
+                         cache_changes = std::move (cache_changes)] () {
+      if (full_content)
+        {
+          cache->clear ();
+        }
+      else
+        {
+          cache->remove_sequences_matching_interval (sample_interval);
+        }
 
-    // Finalize
-    self.get_base_cache ()->finalize_changes ();
+      for (const auto &change : cache_changes)
+        {
+          // a clip that fails to render shouldn't affect the others
+          try
+            {
+              change ();
+            }
+          catch (const std::exception &e)
+            {
+              z_warning ("Failed to render clip: {}", e.what ());
+            }
+        }
+    };
+    if (full_content)
+      {
+        self.cache_update_runner ().queue_replacing_pending (
+          std::move (update_cache));
+      }
+    else
+      {
+        self.cache_update_runner ().queue (std::move (update_cache));
+      }
   }
 
+  /**
+   * @brief Blocks until the updates queued by generate_events() are applied
+   * and published.
+   */
+  void wait_for_cache_updates () const { cache_update_runner ().wait (); }
+
   virtual void clear_all_caches () = 0;
   virtual void
   remove_sequences_matching_interval_from_all_caches (IntervalType interval) = 0;
@@ -129,7 +326,34 @@ public:
   virtual const dsp::TimelineDataCache * get_base_cache () const = 0;
 
 protected:
+  /**
+   * @brief A change to the cache, run on the cache update thread.
+   */
+  using CacheChange = std::function<void ()>;
+
   virtual dsp::TimelineDataCache * get_base_cache () = 0;
+
+  /**
+   * @brief Returns the runner that applies the cache updates.
+   *
+   * Derived classes declare it last so that it's destroyed (waiting for the
+   * running update) before the cache.
+   */
+  virtual utils::CoalescingTaskRunner &cache_update_runner () const = 0;
+
+  /**
+   * @brief Finalizes the cache and publishes it for realtime access.
+   *
+   * Called by the cache update runner.
+   */
+  virtual void publish_cache () = 0;
+
+  /**
+   * @brief Returns a hash of the tempo map, to be combined with the content
+   * hash of clips whose render depends on it.
+   */
+  static size_t tempo_map_hash (const dsp::TempoMap &tempo_map);
+
   /** Last transport state we've seen */
   dsp::ITransport::PlayState last_seen_transport_state_{
     dsp::ITransport::PlayState::Paused
@@ -169,13 +393,17 @@ public:
   void remove_sequences_matching_interval_from_all_caches (
     IntervalType interval) override;
 
+  /**
+   * @brief Returns the cached MIDI events (after waiting for pending cache
+   * updates).
+   */
   std::span<const dsp::SampleBasedMidiEvent> midi_events () const;
 
   /**
    * @brief Generate the MIDI event sequence to be used during realtime
    * processing.
    *
-   * To be called as needed from the UI thread when a new cache is requested.
+   * Same as generate_events() but returns after the events are published.
    *
    * @param tempo_map The tempo map for timing conversion.
    * @param midi_clips The MIDI clips to process.
@@ -188,14 +416,14 @@ public:
   {
     generate_events<arrangement::MidiClip> (
       tempo_map, midi_clips, affected_range);
-    set_midi_events (midi_cache_->midi_events ());
+    wait_for_cache_updates ();
   }
 
   /**
    * @brief Generate the MIDI event sequence to be used during realtime
    * processing.
    *
-   * To be called as needed from the UI thread when a new cache is requested.
+   * Same as generate_events() but returns after the events are published.
    *
    * @param tempo_map The tempo map for timing conversion.
    * @param chord_clips The Chord clips to process.
@@ -208,7 +436,20 @@ public:
   {
     generate_events<arrangement::ChordClip> (
       tempo_map, chord_clips, affected_range);
-    set_midi_events (midi_cache_->midi_events ());
+    wait_for_cache_updates ();
+  }
+
+  /**
+   * @brief Returns statistics about reusing clip renders.
+   */
+  ClipRenderStats render_stats () const
+  {
+    const auto midi_stats = rendered_midi_clips_.stats ();
+    const auto chord_stats = rendered_chord_clips_.stats ();
+    return {
+      .renders = midi_stats.renders + chord_stats.renders,
+      .reuses = midi_stats.reuses + chord_stats.reuses,
+    };
   }
 
 protected:
@@ -217,42 +458,92 @@ protected:
     return midi_cache_.get ();
   }
 
+  utils::CoalescingTaskRunner &cache_update_runner () const override
+  {
+    return cache_update_runner_;
+  }
+
+  void publish_cache () override;
+
 private:
   /**
-   * Caches a MIDI-like clip (MidiClip or ChordClip) to the MIDI cache.
+   * @brief A MIDI-like clip's events (in timeline samples).
    */
-  template <typename MidiClipType>
-  void
-  cache_midi_clip (const MidiClipType &clip, const dsp::TempoMap &tempo_map)
+  struct RenderedMidiClip
   {
-    // MIDI clip processing
-    juce::MidiMessageSequence clip_seq;
+    IntervalType                           interval;
+    std::vector<dsp::SampleBasedMidiEvent> events;
+  };
 
-    // Serialize clip (timings in timeline ticks)
-    arrangement::ClipRenderer::serialize_to_sequence (clip, clip_seq);
-    clip_seq.addTimeToMessages (clip.position ()->ticks ());
+  template <typename MidiClipType> auto &rendered_clips ()
+  {
+    if constexpr (std::is_same_v<MidiClipType, arrangement::ChordClip>)
+      return rendered_chord_clips_;
+    else
+      return rendered_midi_clips_;
+  }
 
-    // Convert JUCE sequence to native events with sample timestamps
-    std::vector<dsp::SampleBasedMidiEvent> native_events;
-    native_events.reserve (clip_seq.getNumEvents ());
-    for (const auto &event : clip_seq)
-      {
-        const auto sample_time = tempo_map.tick_to_samples_rounded (
-          dsp::TimelineTick{ units::ticks (event->message.getTimeStamp ()) });
-        const auto * raw = event->message.getRawData ();
-        const auto   raw_size =
-          static_cast<size_t> (event->message.getRawDataSize ());
-        native_events.push_back (
-          dsp::midi_event::make_raw (
-            std::span<const midi_byte_t>{ raw, raw_size }, sample_time));
-      }
+  /**
+   * Renders a MIDI-like clip (MidiClip or ChordClip) for the MIDI cache.
+   */
+  template <typename MidiClipType>
+  CacheChange cache_midi_clip (
+    const MidiClipType                  &clip,
+    std::shared_ptr<const dsp::TempoMap> tempo_map,
+    size_t                               tempo_hash)
+  {
+    auto hash = arrangement::ClipRenderer::content_hash (clip);
+    boost::hash_combine (hash, tempo_hash);
+    auto rendered = rendered_clips<MidiClipType> ().get_or_render (
+      clip.get_uuid (), hash,
+      [&] () {
+        return prepare_midi_clip_render (clip, std::move (tempo_map));
+      });
+
+    return [this, rendered = std::move (rendered)] () {
+      const auto &render = rendered->get ();
+      midi_cache_->add_midi_sequence (render.interval, render.events);
+    };
+  }
 
-    // Add to cache
-    midi_cache_->add_midi_sequence (
-      std::make_pair (
-        tempo_map.tick_to_samples_rounded (clip.position ()->asTick ()),
-        clip.get_end_position_samples (true)),
-      native_events);
+  /**
+   * @brief Serializes the clip and returns the function that converts the
+   * serialized events to timeline samples.
+   */
+  template <typename MidiClipType>
+  static DeferredClipRender<RenderedMidiClip>::RenderFunc
+  prepare_midi_clip_render (
+    const MidiClipType                  &clip,
+    std::shared_ptr<const dsp::TempoMap> tempo_map)
+  {
+    // Serialize clip (timings in timeline ticks)
+    auto clip_seq = std::make_shared<juce::MidiMessageSequence> ();
+    arrangement::ClipRenderer::serialize_to_sequence (clip, *clip_seq);
+    clip_seq->addTimeToMessages (clip.position ()->ticks ());
+
+    const auto interval = std::make_pair (
+      tempo_map->tick_to_samples_rounded (clip.position ()->asTick ()),
+      clip.get_end_position_samples (true));
+
+    return [clip_seq = std::move (clip_seq), tempo_map = std::move (tempo_map),
+            interval] () {
+      // Convert JUCE sequence to native events with sample timestamps
+      RenderedMidiClip ret;
+      ret.interval = interval;
+      ret.events.reserve (clip_seq->getNumEvents ());
+      for (const auto &event : *clip_seq)
+        {
+          const auto sample_time = tempo_map->tick_to_samples_rounded (
+            dsp::TimelineTick{ units::ticks (event->message.getTimeStamp ()) });
+          const auto * raw = event->message.getRawData ();
+          const auto   raw_size =
+            static_cast<size_t> (event->message.getRawDataSize ());
+          ret.events.push_back (
+            dsp::midi_event::make_raw (
+              std::span<const midi_byte_t>{ raw, raw_size }, sample_time));
+        }
+      return ret;
+    };
   }
 
   /**
@@ -268,6 +559,13 @@ private:
     std::vector<dsp::SampleBasedMidiEvent>,
     farbot::RealtimeObjectOptions::nonRealtimeMutatable>
     active_midi_playback_sequence_;
+
+  RenderedClipCache<RenderedMidiClip> rendered_midi_clips_;
+  RenderedClipCache<RenderedMidiClip> rendered_chord_clips_;
+
+  mutable utils::CoalescingTaskRunner cache_update_runner_{ [this] () {
+    publish_cache ();
+  } };
 };
 
 /**
@@ -290,8 +588,10 @@ public:
 
   /**
    * Process audio events for the given time range.
+   *
+   * @return Whether any clip was mixed into the outputs.
    */
-  void process_audio_events (
+  bool process_audio_events (
     const dsp::graph::ProcessBlockInfo &time_nfo,
     dsp::ITransport::PlayState          transport_state,
     std::span<float>                    output_left,
@@ -301,6 +601,10 @@ public:
   void remove_sequences_matching_interval_from_all_caches (
     IntervalType interval) override;
 
+  /**
+   * @brief Returns the cached audio clips (after waiting for pending cache
+   * updates).
+   */
   std::span<const dsp::AudioTimelineDataCache::AudioClipEntry>
   audio_clips () const;
 
@@ -308,7 +612,7 @@ public:
    * @brief Generate the audio event sequence to be used during realtime
    * processing.
    *
-   * To be called as needed from the UI thread when a new cache is requested.
+   * Same as generate_events() but returns after the clips are published.
    *
    * @param tempo_map The tempo map for timing conversion.
    * @param audio_clips The audio clips to process.
@@ -321,7 +625,16 @@ public:
   {
     generate_events<arrangement::AudioClip> (
       tempo_map, audio_clips, affected_range);
-    set_audio_clips (audio_cache_->audio_clips ());
+    wait_for_cache_updates ();
+  }
+
+  /**
+   * @brief Returns statistics about reusing the renders of clips that need
+   * time-stretching.
+   */
+  ClipRenderStats render_stats () const
+  {
+    return rendered_stretched_clips_.stats ();
   }
 
 protected:
@@ -330,11 +643,24 @@ protected:
     return audio_cache_.get ();
   }
 
+  utils::CoalescingTaskRunner &cache_update_runner () const override
+  {
+    return cache_update_runner_;
+  }
+
+  void publish_cache () override;
+
 private:
+  template <typename ClipT> auto &rendered_clips ()
+  {
+    return rendered_stretched_clips_;
+  }
+
   /**
-   * Caches an AudioClip to the audio cache.
+   * Renders an AudioClip for the audio cache.
    */
-  void cache_audio_clip (const arrangement::AudioClip &clip);
+  CacheChange
+  cache_audio_clip (const arrangement::AudioClip &clip, size_t tempo_hash);
 
   /**
    * @brief Set the audio clips for realtime access.
@@ -347,9 +673,21 @@ private:
   utils::QObjectUniquePtr<dsp::AudioTimelineDataCache> audio_cache_;
 
   farbot::RealtimeObject<
-    std::vector<dsp::AudioTimelineDataCache::AudioClipEntry>,
+    dsp::AudioClipIntervalIndex,
     farbot::RealtimeObjectOptions::nonRealtimeMutatable>
     active_audio_clips_;
+
+  /**
+   * @brief Time-stretched frames of the clips that need stretching.
+   *
+   * Clips that don't need stretching are not rendered (see
+   * ClipRenderer::get_lazy_clip()).
+   */
+  RenderedClipCache<utils::audio::AudioBuffer> rendered_stretched_clips_;
+
+  mutable utils::CoalescingTaskRunner cache_update_runner_{ [this] () {
+    publish_cache ();
+  } };
 };
 
 /**
@@ -388,10 +726,31 @@ public:
   get_automation_value_rt (units::sample_t sample_position) noexcept
     [[clang::nonblocking]];
 
+  /**
+   * @brief Writes the automation value for each sample of a block.
+   *
+   * Sample-accurate counterpart of get_automation_value_rt(): @p values[i]
+   * is set to the value at `start_position + i`. Samples without automation
+   * are left untouched.
+   *
+   * The block is split into runs that are covered by the same curve segment
+   * and each run is evaluated at once with dsp::evaluate_curve_block().
+   *
+   * @param start_position Timeline position of the first sample.
+   * @param values Values to fill.
+   */
+  void fill_automation_values_rt (
+    units::sample_t  start_position,
+    std::span<float> values) noexcept [[clang::nonblocking]];
+
   void clear_all_caches () override;
   void remove_sequences_matching_interval_from_all_caches (
     IntervalType interval) override;
 
+  /**
+   * @brief Returns the cached automation sequences (after waiting for pending
+   * cache updates).
+   */
   std::span<const dsp::AutomationTimelineDataCache::AutomationCacheEntry>
   automation_sequences () const;
 
@@ -399,7 +758,7 @@ public:
    * @brief Generate the automation event sequence to be used during realtime
    * processing.
    *
-   * To be called as needed from the UI thread when a new cache is requested.
+   * Same as generate_events() but returns after the sequences are published.
    *
    * @param tempo_map The tempo map for timing conversion.
    * @param automation_clips The automation clips to process.
@@ -412,7 +771,15 @@ public:
   {
     generate_events<arrangement::AutomationClip> (
       tempo_map, automation_clips, affected_range);
-    set_automation_sequences (automation_cache_->automation_sequences ());
+    wait_for_cache_updates ();
+  }
+
+  /**
+   * @brief Returns statistics about reusing clip renders.
+   */
+  ClipRenderStats render_stats () const
+  {
+    return rendered_automation_clips_.stats ();
   }
 
 protected:
@@ -421,7 +788,57 @@ protected:
     return automation_cache_.get ();
   }
 
+  utils::CoalescingTaskRunner &cache_update_runner () const override
+  {
+    return cache_update_runner_;
+  }
+
+  void publish_cache () override;
+
 private:
+  /**
+   * @brief An automation clip's sequence (in timeline samples).
+   */
+  struct RenderedAutomationClip
+  {
+    IntervalType                                           interval;
+    dsp::AutomationTimelineDataCache::AutomationCacheEntry entry;
+  };
+
+  template <typename ClipT> auto &rendered_clips ()
+  {
+    return rendered_automation_clips_;
+  }
+
+  /**
+   * @brief Where the automation value at a position comes from.
+   */
+  struct ValueSource
+  {
+    /** Segment containing the position, if any. */
+    const dsp::AutomationTimelineDataCache::CachedAutomationSegment * segment{};
+
+    /** Value to use if not inside a segment (latched value), if any. */
+    std::optional<float> value;
+
+    /**
+     * @brief Position up to which the source stays the same (not
+     * considering the start or end of other entries).
+     */
+    units::sample_t valid_until;
+  };
+
+  /**
+   * @brief Finds the source of the automation value at @p sample_position.
+   *
+   * @param limit Upper bound for ValueSource::valid_until.
+   */
+  static ValueSource find_value_source (
+    const std::vector<dsp::AutomationTimelineDataCache::AutomationCacheEntry>
+                   &sequences,
+    units::sample_t sample_position,
+    units::sample_t limit) noexcept [[clang::nonblocking]];
+
   /**
    * @brief Core automation evaluation logic, separated from access
    * management so @ref process_automation_events can hoist the
@@ -433,11 +850,21 @@ private:
     units::sample_t sample_position) noexcept [[clang::nonblocking]];
 
   /**
-   * Caches an AutomationClip to the automation cache.
+   * Renders an AutomationClip for the automation cache.
+   */
+  CacheChange cache_automation_clip (
+    const arrangement::AutomationClip   &clip,
+    std::shared_ptr<const dsp::TempoMap> tempo_map,
+    size_t                               tempo_hash);
+
+  /**
+   * @brief Serializes the clip and returns the function that builds its
+   * segments.
    */
-  void cache_automation_clip (
-    const arrangement::AutomationClip &clip,
-    const dsp::TempoMap               &tempo_map);
+  static DeferredClipRender<RenderedAutomationClip>::RenderFunc
+  prepare_automation_clip_render (
+    const arrangement::AutomationClip   &clip,
+    std::shared_ptr<const dsp::TempoMap> tempo_map);
 
   /**
    * @brief Set the automation sequences for realtime access.
@@ -454,6 +881,12 @@ private:
     std::vector<dsp::AutomationTimelineDataCache::AutomationCacheEntry>,
     farbot::RealtimeObjectOptions::nonRealtimeMutatable>
     active_automation_sequences_;
+
+  RenderedClipCache<RenderedAutomationClip> rendered_automation_clips_;
+
+  mutable utils::CoalescingTaskRunner cache_update_runner_{ [this] () {
+    publish_cache ();
+  } };
 };
 
 } // namespace zrythm::structure::arrangement
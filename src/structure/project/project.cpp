@@ -167,6 +167,17 @@ Project::Project (
 {
   audio_engine_->set_monitor_out_source (monitor_fader_.get_stereo_out_port ());
 
+  // stream long audio files from disk instead of loading them into memory
+  const auto streaming_threshold = app_settings_.audioStreamingThreshold ();
+  if (streaming_threshold > 0)
+    {
+      pool_->set_streaming_threshold (
+        static_cast<double> (streaming_threshold));
+    }
+  pool_->set_page_cache_capacity (
+    static_cast<size_t> (std::max (app_settings_.audioPageCacheSize (), 0))
+    << 20);
+
   QObject::connect (
     audio_engine_.get (), &dsp::AudioEngine::sampleRateChanged,
     tempo_map_wrapper_.get (), [this] (int new_rate) {
@@ -442,18 +453,22 @@ Project::tempoObjectManager () const
 }
 
 void
-to_json (nlohmann::json &j, const Project &project)
+Project::serialize_without_registry (nlohmann::json &j) const
 {
-  j[Project::kTempoMapKey] = project.tempo_map_;
-  j[Project::kTransportKey] = project.transport_;
-  j[Project::kAudioPoolKey] = project.pool_;
-  j[Project::kTracklistKey] = project.tracklist_;
-  // j[Project::kClipLinkGroupManagerKey] =
-  // project.clip_link_group_manager_;
-  j[Project::kPortConnectionsManagerKey] = project.port_connections_manager_;
-  j[Project::kTempoObjectManagerKey] = project.tempo_object_manager_;
-  j[Project::kClipLauncherKey] = project.clip_launcher_;
+  j[kTempoMapKey] = tempo_map_;
+  j[kTransportKey] = transport_;
+  j[kAudioPoolKey] = pool_;
+  j[kTracklistKey] = tracklist_;
+  // j[kClipLinkGroupManagerKey] = clip_link_group_manager_;
+  j[kPortConnectionsManagerKey] = port_connections_manager_;
+  j[kTempoObjectManagerKey] = tempo_object_manager_;
+  j[kClipLauncherKey] = clip_launcher_;
+}
 
+void
+to_json (nlohmann::json &j, const Project &project)
+{
+  project.serialize_without_registry (j);
   j[Project::kRegistryKey] = project.project_registry_;
 }
 
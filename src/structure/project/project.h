@@ -154,6 +154,17 @@ public:
   {
     return project_registry_;
   }
+  ProjectRegistry       &get_project_registry () { return project_registry_; }
+  const ProjectRegistry &get_project_registry () const
+  {
+    return project_registry_;
+  }
+
+  /**
+   * @brief Serializes the project like to_json() does, minus the object
+   * registry.
+   */
+  void serialize_without_registry (nlohmann::json &j) const;
 
   const auto &tempo_map () const { return tempo_map_; }
 
@@ -186,9 +197,11 @@ public:
   void install_recording_callback (
     structure::tracks::TrackRecordingCallback callback);
 
+  /** Key of the object registry in serialized projects. */
+  static constexpr auto kRegistryKey = "registry"sv;
+
 private:
   static constexpr auto kTempoMapKey = "tempoMap"sv;
-  static constexpr auto kRegistryKey = "registry"sv;
   static constexpr auto kTransportKey = "transport"sv;
   static constexpr auto kAudioPoolKey = "audioPool"sv;
   static constexpr auto kTracklistKey = "tracklist"sv;
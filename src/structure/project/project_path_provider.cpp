@@ -24,6 +24,8 @@ ProjectPathProvider::get_path (ProjectPath path)
       return PROJECT_POOL_DIR;
     case ProjectPath::ProjectFile:
       return PROJECT_FILE;
+    case ProjectPath::JournalFile:
+      return PROJECT_JOURNAL_FILE;
     }
   throw std::runtime_error ("Invalid path type.");
 }
@@ -13,6 +13,7 @@ using namespace std::string_view_literals;
 class ProjectPathProvider
 {
   static constexpr auto PROJECT_FILE = "project.zpj"sv;
+  static constexpr auto PROJECT_JOURNAL_FILE = "project.journal"sv;
   static constexpr auto PROJECT_BACKUPS_DIR = "backups"sv;
   static constexpr auto PROJECT_EXPORTS_DIR = "exports"sv;
   static constexpr auto PROJECT_STEMS_DIR = "stems"sv;
@@ -26,6 +27,13 @@ public:
      */
     ProjectFile,
 
+    /**
+     * @brief Changes made since the project file was last written.
+     *
+     * @see controllers::ProjectJournal.
+     */
+    JournalFile,
+
     BackupsDir,
 
     ExportsDir,
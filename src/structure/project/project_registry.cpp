@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
+#include <ranges>
+
 #include "utils/format_qt.h"
 
 #include "dsp/file_audio_source.h"
@@ -18,7 +21,11 @@
 #include "utils/traits.h"
 #include "utils/variant_helpers.h"
 
+#include <QAbstractItemModel>
+#include <QMetaMethod>
+
 #include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
 
 namespace zrythm::structure::project
 {
@@ -65,6 +72,10 @@ struct ProjectRegistry::Impl
   boost::unordered::unordered_flat_map<QUuid, Category> uuid_to_category_;
   boost::unordered::unordered_flat_map<QUuid, int>      ref_counts_;
 
+  /** See take_changes(). */
+  boost::unordered::unordered_flat_set<QUuid> changed_ids_;
+  boost::unordered::unordered_flat_set<QUuid> removed_ids_;
+
   std::optional<DeserializationDependencies> deserialization_dependencies_;
 };
 
@@ -104,7 +115,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
       auto var = utils::convert_to_variant_qobj<dsp::PortPtrVariant> (port);
       impl_->ports_.emplace (uuid, var);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::Port);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -112,7 +123,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
     {
       impl_->params_.emplace (uuid, param);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::Param);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -122,7 +133,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
         utils::convert_to_variant_qobj<plugins::PluginPtrVariant> (plugin);
       impl_->plugins_.emplace (uuid, var);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::Plugin);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -132,7 +143,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
         structure::tracks::TrackPtrVariant> (track);
       impl_->tracks_.emplace (uuid, var);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::Track);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -142,7 +153,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
         structure::arrangement::ArrangerObjectPtrVariant> (obj);
       impl_->arranger_objects_.emplace (uuid, var);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::ArrangerObject);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -150,7 +161,7 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
     {
       impl_->file_audio_sources_.emplace (uuid, fas);
       impl_->uuid_to_category_.emplace (uuid, Impl::Category::FileAudioSource);
-      qobj->setParent (this);
+      adopt (base);
       return;
     }
 
@@ -158,6 +169,18 @@ ProjectRegistry::register_object_impl (utils::UuidIdentifiableBase &base)
     fmt::format ("Unknown object type in ProjectRegistry: {}", uuid.toString ()));
 }
 
+void
+ProjectRegistry::adopt (utils::UuidIdentifiableBase &obj)
+{
+  obj.setParent (this);
+  if (tracking_changes_)
+    {
+      impl_->removed_ids_.erase (obj.raw_uuid ());
+      impl_->changed_ids_.insert (obj.raw_uuid ());
+      track_changes_of (obj);
+    }
+}
+
 void
 ProjectRegistry::acquire_reference_impl (const QUuid &id)
 {
@@ -373,9 +396,105 @@ ProjectRegistry::delete_object_by_id (const QUuid &id)
 
   impl_->uuid_to_category_.erase (id);
   impl_->ref_counts_.erase (id);
+  if (tracking_changes_)
+    {
+      impl_->changed_ids_.erase (id);
+      impl_->removed_ids_.insert (id);
+    }
   delete raw;
 }
 
+// ============================================================================
+// Change tracking
+// ============================================================================
+
+void
+ProjectRegistry::start_change_tracking ()
+{
+  if (tracking_changes_)
+    return;
+
+  tracking_changes_ = true;
+  for (const auto &[id, category] : impl_->uuid_to_category_)
+    {
+      track_changes_of (*find_by_raw_uuid_impl (id));
+    }
+}
+
+void
+ProjectRegistry::track_changes_of (QObject &obj)
+{
+  static const auto slot = staticMetaObject.method (
+    staticMetaObject.indexOfSlot ("on_tracked_object_changed()"));
+  static const std::array model_signals{
+    QMetaMethod::fromSignal (&QAbstractItemModel::dataChanged),
+    QMetaMethod::fromSignal (&QAbstractItemModel::rowsInserted),
+    QMetaMethod::fromSignal (&QAbstractItemModel::rowsRemoved),
+    QMetaMethod::fromSignal (&QAbstractItemModel::rowsMoved),
+    QMetaMethod::fromSignal (&QAbstractItemModel::layoutChanged),
+    QMetaMethod::fromSignal (&QAbstractItemModel::modelReset),
+  };
+
+  auto objects = obj.findChildren<QObject *> ();
+  objects.prepend (&obj);
+  for (auto * o : objects)
+    {
+      const auto * meta = o->metaObject ();
+      for (const auto i : std::views::iota (0, meta->propertyCount ()))
+        {
+          const auto prop = meta->property (i);
+          if (prop.hasNotifySignal ())
+            {
+              QObject::connect (
+                o, prop.notifySignal (), this, slot, Qt::UniqueConnection);
+            }
+        }
+      if (qobject_cast<QAbstractItemModel *> (o) != nullptr)
+        {
+          for (const auto &signal : model_signals)
+            {
+              QObject::connect (o, signal, this, slot, Qt::UniqueConnection);
+            }
+        }
+    }
+}
+
+void
+ProjectRegistry::on_tracked_object_changed ()
+{
+  if (destroying_)
+    return;
+
+  // find the registered object the sender belongs to
+  auto * obj = sender ();
+  while (obj != nullptr && obj->parent () != this)
+    {
+      obj = obj->parent ();
+    }
+  if (auto * base = qobject_cast<utils::UuidIdentifiableBase *> (obj))
+    {
+      if (impl_->uuid_to_category_.contains (base->raw_uuid ()))
+        impl_->changed_ids_.insert (base->raw_uuid ());
+    }
+}
+
+ProjectRegistry::Changes
+ProjectRegistry::take_changes ()
+{
+  Changes ret;
+  for (const auto &id : impl_->changed_ids_)
+    {
+      // also track children created after the object was registered
+      track_changes_of (*find_by_raw_uuid_impl (id));
+      ret.changed.push_back (id);
+    }
+  ret.removed.assign (
+    impl_->removed_ids_.begin (), impl_->removed_ids_.end ());
+  impl_->changed_ids_.clear ();
+  impl_->removed_ids_.clear ();
+  return ret;
+}
+
 // ============================================================================
 // Serialization
 // ============================================================================
@@ -422,6 +541,46 @@ to_json (nlohmann::json &j, const ProjectRegistry &registry)
     serialize_bucket_ptr (registry.impl_->file_audio_sources_);
 }
 
+nlohmann::json
+ProjectRegistry::serialize_objects (std::span<const QUuid> ids) const
+{
+  auto       ret = nlohmann::json::object ();
+  const auto add = [&ret] (std::string_view bucket, nlohmann::json obj) {
+    const auto id = obj.at ("id").get<std::string> ();
+    ret[bucket][id] = std::move (obj);
+  };
+
+  for (const auto &id : ids)
+    {
+      const auto cat_it = impl_->uuid_to_category_.find (id);
+      if (cat_it == impl_->uuid_to_category_.end ())
+        continue;
+
+      switch (cat_it->second)
+        {
+        case Impl::Category::Port:
+          add (kPortsKey, impl_->ports_.at (id));
+          break;
+        case Impl::Category::Param:
+          add (kParametersKey, *impl_->params_.at (id));
+          break;
+        case Impl::Category::Plugin:
+          add (kPluginsKey, impl_->plugins_.at (id));
+          break;
+        case Impl::Category::Track:
+          add (kTracksKey, impl_->tracks_.at (id));
+          break;
+        case Impl::Category::ArrangerObject:
+          add (kArrangerObjectsKey, impl_->arranger_objects_.at (id));
+          break;
+        case Impl::Category::FileAudioSource:
+          add (kFileAudioSourcesKey, *impl_->file_audio_sources_.at (id));
+          break;
+        }
+    }
+  return ret;
+}
+
 // ============================================================================
 // Deserialization builders
 // ============================================================================
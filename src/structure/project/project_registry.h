@@ -3,6 +3,8 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "utils/iobject_registry.h"
 
@@ -42,6 +44,42 @@ public:
 
   void set_deserialization_dependencies (DeserializationDependencies deps);
 
+  /**
+   * @brief Objects added, changed or removed since the last take_changes().
+   */
+  struct Changes
+  {
+    /** Objects added or changed (and still registered). */
+    std::vector<QUuid> changed;
+
+    /** Objects removed. */
+    std::vector<QUuid> removed;
+
+    bool empty () const { return changed.empty () && removed.empty (); }
+  };
+
+  /**
+   * @brief Starts recording which objects are added, changed or removed.
+   *
+   * An object counts as changed when a property with a notify signal of the
+   * object (or of any of its QObject children) changes, or when an item model
+   * among its children changes. Changes that emit no signal are not recorded.
+   */
+  void start_change_tracking ();
+
+  /**
+   * @brief Returns the changes recorded since the last call and clears them.
+   */
+  Changes take_changes ();
+
+  /**
+   * @brief Serializes the given objects the same way to_json() does, keyed by
+   * bucket and then by ID.
+   *
+   * IDs that are not registered are skipped.
+   */
+  nlohmann::json serialize_objects (std::span<const QUuid> ids) const;
+
 private:
   using ObjectVisitor = utils::IObjectRegistry::ObjectVisitor;
 
@@ -60,6 +98,19 @@ private:
 
   void delete_object_by_id (const QUuid &id);
 
+  /**
+   * @brief Makes the registry the parent of a newly registered object.
+   */
+  void adopt (utils::UuidIdentifiableBase &obj);
+
+  /**
+   * @brief Connects the change signals of @p obj and its children to
+   * on_tracked_object_changed().
+   */
+  void track_changes_of (QObject &obj);
+
+  Q_SLOT void on_tracked_object_changed ();
+
   // ============================================================================
   // Serialization
   // ============================================================================
@@ -70,6 +121,7 @@ private:
 private:
   struct Impl;
   bool                  destroying_ = false;
+  bool                  tracking_changes_ = false;
   std::unique_ptr<Impl> impl_;
 };
 
@@ -32,6 +32,12 @@ AutomationTrack::AutomationTrack (
              ? automation_data_provider_->get_automation_value_rt (sample_position)
              : std::nullopt;
   });
+  parameter ()->set_automation_block_provider (
+    [this] (auto start_position, auto values) {
+      if (automation_mode_.load () == AutomationMode::Read)
+        automation_data_provider_->fill_automation_values_rt (
+          start_position, values);
+    });
 
   QObject::connect (
     get_model (), &arrangement::ArrangerObjectListModel::rowsInserted, this,
@@ -119,7 +125,7 @@ AutomationTrack::regeneratePlaybackCaches (
   utils::ExpandableTickRange affectedRange)
 {
   auto children = get_children_view ();
-  automation_data_provider_->generate_automation_events (
+  automation_data_provider_->generate_events<arrangement::AutomationClip> (
     tempo_map_.get_tempo_map (), children, affectedRange);
 
   playback_cache_activity_tracker_->onRegenerationComplete (affectedRange);
@@ -3,7 +3,6 @@
 
 #include "structure/arrangement/clip_renderer.h"
 #include "structure/tracks/clip_playback_data_provider.h"
-#include "utils/float_ranges.h"
 
 namespace zrythm::structure::tracks
 {
@@ -73,15 +72,28 @@ ClipPlaybackDataProvider::generate_audio_events (
   const arrangement::AudioClip         &audio_clip,
   structure::tracks::ClipQuantizeOption quantize_option)
 {
-  // Serialize clip
-  juce::AudioSampleBuffer audio_buffer;
-  arrangement::ClipRenderer::serialize_to_buffer (audio_clip, audio_buffer);
+  // Clips that don't need stretching are rendered during playback from their
+  // source frames, other clips from their stretched frames
+  auto lazy_clip = arrangement::ClipRenderer::get_lazy_clip (audio_clip);
+  if (!lazy_clip.has_value ())
+    {
+      lazy_clip = arrangement::ClipRenderer::get_stretched_clip (audio_clip);
+      auto stretched = std::make_shared<const utils::audio::AudioBuffer> (
+        arrangement::ClipRenderer::prepare_stretched_frames (audio_clip) ());
+      lazy_clip->frames = std::move (stretched);
+    }
+
+  // Load the start of streamed clips before they get launched
+  if (lazy_clip->stream != nullptr)
+    {
+      lazy_clip->stream->request (lazy_clip->clip_start);
+    }
 
   decltype (active_audio_playback_buffer_)::ScopedAccess<
     farbot::ThreadType::nonRealtime>
     rt_audio{ active_audio_playback_buffer_ };
   *rt_audio = AudioCache{
-    std::move (audio_buffer), quantize_option,
+    std::move (*lazy_clip), quantize_option,
     units::ticks (audio_clip.length ()->ticks ())
   };
 }
@@ -490,12 +502,13 @@ ClipPlaybackDataProvider::process_chunks_with_looping (
   internal_clip_buffer_position_ = current_internal_buffer_offset;
 }
 
-void
+bool
 ClipPlaybackDataProvider::process_audio_events (
   const dsp::graph::ProcessBlockInfo &time_nfo,
   std::span<float>                    left_buffer,
   std::span<float>                    right_buffer) noexcept
 {
+  bool wrote_output = false;
   [&] () {
     decltype (active_audio_playback_buffer_)::ScopedAccess<
       farbot::ThreadType::realtime>
@@ -507,8 +520,8 @@ ClipPlaybackDataProvider::process_audio_events (
       }
 
     const auto &cache = cache_opt->value ();
-    const auto &audio_buffer = cache.audio_buffer_;
-    if (audio_buffer.getNumSamples () == 0)
+    const auto &clip = cache.clip_;
+    if (clip.content_length <= units::samples (0))
       {
         return;
       }
@@ -544,50 +557,35 @@ ClipPlaybackDataProvider::process_audio_events (
         units::sample_t samples_to_process_in_chunk,
         units::sample_t total_samples_processed,
         units::sample_t output_buffer_timestamp_offset) {
-        // Calculate the number of samples to copy
+        // Calculate the number of samples to render
         const auto samples_to_copy = std::min (
           samples_to_process_in_chunk.as<int64_t> (units::samples),
-          units::samples (audio_buffer.getNumSamples ())
+          clip.content_length.as<int64_t> (units::samples)
             - current_internal_buffer_offset.as<int64_t> (units::samples));
 
         if (samples_to_copy > units::samples (0))
           {
-            // Copy audio data to output buffers
+            // Render the clip into the output buffers
             const auto output_start_idx =
               total_samples_processed + output_buffer_timestamp_offset;
 
             const auto output_start_idx_samples =
               output_start_idx.in<size_t> (units::samples);
-            if (output_start_idx_samples < left_buffer.size ())
+            const auto output_size =
+              std::min (left_buffer.size (), right_buffer.size ());
+            if (output_start_idx_samples < output_size)
               {
+                wrote_output = true;
                 const auto actual_samples_to_copy = std::min (
-                  samples_to_copy,
-                  static_cast<units::sample_t> (units::samples (
-                    left_buffer.size () - output_start_idx_samples)));
+                  samples_to_copy.in<size_t> (units::samples),
+                  output_size - output_start_idx_samples);
 
-                // Copy left channel
-                utils::float_ranges::add2 (
+                clip.mix (
+                  current_internal_buffer_offset,
                   left_buffer.subspan (
-                    output_start_idx_samples,
-                    actual_samples_to_copy.in (units::samples)),
-                  { audio_buffer.getReadPointer (
-                      0, current_internal_buffer_offset.in<int> (units::samples)),
-                    actual_samples_to_copy.in<size_t> (units::samples) });
-
-                // Copy right channel
-                if (
-                  audio_buffer.getNumChannels () > 1
-                  && right_buffer.size () > output_start_idx_samples)
-                  {
-                    utils::float_ranges::add2 (
-                      right_buffer.subspan (
-                        output_start_idx_samples,
-                        actual_samples_to_copy.in (units::samples)),
-                      { audio_buffer.getReadPointer (
-                          1, current_internal_buffer_offset.in<int> (
-                               units::samples)),
-                        actual_samples_to_copy.in<size_t> (units::samples) });
-                  }
+                    output_start_idx_samples, actual_samples_to_copy),
+                  right_buffer.subspan (
+                    output_start_idx_samples, actual_samples_to_copy));
               }
           }
       });
@@ -595,5 +593,6 @@ ClipPlaybackDataProvider::process_audio_events (
 
   // Update was_playing for next iteration
   was_playing_ = playing_.load ();
+  return wrote_output;
 }
 }
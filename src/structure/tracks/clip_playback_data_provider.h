@@ -7,6 +7,7 @@
 
 #include "dsp/graph_node.h"
 #include "dsp/midi_event_buffer.h"
+#include "dsp/timeline_data_cache.h"
 #include "structure/tracks/track_fwd.h"
 
 #include <farbot/RealtimeObject.hpp>
@@ -42,16 +43,19 @@ class ClipPlaybackDataProvider final
   struct AudioCache
   {
     AudioCache (
-      juce::AudioSampleBuffer               audio_buffer,
-      structure::tracks::ClipQuantizeOption quantize_opt,
-      units::precise_tick_t                 end_position)
-        : audio_buffer_ (std::move (audio_buffer)),
-          quantize_opt_ (quantize_opt), end_position_ (end_position)
+      dsp::AudioTimelineDataCache::LazyAudioClip clip,
+      structure::tracks::ClipQuantizeOption      quantize_opt,
+      units::precise_tick_t                      end_position)
+        : clip_ (std::move (clip)), quantize_opt_ (quantize_opt),
+          end_position_ (end_position)
     {
     }
 
-    juce::AudioSampleBuffer               audio_buffer_;
-    structure::tracks::ClipQuantizeOption quantize_opt_;
+    /**
+     * @brief Source and parameters to render the clip from during playback.
+     */
+    dsp::AudioTimelineDataCache::LazyAudioClip clip_;
+    structure::tracks::ClipQuantizeOption      quantize_opt_;
 
     /**
      * @brief End position to loop at.
@@ -73,7 +77,11 @@ public:
     structure::tracks::ClipQuantizeOption quantize_option);
 
   /**
-   * @brief Generate the audio buffer to be used during realtime processing.
+   * @brief Prepare the audio clip to be rendered during realtime processing.
+   *
+   * The clip is rendered from its source frames during playback (streamed
+   * sources are referenced, not read), so this does not render the whole clip.
+   * Clips that need time-stretching are stretched here.
    *
    * To be called as needed from the UI thread when a new cache is requested.
    */
@@ -96,8 +104,10 @@ public:
 
   /**
    * @brief Process audio events for clip launcher playback.
+   *
+   * @return Whether any part of the clip was mixed into the outputs.
    */
-  void process_audio_events (
+  bool process_audio_events (
     const dsp::graph::ProcessBlockInfo &time_nfo,
     std::span<float>                    left_buffer,
     std::span<float> right_buffer) noexcept [[clang::nonblocking]];
@@ -533,9 +533,10 @@ Track::regeneratePlaybackCaches (utils::ExpandableTickRange affectedRange)
         if (processor_->is_midi () && lanes_)
           {
             auto all_clips = get_all_lane_clips ();
-            processor_->timeline_midi_data_provider ().generate_midi_events (
-              base_dependencies_.tempo_map_.get_tempo_map (), all_clips,
-              affectedRange);
+            processor_->timeline_midi_data_provider ()
+              .generate_events<arrangement::MidiClip> (
+                base_dependencies_.tempo_map_.get_tempo_map (), all_clips,
+                affectedRange);
           }
       }
     else if constexpr (std::is_same_v<ClipT, arrangement::AudioClip>)
@@ -543,9 +544,10 @@ Track::regeneratePlaybackCaches (utils::ExpandableTickRange affectedRange)
         if (processor_->is_audio () && lanes_)
           {
             auto all_clips = get_all_lane_clips ();
-            processor_->timeline_audio_data_provider ().generate_audio_events (
-              base_dependencies_.tempo_map_.get_tempo_map (), all_clips,
-              affectedRange);
+            processor_->timeline_audio_data_provider ()
+              .generate_events<arrangement::AudioClip> (
+                base_dependencies_.tempo_map_.get_tempo_map (), all_clips,
+                affectedRange);
           }
       }
   };
@@ -559,9 +561,10 @@ Track::regeneratePlaybackCaches (utils::ExpandableTickRange affectedRange)
       if (processor_->is_midi ())
         {
           auto chord_clips = chord_owner->get_children_view ();
-          processor_->timeline_midi_data_provider ().generate_midi_events (
-            base_dependencies_.tempo_map_.get_tempo_map (), chord_clips,
-            affectedRange);
+          processor_->timeline_midi_data_provider ()
+            .generate_events<arrangement::ChordClip> (
+              base_dependencies_.tempo_map_.get_tempo_map (), chord_clips,
+              affectedRange);
         }
     }
 
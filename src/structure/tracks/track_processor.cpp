@@ -685,7 +685,7 @@ TrackProcessor::fill_midi_events (
     }
 }
 
-void
+bool
 TrackProcessor::fill_audio_events (
   const dsp::graph::ProcessBlockInfo &time_nfo,
   const dsp::ITransport              &transport,
@@ -693,15 +693,16 @@ TrackProcessor::fill_audio_events (
 {
   const auto active_providers = impl_->active_audio_providers_.load ();
 
+  bool filled = false;
   if (ENUM_BITSET_TEST (active_providers, ActiveAudioProviders::Timeline))
     {
-      impl_->timeline_audio_data_provider_->process_audio_events (
+      filled |= impl_->timeline_audio_data_provider_->process_audio_events (
         time_nfo, transport.get_play_state (), stereo_ports.first,
         stereo_ports.second);
     }
   if (ENUM_BITSET_TEST (active_providers, ActiveAudioProviders::ClipLauncher))
     {
-      impl_->clip_playback_data_provider_->process_audio_events (
+      filled |= impl_->clip_playback_data_provider_->process_audio_events (
         time_nfo, stereo_ports.first, stereo_ports.second);
     }
 
@@ -710,7 +711,10 @@ TrackProcessor::fill_audio_events (
     {
       std::invoke (
         *impl_->fill_events_cb_, transport, time_nfo, nullptr, stereo_ports);
+      filled = true;
     }
+
+  return filled;
 }
 
 // ============================================================================
@@ -725,8 +729,17 @@ TrackProcessor::custom_process_block (
 {
   // Output ports are already cleared by ProcessorBase::process_block.
 
+  // let the readers of the audio output skip it if nothing gets written to it
+  // (no clip playing and no input monitored)
+  bool       audio_out_written = false;
+  const auto mark_silent_audio_out = [&] () {
+    if (is_audio () && !audio_out_written)
+      impl_->processing_caches_->audio_outs_rt_.front ()->set_silent (true);
+  };
+
   if (!enabled_provider_ ())
     {
+      mark_silent_audio_out ();
       return;
     }
 
@@ -736,7 +749,7 @@ TrackProcessor::custom_process_block (
       const auto &out_buf =
         impl_->processing_caches_->audio_outs_rt_.front ()->buffers ();
       assert (out_buf->getNumChannels () >= 2);
-      fill_audio_events (
+      audio_out_written = fill_audio_events (
         time_nfo, transport,
         std::make_pair (
           std::span (out_buf->getWritePointer (0), out_buf->getNumSamples ()),
@@ -766,11 +779,6 @@ TrackProcessor::custom_process_block (
     {
       const auto &stereo_in = impl_->processing_caches_->audio_ins_rt_[0];
       const auto &stereo_out = impl_->processing_caches_->audio_outs_rt_[0];
-      const auto  input_gain = [this] () {
-        const auto &input_gain_param = *impl_->processing_caches_->input_gain_;
-        return input_gain_param.range ().convertFrom0To1 (
-          input_gain_param.currentValue ());
-      };
       const auto mono = [this] () {
         const auto &mono_param = *impl_->processing_caches_->mono_param_;
         return mono_param.range ().isToggled (mono_param.currentValue ());
@@ -791,32 +799,42 @@ TrackProcessor::custom_process_block (
                || (mode == MonitorMode::Auto && is_recording_armed_rt ());
       }();
 
-      if (should_monitor)
+      if (should_monitor && !stereo_in->is_silent ())
         {
+          audio_out_written = true;
           const auto &in_buf = stereo_in->buffers ();
           const auto &out_buf = stereo_out->buffers ();
-
-          utils::float_ranges::mix_product (
-            { out_buf->getWritePointer (
-                0, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            { in_buf->getReadPointer (
-                0, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in (units::samples) },
-            impl_->input_gain_id_ ? input_gain () : 1.f);
-
-          const auto &src_right_buf =
-            (impl_->mono_id_ && mono ())
-              ? in_buf->getWritePointer (
-                  0, time_nfo.buffer_offset_.in<int> (units::samples))
-              : in_buf->getWritePointer (
-                  1, time_nfo.buffer_offset_.in<int> (units::samples));
-          utils::float_ranges::mix_product (
-            { out_buf->getWritePointer (
-                1, time_nfo.buffer_offset_.in<int> (units::samples)),
-              time_nfo.nframes_.in<size_t> (units::samples) },
-            { src_right_buf, time_nfo.nframes_.in<size_t> (units::samples) },
-            impl_->input_gain_id_ ? input_gain () : 1.f);
+          const auto  mix_channel = [&] (int dest_ch, int src_ch) {
+            const std::span<float> dest{
+              out_buf->getWritePointer (
+                dest_ch, time_nfo.buffer_offset_.in<int> (units::samples)),
+              time_nfo.nframes_.in<size_t> (units::samples)
+            };
+            const std::span<const float> src{
+              in_buf->getReadPointer (
+                src_ch, time_nfo.buffer_offset_.in<int> (units::samples)),
+              time_nfo.nframes_.in<size_t> (units::samples)
+            };
+            if (!impl_->input_gain_id_)
+              {
+                utils::float_ranges::add2 (dest, src);
+                return;
+              }
+
+            const auto &input_gain =
+              parameter_ramp (*impl_->processing_caches_->input_gain_);
+            if (input_gain.is_constant ())
+              {
+                utils::float_ranges::mix_product (dest, src, input_gain.value);
+              }
+            else
+              {
+                utils::float_ranges::mix_product (dest, src, input_gain.values);
+              }
+          };
+
+          mix_channel (0, 0);
+          mix_channel (1, (impl_->mono_id_ && mono ()) ? 0 : 1);
         }
     }
   else if (is_midi ())
@@ -881,14 +899,30 @@ TrackProcessor::custom_process_block (
   /* apply output gain */
   if (impl_->output_gain_id_.has_value ())
     {
-      const auto &output_gain_param = *impl_->processing_caches_->output_gain_;
-      const auto  output_gain = output_gain_param.range ().convertFrom0To1 (
-        output_gain_param.currentValue ());
-
-      impl_->processing_caches_->audio_outs_rt_.front ()->buffers ()->applyGain (
-        time_nfo.buffer_offset_.in<int> (units::samples),
-        time_nfo.nframes_.in<int> (units::samples), output_gain);
+      const auto &output_gain =
+        parameter_ramp (*impl_->processing_caches_->output_gain_);
+      const auto &out_buf =
+        impl_->processing_caches_->audio_outs_rt_.front ()->buffers ();
+      if (output_gain.is_constant ())
+        {
+          out_buf->applyGain (
+            time_nfo.buffer_offset_.in<int> (units::samples),
+            time_nfo.nframes_.in<int> (units::samples), output_gain.value);
+        }
+      else
+        {
+          for (const auto ch : std::views::iota (0, out_buf->getNumChannels ()))
+            {
+              utils::float_ranges::mul2 (
+                { out_buf->getWritePointer (
+                    ch, time_nfo.buffer_offset_.in<int> (units::samples)),
+                  time_nfo.nframes_.in<size_t> (units::samples) },
+                output_gain.values);
+            }
+        }
     }
+
+  mark_silent_audio_out ();
 }
 
 void
@@ -928,13 +962,20 @@ TrackProcessor::custom_prepare_for_processing (
     {
       impl_->processing_caches_->mono_param_ = &get_mono_param ();
     }
+  // ramp gain changes to prevent zipper noise
   if (impl_->input_gain_id_.has_value ())
     {
       impl_->processing_caches_->input_gain_ = &get_input_gain_param ();
+      enable_parameter_ramp (
+        *impl_->processing_caches_->input_gain_,
+        ParameterChangeTracker::RampShape::Exponential);
     }
   if (impl_->output_gain_id_.has_value ())
     {
       impl_->processing_caches_->output_gain_ = &get_output_gain_param ();
+      enable_parameter_ramp (
+        *impl_->processing_caches_->output_gain_,
+        ParameterChangeTracker::RampShape::Exponential);
     }
   if (impl_->monitor_audio_id_.has_value ())
     {
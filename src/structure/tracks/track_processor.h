@@ -326,8 +326,10 @@ public:
    * needed.
    *
    * @param stereo_ports StereoPorts to fill.
+   *
+   * @return Whether anything may have been written to @p stereo_ports.
    */
-  void fill_audio_events (
+  bool fill_audio_events (
     const dsp::graph::ProcessBlockInfo &time_nfo,
     const dsp::ITransport              &transport,
     StereoPortPair                      stereo_ports);
@@ -106,6 +106,8 @@ class AppSettings : public QObject
   DEFINE_SETTING_PROPERTY (QStringList, fileBrowserBookmarks, QStringList ())
   DEFINE_SETTING_PROPERTY (QString, fileBrowserLastLocation, {})
   DEFINE_SETTING_PROPERTY (int, undoStackLength, 128)
+  DEFINE_SETTING_PROPERTY (int, journalInterval, 5) // seconds (0=off)
+  DEFINE_SETTING_PROPERTY (int, projectFileEncoding, 0) // JSON (1=CBOR)
   DEFINE_SETTING_PROPERTY (int, pianoRollHighlight, 3)    // both
   DEFINE_SETTING_PROPERTY (int, pianoRollMidiModifier, 0) // velocity
   /* these are all in amplitude (0.0 ~ 2.0) */
@@ -130,6 +132,8 @@ class AppSettings : public QObject
   DEFINE_SETTING_PROPERTY (int, sampleRate, 3)         // 48000
   DEFINE_SETTING_PROPERTY (int, audioBufferSize, 5)    // 512
   DEFINE_SETTING_PROPERTY (int, bounceTailLength, 100) // 100ms
+  DEFINE_SETTING_PROPERTY (int, audioStreamingThreshold, 0) // seconds (0=off)
+  DEFINE_SETTING_PROPERTY (int, audioPageCacheSize, 512) // MiB
   DEFINE_SETTING_PROPERTY (bool, bounceWithParents, 100)
   DEFINE_SETTING_PROPERTY (int, bounceStep, 2) // post-fader
   DEFINE_SETTING_PROPERTY (bool, disableAfterBounce, true)
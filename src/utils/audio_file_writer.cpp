@@ -15,6 +15,76 @@
 namespace zrythm::utils
 {
 
+std::unique_ptr<juce::AudioFormatWriter>
+AudioFileWriter::create_writer (
+  const WriteOptions          &options,
+  const std::filesystem::path &file_path)
+{
+  // Setup audio format manager
+  juce::AudioFormatManager format_manager;
+  format_manager.registerBasicFormats ();
+
+  // Determine format from file extension
+  const auto file_juce =
+    utils::Utf8String::from_path (file_path).to_juce_file ();
+  std::unique_ptr<juce::AudioFormat> format;
+  const auto file_extension = file_juce.getFileExtension ().toLowerCase ();
+
+  if (file_extension == ".wav")
+    {
+      format = std::make_unique<juce::WavAudioFormat> ();
+    }
+  else if (file_extension == ".aiff" || file_extension == ".aif")
+    {
+      format = std::make_unique<juce::AiffAudioFormat> ();
+    }
+  else if (file_extension == ".flac")
+    {
+      format = std::make_unique<juce::FlacAudioFormat> ();
+    }
+  else if (file_extension == ".ogg" || file_extension == ".oga")
+    {
+      format = std::make_unique<juce::OggVorbisAudioFormat> ();
+    }
+  else
+    {
+      throw std::runtime_error (to_std_string (
+        QObject::tr ("Unsupported audio format: %1")
+          .arg (file_extension.toStdString ())));
+    }
+
+  // Create parent directories if needed
+  if (!file_juce.getParentDirectory ().createDirectory ())
+    {
+      throw std::runtime_error (to_std_string (
+        QObject::tr ("Failed to create parent directories for %1")
+          .arg (file_path.string ())));
+    }
+
+  // Create output stream
+  std::unique_ptr<juce::OutputStream> file_output_stream =
+    std::make_unique<juce::FileOutputStream> (file_juce);
+  if (
+    !dynamic_cast<juce::FileOutputStream &> (*file_output_stream).openedOk ())
+    {
+      throw std::runtime_error (to_std_string (
+        QObject::tr ("Failed to open output file: %1")
+          .arg (file_path.string ())));
+    }
+
+  // Create writer
+  auto writer =
+    format->createWriterFor (file_output_stream, options.writer_options_);
+  if (writer == nullptr)
+    {
+      throw std::runtime_error (to_std_string (
+        QObject::tr ("Failed to create audio writer for %1")
+          .arg (file_path.string ())));
+    }
+
+  return writer;
+}
+
 void
 AudioFileWriter::write (
   QPromise<void>              &promise,
@@ -26,67 +96,7 @@ AudioFileWriter::write (
     {
       z_debug ("Writing audio to {}...", file_path);
 
-      // Setup audio format manager
-      juce::AudioFormatManager format_manager;
-      format_manager.registerBasicFormats ();
-
-      // Determine format from file extension
-      const auto file_juce =
-        utils::Utf8String::from_path (file_path).to_juce_file ();
-      std::unique_ptr<juce::AudioFormat> format;
-      const auto file_extension = file_juce.getFileExtension ().toLowerCase ();
-
-      if (file_extension == ".wav")
-        {
-          format = std::make_unique<juce::WavAudioFormat> ();
-        }
-      else if (file_extension == ".aiff" || file_extension == ".aif")
-        {
-          format = std::make_unique<juce::AiffAudioFormat> ();
-        }
-      else if (file_extension == ".flac")
-        {
-          format = std::make_unique<juce::FlacAudioFormat> ();
-        }
-      else if (file_extension == ".ogg" || file_extension == ".oga")
-        {
-          format = std::make_unique<juce::OggVorbisAudioFormat> ();
-        }
-      else
-        {
-          throw std::runtime_error (to_std_string (
-            QObject::tr ("Unsupported audio format: %1")
-              .arg (file_extension.toStdString ())));
-        }
-
-      // Create parent directories if needed
-      if (!file_juce.getParentDirectory ().createDirectory ())
-        {
-          throw std::runtime_error (to_std_string (
-            QObject::tr ("Failed to create parent directories for %1")
-              .arg (file_path.string ())));
-        }
-
-      // Create output stream
-      std::unique_ptr<juce::OutputStream> file_output_stream =
-        std::make_unique<juce::FileOutputStream> (file_juce);
-      if (
-        !dynamic_cast<juce::FileOutputStream &> (*file_output_stream).openedOk ())
-        {
-          throw std::runtime_error (to_std_string (
-            QObject::tr ("Failed to open output file: %1")
-              .arg (file_path.string ())));
-        }
-
-      // Create writer
-      auto writer =
-        format->createWriterFor (file_output_stream, options.writer_options_);
-      if (writer == nullptr)
-        {
-          throw std::runtime_error (to_std_string (
-            QObject::tr ("Failed to create audio writer for %1")
-              .arg (file_path.string ())));
-        }
+      auto writer = create_writer (options, file_path);
 
       const auto total_samples = buffer.getNumSamples ();
       const auto block_size = options.block_length_.in<int> (units::samples);
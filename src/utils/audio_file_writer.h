@@ -37,6 +37,19 @@ public:
     const std::filesystem::path &file_path,
     juce::AudioSampleBuffer    &&buffer);
 
+  /**
+   * @brief Creates a writer for the given file, with the format determined by
+   * the file extension.
+   *
+   * Useful for writing audio incrementally (e.g., while it is being rendered).
+   * Parent directories are created if needed.
+   *
+   * @throw std::runtime_error on failure.
+   */
+  static std::unique_ptr<juce::AudioFormatWriter> create_writer (
+    const WriteOptions          &options,
+    const std::filesystem::path &file_path);
+
 private:
   /**
    * @brief Writes the audio buffer to file.
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <exception>
+
+#include "utils/coalescing_task_runner.h"
+#include "utils/logger.h"
+
+namespace zrythm::utils
+{
+
+namespace
+{
+void
+run_logging_exceptions (const CoalescingTaskRunner::Task &task)
+{
+  try
+    {
+      task ();
+    }
+  catch (const std::exception &e)
+    {
+      z_warning ("Queued task failed: {}", e.what ());
+    }
+}
+}
+
+CoalescingTaskRunner::CoalescingTaskRunner (Task commit, QThreadPool * pool)
+    : commit_ (std::move (commit)),
+      pool_ (pool != nullptr ? pool : QThreadPool::globalInstance ())
+{
+}
+
+CoalescingTaskRunner::~CoalescingTaskRunner ()
+{
+  std::unique_lock lock (mutex_);
+  shutting_down_ = true;
+  stats_.tasks_dropped += pending_.size ();
+  pending_.clear ();
+  idle_cv_.wait (lock, [this] { return !running_; });
+}
+
+void
+CoalescingTaskRunner::queue (Task task)
+{
+  queue_impl (std::move (task), false);
+}
+
+void
+CoalescingTaskRunner::queue_replacing_pending (Task task)
+{
+  queue_impl (std::move (task), true);
+}
+
+void
+CoalescingTaskRunner::queue_impl (Task task, bool replace_pending)
+{
+  std::lock_guard lock (mutex_);
+  if (replace_pending)
+    {
+      stats_.tasks_dropped += pending_.size ();
+      pending_.clear ();
+    }
+  pending_.push_back (std::move (task));
+
+  if (!running_)
+    {
+      running_ = true;
+      pool_->start ([this] () { run (); });
+    }
+}
+
+void
+CoalescingTaskRunner::run ()
+{
+  while (true)
+    {
+      std::vector<Task> batch;
+      {
+        std::lock_guard lock (mutex_);
+        if (pending_.empty ())
+          {
+            running_ = false;
+            idle_cv_.notify_all ();
+            return;
+          }
+        batch.swap (pending_);
+      }
+
+      for (const auto &task : batch)
+        {
+          run_logging_exceptions (task);
+        }
+
+      {
+        std::lock_guard lock (mutex_);
+        stats_.tasks_run += batch.size ();
+
+        // the next batch commits instead
+        if (!pending_.empty () || shutting_down_)
+          {
+            ++stats_.commits_skipped;
+            continue;
+          }
+        ++stats_.commits;
+      }
+
+      run_logging_exceptions (commit_);
+    }
+}
+
+void
+CoalescingTaskRunner::wait () const
+{
+  std::unique_lock lock (mutex_);
+  idle_cv_.wait (lock, [this] { return !running_; });
+}
+
+bool
+CoalescingTaskRunner::is_busy () const
+{
+  std::lock_guard lock (mutex_);
+  return running_;
+}
+
+CoalescingTaskRunner::Stats
+CoalescingTaskRunner::stats () const
+{
+  std::lock_guard lock (mutex_);
+  return stats_;
+}
+
+} // namespace zrythm::utils
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "utils/types.h"
+
+#include <QThreadPool>
+
+namespace zrythm::utils
+{
+
+/**
+ * @brief Runs queued tasks in order on a thread pool, committing their
+ * combined result once the queue runs dry.
+ *
+ * Tasks are run one batch at a time (never concurrently). After each batch,
+ * the commit callback is called unless more tasks were queued in the
+ * meantime, in which case the commit is left to the next batch. This lets a
+ * burst of requests (e.g., while dragging an object) apply their changes
+ * without publishing each intermediate state.
+ *
+ * Tasks that are made obsolete by a new task (e.g., a full regeneration) can
+ * be dropped with queue_replacing_pending() if they haven't started yet.
+ *
+ * Tasks and the commit callback run on the pool's threads; exceptions thrown
+ * by them are logged and otherwise ignored.
+ */
+class CoalescingTaskRunner final
+{
+public:
+  using Task = std::function<void ()>;
+
+  struct Stats
+  {
+    /** Number of tasks run. */
+    uint64_t tasks_run{};
+
+    /** Number of tasks dropped before they started. */
+    uint64_t tasks_dropped{};
+
+    /** Number of times the commit callback was called. */
+    uint64_t commits{};
+
+    /** Number of commits skipped because more tasks were queued. */
+    uint64_t commits_skipped{};
+  };
+
+  /**
+   * @param commit Called after a batch of tasks if no more tasks are pending.
+   * @param pool Thread pool to run on (defaults to the global instance).
+   */
+  explicit CoalescingTaskRunner (Task commit, QThreadPool * pool = nullptr);
+
+  /**
+   * @brief Drops the tasks that haven't started and waits for the running
+   * batch to finish.
+   */
+  ~CoalescingTaskRunner ();
+
+  Z_DISABLE_COPY_MOVE (CoalescingTaskRunner)
+
+  /**
+   * @brief Queues a task to run after the previously queued ones.
+   */
+  void queue (Task task);
+
+  /**
+   * @brief Drops the tasks that haven't started yet and queues @p task.
+   */
+  void queue_replacing_pending (Task task);
+
+  /**
+   * @brief Blocks until all queued tasks ran and were committed.
+   */
+  void wait () const;
+
+  /**
+   * @brief Returns whether there are tasks queued or running.
+   */
+  bool is_busy () const;
+
+  Stats stats () const;
+
+private:
+  void queue_impl (Task task, bool replace_pending);
+
+  /**
+   * @brief Runs batches until the queue is empty (on the pool).
+   */
+  void run ();
+
+private:
+  Task          commit_;
+  QThreadPool * pool_;
+
+  mutable std::mutex              mutex_;
+  mutable std::condition_variable idle_cv_;
+  std::vector<Task>               pending_;
+  bool                            running_{ false };
+  bool                            shutting_down_{ false };
+  Stats                           stats_;
+};
+
+} // namespace zrythm::utils
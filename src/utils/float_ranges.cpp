@@ -1,85 +1,298 @@
 // SPDX-FileCopyrightText: © 2020-2021, 2024, 2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <algorithm>
 #include <cassert>
-#include <ranges>
+#include <cmath>
+#include <vector>
 
 #include "utils/float_ranges.h"
-#include "utils/math_utils.h"
+#include "utils/float_ranges_kernels.h"
 
 #include <juce_dsp/juce_dsp.h>
 
 namespace zrythm::utils::float_ranges
 {
 
+namespace kernels
+{
+
+namespace
+{
+// JUCE already uses SSE or NEON where it was compiled with them
+
+void
+portable_fill (float * buf, float val, size_t size)
+{
+  juce::FloatVectorOperations::fill (buf, val, size);
+}
+
+void
+portable_clip (float * buf, float minf, float maxf, size_t size)
+{
+  juce::FloatVectorOperations::clip (buf, buf, minf, maxf, size);
+}
+
+void
+portable_copy (float * dest, const float * src, size_t size)
+{
+  juce::FloatVectorOperations::copy (dest, src, size);
+}
+
+void
+portable_mul_k2 (float * dest, float k, size_t size)
+{
+  juce::FloatVectorOperations::multiply (dest, k, size);
+}
+
+float
+portable_abs_max (const float * buf, size_t size)
+{
+  auto min_and_max = juce::FloatVectorOperations::findMinAndMax (buf, size);
+  return std::max (
+    std::abs (min_and_max.getStart ()), std::abs (min_and_max.getEnd ()));
+}
+
+float
+portable_min (const float * buf, size_t size)
+{
+  return juce::FloatVectorOperations::findMinimum (buf, size);
+}
+
+float
+portable_max (const float * buf, size_t size)
+{
+  return juce::FloatVectorOperations::findMaximum (buf, size);
+}
+
+void
+portable_add2 (float * dest, const float * src, size_t size)
+{
+  juce::FloatVectorOperations::add (dest, src, size);
+}
+
+void
+portable_mul2 (float * dest, const float * src, size_t size)
+{
+  juce::FloatVectorOperations::multiply (dest, src, size);
+}
+
+void
+portable_product (float * dest, const float * src, float k, size_t size)
+{
+  juce::FloatVectorOperations::copyWithMultiply (dest, src, k, size);
+}
+
+void
+portable_mix_product (float * dest, const float * src, float k, size_t size)
+{
+  juce::FloatVectorOperations::addWithMultiply (dest, src, k, size);
+}
+
+void
+portable_mix_product_gains (
+  float *       dest,
+  const float * src,
+  const float * gains,
+  size_t        size)
+{
+  juce::FloatVectorOperations::addWithMultiply (dest, src, gains, size);
+}
+
+void
+portable_linear_fade (
+  float * dest,
+  float   from,
+  float   first_index,
+  float   index_step,
+  float   divisor,
+  size_t  size)
+{
+  for (size_t i = 0; i < size; ++i)
+    {
+      const float index = first_index + index_step * (float) i;
+      dest[i] *= from + (1.f - from) * (index / divisor);
+    }
+}
+
+void
+portable_make_mono (float * l, float * r, float k, size_t size)
+{
+  juce::FloatVectorOperations::add (l, r, size);
+  juce::FloatVectorOperations::multiply (l, k, size);
+  juce::FloatVectorOperations::copy (r, l, size);
+}
+
+void
+portable_stereo_fader (
+  float *       l,
+  float *       r,
+  const float * gains_l,
+  const float * gains_r,
+  bool          mono,
+  float         limit,
+  size_t        size)
+{
+  for (size_t i = 0; i < size; ++i)
+    {
+      float sl = l[i] * gains_l[i];
+      float sr = r[i] * gains_r[i];
+      if (mono)
+        {
+          sl = (sl + sr) * 0.5f;
+          sr = sl;
+        }
+      l[i] = std::clamp (sl, -limit, limit);
+      r[i] = std::clamp (sr, -limit, limit);
+    }
+}
+
+constexpr KernelTable portable_table{
+  .name = "portable",
+  .fill = &portable_fill,
+  .clip = &portable_clip,
+  .copy = &portable_copy,
+  .mul_k2 = &portable_mul_k2,
+  .abs_max = &portable_abs_max,
+  .min = &portable_min,
+  .max = &portable_max,
+  .add2 = &portable_add2,
+  .mul2 = &portable_mul2,
+  .product = &portable_product,
+  .mix_product = &portable_mix_product,
+  .mix_product_gains = &portable_mix_product_gains,
+  .linear_fade = &portable_linear_fade,
+  .make_mono = &portable_make_mono,
+  .stereo_fader = &portable_stereo_fader,
+};
+
+// select the kernels at startup instead of on the first (possibly realtime)
+// call
+[[maybe_unused]] const KernelTable &startup_kernels = active ();
+}
+
+const KernelTable &
+portable ()
+{
+  return portable_table;
+}
+
+std::span<const KernelTable * const>
+supported ()
+{
+  static const auto tables = [] {
+    std::vector<const KernelTable *> ret{ &portable_table };
+    if (neon () != nullptr && juce::SystemStats::hasNeon ())
+      {
+        ret.push_back (neon ());
+      }
+    if (
+      avx2 () != nullptr && juce::SystemStats::hasAVX2 ()
+      && juce::SystemStats::hasFMA3 ())
+      {
+        ret.push_back (avx2 ());
+      }
+    if (
+      avx512 () != nullptr && juce::SystemStats::hasAVX512F ()
+      && juce::SystemStats::hasFMA3 ())
+      {
+        ret.push_back (avx512 ());
+      }
+    return ret;
+  }();
+  return tables;
+}
+
+const KernelTable &
+active ()
+{
+  static const KernelTable &table = *supported ().back ();
+  return table;
+}
+
+} // namespace kernels
+
 void
 fill (std::span<float> buf, float val)
 {
-  juce::FloatVectorOperations::fill (buf.data (), val, buf.size ());
+  kernels::active ().fill (buf.data (), val, buf.size ());
 }
 
 void
 clip (std::span<float> buf, float minf, float maxf)
 {
-  juce::FloatVectorOperations::clip (
-    buf.data (), buf.data (), minf, maxf, buf.size ());
+  kernels::active ().clip (buf.data (), minf, maxf, buf.size ());
 }
 
 void
 copy (std::span<float> dest, std::span<const float> src)
 {
   assert (dest.size () == src.size ());
-  juce::FloatVectorOperations::copy (dest.data (), src.data (), dest.size ());
+  kernels::active ().copy (dest.data (), src.data (), dest.size ());
 }
 
 void
 mul_k2 (std::span<float> dest, float k)
 {
-  juce::FloatVectorOperations::multiply (dest.data (), k, dest.size ());
+  kernels::active ().mul_k2 (dest.data (), k, dest.size ());
 }
 
 float
 abs_max (std::span<const float> buf)
 {
-  auto min_and_max =
-    juce::FloatVectorOperations::findMinAndMax (buf.data (), buf.size ());
-  return std::max (
-    std::abs (min_and_max.getStart ()), std::abs (min_and_max.getEnd ()));
+  return kernels::active ().abs_max (buf.data (), buf.size ());
 }
 
 float
 min (std::span<const float> buf)
 {
-  return juce::FloatVectorOperations::findMinimum (buf.data (), buf.size ());
+  return kernels::active ().min (buf.data (), buf.size ());
 }
 
 float
 max (std::span<const float> buf)
 {
-  return juce::FloatVectorOperations::findMaximum (buf.data (), buf.size ());
+  return kernels::active ().max (buf.data (), buf.size ());
 }
 
 void
 add2 (std::span<float> dest, std::span<const float> src)
 {
   assert (dest.size () == src.size ());
-  juce::FloatVectorOperations::add (dest.data (), src.data (), dest.size ());
+  kernels::active ().add2 (dest.data (), src.data (), dest.size ());
+}
+
+void
+mul2 (std::span<float> dest, std::span<const float> src)
+{
+  assert (dest.size () == src.size ());
+  kernels::active ().mul2 (dest.data (), src.data (), dest.size ());
 }
 
 void
 product (std::span<float> dest, std::span<const float> src, float k)
 {
   assert (dest.size () == src.size ());
-  juce::FloatVectorOperations::copyWithMultiply (
-    dest.data (), src.data (), k, dest.size ());
+  kernels::active ().product (dest.data (), src.data (), k, dest.size ());
 }
 
 void
 mix_product (std::span<float> dest, std::span<const float> src, float k)
 {
   assert (dest.size () == src.size ());
-  juce::FloatVectorOperations::addWithMultiply (
-    dest.data (), src.data (), k, dest.size ());
+  kernels::active ().mix_product (dest.data (), src.data (), k, dest.size ());
+}
+
+void
+mix_product (
+  std::span<float>       dest,
+  std::span<const float> src,
+  std::span<const float> gains)
+{
+  assert (dest.size () == src.size ());
+  assert (dest.size () == gains.size ());
+  kernels::active ().mix_product_gains (
+    dest.data (), src.data (), gains.data (), dest.size ());
 }
 
 void
@@ -106,15 +319,10 @@ linear_fade_in_from (
   int32_t          total_frames_to_fade,
   float            fade_from_multiplier)
 {
-  const auto size = dest.size ();
   assert (total_frames_to_fade > 1);
-  for (const auto i : std::views::iota (0zu, size))
-    {
-      float k =
-        (float) (i + (size_t) start_offset) / (float) (total_frames_to_fade - 1);
-      k = fade_from_multiplier + (1.f - fade_from_multiplier) * k;
-      dest[i] *= k;
-    }
+  kernels::active ().linear_fade (
+    dest.data (), fade_from_multiplier, (float) start_offset, 1.f,
+    (float) (total_frames_to_fade - 1), dest.size ());
 }
 
 void
@@ -124,16 +332,11 @@ linear_fade_out_to (
   int32_t          total_frames_to_fade,
   float            fade_to_multiplier)
 {
-  const auto size = dest.size ();
   assert (total_frames_to_fade > 1);
-  for (const auto i : std::views::iota (0zu, size))
-    {
-      float k =
-        (float) ((size_t) total_frames_to_fade - (i + (size_t) start_offset) - 1)
-        / (float) (total_frames_to_fade - 1);
-      k = fade_to_multiplier + (1.f - fade_to_multiplier) * k;
-      dest[i] *= k;
-    }
+  kernels::active ().linear_fade (
+    dest.data (), fade_to_multiplier,
+    (float) (total_frames_to_fade - start_offset - 1), -1.f,
+    (float) (total_frames_to_fade - 1), dest.size ());
 }
 
 void
@@ -141,9 +344,24 @@ make_mono (std::span<float> l, std::span<float> r, bool equal_power)
 {
   assert (l.size () == r.size ());
   float multiple = equal_power ? 0.7079f : 0.5f;
-  add2 (l, r);
-  mul_k2 (l, multiple);
-  copy (r, l);
+  kernels::active ().make_mono (l.data (), r.data (), multiple, l.size ());
+}
+
+void
+stereo_fader (
+  std::span<float>       l,
+  std::span<float>       r,
+  std::span<const float> gains_l,
+  std::span<const float> gains_r,
+  bool                   mono,
+  float                  limit)
+{
+  assert (l.size () == r.size ());
+  assert (l.size () == gains_l.size ());
+  assert (l.size () == gains_r.size ());
+  kernels::active ().stereo_fader (
+    l.data (), r.data (), gains_l.data (), gains_r.data (), mono, limit,
+    l.size ());
 }
 
 } // zrythm::utils::float_ranges
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <span>
 
 namespace zrythm::utils::float_ranges
@@ -66,6 +67,12 @@ max (std::span<const float> buf);
 [[using gnu: hot]] void
 add2 (std::span<float> dest, std::span<const float> src);
 
+/**
+ * Calculate dst[i] = dst[i] * src[i].
+ */
+[[using gnu: hot]] void
+mul2 (std::span<float> dest, std::span<const float> src);
+
 /**
  * @brief Calculate dest[i] = src[i] * k.
  */
@@ -78,6 +85,15 @@ product (std::span<float> dest, std::span<const float> src, float k);
 [[using gnu: hot]] void
 mix_product (std::span<float> dest, std::span<const float> src, float k);
 
+/**
+ * @brief Calculate dest[i] = dest[i] + src[i] * gains[i].
+ */
+[[using gnu: hot]] void
+mix_product (
+  std::span<float>       dest,
+  std::span<const float> src,
+  std::span<const float> gains);
+
 /**
  * Reverse the order of samples: dst[i] <=> src[count - i - 1].
  */
@@ -146,4 +162,20 @@ linear_fade_out_to (
 void
 make_mono (std::span<float> l, std::span<float> r, bool equal_power);
 
+/**
+ * @brief Applies per-sample gains to a stereo signal in a single pass.
+ *
+ * Calculates l[i] *= gains_l[i] and r[i] *= gains_r[i], then, if @p mono,
+ * l[i] = r[i] = (l[i] + r[i]) / 2 (equal amplitude), and finally clamps both
+ * channels to [-limit, limit].
+ */
+[[using gnu: hot]] void
+stereo_fader (
+  std::span<float>       l,
+  std::span<float>       r,
+  std::span<const float> gains_l,
+  std::span<const float> gains_r,
+  bool                   mono,
+  float                  limit = std::numeric_limits<float>::infinity ());
+
 }; // zrythm::utils::float_ranges
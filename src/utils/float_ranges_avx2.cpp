@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+// Compiled with AVX2 and FMA enabled (see CMakeLists.txt). Only call into this
+// file after checking that the CPU supports them.
+
+#include "utils/float_ranges_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#  include "utils/float_ranges_kernels_impl.h"
+
+#  include <immintrin.h>
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+namespace
+{
+struct Avx2
+{
+  using V = __m256;
+  static constexpr size_t width = 8;
+
+  static V load (const float * p) { return _mm256_loadu_ps (p); }
+  static void store (float * p, V v) { _mm256_storeu_ps (p, v); }
+  static V set1 (float x) { return _mm256_set1_ps (x); }
+  static V add (V a, V b) { return _mm256_add_ps (a, b); }
+  static V mul (V a, V b) { return _mm256_mul_ps (a, b); }
+  static V div (V a, V b) { return _mm256_div_ps (a, b); }
+  static V min (V a, V b) { return _mm256_min_ps (a, b); }
+  static V max (V a, V b) { return _mm256_max_ps (a, b); }
+  static V abs (V a) { return _mm256_andnot_ps (_mm256_set1_ps (-0.f), a); }
+  static V fmadd (V a, V b, V c) { return _mm256_fmadd_ps (a, b, c); }
+  static V iota () { return _mm256_setr_ps (0, 1, 2, 3, 4, 5, 6, 7); }
+
+  static float reduce_min (V v)
+  {
+    __m128 x = _mm_min_ps (
+      _mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+    x = _mm_min_ps (x, _mm_movehl_ps (x, x));
+    x = _mm_min_ss (x, _mm_shuffle_ps (x, x, 1));
+    return _mm_cvtss_f32 (x);
+  }
+
+  static float reduce_max (V v)
+  {
+    __m128 x = _mm_max_ps (
+      _mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+    x = _mm_max_ps (x, _mm_movehl_ps (x, x));
+    x = _mm_max_ss (x, _mm_shuffle_ps (x, x, 1));
+    return _mm_cvtss_f32 (x);
+  }
+};
+
+constexpr auto avx2_table = detail::make_table<Avx2> ("AVX2");
+}
+
+const KernelTable *
+avx2 ()
+{
+  return &avx2_table;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#else
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+const KernelTable *
+avx2 ()
+{
+  return nullptr;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#endif
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+// Compiled with AVX-512F and FMA enabled (see CMakeLists.txt). Only call into
+// this file after checking that the CPU supports them.
+
+#include "utils/float_ranges_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#  include "utils/float_ranges_kernels_impl.h"
+
+#  include <immintrin.h>
+
+// GCC's AVX-512 intrinsics use deliberately uninitialized vectors
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#    pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#  endif
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+namespace
+{
+struct Avx512
+{
+  using V = __m512;
+  static constexpr size_t width = 16;
+
+  static V load (const float * p) { return _mm512_loadu_ps (p); }
+  static void store (float * p, V v) { _mm512_storeu_ps (p, v); }
+  static V set1 (float x) { return _mm512_set1_ps (x); }
+  static V add (V a, V b) { return _mm512_add_ps (a, b); }
+  static V mul (V a, V b) { return _mm512_mul_ps (a, b); }
+  static V div (V a, V b) { return _mm512_div_ps (a, b); }
+  static V min (V a, V b) { return _mm512_min_ps (a, b); }
+  static V max (V a, V b) { return _mm512_max_ps (a, b); }
+  static V abs (V a) { return _mm512_abs_ps (a); }
+  static V fmadd (V a, V b, V c) { return _mm512_fmadd_ps (a, b, c); }
+  static V iota ()
+  {
+    return _mm512_setr_ps (
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  }
+  static float reduce_min (V v) { return _mm512_reduce_min_ps (v); }
+  static float reduce_max (V v) { return _mm512_reduce_max_ps (v); }
+};
+
+constexpr auto avx512_table = detail::make_table<Avx512> ("AVX-512");
+}
+
+const KernelTable *
+avx512 ()
+{
+  return &avx512_table;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#else
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+const KernelTable *
+avx512 ()
+{
+  return nullptr;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#endif
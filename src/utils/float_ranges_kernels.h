@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * @file
+ *
+ * Instruction-set-specific implementations of the float_ranges functions.
+ *
+ * Each supported instruction set provides a KernelTable. The best table
+ * supported by the CPU is selected at startup and used by the functions in
+ * float_ranges.h. The portable table (backed by JUCE) is always available
+ * and used as the fallback.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+/**
+ * @brief Table of kernels for one instruction set.
+ *
+ * Kernels take raw pointers and sizes so that the instruction-set-specific
+ * translation units don't need to include (and compile with their own target
+ * flags) any inline library code.
+ */
+struct KernelTable
+{
+  /** Name of the instruction set (for logging and benchmarks). */
+  const char * name;
+
+  void (*fill) (float * buf, float val, size_t size);
+  void (*clip) (float * buf, float minf, float maxf, size_t size);
+  void (*copy) (float * dest, const float * src, size_t size);
+  void (*mul_k2) (float * dest, float k, size_t size);
+  float (*abs_max) (const float * buf, size_t size);
+  float (*min) (const float * buf, size_t size);
+  float (*max) (const float * buf, size_t size);
+  void (*add2) (float * dest, const float * src, size_t size);
+  void (*mul2) (float * dest, const float * src, size_t size);
+  void (*product) (float * dest, const float * src, float k, size_t size);
+  void (*mix_product) (float * dest, const float * src, float k, size_t size);
+  void (*mix_product_gains) (
+    float *       dest,
+    const float * src,
+    const float * gains,
+    size_t        size);
+
+  /**
+   * Calculate dest[i] *= from + (1 - from) * (index / divisor), where index
+   * is first_index + index_step * i.
+   */
+  void (*linear_fade) (
+    float * dest,
+    float   from,
+    float   first_index,
+    float   index_step,
+    float   divisor,
+    size_t  size);
+
+  /**
+   * Calculate l[i] = r[i] = (l[i] + r[i]) * k.
+   */
+  void (*make_mono) (float * l, float * r, float k, size_t size);
+
+  /**
+   * Calculate l[i] *= gains_l[i] and r[i] *= gains_r[i], then (if mono)
+   * l[i] = r[i] = (l[i] + r[i]) * 0.5, then clamp both to [-limit, limit].
+   */
+  void (*stereo_fader) (
+    float *       l,
+    float *       r,
+    const float * gains_l,
+    const float * gains_r,
+    bool          mono,
+    float         limit,
+    size_t        size);
+};
+
+/**
+ * @brief Returns the portable kernels.
+ */
+const KernelTable &
+portable ();
+
+/**
+ * @brief Returns the AVX2 (+FMA) kernels, or nullptr if they were not built
+ * for this architecture.
+ */
+const KernelTable *
+avx2 ();
+
+/**
+ * @brief Returns the AVX-512F kernels, or nullptr if they were not built for
+ * this architecture.
+ */
+const KernelTable *
+avx512 ();
+
+/**
+ * @brief Returns the NEON kernels, or nullptr if they were not built for this
+ * architecture.
+ */
+const KernelTable *
+neon ();
+
+/**
+ * @brief Returns the kernel tables usable on this CPU, from the portable one
+ * to the best one.
+ */
+std::span<const KernelTable * const>
+supported ();
+
+/**
+ * @brief Returns the kernel table used by the float_ranges functions.
+ */
+const KernelTable &
+active ();
+
+} // namespace zrythm::utils::float_ranges::kernels
@@ -0,0 +1,335 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+/**
+ * @file
+ *
+ * Generic SIMD kernels, instantiated by each instruction-set-specific
+ * translation unit with its own vector type.
+ *
+ * An instruction set is described by a struct providing:
+ * - `V` (the vector type) and `width` (the number of floats in V)
+ * - `load()`, `store()` (unaligned) and `set1()`
+ * - `add()`, `mul()`, `div()`, `min()`, `max()` and `abs()`
+ * - `fmadd (a, b, c)` (a * b + c)
+ * - `iota()` (0, 1, 2, ...)
+ * - `reduce_min()` and `reduce_max()`
+ *
+ * The struct must be declared in an anonymous namespace so that the
+ * instantiations don't clash with the ones from other instruction sets.
+ *
+ * @note Kernels must not call any inline library code (see KernelTable).
+ */
+
+#pragma once
+
+#include "utils/float_ranges_kernels.h"
+
+namespace zrythm::utils::float_ranges::kernels::detail
+{
+
+/**
+ * @brief Calls @p vector_op for the start of each full vector and
+ * @p scalar_op for each remaining element.
+ */
+template <typename Isa, typename VectorOp, typename ScalarOp>
+inline void
+for_each (size_t size, VectorOp vector_op, ScalarOp scalar_op)
+{
+  size_t i = 0;
+  for (; i + Isa::width <= size; i += Isa::width)
+    vector_op (i);
+  for (; i < size; ++i)
+    scalar_op (i);
+}
+
+template <typename Isa>
+void
+fill (float * buf, float val, size_t size)
+{
+  const auto v = Isa::set1 (val);
+  for_each<Isa> (
+    size, [&] (size_t i) { Isa::store (buf + i, v); },
+    [&] (size_t i) { buf[i] = val; });
+}
+
+template <typename Isa>
+void
+clip (float * buf, float minf, float maxf, size_t size)
+{
+  const auto vmin = Isa::set1 (minf);
+  const auto vmax = Isa::set1 (maxf);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      const auto x = Isa::max (Isa::load (buf + i), vmin);
+      Isa::store (buf + i, Isa::min (x, vmax));
+    },
+    [&] (size_t i) {
+      const float x = buf[i] < minf ? minf : buf[i];
+      buf[i] = x > maxf ? maxf : x;
+    });
+}
+
+template <typename Isa>
+void
+copy (float * dest, const float * src, size_t size)
+{
+  for_each<Isa> (
+    size, [&] (size_t i) { Isa::store (dest + i, Isa::load (src + i)); },
+    [&] (size_t i) { dest[i] = src[i]; });
+}
+
+template <typename Isa>
+void
+mul_k2 (float * dest, float k, size_t size)
+{
+  const auto vk = Isa::set1 (k);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (dest + i, Isa::mul (Isa::load (dest + i), vk));
+    },
+    [&] (size_t i) { dest[i] *= k; });
+}
+
+template <typename Isa>
+float
+abs_max (const float * buf, size_t size)
+{
+  auto  vpeak = Isa::set1 (0.f);
+  float peak = 0.f;
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      vpeak = Isa::max (vpeak, Isa::abs (Isa::load (buf + i)));
+    },
+    [&] (size_t i) {
+      const float x = buf[i] < 0.f ? -buf[i] : buf[i];
+      peak = x > peak ? x : peak;
+    });
+  const float vector_peak = Isa::reduce_max (vpeak);
+  return vector_peak > peak ? vector_peak : peak;
+}
+
+template <typename Isa>
+float
+min (const float * buf, size_t size)
+{
+  if (size == 0)
+    return 0.f;
+
+  auto  vmin = Isa::set1 (buf[0]);
+  float ret = buf[0];
+  for_each<Isa> (
+    size, [&] (size_t i) { vmin = Isa::min (vmin, Isa::load (buf + i)); },
+    [&] (size_t i) { ret = buf[i] < ret ? buf[i] : ret; });
+  const float vector_min = Isa::reduce_min (vmin);
+  return vector_min < ret ? vector_min : ret;
+}
+
+template <typename Isa>
+float
+max (const float * buf, size_t size)
+{
+  if (size == 0)
+    return 0.f;
+
+  auto  vmax = Isa::set1 (buf[0]);
+  float ret = buf[0];
+  for_each<Isa> (
+    size, [&] (size_t i) { vmax = Isa::max (vmax, Isa::load (buf + i)); },
+    [&] (size_t i) { ret = buf[i] > ret ? buf[i] : ret; });
+  const float vector_max = Isa::reduce_max (vmax);
+  return vector_max > ret ? vector_max : ret;
+}
+
+template <typename Isa>
+void
+add2 (float * dest, const float * src, size_t size)
+{
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (
+        dest + i, Isa::add (Isa::load (dest + i), Isa::load (src + i)));
+    },
+    [&] (size_t i) { dest[i] += src[i]; });
+}
+
+template <typename Isa>
+void
+mul2 (float * dest, const float * src, size_t size)
+{
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (
+        dest + i, Isa::mul (Isa::load (dest + i), Isa::load (src + i)));
+    },
+    [&] (size_t i) { dest[i] *= src[i]; });
+}
+
+template <typename Isa>
+void
+product (float * dest, const float * src, float k, size_t size)
+{
+  const auto vk = Isa::set1 (k);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (dest + i, Isa::mul (Isa::load (src + i), vk));
+    },
+    [&] (size_t i) { dest[i] = src[i] * k; });
+}
+
+template <typename Isa>
+void
+mix_product (float * dest, const float * src, float k, size_t size)
+{
+  const auto vk = Isa::set1 (k);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (
+        dest + i, Isa::fmadd (Isa::load (src + i), vk, Isa::load (dest + i)));
+    },
+    [&] (size_t i) { dest[i] += src[i] * k; });
+}
+
+template <typename Isa>
+void
+mix_product_gains (
+  float *       dest,
+  const float * src,
+  const float * gains,
+  size_t        size)
+{
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      Isa::store (
+        dest + i,
+        Isa::fmadd (
+          Isa::load (src + i), Isa::load (gains + i), Isa::load (dest + i)));
+    },
+    [&] (size_t i) { dest[i] += src[i] * gains[i]; });
+}
+
+template <typename Isa>
+void
+linear_fade (
+  float * dest,
+  float   from,
+  float   first_index,
+  float   index_step,
+  float   divisor,
+  size_t  size)
+{
+  // indices are whole numbers, so they are exact in both paths
+  const auto vfrom = Isa::set1 (from);
+  const auto vrange = Isa::set1 (1.f - from);
+  const auto vdivisor = Isa::set1 (divisor);
+  const auto vsteps = Isa::mul (Isa::iota (), Isa::set1 (index_step));
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      const auto index =
+        Isa::add (Isa::set1 (first_index + index_step * (float) i), vsteps);
+      const auto k =
+        Isa::add (vfrom, Isa::mul (vrange, Isa::div (index, vdivisor)));
+      Isa::store (dest + i, Isa::mul (Isa::load (dest + i), k));
+    },
+    [&] (size_t i) {
+      const float index = first_index + index_step * (float) i;
+      dest[i] *= from + (1.f - from) * (index / divisor);
+    });
+}
+
+template <typename Isa>
+void
+make_mono (float * l, float * r, float k, size_t size)
+{
+  const auto vk = Isa::set1 (k);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      const auto mono =
+        Isa::mul (Isa::add (Isa::load (l + i), Isa::load (r + i)), vk);
+      Isa::store (l + i, mono);
+      Isa::store (r + i, mono);
+    },
+    [&] (size_t i) {
+      const float mono = (l[i] + r[i]) * k;
+      l[i] = mono;
+      r[i] = mono;
+    });
+}
+
+template <typename Isa>
+void
+stereo_fader (
+  float *       l,
+  float *       r,
+  const float * gains_l,
+  const float * gains_r,
+  bool          mono,
+  float         limit,
+  size_t        size)
+{
+  const auto vhalf = Isa::set1 (0.5f);
+  const auto vmin = Isa::set1 (-limit);
+  const auto vmax = Isa::set1 (limit);
+  for_each<Isa> (
+    size,
+    [&] (size_t i) {
+      auto vl = Isa::mul (Isa::load (l + i), Isa::load (gains_l + i));
+      auto vr = Isa::mul (Isa::load (r + i), Isa::load (gains_r + i));
+      if (mono)
+        {
+          vl = Isa::mul (Isa::add (vl, vr), vhalf);
+          vr = vl;
+        }
+      Isa::store (l + i, Isa::min (Isa::max (vl, vmin), vmax));
+      Isa::store (r + i, Isa::min (Isa::max (vr, vmin), vmax));
+    },
+    [&] (size_t i) {
+      float sl = l[i] * gains_l[i];
+      float sr = r[i] * gains_r[i];
+      if (mono)
+        {
+          sl = (sl + sr) * 0.5f;
+          sr = sl;
+        }
+      sl = sl < -limit ? -limit : sl;
+      sr = sr < -limit ? -limit : sr;
+      l[i] = sl > limit ? limit : sl;
+      r[i] = sr > limit ? limit : sr;
+    });
+}
+
+template <typename Isa>
+constexpr KernelTable
+make_table (const char * name)
+{
+  return {
+    .name = name,
+    .fill = &fill<Isa>,
+    .clip = &clip<Isa>,
+    .copy = &copy<Isa>,
+    .mul_k2 = &mul_k2<Isa>,
+    .abs_max = &abs_max<Isa>,
+    .min = &min<Isa>,
+    .max = &max<Isa>,
+    .add2 = &add2<Isa>,
+    .mul2 = &mul2<Isa>,
+    .product = &product<Isa>,
+    .mix_product = &mix_product<Isa>,
+    .mix_product_gains = &mix_product_gains<Isa>,
+    .linear_fade = &linear_fade<Isa>,
+    .make_mono = &make_mono<Isa>,
+    .stereo_fader = &stereo_fader<Isa>,
+  };
+}
+
+} // namespace zrythm::utils::float_ranges::kernels::detail
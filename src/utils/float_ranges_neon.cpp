@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+// NEON is part of the AArch64 baseline so no extra flags are needed here.
+
+#include "utils/float_ranges_kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#  include "utils/float_ranges_kernels_impl.h"
+
+#  include <arm_neon.h>
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+namespace
+{
+struct Neon
+{
+  using V = float32x4_t;
+  static constexpr size_t width = 4;
+
+  static V load (const float * p) { return vld1q_f32 (p); }
+  static void store (float * p, V v) { vst1q_f32 (p, v); }
+  static V set1 (float x) { return vdupq_n_f32 (x); }
+  static V add (V a, V b) { return vaddq_f32 (a, b); }
+  static V mul (V a, V b) { return vmulq_f32 (a, b); }
+  static V div (V a, V b) { return vdivq_f32 (a, b); }
+  static V min (V a, V b) { return vminq_f32 (a, b); }
+  static V max (V a, V b) { return vmaxq_f32 (a, b); }
+  static V abs (V a) { return vabsq_f32 (a); }
+  static V fmadd (V a, V b, V c) { return vfmaq_f32 (c, a, b); }
+  static V iota ()
+  {
+    constexpr float values[] = { 0, 1, 2, 3 };
+    return vld1q_f32 (values);
+  }
+  static float reduce_min (V v) { return vminvq_f32 (v); }
+  static float reduce_max (V v) { return vmaxvq_f32 (v); }
+};
+
+constexpr auto neon_table = detail::make_table<Neon> ("NEON");
+}
+
+const KernelTable *
+neon ()
+{
+  return &neon_table;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#else
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+const KernelTable *
+neon ()
+{
+  return nullptr;
+}
+
+} // namespace zrythm::utils::float_ranges::kernels
+
+#endif
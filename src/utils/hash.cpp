@@ -33,6 +33,17 @@ private:
 };
 }
 
+HashT
+get_combined_hash (std::span<const std::span<const std::byte>> parts)
+{
+  StreamingHash hasher;
+  for (const auto &part : parts)
+    {
+      hasher.update (part);
+    }
+  return hasher.finalize ();
+}
+
 HashT
 get_file_hash (const std::filesystem::path &path)
 {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <QFile>
 
 #include <xxhash.h>
@@ -33,6 +35,10 @@ get_string_hash (const std::string &str)
   return get_custom_hash (str.data (), str.size ());
 }
 
+// Hash several byte ranges as if they were a single contiguous range
+HashT
+get_combined_hash (std::span<const std::span<const std::byte>> parts);
+
 // Hash a file
 HashT
 get_file_hash (const std::filesystem::path &path);
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Fixed-capacity Chase-Lev work-stealing deque.
+ *
+ * The owner thread pushes and pops at the bottom (LIFO), while any other
+ * thread may steal from the top (FIFO). All operations are lock-free and
+ * never allocate, so they can be used from realtime threads.
+ *
+ * Unlike the original algorithm, the buffer does not grow: push() fails when
+ * the deque is full and the caller is expected to fall back to some other
+ * queue.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê,
+ * Pop, Cohen, Zappa Nardelli, 2013).
+ */
+template <typename T> class WorkStealingDeque
+{
+  static_assert (std::is_trivially_copyable_v<T>);
+
+public:
+  explicit WorkStealingDeque (size_t capacity = 64) { reserve (capacity); }
+
+  size_t capacity () const { return static_cast<size_t> (mask_) + 1; }
+
+  /**
+   * @brief Grows the buffer to at least @p capacity elements (rounded up to a
+   * power of 2).
+   *
+   * @warning Not thread-safe. Must only be called while the deque is empty and
+   * not accessed by any other thread.
+   */
+  void reserve (size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    if (buffer_ != nullptr && size <= this->capacity ())
+      return;
+
+    assert (empty ());
+    buffer_ = std::make_unique<std::atomic<T>[]> (size);
+    mask_ = static_cast<int64_t> (size) - 1;
+    top_.store (0, std::memory_order_relaxed);
+    bottom_.store (0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Approximate emptiness check (exact only for the owner when no
+   * thief is active).
+   */
+  bool empty () const
+  {
+    return bottom_.load (std::memory_order_relaxed)
+           <= top_.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Pushes an item at the bottom (owner thread only).
+   *
+   * @return False if the deque is full.
+   */
+  bool push (T item)
+  {
+    const auto b = bottom_.load (std::memory_order_relaxed);
+    const auto t = top_.load (std::memory_order_acquire);
+    if (b - t > mask_)
+      return false;
+
+    buffer_[b & mask_].store (item, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+    bottom_.store (b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Pops the most recently pushed item (owner thread only).
+   */
+  bool pop (T &item)
+  {
+    const auto b = bottom_.load (std::memory_order_relaxed) - 1;
+    bottom_.store (b, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    auto t = top_.load (std::memory_order_relaxed);
+
+    if (t > b)
+      {
+        // empty
+        bottom_.store (b + 1, std::memory_order_relaxed);
+        return false;
+      }
+
+    item = buffer_[b & mask_].load (std::memory_order_relaxed);
+    if (t == b)
+      {
+        // last item - race against thieves
+        const bool won = top_.compare_exchange_strong (
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store (b + 1, std::memory_order_relaxed);
+        return won;
+      }
+    return true;
+  }
+
+  /**
+   * @brief Steals the oldest item (any thread).
+   *
+   * @return False if the deque was empty or another thread won the race.
+   */
+  bool steal (T &item)
+  {
+    auto t = top_.load (std::memory_order_acquire);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    const auto b = bottom_.load (std::memory_order_acquire);
+    if (t >= b)
+      return false;
+
+    item = buffer_[t & mask_].load (std::memory_order_relaxed);
+    return top_.compare_exchange_strong (
+      t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+private:
+  alignas (64) std::atomic<int64_t> top_{ 0 };
+  alignas (64) std::atomic<int64_t> bottom_{ 0 };
+  alignas (64) std::unique_ptr<std::atomic<T>[]> buffer_;
+  int64_t mask_{};
+};
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "controllers/project_json_serializer.h"
+#include "controllers/project_saver.h"
+
+#include <QUuid>
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+
+namespace zrythm::controllers
+{
+
+namespace
+{
+constexpr int NUM_TRACKS = 1000;
+constexpr int NUM_PARAMS_PER_TRACK = 40;
+constexpr int NUM_REGIONS_PER_TRACK = 8;
+constexpr int NUM_NOTES_PER_REGION = 64;
+
+std::string
+make_uuid ()
+{
+  return QUuid::createUuid ().toString (QUuid::WithoutBraces).toStdString ();
+}
+
+/**
+ * @brief Creates a document shaped like a project with @ref NUM_TRACKS MIDI
+ * tracks (parameters, regions and notes keyed by UUIDs).
+ *
+ * Only the shape matters here (it doesn't follow the schema).
+ */
+nlohmann::json
+make_project_document ()
+{
+  std::mt19937                          rng (1234);
+  std::uniform_real_distribution<float> value_dist (0.f, 1.f);
+  std::uniform_int_distribution<int>    pitch_dist (0, 127);
+
+  auto tracks = nlohmann::json::array ();
+  for (int t = 0; t < NUM_TRACKS; ++t)
+    {
+      auto params = nlohmann::json::array ();
+      for (int p = 0; p < NUM_PARAMS_PER_TRACK; ++p)
+        {
+          params.push_back (
+            { { "id", make_uuid () },
+              { "uniqueId", "param_" + std::to_string (p) },
+              { "baseValue", value_dist (rng) },
+              { "automationState", "off" } });
+        }
+
+      auto regions = nlohmann::json::array ();
+      for (int r = 0; r < NUM_REGIONS_PER_TRACK; ++r)
+        {
+          auto notes = nlohmann::json::array ();
+          for (int n = 0; n < NUM_NOTES_PER_REGION; ++n)
+            {
+              notes.push_back (
+                { { "id", make_uuid () },
+                  { "position", { { "value", n * 240.0 } } },
+                  { "length", { { "value", 240.0 } } },
+                  { "pitch", pitch_dist (rng) },
+                  { "velocity", 90 },
+                  { "muted", false } });
+            }
+          regions.push_back (
+            { { "id", make_uuid () },
+              { "name", "Region " + std::to_string (r) },
+              { "position", { { "value", r * 15360.0 } } },
+              { "length", { { "value", 15360.0 } } },
+              { "notes", std::move (notes) } });
+        }
+
+      tracks.push_back (
+        { { "id", make_uuid () },
+          { "name", "Track " + std::to_string (t) },
+          { "color", "#3584e4" },
+          { "parameters", std::move (params) },
+          { "regions", std::move (regions) } });
+    }
+
+  return {
+    { "documentType", ProjectJsonSerializer::DOCUMENT_TYPE },
+    { "title", "Benchmark" },
+    { "projectData",
+     { { "tracklist", { { "tracks", std::move (tracks) } } } } },
+  };
+}
+
+const nlohmann::json &
+project_document ()
+{
+  static const auto doc = make_project_document ();
+  return doc;
+}
+
+std::string
+compress (const std::string &data)
+{
+  char * compressed = nullptr;
+  size_t compressed_size = 0;
+  ProjectSaver::compress (
+    &compressed, &compressed_size,
+    QByteArray::fromRawData (
+      data.data (), static_cast<qsizetype> (data.size ())));
+  std::string ret (compressed, compressed_size);
+  free (compressed);
+  return ret;
+}
+
+void
+set_label (benchmark::State &state, ProjectJsonSerializer::Encoding encoding)
+{
+  state.SetLabel (
+    encoding == ProjectJsonSerializer::Encoding::Json ? "json" : "cbor");
+}
+}
+
+/**
+ * @brief Encodes and compresses the document (what the saver does after
+ * serializing the project).
+ */
+static void
+BM_ProjectFileSave (benchmark::State &state)
+{
+  const auto  encoding = static_cast<ProjectJsonSerializer::Encoding> (
+    state.range (0));
+  const auto &doc = project_document ();
+  size_t      encoded_size = 0;
+  size_t      file_size = 0;
+  for (auto _ : state)
+    {
+      const auto data = ProjectJsonSerializer::encode (doc, encoding);
+      const auto file = compress (data);
+      encoded_size = data.size ();
+      file_size = file.size ();
+      benchmark::DoNotOptimize (file);
+    }
+  set_label (state, encoding);
+  state.counters["encoded_bytes"] = static_cast<double> (encoded_size);
+  state.counters["file_bytes"] = static_cast<double> (file_size);
+}
+BENCHMARK (BM_ProjectFileSave)
+  ->Arg (static_cast<int> (ProjectJsonSerializer::Encoding::Json))
+  ->Arg (static_cast<int> (ProjectJsonSerializer::Encoding::Cbor))
+  ->Unit (benchmark::kMillisecond);
+
+/**
+ * @brief Decompresses and decodes the document (what the loader does before
+ * validating and deserializing the project).
+ */
+static void
+BM_ProjectFileLoad (benchmark::State &state)
+{
+  const auto encoding = static_cast<ProjectJsonSerializer::Encoding> (
+    state.range (0));
+  const auto file =
+    compress (ProjectJsonSerializer::encode (project_document (), encoding));
+  const auto src = QByteArray::fromRawData (
+    file.data (), static_cast<qsizetype> (file.size ()));
+  for (auto _ : state)
+    {
+      char * data = nullptr;
+      size_t data_size = 0;
+      ProjectSaver::decompress (&data, &data_size, src);
+      auto doc =
+        ProjectJsonSerializer::decode (std::string_view (data, data_size));
+      free (data);
+      benchmark::DoNotOptimize (doc);
+    }
+  set_label (state, encoding);
+}
+BENCHMARK (BM_ProjectFileLoad)
+  ->Arg (static_cast<int> (ProjectJsonSerializer::Encoding::Json))
+  ->Arg (static_cast<int> (ProjectJsonSerializer::Encoding::Cbor))
+  ->Unit (benchmark::kMillisecond);
+}
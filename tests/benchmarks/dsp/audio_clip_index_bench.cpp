@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <random>
+#include <vector>
+
+#include "dsp/timeline_data_cache.h"
+
+#include <benchmark/benchmark.h>
+
+namespace zrythm::dsp
+{
+
+namespace
+{
+constexpr int64_t BLOCK_LENGTH = 256;
+
+/**
+ * @brief Creates @p num_clips clips spread over the timeline like comped
+ * takes: mostly short, sometimes overlapping, with a few long clips.
+ */
+std::vector<AudioClipIntervalIndex::Entry>
+make_clips (int64_t num_clips)
+{
+  std::mt19937                           rng (1234);
+  std::uniform_int_distribution<int64_t> length_dist (2'000, 48'000);
+  std::uniform_int_distribution<int64_t> overlap_dist (0, 4'000);
+
+  std::vector<AudioClipIntervalIndex::Entry> clips;
+  clips.reserve (static_cast<size_t> (num_clips));
+  int64_t pos = 0;
+  for (int64_t i = 0; i < num_clips; ++i)
+    {
+      const auto length = (i % 500 == 0) ? 480'000 : length_dist (rng);
+      AudioClipIntervalIndex::Entry entry;
+      entry.start_sample = units::samples (pos);
+      entry.end_sample = units::samples (pos + length);
+      clips.push_back (std::move (entry));
+      pos += std::max (int64_t{ 1 }, length - overlap_dist (rng));
+    }
+  return clips;
+}
+
+int64_t
+timeline_end (std::span<const AudioClipIntervalIndex::Entry> clips)
+{
+  return clips.back ().end_sample.in (units::samples);
+}
+}
+
+/**
+ * @brief Baseline: tests every clip for overlap on every block.
+ */
+static void
+BM_ActiveClipsLinearScan (benchmark::State &state)
+{
+  const auto clips = make_clips (state.range (0));
+  const auto end = timeline_end (clips);
+  int64_t    pos = 0;
+  for (auto _ : state)
+    {
+      const auto block_start = units::samples (pos);
+      const auto block_end = units::samples (pos + BLOCK_LENGTH);
+      size_t     num_overlapping = 0;
+      for (const auto &clip : clips)
+        {
+          if (clip.end_sample > block_start && clip.start_sample < block_end)
+            ++num_overlapping;
+        }
+      benchmark::DoNotOptimize (num_overlapping);
+      pos = (pos + BLOCK_LENGTH) % end;
+    }
+  state.SetComplexityN (state.range (0));
+}
+BENCHMARK (BM_ActiveClipsLinearScan)
+  ->RangeMultiplier (10)
+  ->Range (100, 10'000)
+  ->Complexity ();
+
+/**
+ * @brief Looks up the clips for consecutive blocks through the index.
+ */
+static void
+BM_ActiveClipsIntervalIndex (benchmark::State &state)
+{
+  const auto                   clips = make_clips (state.range (0));
+  const auto                   end = timeline_end (clips);
+  const AudioClipIntervalIndex index (clips);
+  int64_t                      pos = 0;
+  for (auto _ : state)
+    {
+      const auto block_start = units::samples (pos);
+      const auto block_end = units::samples (pos + BLOCK_LENGTH);
+      size_t     num_overlapping = 0;
+      for (
+        const auto &clip :
+        index.find_overlap_candidates (block_start, block_end))
+        {
+          if (clip.end_sample > block_start && clip.start_sample < block_end)
+            ++num_overlapping;
+        }
+      benchmark::DoNotOptimize (num_overlapping);
+      pos = (pos + BLOCK_LENGTH) % end;
+    }
+  state.SetComplexityN (state.range (0));
+}
+BENCHMARK (BM_ActiveClipsIntervalIndex)
+  ->RangeMultiplier (10)
+  ->Range (100, 10'000)
+  ->Complexity ();
+
+/**
+ * @brief Looks up the clips for random positions (a seek on every block).
+ */
+static void
+BM_ActiveClipsIntervalIndexSeek (benchmark::State &state)
+{
+  const auto                             clips = make_clips (state.range (0));
+  const auto                             end = timeline_end (clips);
+  const AudioClipIntervalIndex           index (clips);
+  std::mt19937                           rng (5678);
+  std::uniform_int_distribution<int64_t> pos_dist (0, end);
+  for (auto _ : state)
+    {
+      const auto pos = pos_dist (rng);
+      size_t     num_candidates = 0;
+      for (
+        const auto &clip : index.find_overlap_candidates (
+          units::samples (pos), units::samples (pos + BLOCK_LENGTH)))
+        {
+          benchmark::DoNotOptimize (&clip);
+          ++num_candidates;
+        }
+      benchmark::DoNotOptimize (num_candidates);
+    }
+  state.SetComplexityN (state.range (0));
+}
+BENCHMARK (BM_ActiveClipsIntervalIndexSeek)
+  ->RangeMultiplier (10)
+  ->Range (100, 10'000)
+  ->Complexity (benchmark::oLogN);
+}
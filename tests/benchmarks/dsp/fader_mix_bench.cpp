@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <vector>
+
+#include "dsp/panning.h"
+#include "utils/float_ranges.h"
+
+#include <benchmark/benchmark.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace zrythm::dsp
+{
+
+namespace
+{
+constexpr int NUM_CHANNELS = 256;
+
+/**
+ * @brief A mix of stereo faders with gain, balance, mono compatibility, phase
+ * swap and the hard limit all in use.
+ *
+ * The settings keep the signal level constant so that repeated processing
+ * doesn't produce denormals.
+ */
+struct FaderMix
+{
+  explicit FaderMix (size_t block_length)
+      : buffers_ (
+          NUM_CHANNELS,
+          juce::AudioSampleBuffer (2, static_cast<int> (block_length))),
+        gains_ (block_length, 1.f), gains_l_ (block_length),
+        gains_r_ (block_length)
+  {
+    for (auto &buf : buffers_)
+      {
+        for (const auto ch : { 0, 1 })
+          {
+            juce::FloatVectorOperations::fill (
+              buf.getWritePointer (ch), 0.5f, buf.getNumSamples ());
+          }
+      }
+  }
+
+  std::vector<juce::AudioSampleBuffer> buffers_;
+  std::vector<float>                   gains_;
+  std::vector<float>                   gains_l_;
+  std::vector<float>                   gains_r_;
+  float                                balance_ = 0.5f;
+};
+
+std::span<float>
+channel (juce::AudioSampleBuffer &buf, int ch)
+{
+  return {
+    buf.getWritePointer (ch), static_cast<size_t> (buf.getNumSamples ())
+  };
+}
+
+void
+set_per_channel_counter (benchmark::State &state)
+{
+  state.counters["per_channel"] = benchmark::Counter (
+    NUM_CHANNELS, benchmark::Counter::kIsIterationInvariantRate
+                    | benchmark::Counter::kInvert);
+}
+}
+
+/**
+ * @brief Baseline: a separate pass over the buffers for each stage.
+ */
+static void
+BM_FaderMixSeparatePasses (benchmark::State &state)
+{
+  FaderMix mix (static_cast<size_t> (state.range (0)));
+  for (auto _ : state)
+    {
+      for (auto &buf : mix.buffers_)
+        {
+          const auto [calc_l, calc_r] = calculate_balance_control (
+            BalanceControlAlgorithm::Linear, mix.balance_);
+          auto l = channel (buf, 0);
+          auto r = channel (buf, 1);
+          utils::float_ranges::mul2 (l, mix.gains_);
+          utils::float_ranges::mul2 (r, mix.gains_);
+          utils::float_ranges::mul_k2 (l, calc_l);
+          utils::float_ranges::mul_k2 (r, calc_r);
+          utils::float_ranges::make_mono (l, r, false);
+          utils::float_ranges::mul_k2 (l, -1.f);
+          utils::float_ranges::mul_k2 (r, -1.f);
+          utils::float_ranges::clip (l, -2.f, 2.f);
+          utils::float_ranges::clip (r, -2.f, 2.f);
+          benchmark::DoNotOptimize (buf.getWritePointer (0));
+        }
+    }
+  set_per_channel_counter (state);
+}
+BENCHMARK (BM_FaderMixSeparatePasses)->RangeMultiplier (4)->Range (64, 1024);
+
+/**
+ * @brief Folds balance and phase into the gains and applies everything in a
+ * single pass (like Fader does).
+ */
+static void
+BM_FaderMixFused (benchmark::State &state)
+{
+  FaderMix mix (static_cast<size_t> (state.range (0)));
+  for (auto _ : state)
+    {
+      for (auto &buf : mix.buffers_)
+        {
+          juce::ScopedNoDenormals no_denormals;
+          const auto [calc_l, calc_r] = calculate_balance_control (
+            BalanceControlAlgorithm::Linear, mix.balance_);
+          utils::float_ranges::product (mix.gains_l_, mix.gains_, -calc_l);
+          utils::float_ranges::product (mix.gains_r_, mix.gains_, -calc_r);
+          utils::float_ranges::stereo_fader (
+            channel (buf, 0), channel (buf, 1), mix.gains_l_, mix.gains_r_,
+            true, 2.f);
+          benchmark::DoNotOptimize (buf.getWritePointer (0));
+        }
+    }
+  set_per_channel_counter (state);
+}
+BENCHMARK (BM_FaderMixFused)->RangeMultiplier (4)->Range (64, 1024);
+}
@@ -0,0 +1,281 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "dsp/graph_builder.h"
+#include "dsp/graph_dispatcher.h"
+#include "dsp/tempo_map.h"
+#include "utils/float_ranges.h"
+#include "utils/utf8_string.h"
+
+#include "../tests/helpers/mock_hardware_audio_interface.h"
+#include "../tests/unit/dsp/graph_helpers.h"
+#include <benchmark/benchmark.h>
+#include <gmock/gmock.h>
+
+namespace zrythm::dsp
+{
+using namespace testing;
+
+namespace
+{
+/**
+ * @brief Processable with a realistic buffer allocation in prepare and a bit
+ * of DSP work per block.
+ */
+class BenchProcessable final : public graph::IProcessable
+{
+public:
+  explicit BenchProcessable (bool stages_inputs)
+      : stages_inputs_ (stages_inputs)
+  {
+  }
+
+  utils::Utf8String get_node_name () const override { return u8"bench_node"; }
+
+  void process_block (
+    graph::ProcessBlockInfo time_nfo,
+    const ITransport &,
+    const TempoMap &) noexcept override
+  {
+    auto buf = std::span (buffer_).first (time_nfo.nframes_.in (units::samples));
+    utils::float_ranges::fill (buf, 0.5f);
+    utils::float_ranges::mul_k2 (buf, 0.8f);
+    benchmark::DoNotOptimize (utils::float_ranges::abs_max (buf));
+  }
+
+  void release_resources () override
+  {
+    buffer_.clear ();
+    buffer_.shrink_to_fit ();
+  }
+
+  bool stage_node_inputs (const graph::GraphNode &) override
+  {
+    return stages_inputs_;
+  }
+
+protected:
+  void prepare_for_processing_impl (
+    const graph::GraphNode *,
+    units::sample_rate_t,
+    units::sample_u32_t max_block_length) override
+  {
+    buffer_.assign (max_block_length.in (units::samples) * 2, 0.f);
+  }
+
+private:
+  std::vector<float> buffer_;
+
+  /** Whether input changes are applied without pausing processing. */
+  bool stages_inputs_{};
+};
+
+/**
+ * @brief Builds @p num_tracks chains of @p chain_length nodes feeding a
+ * master node.
+ */
+class BenchGraphBuilder final : public graph::IGraphBuilder
+{
+public:
+  BenchGraphBuilder (
+    std::vector<std::unique_ptr<BenchProcessable>> &processables,
+    BenchProcessable                               &master,
+    size_t                                          chain_length)
+      : processables_ (processables), master_ (master),
+        chain_length_ (chain_length)
+  {
+  }
+
+  size_t num_tracks_{};
+
+protected:
+  void build_graph_impl (graph::Graph &graph) override
+  {
+    auto * master_node = graph.add_node_for_processable (master_);
+    for (size_t t = 0; t < num_tracks_; ++t)
+      {
+        graph::GraphNode * prev = nullptr;
+        for (size_t n = 0; n < chain_length_; ++n)
+          {
+            auto * node = graph.add_node_for_processable (
+              *processables_.at ((t * chain_length_) + n));
+            if (prev != nullptr)
+              prev->connect_to (*node);
+            prev = node;
+          }
+        prev->connect_to (*master_node);
+      }
+  }
+
+private:
+  std::vector<std::unique_ptr<BenchProcessable>> &processables_;
+  BenchProcessable                               &master_;
+  size_t                                          chain_length_;
+};
+}
+
+/**
+ * @brief Measures the longest time the audio thread could not run a cycle
+ * while the graph is being rebuilt (one track added per rebuild).
+ *
+ * The master node's inputs change on every rebuild, so it is either
+ * re-prepared while processing is paused or its new inputs are staged and
+ * the graph is swapped in without pausing.
+ */
+class GraphDispatcherBenchmark : public benchmark::Fixture
+{
+protected:
+  using MockTransport = zrythm::dsp::graph_test::MockTransport;
+
+  void SetUp (benchmark::State &state) override
+  {
+    const auto num_tracks = static_cast<size_t> (state.range (0));
+    const bool stages_inputs = state.range (1) != 0;
+    max_tracks_ = num_tracks * 2;
+    for (size_t i = 0; i < max_tracks_ * chain_length_; ++i)
+      {
+        processables_.push_back (
+          std::make_unique<BenchProcessable> (stages_inputs));
+      }
+    master_ = std::make_unique<BenchProcessable> (stages_inputs);
+
+    transport_ = std::make_unique<NiceMock<MockTransport>> ();
+    ON_CALL (*transport_, get_play_state ())
+      .WillByDefault (Return (ITransport::PlayState::Paused));
+    ON_CALL (*transport_, get_playhead_position_in_audio_thread ())
+      .WillByDefault (Return (units::samples (0)));
+    ON_CALL (*transport_, get_loop_range_positions ())
+      .WillByDefault (
+        Return (std::make_pair (units::samples (0), units::samples (48000))));
+    tempo_map_ = std::make_unique<TempoMap> (units::sample_rate (48000));
+    hw_interface_ =
+      std::make_unique<test_helpers::MockHardwareAudioInterface> ();
+
+    auto builder = std::make_unique<BenchGraphBuilder> (
+      processables_, *master_, chain_length_);
+    builder->num_tracks_ = num_tracks;
+    builder_ = builder.get ();
+    terminals_ = { master_.get () };
+
+    dispatcher_ = std::make_unique<DspGraphDispatcher> (
+      std::move (builder), [this] () { return std::span (terminals_); },
+      *hw_interface_,
+      [this] (std::function<void ()> func) {
+        std::lock_guard lock (processing_mutex_);
+        func ();
+      },
+      [] (std::function<void ()> func) { func (); });
+    dispatcher_->recalc_graph (false);
+  }
+
+  void TearDown (benchmark::State &) override
+  {
+    dispatcher_.reset ();
+    builder_ = nullptr;
+    processables_.clear ();
+    master_.reset ();
+    transport_.reset ();
+    tempo_map_.reset ();
+    hw_interface_.reset ();
+  }
+
+  /**
+   * @brief Emulates the audio callback: runs a cycle whenever processing is
+   * not paused and records the longest gap between completed cycles.
+   */
+  void run_audio_thread ()
+  {
+    const auto time_nfo = graph::ProcessBlockInfo::from_position_and_nframes (
+      units::samples (0), units::samples (256));
+    auto last_cycle = std::chrono::steady_clock::now ();
+    while (!stop_audio_thread_.load ())
+      {
+        {
+          std::unique_lock lock (processing_mutex_, std::try_to_lock);
+          if (lock.owns_lock ())
+            {
+              dispatcher_->start_cycle (
+                *transport_, time_nfo, units::samples (0), true, *tempo_map_);
+              const auto now = std::chrono::steady_clock::now ();
+              const auto gap =
+                std::chrono::duration_cast<std::chrono::microseconds> (
+                  now - last_cycle)
+                  .count ();
+              max_stall_us_.store (std::max (max_stall_us_.load (), gap));
+              last_cycle = now;
+            }
+        }
+        std::this_thread::sleep_for (std::chrono::microseconds (100));
+      }
+  }
+
+  static constexpr size_t chain_length_ = 4;
+
+  size_t                                         max_tracks_{};
+  std::vector<std::unique_ptr<BenchProcessable>> processables_;
+  std::unique_ptr<BenchProcessable>              master_;
+  std::vector<graph::IProcessable *>             terminals_;
+  BenchGraphBuilder *                            builder_{};
+  std::unique_ptr<NiceMock<MockTransport>>       transport_;
+  std::unique_ptr<TempoMap>                      tempo_map_;
+  std::unique_ptr<IHardwareAudioInterface>       hw_interface_;
+  std::unique_ptr<DspGraphDispatcher>            dispatcher_;
+
+  std::mutex                processing_mutex_;
+  std::atomic<bool>         stop_audio_thread_{ false };
+  std::atomic<std::int64_t> max_stall_us_{ 0 };
+};
+
+BENCHMARK_DEFINE_F (GraphDispatcherBenchmark, RecalcWhileProcessing)
+(benchmark::State &state)
+{
+  stop_audio_thread_ = false;
+  std::thread audio_thread ([this] () { run_audio_thread (); });
+
+  std::int64_t worst_stall_us = 0;
+  for (auto _ : state)
+    {
+      state.PauseTiming ();
+      if (builder_->num_tracks_ >= max_tracks_)
+        {
+          builder_->num_tracks_ = max_tracks_ / 2;
+        }
+      ++builder_->num_tracks_;
+      // let a few cycles through so the gap before the rebuild is not counted
+      std::this_thread::sleep_for (std::chrono::milliseconds (2));
+      max_stall_us_ = 0;
+      state.ResumeTiming ();
+
+      dispatcher_->recalc_graph (false);
+
+      state.PauseTiming ();
+      std::this_thread::sleep_for (std::chrono::milliseconds (2));
+      worst_stall_us = std::max (worst_stall_us, max_stall_us_.load ());
+      state.ResumeTiming ();
+    }
+
+  stop_audio_thread_ = true;
+  audio_thread.join ();
+
+  state.counters["max_audio_stall_us"] =
+    benchmark::Counter (static_cast<double> (worst_stall_us));
+  state.counters["nodes"] = static_cast<double> (
+    (builder_->num_tracks_ * chain_length_) + 1);
+}
+
+BENCHMARK_REGISTER_F (GraphDispatcherBenchmark, RecalcWhileProcessing)
+  // Format: {num_tracks, stage_inputs (0: pause to re-prepare, 1: no pause)}
+  ->Args ({ 50, 0 })
+  ->Args ({ 300, 0 })
+  ->Args ({ 1000, 0 })
+  ->Args ({ 50, 1 })
+  ->Args ({ 300, 1 })
+  ->Args ({ 1000, 1 })
+  ->Unit (benchmark::kMillisecond)
+  ->UseRealTime ();
+}
@@ -204,6 +204,108 @@ protected:
     return collection;
   }
 
+  /**
+   * @brief One source fanning out to @p width parallel nodes that all feed a
+   * single sink (e.g., many tracks into the master bus).
+   */
+  GraphNodeCollection create_wide_graph (size_t width)
+  {
+    GraphNodeCollection collection;
+
+    auto   root_proc = create_processable ();
+    auto   sink_proc = create_processable ();
+    auto   root = std::make_unique<GraphNode> (0, *root_proc);
+    auto   sink = std::make_unique<GraphNode> (width + 1, *sink_proc);
+    auto * root_ptr = root.get ();
+    auto * sink_ptr = sink.get ();
+    collection.graph_nodes_.push_back (std::move (root));
+    collection.graph_nodes_.push_back (std::move (sink));
+    processables_.push_back (std::move (root_proc));
+    processables_.push_back (std::move (sink_proc));
+
+    for (size_t i = 0; i < width; i++)
+      {
+        auto proc = create_processable ();
+        auto node = std::make_unique<GraphNode> (i + 1, *proc);
+        root_ptr->connect_to (*node);
+        node->connect_to (*sink_ptr);
+        collection.graph_nodes_.push_back (std::move (node));
+        processables_.push_back (std::move (proc));
+      }
+
+    collection.finalize_nodes ();
+    return collection;
+  }
+
+  /**
+   * @brief @p num_chains independent chains of @p depth nodes merging into a
+   * single sink (e.g., tracks with long insert chains).
+   */
+  GraphNodeCollection create_deep_graph (size_t num_chains, size_t depth)
+  {
+    GraphNodeCollection collection;
+
+    auto   sink_proc = create_processable ();
+    auto   sink = std::make_unique<GraphNode> (0, *sink_proc);
+    auto * sink_ptr = sink.get ();
+    collection.graph_nodes_.push_back (std::move (sink));
+    processables_.push_back (std::move (sink_proc));
+
+    for (size_t c = 0; c < num_chains; c++)
+      {
+        GraphNode * prev = nullptr;
+        for (size_t d = 0; d < depth; d++)
+          {
+            auto proc = create_processable ();
+            auto node = std::make_unique<GraphNode> (
+              collection.graph_nodes_.size (), *proc);
+            if (prev != nullptr)
+              prev->connect_to (*node);
+            prev = node.get ();
+            collection.graph_nodes_.push_back (std::move (node));
+            processables_.push_back (std::move (proc));
+          }
+        prev->connect_to (*sink_ptr);
+      }
+
+    collection.finalize_nodes ();
+    return collection;
+  }
+
+  /**
+   * @brief Runs cycles on @p collection with the given strategy and thread
+   * count.
+   */
+  void run_cycles (
+    benchmark::State                &state,
+    GraphNodeCollection            &&collection,
+    GraphScheduler::DispatchStrategy strategy,
+    int                              num_threads)
+  {
+    const auto num_nodes = collection.graph_nodes_.size ();
+    scheduler_->set_dispatch_strategy (strategy);
+    scheduler_->rechain_from_node_collection (
+      std::move (collection), sample_rate_, max_block_length_);
+    scheduler_->start_threads (num_threads);
+
+    const auto time_info =
+      dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+        units::samples (0), units::samples (256));
+
+    for (auto _ : state)
+      {
+        scheduler_->run_cycle (
+          time_info, units::samples (0), *transport_, *tempo_map_);
+      }
+
+    scheduler_->terminate_threads ();
+    state.SetComplexityN (static_cast<int64_t> (num_nodes));
+    state.SetLabel (
+      strategy == GraphScheduler::DispatchStrategy::WorkStealing
+        ? "work-stealing"
+        : "shared-queue");
+  }
+
   units::sample_rate_t            sample_rate_{ units::sample_rate (48000) };
   units::sample_u32_t             max_block_length_{ units::samples (1024) };
   std::unique_ptr<MockTransport>  transport_;
@@ -292,6 +394,32 @@ BENCHMARK_DEFINE_F (GraphSchedulerBenchmark, ComplexGraph)
   state.counters["Nodes/Thread"] = double (num_nodes) / double (num_threads);
 }
 
+BENCHMARK_DEFINE_F (GraphSchedulerBenchmark, WideGraph)
+(benchmark::State &state)
+{
+  const auto width = state.range (0);
+  const auto num_threads = state.range (1);
+  const auto strategy =
+    static_cast<GraphScheduler::DispatchStrategy> (state.range (2));
+
+  run_cycles (
+    state, create_wide_graph (width), strategy, static_cast<int> (num_threads));
+}
+
+BENCHMARK_DEFINE_F (GraphSchedulerBenchmark, DeepGraph)
+(benchmark::State &state)
+{
+  const auto num_chains = state.range (0);
+  const auto depth = state.range (1);
+  const auto num_threads = state.range (2);
+  const auto strategy =
+    static_cast<GraphScheduler::DispatchStrategy> (state.range (3));
+
+  run_cycles (
+    state, create_deep_graph (num_chains, depth), strategy,
+    static_cast<int> (num_threads));
+}
+
 // Register linear chain benchmarks
 BENCHMARK_REGISTER_F (GraphSchedulerBenchmark, LinearChain)
   // Format: {num_nodes, block_size, num_threads}
@@ -355,5 +483,17 @@ BENCHMARK_REGISTER_F (GraphSchedulerBenchmark, ComplexGraph)
   ->Args ({ 500, 64, 2, 20 })    // Small but dense
   ->Complexity ();
 
+// Register dispatch strategy comparison benchmarks
+// Strategy: 0 = shared queue, 1 = work stealing
+BENCHMARK_REGISTER_F (GraphSchedulerBenchmark, WideGraph)
+  // Format: {width, num_threads, strategy}
+  ->ArgsProduct ({ { 256, 1024 }, { 4, 8, 16, 32 }, { 0, 1 } })
+  ->Complexity ();
+
+BENCHMARK_REGISTER_F (GraphSchedulerBenchmark, DeepGraph)
+  // Format: {num_chains, depth, num_threads, strategy}
+  ->ArgsProduct ({ { 16, 64 }, { 16, 64 }, { 4, 8, 16, 32 }, { 0, 1 } })
+  ->Complexity ();
+
 BENCHMARK_MAIN ();
 }
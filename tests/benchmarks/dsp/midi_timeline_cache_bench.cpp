@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <vector>
+
+#include "dsp/midi_event.h"
+#include "dsp/timeline_data_cache.h"
+
+#include <benchmark/benchmark.h>
+
+namespace zrythm::dsp
+{
+
+namespace
+{
+constexpr int64_t CLIP_LENGTH = 48'000;
+constexpr int64_t NOTES_PER_CLIP = 16;
+
+struct Clip
+{
+  TimelineDataCache::IntervalType   interval;
+  std::vector<SampleBasedMidiEvent> events;
+};
+
+/**
+ * @brief Creates a clip with a run of notes, transposed by @p transpose.
+ */
+Clip
+make_clip (int64_t index, int transpose = 0)
+{
+  const auto start = index * CLIP_LENGTH;
+  const auto note_length = CLIP_LENGTH / NOTES_PER_CLIP;
+  Clip       clip{
+    { units::samples (start), units::samples (start + CLIP_LENGTH) }, {}
+  };
+  for (int64_t i = 0; i < NOTES_PER_CLIP; ++i)
+    {
+      const auto pitch = static_cast<midi_byte_t> (48 + (i % 24) + transpose);
+      const auto note_start = start + (i * note_length);
+      clip.events.push_back (
+        midi_event::make_note_on (0, pitch, 100, units::samples (note_start)));
+      clip.events.push_back (midi_event::make_note_off (
+        0, pitch, units::samples (note_start + note_length)));
+    }
+  return clip;
+}
+
+std::vector<Clip>
+make_clips (int64_t num_clips)
+{
+  std::vector<Clip> clips;
+  clips.reserve (static_cast<size_t> (num_clips));
+  for (int64_t i = 0; i < num_clips; ++i)
+    {
+      clips.push_back (make_clip (i));
+    }
+  return clips;
+}
+}
+
+/**
+ * @brief Baseline: rebuilds the cache from scratch after an edit.
+ */
+static void
+BM_MidiCacheFullRebuild (benchmark::State &state)
+{
+  const auto            clips = make_clips (state.range (0));
+  MidiTimelineDataCache cache;
+  for (auto _ : state)
+    {
+      cache.clear ();
+      for (const auto &clip : clips)
+        {
+          cache.add_midi_sequence (clip.interval, clip.events);
+        }
+      cache.finalize_changes ();
+      benchmark::DoNotOptimize (cache.midi_events ().data ());
+    }
+  state.SetComplexityN (state.range (0));
+}
+BENCHMARK (BM_MidiCacheFullRebuild)
+  ->RangeMultiplier (10)
+  ->Range (100, 10'000)
+  ->Complexity ();
+
+/**
+ * @brief Replaces a single clip (as when editing a note) and publishes the
+ * change.
+ */
+static void
+BM_MidiCacheEditToPublish (benchmark::State &state)
+{
+  const auto            num_clips = state.range (0);
+  const auto            clips = make_clips (num_clips);
+  const auto            edited_clip = make_clip (num_clips / 2, 1);
+  const auto           &original_clip = clips[num_clips / 2];
+  MidiTimelineDataCache cache;
+  for (const auto &clip : clips)
+    {
+      cache.add_midi_sequence (clip.interval, clip.events);
+    }
+  cache.finalize_changes ();
+
+  bool edited = false;
+  for (auto _ : state)
+    {
+      const auto &clip = edited ? original_clip : edited_clip;
+      cache.remove_sequences_matching_interval (clip.interval);
+      cache.add_midi_sequence (clip.interval, clip.events);
+      cache.finalize_changes ();
+      benchmark::DoNotOptimize (cache.midi_events ().data ());
+      edited = !edited;
+    }
+  state.SetComplexityN (num_clips);
+}
+BENCHMARK (BM_MidiCacheEditToPublish)
+  ->RangeMultiplier (10)
+  ->Range (100, 10'000)
+  ->Complexity ();
+}
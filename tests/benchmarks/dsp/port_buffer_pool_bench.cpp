@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <ranges>
+
+#include "dsp/audio_port.h"
+#include "dsp/graph.h"
+#include "dsp/port_buffer_pool.h"
+#include "dsp/tempo_map.h"
+#include "utils/utf8_string.h"
+
+#include "../tests/unit/dsp/graph_helpers.h"
+#include <benchmark/benchmark.h>
+#include <gmock/gmock.h>
+
+namespace zrythm::dsp
+{
+using namespace testing;
+
+namespace
+{
+/**
+ * @brief Processor applying a gain from its input port to its output port
+ * (or generating a signal if it has no input), clearing the input afterwards
+ * like ProcessorBase.
+ */
+class GainProcessable final : public graph::IProcessable
+{
+public:
+  GainProcessable (AudioPort * in, AudioPort &out) : in_ (in), out_ (out) { }
+
+  utils::Utf8String get_node_name () const override { return u8"gain"; }
+
+  void process_block (
+    graph::ProcessBlockInfo time_nfo,
+    const ITransport &,
+    const TempoMap &) noexcept override
+  {
+    const auto offset = time_nfo.buffer_offset_.in<int> (units::samples);
+    const auto nframes = time_nfo.nframes_.in<int> (units::samples);
+    auto      &out_buf = *out_.buffers ();
+    for (const auto ch : std::views::iota (0, out_buf.getNumChannels ()))
+      {
+        if (in_ != nullptr)
+          {
+            out_buf.copyFrom (
+              ch, offset, in_->buffers ()->getReadPointer (ch, offset),
+              nframes, 0.8f);
+          }
+        else
+          {
+            juce::FloatVectorOperations::fill (
+              out_buf.getWritePointer (ch, offset), 0.5f, nframes);
+          }
+      }
+    if (in_ != nullptr)
+      {
+        in_->clear_buffer (
+          static_cast<size_t> (offset), static_cast<size_t> (nframes));
+      }
+  }
+
+private:
+  AudioPort * in_{};
+  AudioPort  &out_;
+};
+
+/**
+ * @brief @p num_tracks chains of plugins connected through output and input
+ * port pairs, summed into a master input.
+ */
+class PortChains
+{
+public:
+  PortChains (size_t num_tracks, size_t chain_length)
+  {
+    master_in_ = make_port (PortFlow::Input);
+    master_out_ = make_port (PortFlow::Output);
+    master_ = std::make_unique<GainProcessable> (master_in_, *master_out_);
+    auto * master_in_node = graph_.add_node_for_processable (*master_in_);
+    master_in_node->connect_to (*graph_.add_node_for_processable (*master_));
+    graph_.add_node_for_processable (*master_)->connect_to (
+      *graph_.add_node_for_processable (*master_out_));
+
+    for (size_t t = 0; t < num_tracks; ++t)
+      {
+        AudioPort * in = nullptr;
+        for (size_t n = 0; n < chain_length; ++n)
+          {
+            auto * out = make_port (PortFlow::Output);
+            processors_.push_back (
+              std::make_unique<GainProcessable> (in, *out));
+            auto * proc_node =
+              graph_.add_node_for_processable (*processors_.back ());
+            if (in != nullptr)
+              graph_.add_node_for_processable (*in)->connect_to (*proc_node);
+            auto * out_node = graph_.add_node_for_processable (*out);
+            proc_node->connect_to (*out_node);
+
+            // the next plugin's input, or the master input
+            in =
+              n + 1 < chain_length ? make_port (PortFlow::Input) : master_in_;
+            out_node->connect_to (*graph_.add_node_for_processable (*in));
+          }
+      }
+    graph_.finalize_nodes ();
+
+    for (auto * node : graph_.get_nodes ().topological_order_)
+      {
+        node->get_processable ().prepare_for_processing (
+          node, units::sample_rate (48000), BLOCK_LENGTH);
+      }
+  }
+
+  void process_cycle (const ITransport &transport, const TempoMap &tempo_map)
+  {
+    const auto time_nfo = graph::ProcessBlockInfo::from_position_and_nframes (
+      units::samples (0), BLOCK_LENGTH);
+    for (auto * node : graph_.get_nodes ().topological_order_)
+      {
+        node->get_processable ().process_block (
+          time_nfo, transport, tempo_map);
+      }
+  }
+
+  const auto &nodes () const { return graph_.get_nodes (); }
+
+  static constexpr auto BLOCK_LENGTH = units::samples (256);
+
+private:
+  AudioPort * make_port (PortFlow flow)
+  {
+    ports_.push_back (
+      std::make_unique<AudioPort> (
+        u8"port", flow, AudioPort::BusLayout::Stereo, 2));
+    return ports_.back ().get ();
+  }
+
+  std::vector<std::unique_ptr<AudioPort>>       ports_;
+  std::vector<std::unique_ptr<GainProcessable>> processors_;
+  AudioPort *                                   master_in_{};
+  AudioPort *                                   master_out_{};
+  std::unique_ptr<GainProcessable>              master_;
+  graph::Graph                                  graph_;
+};
+}
+
+/**
+ * @brief Measures a single-threaded processing cycle with and without pooled
+ * port buffers.
+ *
+ * Reports the size of the port buffers touched per cycle: the arena plus the
+ * buffers of the ports that are not pooled when pooled, and all port buffers
+ * otherwise.
+ */
+static void
+BM_PortBufferPoolCycle (benchmark::State &state)
+{
+  const auto num_tracks = static_cast<size_t> (state.range (0));
+  const bool pooled = state.range (1) != 0;
+  constexpr size_t chain_length = 4;
+
+  NiceMock<graph_test::MockTransport> transport;
+  TempoMap                            tempo_map (units::sample_rate (48000));
+  PortChains                          chains (num_tracks, chain_length);
+
+  const auto assignment =
+    PortBufferPool::assign (chains.nodes (), PortChains::BLOCK_LENGTH);
+  if (pooled)
+    assignment->bind ();
+
+  for (auto _ : state)
+    {
+      chains.process_cycle (transport, tempo_map);
+    }
+
+  // an output per plugin, an input per plugin but the first, and the master
+  // ports
+  const auto  &stats = assignment->stats ();
+  const size_t num_ports = (num_tracks * ((chain_length * 2) - 1)) + 2;
+  const size_t port_bytes =
+    2 * PortChains::BLOCK_LENGTH.in<size_t> (units::samples) * sizeof (float);
+  const size_t all_bytes = num_ports * port_bytes;
+  const size_t working_set =
+    pooled ? all_bytes - stats.unpooled_bytes + stats.pooled_bytes : all_bytes;
+  state.counters["port_buffers_KiB"] =
+    benchmark::Counter (static_cast<double> (working_set) / 1024.);
+  state.counters["pooled_ports"] =
+    benchmark::Counter (static_cast<double> (stats.num_ports));
+  state.counters["shared_buffers"] =
+    benchmark::Counter (static_cast<double> (stats.num_slots));
+}
+
+BENCHMARK (BM_PortBufferPoolCycle)
+  // Format: {num_tracks, pooled}
+  ->Args ({ 16, 0 })
+  ->Args ({ 16, 1 })
+  ->Args ({ 128, 0 })
+  ->Args ({ 128, 1 })
+  ->Unit (benchmark::kMicrosecond);
+}
@@ -5,6 +5,7 @@
 #include <cstdlib>
 
 #include "utils/float_ranges.h"
+#include "utils/float_ranges_kernels.h"
 
 #include <benchmark/benchmark.h>
 
@@ -13,6 +14,33 @@ using namespace zrythm::utils::float_ranges;
 namespace
 {
 
+/**
+ * @brief Runs the benchmark for each buffer size and each kernel table
+ * supported by this CPU.
+ *
+ * The first argument is the buffer size and the second one is the index of
+ * the kernel table in kernels::supported().
+ */
+void
+kernel_args (benchmark::internal::Benchmark * b)
+{
+  const auto num_tables = static_cast<int64_t> (kernels::supported ().size ());
+  b->ArgNames ({ "size", "kernels" })
+    ->ArgsProduct ({
+      benchmark::CreateRange (32, 4096, 2),
+      benchmark::CreateDenseRange (0, num_tables - 1, 1),
+    });
+}
+
+const kernels::KernelTable &
+kernel_table (benchmark::State &state)
+{
+  const auto &table =
+    *kernels::supported ()[static_cast<size_t> (state.range (1))];
+  state.SetLabel (table.name);
+  return table;
+}
+
 template <size_t N>
 std::array<float, N>
 make_signal (float value)
@@ -27,120 +55,199 @@ make_signal (float value)
 static void
 BM_Fill (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> buf (size);
   for (auto _ : state)
     {
-      fill (buf, 0.5f);
+      k.fill (buf.data (), 0.5f, size);
       benchmark::DoNotOptimize (buf.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_Fill)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Fill)->Apply (kernel_args);
 
 static void
 BM_Clip (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> buf (size, 2.0f);
   for (auto _ : state)
     {
-      clip (buf, -1.0f, 1.0f);
+      k.clip (buf.data (), -1.0f, 1.0f, size);
       benchmark::DoNotOptimize (buf.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_Clip)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Clip)->Apply (kernel_args);
 
 static void
 BM_Copy (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> src (size, 0.5f);
   std::vector<float> dest (size);
   for (auto _ : state)
     {
-      copy (dest, src);
+      k.copy (dest.data (), src.data (), size);
       benchmark::DoNotOptimize (dest.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_Copy)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Copy)->Apply (kernel_args);
 
 static void
 BM_MulK2 (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> buf (size, 0.5f);
   for (auto _ : state)
     {
-      mul_k2 (buf, 0.99f);
+      k.mul_k2 (buf.data (), 0.99f, size);
       benchmark::DoNotOptimize (buf.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_MulK2)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_MulK2)->Apply (kernel_args);
 
 static void
 BM_AbsMax (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> buf (size);
   for (size_t i = 0; i < size; ++i)
     buf[i] = static_cast<float> (i % 256) / 256.f - 0.5f;
   for (auto _ : state)
     {
-      auto peak = abs_max (buf);
+      auto peak = k.abs_max (buf.data (), size);
       benchmark::DoNotOptimize (peak);
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_AbsMax)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_AbsMax)->Apply (kernel_args);
+
+static void
+BM_Min (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> buf (size);
+  for (size_t i = 0; i < size; ++i)
+    buf[i] = static_cast<float> (i % 256) / 256.f - 0.5f;
+  for (auto _ : state)
+    {
+      auto min = k.min (buf.data (), size);
+      benchmark::DoNotOptimize (min);
+    }
+}
+BENCHMARK (BM_Min)->Apply (kernel_args);
+
+static void
+BM_Max (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> buf (size);
+  for (size_t i = 0; i < size; ++i)
+    buf[i] = static_cast<float> (i % 256) / 256.f - 0.5f;
+  for (auto _ : state)
+    {
+      auto max = k.max (buf.data (), size);
+      benchmark::DoNotOptimize (max);
+    }
+}
+BENCHMARK (BM_Max)->Apply (kernel_args);
 
 static void
 BM_Add2 (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> dest (size, 0.5f);
   std::vector<float> src (size, 0.3f);
   for (auto _ : state)
     {
-      add2 (dest, src);
+      k.add2 (dest.data (), src.data (), size);
       benchmark::DoNotOptimize (dest.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_Add2)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Add2)->Apply (kernel_args);
+
+static void
+BM_Mul2 (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> dest (size, 0.5f);
+  std::vector<float> src (size, 1.0f);
+  for (auto _ : state)
+    {
+      k.mul2 (dest.data (), src.data (), size);
+      benchmark::DoNotOptimize (dest.data ());
+    }
+}
+BENCHMARK (BM_Mul2)->Apply (kernel_args);
 
 static void
 BM_Product (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> dest (size);
   std::vector<float> src (size, 0.5f);
   for (auto _ : state)
     {
-      product (dest, src, 0.8f);
+      k.product (dest.data (), src.data (), 0.8f, size);
       benchmark::DoNotOptimize (dest.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_Product)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Product)->Apply (kernel_args);
 
 static void
 BM_MixProduct (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> dest (size, 0.5f);
   std::vector<float> src (size, 0.3f);
   for (auto _ : state)
     {
-      mix_product (dest, src, 0.8f);
+      k.mix_product (dest.data (), src.data (), 0.8f, size);
+      benchmark::DoNotOptimize (dest.data ());
+    }
+}
+BENCHMARK (BM_MixProduct)->Apply (kernel_args);
+
+static void
+BM_MixProductWithGains (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> dest (size, 0.5f);
+  std::vector<float> src (size, 0.3f);
+  std::vector<float> gains (size, 0.8f);
+  for (auto _ : state)
+    {
+      k.mix_product_gains (dest.data (), src.data (), gains.data (), size);
       benchmark::DoNotOptimize (dest.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_MixProduct)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_MixProductWithGains)->Apply (kernel_args);
+
+static void
+BM_LinearFade (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> buf (size, 0.5f);
+  for (auto _ : state)
+    {
+      // fade from 1 so that the buffer doesn't decay into denormals
+      k.linear_fade (
+        buf.data (), 1.f, 0.f, 1.f, static_cast<float> (size - 1), size);
+      benchmark::DoNotOptimize (buf.data ());
+    }
+}
+BENCHMARK (BM_LinearFade)->Apply (kernel_args);
 
 static void
 BM_Reverse (benchmark::State &state)
@@ -157,7 +264,7 @@ BM_Reverse (benchmark::State &state)
     }
   state.SetComplexityN (size);
 }
-BENCHMARK (BM_Reverse)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Reverse)->RangeMultiplier (2)->Range (32, 4096)->Complexity ();
 
 static void
 BM_Normalize (benchmark::State &state)
@@ -174,21 +281,38 @@ BM_Normalize (benchmark::State &state)
     }
   state.SetComplexityN (size);
 }
-BENCHMARK (BM_Normalize)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_Normalize)->RangeMultiplier (2)->Range (32, 4096)->Complexity ();
 
 static void
 BM_MakeMono (benchmark::State &state)
 {
+  const auto        &k = kernel_table (state);
   const auto         size = static_cast<size_t> (state.range (0));
   std::vector<float> l (size, 0.5f);
   std::vector<float> r (size, 0.3f);
   for (auto _ : state)
     {
-      make_mono (l, r, true);
+      k.make_mono (l.data (), r.data (), 0.7079f, size);
+      benchmark::DoNotOptimize (l.data ());
+    }
+}
+BENCHMARK (BM_MakeMono)->Apply (kernel_args);
+
+static void
+BM_StereoFader (benchmark::State &state)
+{
+  const auto        &k = kernel_table (state);
+  const auto         size = static_cast<size_t> (state.range (0));
+  std::vector<float> l (size, 0.5f);
+  std::vector<float> r (size, 0.3f);
+  std::vector<float> gains (size, -1.f);
+  for (auto _ : state)
+    {
+      k.stereo_fader (
+        l.data (), r.data (), gains.data (), gains.data (), true, 2.f, size);
       benchmark::DoNotOptimize (l.data ());
     }
-  state.SetComplexityN (size);
 }
-BENCHMARK (BM_MakeMono)->Range (64, 8192)->Complexity ();
+BENCHMARK (BM_StereoFader)->Apply (kernel_args);
 
 BENCHMARK_MAIN ();
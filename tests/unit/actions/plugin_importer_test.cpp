@@ -417,7 +417,8 @@ TEST_F (PluginImporterTest, FailedInstantiationSkipsImport)
     instantiation_finished_called_ = false;
 
     plugin_importer_->importPluginToNewTrack (descriptor.get ());
-    QCoreApplication::processEvents ();
+    // CLAP plugins are created on the instantiation thread pool
+    process_events_until_true ([&] () { return failure_spy.count () > 0; });
 
     // Failure signal emitted with the plugin name and an error message
     ASSERT_EQ (failure_spy.count (), 1);
@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "controllers/project_journal.h"
+#include "utils/io_utils.h"
+
+#include <QFile>
+
+#include <gtest/gtest.h>
+
+namespace zrythm::controllers
+{
+
+class ProjectJournalTest : public ::testing::Test
+{
+protected:
+  void SetUp () override
+  {
+    temp_dir_obj = utils::io::make_tmp_dir ();
+    journal_path =
+      utils::Utf8String::from_qstring (temp_dir_obj->path ()).to_path ()
+      / "project.journal";
+  }
+
+  static nlohmann::json make_object (int index, int value)
+  {
+    return {
+      { "id", fmt::format ("{{obj-{:04}}}", index) }, { "value", value }
+    };
+  }
+
+  /**
+   * @brief Creates a document with @p num_objects registry objects.
+   *
+   * IDs are in sorted order, so the document compares equal after replaying
+   * (the journal doesn't keep the order of registry objects).
+   */
+  static nlohmann::json make_document (int num_objects)
+  {
+    auto objects = nlohmann::json::array ();
+    for (int i = 0; i < num_objects; ++i)
+      {
+        objects.push_back (make_object (i, i));
+      }
+    return {
+      { "title", "Journal Test" },
+      { "projectData",
+        { { "registry", { { "arrangerObjects", std::move (objects) } } } } },
+    };
+  }
+
+  static nlohmann::json &objects_of (nlohmann::json &doc)
+  {
+    return doc["projectData"]["registry"]["arrangerObjects"];
+  }
+
+  static ProjectJournal::Entry make_entry (const nlohmann::json &object)
+  {
+    ProjectJournal::Entry entry;
+    entry.objects["arrangerObjects"][object["id"].get<std::string> ()] = object;
+    return entry;
+  }
+
+  static ProjectJournal::Entry make_title_entry (std::string_view title)
+  {
+    ProjectJournal::Entry entry;
+    entry.sections.emplace_back ("/title", title);
+    return entry;
+  }
+
+  std::uintmax_t journal_size () const
+  {
+    return std::filesystem::file_size (journal_path);
+  }
+
+  static constexpr utils::hash::HashT SNAPSHOT_HASH = 1234;
+
+  std::unique_ptr<QTemporaryDir> temp_dir_obj;
+  std::filesystem::path          journal_path;
+};
+
+TEST_F (ProjectJournalTest, AppendWritesOnlyChanges)
+{
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+  const auto header_size = journal_size ();
+
+  // no changes
+  EXPECT_EQ (journal.append ({}, journal.next_revision ()), 0);
+  EXPECT_EQ (journal_size (), header_size);
+
+  EXPECT_EQ (
+    journal.append (
+      make_entry (make_object (500, -1)), journal.next_revision ()),
+    1);
+  EXPECT_LT (journal_size () - header_size, 200);
+}
+
+TEST_F (ProjectJournalTest, AppendSkipsUnchangedSections)
+{
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+
+  EXPECT_EQ (
+    journal.append (make_title_entry ("Title"), journal.next_revision ()), 1);
+  const auto size = journal_size ();
+  EXPECT_EQ (
+    journal.append (make_title_entry ("Title"), journal.next_revision ()), 0);
+  EXPECT_EQ (journal_size (), size);
+  EXPECT_EQ (
+    journal.append (make_title_entry ("Renamed"), journal.next_revision ()),
+    1);
+}
+
+TEST_F (ProjectJournalTest, ReplayRestoresLatestDocument)
+{
+  const auto     snapshot = make_document (10);
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+
+  auto doc = snapshot;
+  objects_of (doc)[2] = make_object (2, 100);
+  journal.append (make_entry (objects_of (doc)[2]), journal.next_revision ());
+
+  doc["title"] = "Renamed";
+  objects_of (doc).erase (5);
+  objects_of (doc).push_back (make_object (10, 10));
+  auto entry = make_entry (make_object (10, 10));
+  entry.removed.emplace_back ("{obj-0005}");
+  entry.sections.emplace_back ("/title", "Renamed");
+  journal.append (std::move (entry), journal.next_revision ());
+
+  auto recovered = snapshot;
+  EXPECT_EQ (
+    ProjectJournal::replay (recovered, SNAPSHOT_HASH, journal_path), 2);
+  EXPECT_EQ (recovered, doc);
+}
+
+TEST_F (ProjectJournalTest, AppendIgnoresEntriesInSnapshot)
+{
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+
+  // an entry serialized before a snapshot that was written first
+  const auto entry_revision = journal.next_revision ();
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+  EXPECT_EQ (
+    journal.append (make_entry (make_object (1, 100)), entry_revision), 0);
+}
+
+TEST_F (ProjectJournalTest, ResetKeepsEntriesNewerThanSnapshot)
+{
+  const auto     snapshot = make_document (10);
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+
+  // an entry serialized after a snapshot that is written later
+  const auto snapshot_revision = journal.next_revision ();
+  journal.append (make_entry (make_object (1, 100)), journal.next_revision ());
+  journal.reset (SNAPSHOT_HASH, snapshot_revision);
+
+  auto doc = snapshot;
+  objects_of (doc)[1] = make_object (1, 100);
+  auto recovered = snapshot;
+  EXPECT_EQ (
+    ProjectJournal::replay (recovered, SNAPSHOT_HASH, journal_path), 1);
+  EXPECT_EQ (recovered, doc);
+}
+
+TEST_F (ProjectJournalTest, ReplayIgnoresJournalOfOtherSnapshot)
+{
+  const auto     snapshot = make_document (10);
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+  journal.append (make_title_entry ("Renamed"), journal.next_revision ());
+
+  auto recovered = snapshot;
+  EXPECT_EQ (
+    ProjectJournal::replay (recovered, SNAPSHOT_HASH + 1, journal_path), 0);
+  EXPECT_EQ (recovered, snapshot);
+}
+
+TEST_F (ProjectJournalTest, ReplayDiscardsIncompleteEntry)
+{
+  const auto     snapshot = make_document (10);
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+  journal.append (make_title_entry ("Renamed"), journal.next_revision ());
+  auto doc = snapshot;
+  doc["title"] = "Renamed";
+
+  // simulate a crash while appending
+  {
+    QFile file (utils::Utf8String::from_path (journal_path).to_qstring ());
+    ASSERT_TRUE (file.open (QIODevice::WriteOnly | QIODevice::Append));
+    file.write (R"({"objects":{},"removed":[],"sections":{"/ti)");
+  }
+
+  auto recovered = snapshot;
+  EXPECT_EQ (
+    ProjectJournal::replay (recovered, SNAPSHOT_HASH, journal_path), 1);
+  EXPECT_EQ (recovered, doc);
+}
+
+TEST_F (ProjectJournalTest, RemoveDeletesFile)
+{
+  ProjectJournal journal (journal_path);
+  journal.reset (SNAPSHOT_HASH, journal.next_revision ());
+  EXPECT_TRUE (std::filesystem::exists (journal_path));
+
+  journal.remove ();
+  EXPECT_FALSE (std::filesystem::exists (journal_path));
+  EXPECT_EQ (
+    journal.append (make_title_entry ("Renamed"), journal.next_revision ()),
+    0);
+}
+
+}
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include "controllers/project_journal.h"
 #include "controllers/project_loader.h"
 #include "controllers/project_saver.h"
 #include "project_json_serializer_test.h"
@@ -49,6 +50,27 @@ TEST_F (ProjectLoaderTest, ParseAndValidateMinimalJson)
   });
 }
 
+TEST_F (ProjectLoaderTest, ParseAndValidateMinimalCbor)
+{
+  auto       json = create_minimal_valid_project_json ();
+  const auto data =
+    ProjectJsonSerializer::encode (json, ProjectJsonSerializer::Encoding::Cbor);
+  EXPECT_EQ (
+    ProjectJsonSerializer::detect_encoding (data),
+    ProjectJsonSerializer::Encoding::Cbor);
+  EXPECT_EQ (ProjectLoader::parse_and_validate (data), json);
+}
+
+TEST_F (ProjectLoaderTest, ParseTruncatedCbor)
+{
+  auto json = create_minimal_valid_project_json ();
+  auto data =
+    ProjectJsonSerializer::encode (json, ProjectJsonSerializer::Encoding::Cbor);
+  data.resize (data.size () / 2);
+  EXPECT_THROW (
+    { ProjectLoader::parse_and_validate (data); }, ZrythmException);
+}
+
 TEST_F (ProjectLoaderTest, ExtractTitleFromJson)
 {
   auto json = create_minimal_valid_project_json ();
@@ -112,6 +134,87 @@ TEST_F (ProjectLoaderTest, DecompressAndParseRoundTrip)
   });
 }
 
+TEST_F (ProjectLoaderTest, LoadFromDirectoryCbor)
+{
+  auto project = create_minimal_project ();
+  create_ui_state_and_undo_stack (*project);
+
+  constexpr utils::Version test_version{ 2, 0, {} };
+  nlohmann::json           j = ProjectJsonSerializer::serialize (
+    *project, *ui_state, *undo_stack, test_version, "Binary Load Test");
+
+  ProjectSaver::make_project_dirs (project_dir);
+
+  const auto data =
+    ProjectJsonSerializer::encode (j, ProjectJsonSerializer::Encoding::Cbor);
+  char *     compressed_data = nullptr;
+  size_t     compressed_size = 0;
+  QByteArray src_data = QByteArray::fromRawData (
+    data.data (), static_cast<qsizetype> (data.size ()));
+  ProjectSaver::compress (&compressed_data, &compressed_size, src_data);
+
+  auto project_file_path =
+    project_dir
+    / structure::project::ProjectPathProvider::get_path (
+      structure::project::ProjectPathProvider::ProjectPath::ProjectFile);
+  utils::io::set_file_contents (
+    project_file_path, compressed_data, compressed_size);
+  free (compressed_data);
+
+  // the binary data must survive decompression intact
+  EXPECT_EQ (ProjectLoader::get_uncompressed_project_text (project_dir), data);
+
+  auto future = ProjectLoader::load_from_directory (project_dir);
+  EXPECT_NO_THROW ({ future.waitForFinished (); });
+  auto result = future.result ();
+  EXPECT_EQ (result.title.view (), "Binary Load Test");
+  EXPECT_EQ (result.encoding, ProjectJsonSerializer::Encoding::Cbor);
+  EXPECT_EQ (result.json, j);
+}
+
+TEST_F (ProjectLoaderTest, LoadFromDirectoryReplaysJournal)
+{
+  auto project = create_minimal_project ();
+  create_ui_state_and_undo_stack (*project);
+
+  constexpr utils::Version test_version{ 2, 0, {} };
+  nlohmann::json           j = ProjectJsonSerializer::serialize (
+    *project, *ui_state, *undo_stack, test_version, "Journal Test");
+
+  ProjectSaver::make_project_dirs (project_dir);
+
+  const auto data = j.dump ();
+  char *     compressed_data = nullptr;
+  size_t     compressed_size = 0;
+  QByteArray src_data = QByteArray::fromRawData (
+    data.data (), static_cast<qsizetype> (data.size ()));
+  ProjectSaver::compress (&compressed_data, &compressed_size, src_data);
+  utils::io::set_file_contents (
+    project_dir
+      / structure::project::ProjectPathProvider::get_path (
+        structure::project::ProjectPathProvider::ProjectPath::ProjectFile),
+    compressed_data, compressed_size);
+  free (compressed_data);
+
+  // unsaved change
+  ProjectJournal journal (
+    project_dir
+    / structure::project::ProjectPathProvider::get_path (
+      structure::project::ProjectPathProvider::ProjectPath::JournalFile));
+  journal.reset (utils::hash::get_string_hash (data), journal.next_revision ());
+  ProjectJournal::Entry entry;
+  entry.sections.emplace_back (
+    fmt::format ("/{}", ProjectJsonSerializer::kTitle), "Recovered");
+  journal.append (std::move (entry), journal.next_revision ());
+
+  auto future = ProjectLoader::load_from_directory (project_dir);
+  EXPECT_NO_THROW ({ future.waitForFinished (); });
+  auto result = future.result ();
+  EXPECT_EQ (result.title.view (), "Recovered");
+  EXPECT_EQ (result.num_journal_entries, 1);
+  EXPECT_EQ (result.file_hash, utils::hash::get_string_hash (data));
+}
+
 TEST_F (ProjectLoaderTest, LoadFromDirectoryMissingProjectFile)
 {
   // Create directory but no project file
@@ -240,4 +343,44 @@ TEST_F (ProjectLoaderTest, RoundtripWithAudioFiles)
   EXPECT_EQ (loaded_clip.get_num_frames (), num_frames);
 }
 
+TEST_F (ProjectLoaderTest, SaveAndLoadCbor)
+{
+  auto project = create_minimal_project ();
+  create_ui_state_and_undo_stack (*project);
+
+  auto save_future = ProjectSaver::save (
+    *project, *ui_state, *undo_stack, TEST_APP_VERSION, project_dir, false,
+    ProjectJsonSerializer::Encoding::Cbor);
+  test_helpers::waitForFutureWithEvents (save_future);
+  ASSERT_TRUE (save_future.isFinished ()) << "Save operation timed out";
+  ASSERT_FALSE (save_future.result ().isEmpty ());
+
+  // the project file holds CBOR
+  EXPECT_TRUE (ProjectLoader::get_uncompressed_project_text (project_dir)
+                 .starts_with (ProjectJsonSerializer::CBOR_MAGIC));
+
+  auto load_future = ProjectLoader::load_from_directory (project_dir);
+  load_future.waitForFinished ();
+  const auto result = load_future.result ();
+  EXPECT_EQ (result.encoding, ProjectJsonSerializer::Encoding::Cbor);
+
+  // the loaded document matches the project (apart from the save time)
+  auto expected = ProjectJsonSerializer::serialize (
+    *project, *ui_state, *undo_stack, TEST_APP_VERSION, result.title.view ());
+  auto loaded = result.json;
+  expected.erase (ProjectJsonSerializer::kDatetimeKey);
+  loaded.erase (ProjectJsonSerializer::kDatetimeKey);
+  EXPECT_EQ (loaded, expected);
+
+  // and loads into a project with the same objects
+  auto loaded_project = create_minimal_project ();
+  create_ui_state_and_undo_stack (*loaded_project);
+  ProjectLoader::deserialize (
+    result.json, *loaded_project, *ui_state, *undo_stack);
+  const auto reserialized = ProjectJsonSerializer::serialize (
+    *loaded_project, *ui_state, *undo_stack, TEST_APP_VERSION,
+    result.title.view ());
+  EXPECT_EQ (extract_all_uuids (reserialized), extract_all_uuids (expected));
+}
+
 } // namespace zrythm::controllers
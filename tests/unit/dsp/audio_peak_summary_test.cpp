@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+
+#include "dsp/audio_peak_summary.h"
+
+#include <gtest/gtest.h>
+
+namespace zrythm::dsp
+{
+
+class AudioPeakSummaryTest : public ::testing::Test
+{
+protected:
+  static constexpr int NUM_FRAMES = AudioPeakSummary::WINDOW_FRAMES * 2 + 1000;
+
+  void SetUp () override
+  {
+    source_.setSize (2, NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; ++i)
+      {
+        source_.setSample (0, i, static_cast<float> (i) / NUM_FRAMES);
+        source_.setSample (1, i, -static_cast<float> (i) / NUM_FRAMES);
+      }
+  }
+
+  AudioPeakSummary::FrameReader make_reader ()
+  {
+    return [this] (
+             units::sample_t start, int num_frames,
+             juce::AudioSampleBuffer &dest) {
+      ++num_reads_;
+      max_read_frames_ = std::max (max_read_frames_, num_frames);
+      for (int ch = 0; ch < 2; ++ch)
+        {
+          dest.copyFrom (
+            ch, 0, source_, ch, start.in<int> (units::samples), num_frames);
+        }
+    };
+  }
+
+  juce::AudioSampleBuffer source_;
+  int                     num_reads_ = 0;
+  int                     max_read_frames_ = 0;
+};
+
+TEST_F (AudioPeakSummaryTest, ReadsOneWindowAtATime)
+{
+  AudioPeakSummary summary (2);
+  summary.extend (units::samples (NUM_FRAMES), make_reader ());
+
+  EXPECT_EQ (summary.num_frames (), units::samples (NUM_FRAMES));
+  EXPECT_EQ (num_reads_, 3);
+  EXPECT_EQ (max_read_frames_, AudioPeakSummary::WINDOW_FRAMES);
+}
+
+TEST_F (AudioPeakSummaryTest, FindsPeaksOfRange)
+{
+  AudioPeakSummary summary (2);
+  summary.extend (units::samples (NUM_FRAMES), make_reader ());
+
+  constexpr auto block = AudioPeakSummary::FRAMES_PER_BLOCK;
+  const auto     left = summary.find_min_and_max (
+    0, units::samples (block * 10), units::samples (block * 20));
+  EXPECT_FLOAT_EQ (left.getStart (), source_.getSample (0, block * 10));
+  EXPECT_FLOAT_EQ (left.getEnd (), source_.getSample (0, block * 20 - 1));
+
+  const auto right = summary.find_min_and_max (
+    1, units::samples (block * 10), units::samples (block * 20));
+  EXPECT_FLOAT_EQ (right.getStart (), source_.getSample (1, block * 20 - 1));
+  EXPECT_FLOAT_EQ (right.getEnd (), source_.getSample (1, block * 10));
+
+  // partial blocks are rounded out to whole blocks
+  const auto partial = summary.find_min_and_max (
+    0, units::samples (block * 10 + 5), units::samples (block * 10 + 6));
+  EXPECT_FLOAT_EQ (partial.getStart (), source_.getSample (0, block * 10));
+  EXPECT_FLOAT_EQ (partial.getEnd (), source_.getSample (0, block * 11 - 1));
+
+  // past the end is silent
+  const auto past_end = summary.find_min_and_max (
+    0, units::samples (NUM_FRAMES), units::samples (NUM_FRAMES + 100));
+  EXPECT_FLOAT_EQ (past_end.getStart (), 0.f);
+  EXPECT_FLOAT_EQ (past_end.getEnd (), 0.f);
+}
+
+TEST_F (AudioPeakSummaryTest, ExtendSummarizesOnlyNewFrames)
+{
+  AudioPeakSummary summary (2);
+  const auto       initial_frames = AudioPeakSummary::WINDOW_FRAMES * 2 + 10;
+  summary.extend (units::samples (initial_frames), make_reader ());
+  ASSERT_EQ (num_reads_, 3);
+
+  // the partial last block is summarized again along with the new frames
+  num_reads_ = 0;
+  max_read_frames_ = 0;
+  summary.extend (units::samples (NUM_FRAMES), make_reader ());
+  EXPECT_EQ (num_reads_, 1);
+  EXPECT_EQ (
+    max_read_frames_, NUM_FRAMES - AudioPeakSummary::WINDOW_FRAMES * 2);
+
+  const auto last = summary.find_min_and_max (
+    0, units::samples (NUM_FRAMES - 1), units::samples (NUM_FRAMES));
+  EXPECT_FLOAT_EQ (last.getEnd (), source_.getSample (0, NUM_FRAMES - 1));
+}
+
+} // namespace zrythm::dsp
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: © 2025-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <chrono>
 #include <filesystem>
 
 #include "dsp/audio_pool.h"
@@ -110,6 +111,41 @@ TEST_F (AudioPoolTest, WriteClip)
   EXPECT_TRUE (utils::io::path_exists (path));
 }
 
+// Test that clips are only written again when their content changed
+TEST_F (AudioPoolTest, SkipsRewritingUnchangedClip)
+{
+  auto * clip = &utils::get_typed<FileAudioSource> (registry, clip_id);
+  ASSERT_NO_THROW (audio_pool->write_clip (clip, false, false));
+  const auto path = audio_pool->get_clip_path (clip_id, false);
+  const auto old_time =
+    std::filesystem::last_write_time (path) - std::chrono::hours (1);
+  std::filesystem::last_write_time (path, old_time);
+
+  ASSERT_NO_THROW (audio_pool->write_clip (clip, false, false));
+  EXPECT_EQ (std::filesystem::last_write_time (path), old_time);
+
+  utils::audio::AudioBuffer frames (2, 10);
+  frames.clear ();
+  frames.setSample (0, 0, 0.5f);
+  clip->replace_frames (frames, units::samples (0));
+  ASSERT_NO_THROW (audio_pool->write_clip (clip, false, false));
+  EXPECT_NE (std::filesystem::last_write_time (path), old_time);
+}
+
+// Test that clips with the same content are copied
+TEST_F (AudioPoolTest, CopiesClipWithSameContent)
+{
+  auto * clip = &utils::get_typed<FileAudioSource> (registry, clip_id);
+  ASSERT_NO_THROW (audio_pool->write_clip (clip, false, false));
+
+  auto new_clip_id = audio_pool->duplicate_clip (clip_id, true);
+  const auto path = audio_pool->get_clip_path (clip_id, false);
+  const auto new_path = audio_pool->get_clip_path (new_clip_id.id (), false);
+  ASSERT_TRUE (utils::io::path_exists (new_path));
+  EXPECT_EQ (
+    utils::hash::get_file_hash (new_path), utils::hash::get_file_hash (path));
+}
+
 // Test removing unused clips
 TEST_F (AudioPoolTest, RemoveUnused)
 {
@@ -155,6 +191,46 @@ TEST_F (AudioPoolTest, ReloadClipFrameBufs)
   EXPECT_GT (clip->get_num_frames (), 0);
 }
 
+// Test streaming clips from disk instead of loading them into memory
+TEST_F (AudioPoolTest, StreamLoadedClips)
+{
+  auto * clip = &utils::get_typed<FileAudioSource> (registry, clip_id);
+  audio_pool->write_clip (clip, false, false);
+
+  AudioPool new_pool (registry, path_getter, sample_rate_getter);
+  new_pool.set_streaming_threshold (0.0);
+  ASSERT_NO_THROW (new_pool.init_loaded ());
+
+  EXPECT_TRUE (clip->is_streaming ());
+  EXPECT_EQ (clip->get_num_frames (), 100);
+  EXPECT_EQ (clip->get_samples ().getNumSamples (), 0);
+  EXPECT_EQ (new_pool.streaming_stats ().resident_pages, 1);
+
+  // writing to the file being streamed is a no-op
+  EXPECT_NO_THROW (new_pool.write_clip (clip, false, false));
+
+  // duplicates are loaded into memory
+  auto new_clip_ref = new_pool.duplicate_clip (clip_id, false);
+  const auto &new_clip =
+    utils::get_typed<FileAudioSource> (registry, new_clip_ref.id ());
+  EXPECT_FALSE (new_clip.is_streaming ());
+  EXPECT_EQ (new_clip.get_num_frames (), 100);
+}
+
+// Test that clips are loaded into memory when streaming is disabled
+TEST_F (AudioPoolTest, StreamingDisabledByDefault)
+{
+  auto * clip = &utils::get_typed<FileAudioSource> (registry, clip_id);
+  audio_pool->write_clip (clip, false, false);
+
+  AudioPool new_pool (registry, path_getter, sample_rate_getter);
+  ASSERT_NO_THROW (new_pool.init_loaded ());
+
+  EXPECT_FALSE (clip->is_streaming ());
+  EXPECT_EQ (clip->get_samples ().getNumSamples (), 100);
+  EXPECT_EQ (new_pool.streaming_stats ().resident_pages, 0);
+}
+
 // Test writing all clips to disk
 TEST_F (AudioPoolTest, WriteToDisk)
 {
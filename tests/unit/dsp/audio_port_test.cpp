@@ -170,4 +170,85 @@ TEST_F (AudioPortTest, OutputPortPreservesDataThroughProcessBlock)
     }
 }
 
+TEST_F (AudioPortTest, InputPortAliasesSingleSource)
+{
+  AudioPort src (u8"Src", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  AudioPort dest (u8"Dest", PortFlow::Input, AudioPort::BusLayout::Stereo, 2);
+  src.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.set_port_sources (std::views::single (&src));
+  dest.set_source_aliasing_allowed (true);
+  src.buffers ()->setSample (0, 10, 0.5f);
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), BLOCK_LENGTH);
+  dest.process_block (time_nfo, *mock_transport_, *tempo_map_);
+  ASSERT_TRUE (dest.is_aliased ());
+  EXPECT_EQ (
+    dest.buffers ()->getReadPointer (0), src.buffers ()->getReadPointer (0));
+  EXPECT_FLOAT_EQ (dest.buffers ()->getSample (0, 10), 0.5f);
+
+  // clearing drops the alias without touching the source
+  dest.clear_buffer (0, BLOCK_LENGTH.in (units::samples));
+  EXPECT_FALSE (dest.is_aliased ());
+  EXPECT_FLOAT_EQ (dest.buffers ()->getSample (0, 10), 0.f);
+  EXPECT_FLOAT_EQ (src.buffers ()->getSample (0, 10), 0.5f);
+}
+
+TEST_F (AudioPortTest, InputPortCopiesSourceThatCannotBeAliased)
+{
+  AudioPort src (u8"Src", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  AudioPort dest (u8"Dest", PortFlow::Input, AudioPort::BusLayout::Stereo, 2);
+  src.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.set_port_sources (std::views::single (&src));
+  src.buffers ()->setSample (0, 10, 0.5f);
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), BLOCK_LENGTH);
+
+  // not allowed by the owner
+  dest.process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_FALSE (dest.is_aliased ());
+  EXPECT_FLOAT_EQ (dest.buffers ()->getSample (0, 10), 0.5f);
+  dest.clear_buffer (0, BLOCK_LENGTH.in (units::samples));
+
+  // the data must be limited
+  dest.set_source_aliasing_allowed (true);
+  dest.mark_as_requires_limiting ();
+  src.buffers ()->setSample (0, 10, 3.f);
+  dest.process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_FALSE (dest.is_aliased ());
+  EXPECT_FLOAT_EQ (dest.buffers ()->getSample (0, 10), 2.f);
+  EXPECT_FLOAT_EQ (src.buffers ()->getSample (0, 10), 3.f);
+}
+
+TEST_F (AudioPortTest, InputPortSilentWhenAllSourcesAreSilent)
+{
+  AudioPort src1 (u8"Src1", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  AudioPort src2 (u8"Src2", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  AudioPort dest (u8"Dest", PortFlow::Input, AudioPort::BusLayout::Stereo, 2);
+  src1.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  src2.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  dest.set_port_sources (std::array{ &src1, &src2 });
+  EXPECT_FALSE (dest.is_silent ());
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), BLOCK_LENGTH);
+  src1.set_silent (true);
+  src2.set_silent (true);
+  dest.process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_TRUE (dest.is_silent ());
+  dest.clear_buffer (0, BLOCK_LENGTH.in (units::samples));
+
+  // silent sources are not summed
+  src1.buffers ()->setSample (0, 10, 0.5f);
+  src2.buffers ()->setSample (0, 10, 0.25f);
+  src2.set_silent (false);
+  dest.process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_FALSE (dest.is_silent ());
+  EXPECT_FLOAT_EQ (dest.buffers ()->getSample (0, 10), 0.25f);
+}
+
 } // namespace zrythm::dsp
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: © 2024-2025 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
+
 #include "dsp/curve.h"
 #include "utils/logger.h"
 
@@ -199,4 +201,43 @@ TEST (CurveTest, CurveOptionsQmlAdapterEdgeCases)
     adapter.algorithm (), ENUM_VALUE_TO_INT (CurveOptions::Algorithm::Exponent));
 #endif
 }
+
+TEST (CurveTest, EvaluateCurveBlockMatchesScalar)
+{
+  constexpr auto algorithms = std::array{
+    CurveOptions::Algorithm::Exponent, CurveOptions::Algorithm::SuperEllipse,
+    CurveOptions::Algorithm::Vital, CurveOptions::Algorithm::Pulse,
+    CurveOptions::Algorithm::Logarithmic,
+  };
+  constexpr double ratio_start = 0.1;
+  constexpr double ratio_step = 0.01;
+
+  std::array<float, 100> values{};
+  for (const auto algo : algorithms)
+    {
+      for (const float curviness : { -1.f, -0.5f, -0.01f, 0.f, 0.3f, 1.f })
+        {
+          for (const auto &[value_a, value_b] : { std::pair{ 0.2f, 0.9f },
+                                                  std::pair{ 0.8f, 0.1f },
+                                                  std::pair{ 0.5f, 0.5f } })
+            {
+              evaluate_curve_block (
+                value_a, value_b, algo, curviness, ratio_start, ratio_step,
+                values);
+              for (size_t i = 0; i < values.size (); ++i)
+                {
+                  // ratios past the end are clamped
+                  const double ratio = std::min (
+                    ratio_start + (ratio_step * static_cast<double> (i)), 1.0);
+                  ASSERT_NEAR (
+                    values[i],
+                    evaluate_curve (value_a, value_b, algo, curviness, ratio),
+                    1e-6f)
+                    << "algorithm " << static_cast<int> (algo) << ", curviness "
+                    << curviness << ", ratio " << ratio;
+                }
+            }
+        }
+    }
+}
 }
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <stdexcept>
+
+#include "dsp/decoded_page_cache.h"
+
+#include <gtest/gtest.h>
+
+namespace zrythm::dsp
+{
+
+class DecodedPageCacheTest : public ::testing::Test
+{
+protected:
+  static constexpr int PAGE_FRAMES = 256;
+
+  // 2 channels * 256 frames * 4 bytes
+  static constexpr size_t PAGE_BYTES = 2048;
+
+  DecodedPageCache::PageLoader make_loader (float value)
+  {
+    return [this, value] () {
+      ++num_loads_;
+      auto page = std::make_shared<juce::AudioSampleBuffer> (2, PAGE_FRAMES);
+      for (int ch = 0; ch < 2; ++ch)
+        {
+          juce::FloatVectorOperations::fill (
+            page->getWritePointer (ch), value, PAGE_FRAMES);
+        }
+      return page;
+    };
+  }
+
+  DecodedPageCache::SourceId source_a_{ QUuid::createUuid () };
+  DecodedPageCache::SourceId source_b_{ QUuid::createUuid () };
+  int                        num_loads_ = 0;
+};
+
+TEST_F (DecodedPageCacheTest, LoadsOnMissAndReusesOnHit)
+{
+  DecodedPageCache cache (PAGE_BYTES * 10);
+
+  auto page = cache.get_or_load (source_a_, 0, make_loader (0.5f));
+  ASSERT_NE (page, nullptr);
+  EXPECT_FLOAT_EQ (page->getSample (1, 10), 0.5f);
+  EXPECT_EQ (num_loads_, 1);
+
+  auto same_page = cache.get_or_load (source_a_, 0, make_loader (0.7f));
+  EXPECT_EQ (same_page, page);
+  EXPECT_EQ (num_loads_, 1);
+
+  const auto stats = cache.stats ();
+  EXPECT_EQ (stats.hits, 1);
+  EXPECT_EQ (stats.misses, 1);
+  EXPECT_EQ (stats.num_pages, 1);
+  EXPECT_EQ (stats.size_bytes, PAGE_BYTES);
+}
+
+TEST_F (DecodedPageCacheTest, PagesAreKeyedBySourceAndIndex)
+{
+  DecodedPageCache cache (PAGE_BYTES * 10);
+
+  cache.get_or_load (source_a_, 0, make_loader (0.1f));
+  cache.get_or_load (source_a_, 1, make_loader (0.2f));
+  cache.get_or_load (source_b_, 0, make_loader (0.3f));
+  EXPECT_EQ (num_loads_, 3);
+
+  EXPECT_FLOAT_EQ (cache.find (source_a_, 1)->getSample (0, 0), 0.2f);
+  EXPECT_FLOAT_EQ (cache.find (source_b_, 0)->getSample (0, 0), 0.3f);
+  EXPECT_EQ (cache.find (source_b_, 1), nullptr);
+}
+
+TEST_F (DecodedPageCacheTest, EvictsLeastRecentlyUsedPages)
+{
+  DecodedPageCache cache (PAGE_BYTES * 4);
+
+  for (size_t i = 0; i < 4; ++i)
+    {
+      cache.get_or_load (source_a_, i, make_loader (0.f));
+    }
+
+  // use page 0 so that page 1 becomes the least recently used
+  EXPECT_NE (cache.find (source_a_, 0), nullptr);
+
+  cache.get_or_load (source_a_, 4, make_loader (0.f));
+
+  const auto stats = cache.stats ();
+  EXPECT_LE (stats.size_bytes, stats.capacity_bytes);
+  EXPECT_GT (stats.evictions, 0);
+  EXPECT_EQ (cache.find (source_a_, 1), nullptr);
+  EXPECT_NE (cache.find (source_a_, 0), nullptr);
+  EXPECT_NE (cache.find (source_a_, 4), nullptr);
+}
+
+TEST_F (DecodedPageCacheTest, EvictedPagesStayValidForHolders)
+{
+  DecodedPageCache cache (PAGE_BYTES);
+
+  auto page = cache.get_or_load (source_a_, 0, make_loader (0.25f));
+  cache.get_or_load (source_a_, 1, make_loader (0.f));
+  cache.get_or_load (source_a_, 2, make_loader (0.f));
+
+  EXPECT_EQ (cache.find (source_a_, 0), nullptr);
+  EXPECT_FLOAT_EQ (page->getSample (0, 0), 0.25f);
+}
+
+TEST_F (DecodedPageCacheTest, ShrinkingCapacityEvicts)
+{
+  DecodedPageCache cache (PAGE_BYTES * 10);
+  for (size_t i = 0; i < 10; ++i)
+    {
+      cache.get_or_load (source_a_, i, make_loader (0.f));
+    }
+  EXPECT_EQ (cache.stats ().num_pages, 10);
+
+  cache.set_capacity (PAGE_BYTES * 2);
+  EXPECT_LE (cache.stats ().size_bytes, PAGE_BYTES * 2);
+}
+
+TEST_F (DecodedPageCacheTest, RemoveSource)
+{
+  DecodedPageCache cache (PAGE_BYTES * 10);
+  cache.get_or_load (source_a_, 0, make_loader (0.f));
+  cache.get_or_load (source_a_, 1, make_loader (0.f));
+  cache.get_or_load (source_b_, 0, make_loader (0.f));
+
+  cache.remove_source (source_a_);
+
+  const auto stats = cache.stats ();
+  EXPECT_EQ (stats.num_pages, 1);
+  EXPECT_EQ (stats.size_bytes, PAGE_BYTES);
+  EXPECT_EQ (cache.find (source_a_, 0), nullptr);
+  EXPECT_NE (cache.find (source_b_, 0), nullptr);
+}
+
+TEST_F (DecodedPageCacheTest, LoaderExceptionsPropagate)
+{
+  DecodedPageCache cache (PAGE_BYTES * 10);
+  EXPECT_THROW (
+    cache.get_or_load (
+      source_a_, 0,
+      [] () -> DecodedPageCache::PagePtr {
+        throw std::runtime_error ("decode failed");
+      }),
+    std::runtime_error);
+  EXPECT_EQ (cache.stats ().num_pages, 0);
+}
+
+} // namespace zrythm::dsp
@@ -1047,6 +1047,100 @@ TEST_F (FaderTest, GainSmoothing)
     }
 }
 
+TEST_F (FaderTest, SampleAccurateGainAutomation)
+{
+  audio_fader_->prepare_for_processing (
+    nullptr, sample_rate_, max_block_length_);
+  ON_CALL (*mock_transport_, get_play_state ())
+    .WillByDefault (::testing::Return (ITransport::PlayState::Rolling));
+
+  auto      &stereo_in = audio_fader_->get_stereo_in_port ();
+  auto      &stereo_out = audio_fader_->get_stereo_out_port ();
+  auto      &gain_param = audio_fader_->get_amp_param ();
+  const auto unity = gain_param.range ().convertTo0To1 (1.f);
+
+  // automation that goes down by a small amount on each sample after the
+  // first block
+  bool ramp = false;
+  gain_param.set_automation_provider ([] (auto) { return std::nullopt; });
+  gain_param.set_automation_block_provider (
+    [&] (units::sample_t, std::span<float> values) {
+      for (size_t i = 0; i < values.size (); ++i)
+        {
+          values[i] =
+            ramp ? unity * (1.f - (static_cast<float> (i) / 1000.f)) : unity;
+        }
+    });
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (512));
+  const auto process = [&] () {
+    for (int i = 0; i < 512; i++)
+      {
+        stereo_in.buffers ()->setSample (0, i, 1.f);
+        stereo_in.buffers ()->setSample (1, i, 1.f);
+      }
+    audio_fader_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  };
+
+  // let the initial gain ramp finish
+  for (int block = 0; block < 10; block++)
+    {
+      process ();
+    }
+
+  ramp = true;
+  process ();
+  for (int i = 0; i < 512; i++)
+    {
+      const auto expected = gain_param.range ().convertFrom0To1 (
+        unity * (1.f - (static_cast<float> (i) / 1000.f)));
+      EXPECT_NEAR (stereo_out.buffers ()->getSample (0, i), expected, 1e-5f);
+      EXPECT_NEAR (stereo_out.buffers ()->getSample (1, i), expected, 1e-5f);
+    }
+}
+
+TEST_F (FaderTest, BalanceChangesAreSmoothed)
+{
+  audio_fader_->prepare_for_processing (
+    nullptr, sample_rate_, max_block_length_);
+
+  auto &stereo_in = audio_fader_->get_stereo_in_port ();
+  auto &stereo_out = audio_fader_->get_stereo_out_port ();
+  audio_fader_->gain ()->setBaseValue (
+    audio_fader_->gain ()->range ().convertTo0To1 (1.0f));
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (512));
+  const auto process = [&] () {
+    for (int i = 0; i < 512; i++)
+      {
+        stereo_in.buffers ()->setSample (0, i, 1.f);
+        stereo_in.buffers ()->setSample (1, i, 1.f);
+      }
+    audio_fader_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  };
+
+  // let the initial gain ramp finish
+  for (int block = 0; block < 10; block++)
+    {
+      process ();
+    }
+
+  // hard left ramps the right channel down over the block
+  audio_fader_->balance ()->setBaseValue (0.0f);
+  process ();
+  EXPECT_NEAR (stereo_out.buffers ()->getSample (1, 0), 1.0f, 0.01f);
+  EXPECT_GT (
+    stereo_out.buffers ()->getSample (1, 100),
+    stereo_out.buffers ()->getSample (1, 200));
+  EXPECT_NEAR (stereo_out.buffers ()->getSample (1, 511), 0.0f, 1e-5f);
+  for (int i = 0; i < 512; i++)
+    {
+      EXPECT_NEAR (stereo_out.buffers ()->getSample (0, i), 1.0f, 1e-5f);
+    }
+}
+
 TEST_F (FaderTest, InputBufferClearedBetweenProcessCalls)
 {
   audio_fader_->prepare_for_processing (
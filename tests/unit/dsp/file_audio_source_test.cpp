@@ -216,6 +216,36 @@ TEST_F (FileAudioSourceTest, ReplaceFrames)
   EXPECT_EQ (src.get_num_frames (), 100);
 }
 
+TEST_F (FileAudioSourceTest, SharedSamplesAreCopiedOnWrite)
+{
+  utils::audio::AudioBuffer initial (2, 100);
+  initial.clear ();
+  FileAudioSource src (
+    initial, FileAudioSource::BitDepth::BIT_DEPTH_32, project_sample_rate,
+    current_bpm, u8"shared_test", nullptr);
+
+  // not copied while unchanged
+  const auto shared = src.get_shared_samples ();
+  EXPECT_EQ (shared.get (), &src.get_samples ());
+
+  utils::audio::AudioBuffer replacement (2, 50);
+  for (int i = 0; i < 50; ++i)
+    {
+      replacement.setSample (0, i, 0.5f);
+      replacement.setSample (1, i, -0.5f);
+    }
+  src.replace_frames (replacement, units::samples (25));
+  src.expand_with_frames (replacement);
+
+  // the shared frames are left unchanged
+  EXPECT_NE (shared.get (), &src.get_samples ());
+  EXPECT_EQ (shared->getNumSamples (), 100);
+  EXPECT_FLOAT_EQ (shared->getSample (0, 30), 0.f);
+  EXPECT_EQ (src.get_num_frames (), 150);
+  EXPECT_FLOAT_EQ (src.get_samples ().getSample (0, 30), 0.5f);
+  EXPECT_FLOAT_EQ (src.get_samples ().getSample (1, 120), -0.5f);
+}
+
 TEST_F (FileAudioSourceTest, ClearFrames)
 {
   utils::audio::AudioBuffer buf (2, 100);
@@ -1,7 +1,9 @@
 // SPDX-FileCopyrightText: © 2025 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <future>
 #include <ranges>
+#include <thread>
 
 #include "dsp/graph_builder.h"
 #include "dsp/graph_dispatcher.h"
@@ -381,28 +383,20 @@ TEST_F (DspGraphDispatcherTest, MultipleRecalcGraphCalls)
 
   dispatcher_->recalc_graph (false);
 
-  // Second recalculation (should release old resources and prepare new ones)
-  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
-  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
-  EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
-
-  EXPECT_CALL (
-    *processables_[0],
-    prepare_for_processing_impl (
-      _, units::sample_rate (48000), units::samples (256u)))
-    .Times (1);
-  EXPECT_CALL (
-    *processables_[1],
-    prepare_for_processing_impl (
-      _, units::sample_rate (48000), units::samples (256u)))
-    .Times (1);
-  EXPECT_CALL (
-    *processables_[2],
-    prepare_for_processing_impl (
-      _, units::sample_rate (48000), units::samples (256u)))
-    .Times (1);
+  // Second recalculation (nothing changed, so processables keep their state)
+  for (const auto &processable : processables_)
+    {
+      EXPECT_CALL (*processable, release_resources ()).Times (0);
+      EXPECT_CALL (*processable, prepare_for_processing_impl (_, _, _))
+        .Times (0);
+      EXPECT_CALL (*processable, stage_node_inputs (_)).Times (0);
+    }
 
   dispatcher_->recalc_graph (false);
+  for (const auto &processable : processables_)
+    {
+      Mock::VerifyAndClearExpectations (processable.get ());
+    }
 
   // These will be called again on destruction
   EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
@@ -463,14 +457,19 @@ TEST_F (DspGraphDispatcherTest, DynamicTerminalProviderAffectsPruning)
   // Change terminal to B — C should be pruned on next recalc
   terminal_processables_ = { processables_[1].get () };
 
-  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
-  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
+  // only C is released; A and B keep their inputs
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (0);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (0);
   EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
   EXPECT_CALL (*processables_[0], prepare_for_processing_impl (_, _, _))
-    .Times (1);
+    .Times (0);
   EXPECT_CALL (*processables_[1], prepare_for_processing_impl (_, _, _))
-    .Times (1);
+    .Times (0);
   dispatcher_->recalc_graph (false);
+  for (const auto &processable : processables_)
+    {
+      Mock::VerifyAndClearExpectations (processable.get ());
+    }
 
   EXPECT_CALL (*processables_[0], process_block (_, _, _)).Times (1);
   EXPECT_CALL (*processables_[1], process_block (_, _, _)).Times (1);
@@ -482,4 +481,236 @@ TEST_F (DspGraphDispatcherTest, DynamicTerminalProviderAffectsPruning)
   EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
 }
 
+TEST_F (
+  DspGraphDispatcherTest,
+  RecalcGraphDoesNotPauseForUnchangedProcessables)
+{
+  int build_count = 0;
+  EXPECT_CALL (*mock_graph_builder_, build_graph_impl (_))
+    .Times (2)
+    .WillRepeatedly ([&] (graph::Graph &graph) {
+      auto * node1 = graph.add_node_for_processable (*processables_[0]);
+      auto * node2 = graph.add_node_for_processable (*processables_[1]);
+      node1->connect_to (*node2);
+      if (++build_count > 1)
+        {
+          // a new processable appears on the second build
+          node2->connect_to (
+            *graph.add_node_for_processable (*processables_[2]));
+        }
+    });
+
+  terminal_processables_ = { processables_[1].get () };
+
+  bool engine_locked = false;
+  run_function_with_engine_lock_ = [&] (std::function<void ()> func) {
+    engine_locked = true;
+    func ();
+    engine_locked = false;
+  };
+
+  create_dispatcher ();
+  dispatcher_->recalc_graph (false);
+
+  terminal_processables_ = { processables_[2].get () };
+
+  // the new processable is prepared while the live graph keeps running
+  EXPECT_CALL (*processables_[2], prepare_for_processing_impl (_, _, _))
+    .WillOnce ([&] (auto, auto, auto) { EXPECT_FALSE (engine_locked); });
+  // shared processables with the same inputs are left alone
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (0);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (0);
+  EXPECT_CALL (*processables_[0], prepare_for_processing_impl (_, _, _))
+    .Times (0);
+  EXPECT_CALL (*processables_[1], prepare_for_processing_impl (_, _, _))
+    .Times (0);
+  dispatcher_->recalc_graph (false);
+
+  const auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256));
+  EXPECT_CALL (*processables_[0], process_block (_, _, _)).Times (1);
+  EXPECT_CALL (*processables_[1], process_block (_, _, _)).Times (1);
+  EXPECT_CALL (*processables_[2], process_block (_, _, _)).Times (1);
+  dispatcher_->start_cycle (
+    *transport_, time_info, units::samples (0), true, *tempo_map_);
+
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
+}
+
+
+TEST_F (DspGraphDispatcherTest, RecalcGraphStagesChangedInputs)
+{
+  int build_count = 0;
+  EXPECT_CALL (*mock_graph_builder_, build_graph_impl (_))
+    .Times (2)
+    .WillRepeatedly ([&] (graph::Graph &graph) {
+      auto * node1 = graph.add_node_for_processable (*processables_[0]);
+      auto * node2 = graph.add_node_for_processable (*processables_[1]);
+      auto * node3 = graph.add_node_for_processable (*processables_[2]);
+      node1->connect_to (*node3);
+      if (++build_count > 1)
+        {
+          // C gets a new input on the second build
+          node2->connect_to (*node3);
+        }
+    });
+
+  terminal_processables_ = { processables_[2].get () };
+
+  bool engine_locked = false;
+  run_function_with_engine_lock_ = [&] (std::function<void ()> func) {
+    engine_locked = true;
+    func ();
+    engine_locked = false;
+  };
+
+  create_dispatcher ();
+  dispatcher_->recalc_graph (false);
+
+  // the new input is prepared while the live graph keeps running
+  EXPECT_CALL (*processables_[1], prepare_for_processing_impl (_, _, _))
+    .WillOnce ([&] (auto, auto, auto) { EXPECT_FALSE (engine_locked); });
+  // C stages its new inputs and applies them when the graph is adopted
+  {
+    InSequence seq;
+    EXPECT_CALL (*processables_[2], stage_node_inputs (_))
+      .WillOnce ([&] (const graph::GraphNode &node) {
+        EXPECT_FALSE (engine_locked);
+        EXPECT_EQ (node.depends ().size (), 2u);
+        return true;
+      });
+    EXPECT_CALL (*processables_[2], commit_node_inputs ()).Times (1);
+  }
+  EXPECT_CALL (*processables_[2], release_resources ()).Times (0);
+  EXPECT_CALL (*processables_[2], prepare_for_processing_impl (_, _, _))
+    .Times (0);
+  dispatcher_->recalc_graph (false);
+  Mock::VerifyAndClearExpectations (processables_[2].get ());
+
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
+}
+
+TEST_F (
+  DspGraphDispatcherTest,
+  RecalcGraphRepreparesWhileLockedIfStagingFails)
+{
+  int build_count = 0;
+  EXPECT_CALL (*mock_graph_builder_, build_graph_impl (_))
+    .Times (2)
+    .WillRepeatedly ([&] (graph::Graph &graph) {
+      auto * node1 = graph.add_node_for_processable (*processables_[0]);
+      auto * node2 = graph.add_node_for_processable (*processables_[1]);
+      auto * node3 = graph.add_node_for_processable (*processables_[2]);
+      node1->connect_to (*node3);
+      if (++build_count > 1)
+        {
+          node2->connect_to (*node3);
+        }
+    });
+
+  terminal_processables_ = { processables_[2].get () };
+
+  bool engine_locked = false;
+  run_function_with_engine_lock_ = [&] (std::function<void ()> func) {
+    engine_locked = true;
+    func ();
+    engine_locked = false;
+  };
+
+  create_dispatcher ();
+  dispatcher_->recalc_graph (false);
+
+  EXPECT_CALL (*processables_[2], stage_node_inputs (_))
+    .WillOnce (Return (false));
+  EXPECT_CALL (*processables_[2], commit_node_inputs ()).Times (0);
+  EXPECT_CALL (*processables_[2], release_resources ())
+    .WillOnce ([&] { EXPECT_TRUE (engine_locked); });
+  EXPECT_CALL (*processables_[2], prepare_for_processing_impl (_, _, _))
+    .WillOnce ([&] (auto, auto, auto) { EXPECT_TRUE (engine_locked); });
+  // A's inputs didn't change
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (0);
+  EXPECT_CALL (*processables_[0], prepare_for_processing_impl (_, _, _))
+    .Times (0);
+  dispatcher_->recalc_graph (false);
+  Mock::VerifyAndClearExpectations (processables_[0].get ());
+  Mock::VerifyAndClearExpectations (processables_[2].get ());
+
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
+}
+
+TEST_F (DspGraphDispatcherTest, RecalcGraphDoesNotBlockOnStalledCycle)
+{
+  int build_count = 0;
+  EXPECT_CALL (*mock_graph_builder_, build_graph_impl (_))
+    .Times (2)
+    .WillRepeatedly ([&] (graph::Graph &graph) {
+      // B is replaced by C on the second build
+      auto * node1 = graph.add_node_for_processable (*processables_[0]);
+      auto * node2 = graph.add_node_for_processable (
+        *processables_[++build_count > 1 ? 2 : 1]);
+      node1->connect_to (*node2);
+    });
+
+  terminal_processables_ = { processables_[1].get () };
+
+  bool engine_locked = false;
+  run_function_with_engine_lock_ = [&] (std::function<void ()> func) {
+    engine_locked = true;
+    func ();
+    engine_locked = false;
+  };
+
+  create_dispatcher ();
+  dispatcher_->recalc_graph (false);
+
+  // A gets stuck in the first cycle
+  std::promise<void> stalled;
+  std::promise<void> resume;
+  auto               resumed = resume.get_future ();
+  EXPECT_CALL (*processables_[0], process_block (_, _, _))
+    .WillOnce ([&] (auto, const auto &, const auto &) {
+      stalled.set_value ();
+      resumed.wait ();
+    })
+    .WillOnce (Return ());
+  EXPECT_CALL (*processables_[2], process_block (_, _, _)).Times (1);
+
+  const auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256));
+  std::thread audio_thread ([&] () {
+    dispatcher_->start_cycle (
+      *transport_, time_info, units::samples (0), true, *tempo_map_);
+  });
+  stalled.get_future ().wait ();
+
+  // the swap neither pauses the engine nor releases B, which the stuck cycle
+  // is about to process
+  terminal_processables_ = { processables_[2].get () };
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (0);
+  dispatcher_->recalc_graph (false);
+  EXPECT_FALSE (engine_locked);
+  Mock::VerifyAndClearExpectations (processables_[1].get ());
+
+  // the stuck cycle still runs the previous graph
+  EXPECT_CALL (*processables_[1], process_block (_, _, _)).Times (1);
+  resume.set_value ();
+  audio_thread.join ();
+
+  // the next cycle adopts the new graph
+  dispatcher_->start_cycle (
+    *transport_, time_info, units::samples (0), true, *tempo_map_);
+
+  // B is released once the previous graph is reclaimed
+  EXPECT_CALL (*processables_[0], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[1], release_resources ()).Times (1);
+  EXPECT_CALL (*processables_[2], release_resources ()).Times (1);
+  dispatcher_.reset ();
+}
+
 }
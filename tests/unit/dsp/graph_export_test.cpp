@@ -81,3 +81,25 @@ TEST_F (GraphExportTest, ClassNameInclusion)
   // Should contain class name pattern
   EXPECT_THAT (dot.view (), HasSubstr ("\\n("));
 }
+
+TEST_F (GraphExportTest, ColorByCost)
+{
+  Graph  graph;
+  auto * node1 = graph.add_node_for_processable (*processable1_);
+  auto * node2 = graph.add_node_for_processable (*processable2_);
+  node1->connect_to (*node2);
+  graph.finalize_nodes ();
+
+  node1->timing_stats ().record (10000, 0);
+
+  auto dot = GraphExport::export_to_dot (graph.get_nodes (), false, true);
+
+  // only the node with statistics gets colored
+  EXPECT_THAT (dot.view (), HasSubstr ("mean 10 us"));
+  EXPECT_THAT (dot.view (), HasSubstr ("fillcolor=\"0 0.6 1.0\""));
+  EXPECT_EQ (dot.view ().find ("fillcolor"), dot.view ().rfind ("fillcolor"));
+
+  // without coloring, statistics are not included
+  auto plain_dot = GraphExport::export_to_dot (graph.get_nodes ());
+  EXPECT_THAT (plain_dot.view (), Not (HasSubstr ("fillcolor")));
+}
@@ -31,6 +31,8 @@ public:
     (dsp::graph::ProcessBlockInfo, const dsp::ITransport &, const dsp::TempoMap &),
     (noexcept, override));
   MOCK_METHOD (void, release_resources, (), (override));
+  MOCK_METHOD (bool, stage_node_inputs, (const graph::GraphNode &), (override));
+  MOCK_METHOD (void, commit_node_inputs, (), (noexcept, override));
 };
 
 class MockTransport : public zrythm::dsp::ITransport
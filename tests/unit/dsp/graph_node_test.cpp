@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: © 2024 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
 #include <memory>
 
 #include "dsp/graph_node.h"
@@ -379,6 +380,132 @@ TEST_F (GraphNodeTest, LatencyPropagationInCollection)
   EXPECT_EQ (collection.get_max_route_playback_latency (), units::samples (128));
 }
 
+TEST_F (GraphNodeTest, CriticalPathPrioritization)
+{
+  GraphNodeCollection collection;
+
+  // short: 1 -> 5, long: 2 -> 3 -> 4 -> 5
+  std::vector<GraphNode *> nodes;
+  for (int i = 1; i <= 5; ++i)
+    {
+      auto node = std::make_unique<GraphNode> (i, *processable_);
+      nodes.push_back (node.get ());
+      collection.graph_nodes_.push_back (std::move (node));
+    }
+  nodes[0]->connect_to (*nodes[4]);
+  nodes[1]->connect_to (*nodes[2]);
+  nodes[2]->connect_to (*nodes[3]);
+  nodes[3]->connect_to (*nodes[4]);
+
+  collection.finalize_nodes ();
+  ASSERT_EQ (collection.topological_order_.size (), 5);
+  EXPECT_EQ (collection.topological_order_.back (), nodes[4]);
+  ASSERT_EQ (collection.prioritized_trigger_nodes_.size (), 2);
+
+  nodes[0]->record_process_time (400.f);
+  for (int i = 1; i <= 4; ++i)
+    {
+      nodes[i]->record_process_time (100.f);
+    }
+  collection.update_critical_paths ();
+
+  EXPECT_FLOAT_EQ (nodes[0]->get_critical_path_cost (), 500.f);
+  EXPECT_FLOAT_EQ (nodes[1]->get_critical_path_cost (), 400.f);
+  EXPECT_EQ (collection.prioritized_trigger_nodes_.front (), nodes[0]);
+
+  // the long chain becomes more expensive
+  for (int i = 0; i < 50; ++i)
+    {
+      nodes[2]->record_process_time (1000.f);
+    }
+  collection.update_critical_paths ();
+
+  EXPECT_GT (
+    nodes[1]->get_critical_path_cost (), nodes[0]->get_critical_path_cost ());
+  EXPECT_EQ (collection.prioritized_trigger_nodes_.front (), nodes[1]);
+}
+
+TEST_F (GraphNodeTest, IncrementalCriticalPathUpdate)
+{
+  GraphNodeCollection collection;
+
+  // 1 -> 3 -> 4, 2 -> 4, 5 (unrelated)
+  std::vector<GraphNode *> nodes;
+  for (int i = 1; i <= 5; ++i)
+    {
+      auto node = std::make_unique<GraphNode> (i, *processable_);
+      nodes.push_back (node.get ());
+      collection.graph_nodes_.push_back (std::move (node));
+    }
+  nodes[0]->connect_to (*nodes[2]);
+  nodes[2]->connect_to (*nodes[3]);
+  nodes[1]->connect_to (*nodes[3]);
+  collection.finalize_nodes ();
+
+  for (auto * node : nodes)
+    {
+      EXPECT_TRUE (node->record_process_time (100.f));
+    }
+  collection.update_critical_paths ();
+  EXPECT_FLOAT_EQ (nodes[0]->get_critical_path_cost (), 300.f);
+  EXPECT_FLOAT_EQ (nodes[1]->get_critical_path_cost (), 200.f);
+
+  // small changes are not reported
+  EXPECT_FALSE (nodes[3]->record_process_time (105.f));
+
+  // a change is reported once until the critical paths are updated
+  EXPECT_TRUE (nodes[2]->record_process_time (2100.f));
+  EXPECT_FALSE (nodes[2]->record_process_time (2100.f));
+  const auto changed_cost = nodes[2]->get_process_cost ();
+
+  const std::array<GraphNode *, 1> changed{ nodes[2] };
+  collection.update_critical_paths (changed);
+
+  // only the ancestors of the changed node are updated
+  EXPECT_FLOAT_EQ (
+    nodes[0]->get_critical_path_cost (),
+    100.f + changed_cost + nodes[3]->get_critical_path_cost ());
+  EXPECT_FLOAT_EQ (nodes[1]->get_critical_path_cost (), 200.f);
+  EXPECT_FLOAT_EQ (nodes[3]->get_critical_path_cost (), 100.f);
+  EXPECT_FLOAT_EQ (nodes[4]->get_critical_path_cost (), 100.f);
+  EXPECT_EQ (collection.prioritized_trigger_nodes_.front (), nodes[0]);
+
+  // the change was applied, so it can be reported again
+  EXPECT_FALSE (nodes[2]->record_process_time (changed_cost));
+  EXPECT_TRUE (nodes[2]->record_process_time (100000.f));
+}
+
+TEST_F (GraphNodeTest, MeasurementsSurviveRebuild)
+{
+  MockProcessable other_processable;
+
+  GraphNodeCollection old_collection;
+  old_collection.graph_nodes_.push_back (
+    std::make_unique<GraphNode> (1, *processable_));
+  old_collection.graph_nodes_.push_back (
+    std::make_unique<GraphNode> (2, other_processable));
+  old_collection.graph_nodes_.front ()->record_process_time (300.f);
+  old_collection.graph_nodes_.back ()->record_process_time (700.f);
+  old_collection.graph_nodes_.back ()->timing_stats ().record (700, 1);
+  old_collection.graph_nodes_.back ()->timing_stats ().record (900, 2);
+
+  GraphNodeCollection new_collection;
+  new_collection.graph_nodes_.push_back (
+    std::make_unique<GraphNode> (1, other_processable));
+  new_collection.finalize_nodes ();
+  new_collection.inherit_measurements (old_collection);
+
+  const auto &node = *new_collection.graph_nodes_.front ();
+  EXPECT_FLOAT_EQ (node.get_process_cost (), 700.f);
+  EXPECT_FLOAT_EQ (node.get_critical_path_cost (), 700.f);
+
+  const auto stats = node.timing_stats ().snapshot ();
+  EXPECT_EQ (stats.count, 2);
+  EXPECT_EQ (stats.min_ns, 700);
+  EXPECT_EQ (stats.max_ns, 900);
+  EXPECT_EQ (stats.last_thread_id, 2);
+}
+
 TEST_F (GraphNodeTest, ProcessableSearch)
 {
   GraphNodeCollection collection;
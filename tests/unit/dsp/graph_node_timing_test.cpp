@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <thread>
+#include <vector>
+
+#include "dsp/graph_node_timing.h"
+
+#include <gtest/gtest.h>
+
+namespace zrythm::dsp::graph
+{
+
+TEST (GraphNodeTimingStatsTest, EmptySnapshot)
+{
+  GraphNodeTimingStats stats;
+  const auto           snapshot = stats.snapshot ();
+  EXPECT_EQ (snapshot.count, 0);
+  EXPECT_EQ (snapshot.max_ns, 0);
+  EXPECT_EQ (snapshot.p99_ns, 0);
+  EXPECT_EQ (snapshot.last_thread_id, -1);
+}
+
+TEST (GraphNodeTimingStatsTest, BucketBoundsContainValues)
+{
+  for (
+    const uint64_t value :
+    { 0ull, 1ull, 3ull, 4ull, 7ull, 8ull, 9ull, 100ull, 1000ull, 123456ull,
+      1ull << 30 })
+    {
+      const auto index = GraphNodeTimingStats::bucket_index (value);
+      EXPECT_LE (value, GraphNodeTimingStats::bucket_upper_bound (index));
+      if (index > 0)
+        {
+          EXPECT_GT (value, GraphNodeTimingStats::bucket_upper_bound (index - 1));
+        }
+    }
+
+  // values that are too large go to the last bucket
+  EXPECT_EQ (
+    GraphNodeTimingStats::bucket_index (std::numeric_limits<uint64_t>::max ()),
+    GraphNodeTimingStats::NUM_BUCKETS - 1);
+}
+
+TEST (GraphNodeTimingStatsTest, Statistics)
+{
+  GraphNodeTimingStats stats;
+  for (int i = 0; i < 99; ++i)
+    {
+      stats.record (1000, 0);
+    }
+  stats.record (50000, 2);
+
+  const auto snapshot = stats.snapshot ();
+  EXPECT_EQ (snapshot.count, 100);
+  EXPECT_EQ (snapshot.min_ns, 1000);
+  EXPECT_EQ (snapshot.max_ns, 50000);
+  EXPECT_DOUBLE_EQ (snapshot.mean_ns, 1490.0);
+  EXPECT_GE (snapshot.p99_ns, 1000);
+  EXPECT_LT (snapshot.p99_ns, 1250);
+  EXPECT_EQ (snapshot.last_thread_id, 2);
+
+  stats.record (60000, 1);
+  EXPECT_EQ (stats.snapshot ().p99_ns, 60000);
+
+  stats.reset ();
+  EXPECT_EQ (stats.snapshot ().count, 0);
+}
+
+TEST (GraphNodeTimingStatsTest, ConcurrentRecording)
+{
+  GraphNodeTimingStats     stats;
+  constexpr int            num_threads = 4;
+  constexpr int            num_records = 10000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t)
+    {
+      threads.emplace_back ([&stats, t] () {
+        for (int i = 1; i <= num_records; ++i)
+          {
+            stats.record (static_cast<uint64_t> (i), t);
+          }
+      });
+    }
+  for (auto &thread : threads)
+    {
+      thread.join ();
+    }
+
+  const auto snapshot = stats.snapshot ();
+  EXPECT_EQ (snapshot.count, num_threads * num_records);
+  EXPECT_EQ (snapshot.min_ns, 1);
+  EXPECT_EQ (snapshot.max_ns, num_records);
+  EXPECT_DOUBLE_EQ (snapshot.mean_ns, (num_records + 1) / 2.0);
+}
+
+} // namespace zrythm::dsp::graph
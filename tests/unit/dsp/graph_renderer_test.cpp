@@ -6,6 +6,7 @@
 
 #include "dsp/graph_renderer.h"
 #include "dsp/port_all.h"
+#include "utils/io_utils.h"
 #include "utils/utf8_string.h"
 
 #include <QFuture>
@@ -611,4 +612,305 @@ TEST_F (GraphRendererTest, RenderWithProgressReporting)
   // Verify the sine wave samples are correct
   verify_sine_wave_samples (result);
 }
+
+class GraphRendererStreamingTest : public GraphRendererTest
+{
+protected:
+  void SetUp () override
+  {
+    GraphRendererTest::SetUp ();
+    temp_dir_ = utils::io::make_tmp_dir ();
+    file_path_ = utils::Utf8String::from_qstring (temp_dir_->path ()).to_path ()
+                 / "render.wav";
+  }
+
+  GraphRenderer::StreamingOptions
+  create_streaming_options (std::optional<int> dither_bits = std::nullopt)
+  {
+    juce::AudioFormatWriterOptions writer_options;
+    writer_options = writer_options.withSampleRate (48000)
+                       .withNumChannels (2)
+                       .withBitsPerSample (24);
+    return GraphRenderer::StreamingOptions{
+      .write_options_ = { .writer_options_ = writer_options },
+      .file_path_ = file_path_,
+      .dither_bits_ = dither_bits,
+      .max_queued_blocks_ = 2,
+    };
+  }
+
+  juce::AudioSampleBuffer read_rendered_file () const
+  {
+    return read_rendered_file (file_path_);
+  }
+
+  static juce::AudioSampleBuffer
+  read_rendered_file (const std::filesystem::path &path)
+  {
+    juce::AudioFormatManager format_manager;
+    format_manager.registerBasicFormats ();
+    std::unique_ptr<juce::AudioFormatReader> reader (
+      format_manager.createReaderFor (
+        utils::Utf8String::from_path (path).to_juce_file ()));
+    if (reader == nullptr)
+      {
+        return {};
+      }
+
+    juce::AudioSampleBuffer buffer (
+      static_cast<int> (reader->numChannels),
+      static_cast<int> (reader->lengthInSamples));
+    reader->read (&buffer, 0, buffer.getNumSamples (), 0, true, true);
+    return buffer;
+  }
+
+  std::unique_ptr<QTemporaryDir> temp_dir_;
+  std::filesystem::path          file_path_;
+};
+
+TEST_F (GraphRendererStreamingTest, RenderToFile)
+{
+  auto collection = create_simple_test_collection ();
+  // more blocks than can be queued, so the renderer has to wait for the writer
+  auto range = create_test_range (0, 48000);
+
+  auto future = GraphRenderer::render_to_file_async (
+    options_, create_streaming_options (), std::move (collection),
+    [] (std::function<void ()> func) { func (); }, range, *tempo_map_);
+
+  const auto stats = future.result ();
+  future.waitForFinished ();
+
+  EXPECT_EQ (stats.frames_rendered_, units::samples (48000));
+  EXPECT_GT (stats.elapsed_seconds_, 0.0);
+  EXPECT_GT (stats.realtime_factor_, 0.0);
+  EXPECT_EQ (future.progressValue (), 48000);
+  EXPECT_THAT (future.progressText ().toStdString (), HasSubstr ("realtime"));
+
+  const auto result = read_rendered_file ();
+  ASSERT_EQ (result.getNumChannels (), 2);
+  ASSERT_EQ (result.getNumSamples (), 48000);
+  for (int ch = 0; ch < result.getNumChannels (); ++ch)
+    {
+      for (int i = 0; i < result.getNumSamples (); ++i)
+        {
+          const auto expected_sample =
+            0.1f * static_cast<float> (ch + 1)
+            * std::sin (
+              2.0f * std::numbers::pi_v<float> * 440.0f * static_cast<float> (i)
+              / 48000.0f);
+          ASSERT_NEAR (result.getSample (ch, i), expected_sample, 1e-5f)
+            << "Channel " << ch << ", Sample " << i;
+        }
+    }
+}
+
+TEST_F (GraphRendererStreamingTest, RenderToFileWithDither)
+{
+  auto collection = create_simple_test_collection ();
+  auto range = create_test_range (0, 1024);
+
+  auto future = GraphRenderer::render_to_file_async (
+    options_, create_streaming_options (16), std::move (collection),
+    [] (std::function<void ()> func) { func (); }, range, *tempo_map_);
+  future.waitForFinished ();
+
+  // dither noise is in the order of the 16-bit quantization step
+  const auto result = read_rendered_file ();
+  ASSERT_EQ (result.getNumSamples (), 1024);
+  for (int i = 0; i < result.getNumSamples (); ++i)
+    {
+      const auto expected_sample =
+        0.1f
+        * std::sin (
+          2.0f * std::numbers::pi_v<float> * 440.0f * static_cast<float> (i)
+          / 48000.0f);
+      EXPECT_NEAR (result.getSample (0, i), expected_sample, 1e-3f);
+    }
+}
+
+TEST_F (GraphRendererStreamingTest, CanceledRenderRemovesFile)
+{
+  auto collection = create_simple_test_collection ();
+  auto range = create_test_range (0, 48000 * 60);
+
+  auto future = GraphRenderer::render_to_file_async (
+    options_, create_streaming_options (), std::move (collection),
+    [] (std::function<void ()> func) { func (); }, range, *tempo_map_);
+
+  future.cancel ();
+  future.waitForFinished ();
+
+  EXPECT_TRUE (future.isCanceled ());
+  EXPECT_FALSE (std::filesystem::exists (file_path_));
+}
+
+TEST_F (GraphRendererStreamingTest, UnsupportedFormatFails)
+{
+  auto collection = create_simple_test_collection ();
+  auto range = create_test_range (0, 256);
+  auto streaming_options = create_streaming_options ();
+  streaming_options.file_path_.replace_extension (".xyz");
+
+  bool fail_handler_called{};
+  auto future =
+    GraphRenderer::render_to_file_async (
+      options_, streaming_options, std::move (collection),
+      [] (std::function<void ()> func) { func (); }, range, *tempo_map_)
+      .onFailed ([&fail_handler_called] () {
+        fail_handler_called = true;
+        return GraphRenderer::RenderStats{};
+      });
+
+  future.waitForFinished ();
+  EXPECT_TRUE (fail_handler_called);
+}
+
+class GraphRendererStemsTest : public GraphRendererStreamingTest
+{
+protected:
+  void SetUp () override
+  {
+    GraphRendererStreamingTest::SetUp ();
+
+    second_processable_ = std::make_unique<NiceMock<MockProcessable>> ();
+    unrelated_processable_ = std::make_unique<NiceMock<MockProcessable>> ();
+    second_generator_ = std::make_unique<SineWaveGenerator> (
+      *extra_audio_port_, 0.05f, 660.0f, 48000.0f);
+    ON_CALL (*second_processable_, get_node_name ())
+      .WillByDefault (Return (u8"second_node"));
+    ON_CALL (*second_processable_, process_block (_, _, _))
+      .WillByDefault ([this] (auto time_nfo, const auto &transport, const auto &) {
+        second_generator_->process_block (time_nfo, transport);
+      });
+    ON_CALL (*unrelated_processable_, get_node_name ())
+      .WillByDefault (Return (u8"unrelated_node"));
+
+    // processable_ -> audio_port_ -> extra_audio_port_for_summing_
+    // second_processable_ -> extra_audio_port_
+    // unrelated_processable_
+    auto * node = graph_.add_node_for_processable (*processable_);
+    auto * port_node = graph_.add_node_for_processable (*audio_port_);
+    auto * summing_node =
+      graph_.add_node_for_processable (*extra_audio_port_for_summing_);
+    node->connect_to (*port_node);
+    port_node->connect_to (*summing_node);
+    auto * second_node = graph_.add_node_for_processable (*second_processable_);
+    auto * second_port_node =
+      graph_.add_node_for_processable (*extra_audio_port_);
+    second_node->connect_to (*second_port_node);
+    graph_.add_node_for_processable (*unrelated_processable_);
+    graph_.finalize_nodes ();
+  }
+
+  GraphRenderer::StemOutput
+  create_stem (const AudioPort &port, const std::string &file_name)
+  {
+    auto streaming_options = create_streaming_options ();
+    streaming_options.file_path_.replace_filename (file_name);
+    return { .port_ = &port, .streaming_options_ = streaming_options };
+  }
+
+  static void verify_sine_wave_file (
+    const juce::AudioSampleBuffer &result,
+    int                            num_samples,
+    float                          amplitude,
+    float                          frequency)
+  {
+    ASSERT_EQ (result.getNumChannels (), 2);
+    ASSERT_EQ (result.getNumSamples (), num_samples);
+    for (int ch = 0; ch < result.getNumChannels (); ++ch)
+      {
+        for (int i = 0; i < result.getNumSamples (); ++i)
+          {
+            const auto expected_sample =
+              amplitude * static_cast<float> (ch + 1)
+              * std::sin (
+                2.0f * std::numbers::pi_v<float> * frequency
+                * static_cast<float> (i) / 48000.0f);
+            ASSERT_NEAR (result.getSample (ch, i), expected_sample, 1e-5f)
+              << "Channel " << ch << ", Sample " << i;
+          }
+      }
+  }
+
+  std::unique_ptr<NiceMock<MockProcessable>> second_processable_;
+  std::unique_ptr<NiceMock<MockProcessable>> unrelated_processable_;
+  std::unique_ptr<SineWaveGenerator>         second_generator_;
+  graph::Graph                               graph_;
+};
+
+TEST_F (GraphRendererStemsTest, RenderStemsInSinglePass)
+{
+  constexpr int num_frames = 4096;
+  const auto    num_blocks =
+    num_frames / options_.block_length_.in<int> (units::samples);
+
+  // each stem source is processed once per block, and nodes that don't feed
+  // any stem are pruned
+  EXPECT_CALL (*processable_, process_block (_, _, _)).Times (num_blocks);
+  EXPECT_CALL (*second_processable_, process_block (_, _, _))
+    .Times (num_blocks);
+  EXPECT_CALL (*unrelated_processable_, process_block (_, _, _)).Times (0);
+
+  std::vector<GraphRenderer::StemOutput> stems;
+  stems.push_back (create_stem (*audio_port_, "stem1.wav"));
+  stems.push_back (create_stem (*extra_audio_port_, "stem2.wav"));
+  const auto stem1_path = stems[0].streaming_options_.file_path_;
+  const auto stem2_path = stems[1].streaming_options_.file_path_;
+
+  auto future = GraphRenderer::render_stems_to_files_async (
+    options_, std::move (stems), graph_,
+    [] (std::function<void ()> func) { func (); },
+    create_test_range (0, num_frames), *tempo_map_);
+
+  const auto stats = future.result ();
+  EXPECT_EQ (stats.frames_rendered_, units::samples (num_frames));
+
+  verify_sine_wave_file (
+    read_rendered_file (stem1_path), num_frames, 0.1f, 440.0f);
+  verify_sine_wave_file (
+    read_rendered_file (stem2_path), num_frames, 0.05f, 660.0f);
+}
+
+TEST_F (GraphRendererStemsTest, CanceledRenderRemovesAllStems)
+{
+  std::vector<GraphRenderer::StemOutput> stems;
+  stems.push_back (create_stem (*audio_port_, "stem1.wav"));
+  stems.push_back (create_stem (*extra_audio_port_, "stem2.wav"));
+  const auto stem1_path = stems[0].streaming_options_.file_path_;
+  const auto stem2_path = stems[1].streaming_options_.file_path_;
+
+  auto future = GraphRenderer::render_stems_to_files_async (
+    options_, std::move (stems), graph_,
+    [] (std::function<void ()> func) { func (); },
+    create_test_range (0, 48000 * 60), *tempo_map_);
+
+  future.cancel ();
+  future.waitForFinished ();
+
+  EXPECT_TRUE (future.isCanceled ());
+  EXPECT_FALSE (std::filesystem::exists (stem1_path));
+  EXPECT_FALSE (std::filesystem::exists (stem2_path));
+}
+
+TEST_F (GraphRendererStemsTest, PortNotInGraphThrows)
+{
+  AudioPort other_port (
+    u8"OtherAudioOut", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  std::vector<GraphRenderer::StemOutput> stems;
+  stems.push_back (create_stem (other_port, "stem.wav"));
+
+  EXPECT_THROW (
+    GraphRenderer::render_stems_to_files_async (
+      options_, std::move (stems), graph_,
+      [] (std::function<void ()> func) { func (); },
+      create_test_range (0, 256), *tempo_map_),
+    std::invalid_argument);
+  EXPECT_THROW (
+    GraphRenderer::render_stems_to_files_async (
+      options_, {}, graph_, [] (std::function<void ()> func) { func (); },
+      create_test_range (0, 256), *tempo_map_),
+    std::invalid_argument);
+}
 } // namespace zrythm::dsp
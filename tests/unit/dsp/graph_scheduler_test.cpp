@@ -1,9 +1,11 @@
 // SPDX-FileCopyrightText: © 2024 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <mutex>
+#include <ranges>
 #include <thread>
 
 #include "dsp/graph_scheduler.h"
@@ -96,6 +98,40 @@ TEST_F (GraphSchedulerTest, ProcessingCycle)
   scheduler_->terminate_threads ();
 }
 
+TEST_F (GraphSchedulerTest, NodeTimingIsOptIn)
+{
+  auto collection = create_test_collection ();
+
+  scheduler_->rechain_from_node_collection (
+    std::move (collection), sample_rate_, block_length_);
+  scheduler_->start_threads (2);
+
+  auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256u));
+  scheduler_->run_cycle (
+    time_info, units::samples (0), *transport_, *tempo_map_);
+  for (const auto &node : scheduler_->get_nodes ().graph_nodes_)
+    {
+      EXPECT_EQ (node->timing_stats ().snapshot ().count, 0);
+    }
+
+  scheduler_->set_node_timing_enabled (true);
+  scheduler_->run_cycle (
+    time_info, units::samples (0), *transport_, *tempo_map_);
+  scheduler_->run_cycle (
+    time_info, units::samples (0), *transport_, *tempo_map_);
+
+  scheduler_->terminate_threads ();
+
+  for (const auto &node : scheduler_->get_nodes ().graph_nodes_)
+    {
+      const auto snapshot = node->timing_stats ().snapshot ();
+      EXPECT_EQ (snapshot.count, 2);
+      EXPECT_LE (snapshot.min_ns, snapshot.max_ns);
+      EXPECT_GE (snapshot.last_thread_id, -1);
+    }
+}
+
 TEST_F (GraphSchedulerTest, MultiThreadedProcessing)
 {
   auto collection = create_test_collection ();
@@ -206,4 +242,244 @@ TEST_F (GraphSchedulerTest, RechainWithLargerBufferSize)
 
   scheduler_->terminate_threads ();
 }
+
+TEST_F (GraphSchedulerTest, WorkStealingProcessesEachNodeOncePerCycle)
+{
+  // root -> 16 parallel nodes -> sink
+  constexpr int       width = 16;
+  GraphNodeCollection collection;
+  auto root = std::make_unique<GraphNode> (0, *processable_);
+  auto sink = std::make_unique<GraphNode> (width + 1, *processable_);
+  for (int i = 0; i < width; ++i)
+    {
+      auto node = std::make_unique<GraphNode> (i + 1, *processable_);
+      root->connect_to (*node);
+      node->connect_to (*sink);
+      collection.graph_nodes_.push_back (std::move (node));
+    }
+  collection.graph_nodes_.push_back (std::move (root));
+  collection.graph_nodes_.push_back (std::move (sink));
+  collection.finalize_nodes ();
+
+  std::atomic<int> process_count{ 0 };
+  ON_CALL (*processable_, process_block (_, _, _))
+    .WillByDefault ([&] (auto, auto &, auto &) { process_count++; });
+
+  scheduler_->set_dispatch_strategy (
+    GraphScheduler::DispatchStrategy::WorkStealing);
+  scheduler_->rechain_from_node_collection (
+    std::move (collection), sample_rate_, block_length_);
+  scheduler_->start_threads (4);
+
+  auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256u));
+  constexpr int num_cycles = 50;
+  for (int i = 0; i < num_cycles; ++i)
+    {
+      scheduler_->run_cycle (
+        time_info, units::samples (0), *transport_, *tempo_map_);
+      EXPECT_EQ (process_count.load (), (width + 2) * (i + 1));
+    }
+
+  scheduler_->terminate_threads ();
+}
+
+TEST_F (GraphSchedulerTest, PrioritizedDispatchProcessesEachNodeOncePerCycle)
+{
+  for (
+    const auto strategy :
+    { GraphScheduler::DispatchStrategy::SharedQueue,
+      GraphScheduler::DispatchStrategy::WorkStealing })
+    {
+      // root -> 48 parallel nodes (more than fit in a ready batch) -> sink
+      constexpr int       width = 48;
+      GraphNodeCollection collection;
+      auto root = std::make_unique<GraphNode> (0, *processable_);
+      auto sink = std::make_unique<GraphNode> (width + 1, *processable_);
+      for (int i = 0; i < width; ++i)
+        {
+          auto node = std::make_unique<GraphNode> (i + 1, *processable_);
+          root->connect_to (*node);
+          node->connect_to (*sink);
+          collection.graph_nodes_.push_back (std::move (node));
+        }
+      collection.graph_nodes_.push_back (std::move (root));
+      collection.graph_nodes_.push_back (std::move (sink));
+      collection.finalize_nodes ();
+
+      std::atomic<int> process_count{ 0 };
+      ON_CALL (*processable_, process_block (_, _, _))
+        .WillByDefault ([&] (auto, auto &, auto &) { process_count++; });
+
+      scheduler_->set_dispatch_strategy (strategy);
+      ASSERT_TRUE (scheduler_->critical_path_prioritization_enabled ());
+      scheduler_->rechain_from_node_collection (
+        std::move (collection), sample_rate_, block_length_);
+      scheduler_->start_threads (4);
+
+      auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+        units::samples (0), units::samples (256u));
+      // enough cycles to go through a few critical path updates
+      constexpr int num_cycles = 48;
+      for (int i = 0; i < num_cycles; ++i)
+        {
+          scheduler_->run_cycle (
+            time_info, units::samples (0), *transport_, *tempo_map_);
+          EXPECT_EQ (process_count.load (), (width + 2) * (i + 1));
+        }
+
+      scheduler_->terminate_threads ();
+
+      const auto &nodes = scheduler_->get_nodes ();
+      for (const auto &node : nodes.graph_nodes_)
+        {
+          EXPECT_GT (node->get_process_cost (), 0.f);
+        }
+      EXPECT_GE (
+        nodes.prioritized_trigger_nodes_.front ()->get_critical_path_cost (),
+        nodes.prioritized_trigger_nodes_.front ()->get_process_cost ());
+    }
+}
+
+TEST_F (GraphSchedulerTest, PrunesNodesOnlyFeedingGateIgnoringItsInputs)
+{
+  class PrunableProcessable : public MockProcessable
+  {
+  public:
+    bool can_be_pruned () const override { return true; }
+  };
+  class GateProcessable : public MockProcessable
+  {
+  public:
+    bool can_ignore_inputs () const override { return true; }
+    bool ignore_inputs_in_next_cycle (bool allowed) noexcept override
+    {
+      return allowed && ignore_inputs_.load ();
+    }
+    std::atomic<bool> ignore_inputs_;
+  };
+
+  // up1 -> up2 -> gate -> out, source -> up2 and shared -> {gate, out}
+  NiceMock<MockProcessable>     source;
+  NiceMock<PrunableProcessable> up1;
+  NiceMock<PrunableProcessable> up2;
+  NiceMock<PrunableProcessable> shared;
+  NiceMock<GateProcessable>     gate;
+  NiceMock<MockProcessable>     out;
+  std::array<std::atomic<int>, 6> process_counts{};
+  const std::array<MockProcessable *, 6> processables{
+    &source, &up1, &up2, &shared, &gate, &out
+  };
+  GraphNodeCollection collection;
+  for (const auto i : std::views::iota (0zu, processables.size ()))
+    {
+      ON_CALL (*processables[i], get_node_name ())
+        .WillByDefault (Return (u8"test_node"));
+      ON_CALL (*processables[i], process_block (_, _, _))
+        .WillByDefault ([&, i] (auto, auto &, auto &) {
+          process_counts[i]++;
+        });
+      collection.graph_nodes_.push_back (
+        std::make_unique<GraphNode> (i, *processables[i]));
+    }
+  const auto node = [&] (size_t i) -> GraphNode & {
+    return *collection.graph_nodes_[i];
+  };
+  node (0).connect_to (node (2));
+  node (1).connect_to (node (2));
+  node (2).connect_to (node (4));
+  node (3).connect_to (node (4));
+  node (3).connect_to (node (5));
+  node (4).connect_to (node (5));
+  collection.finalize_nodes ();
+  ASSERT_EQ (collection.prunable_subgraphs_.size (), 1);
+  EXPECT_EQ (collection.prunable_subgraphs_.front ().upstream.size (), 2);
+
+  scheduler_->rechain_from_node_collection (
+    std::move (collection), sample_rate_, block_length_);
+  scheduler_->start_threads (2);
+
+  auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256u));
+  const auto run_cycle_and_expect = [&] (std::array<int, 6> expected) {
+    for (auto &count : process_counts)
+      count = 0;
+    scheduler_->run_cycle (
+      time_info, units::samples (0), *transport_, *tempo_map_);
+    for (const auto i : std::views::iota (0zu, expected.size ()))
+      {
+        EXPECT_EQ (process_counts[i].load (), expected[i]) << "node " << i;
+      }
+  };
+
+  run_cycle_and_expect ({ 1, 1, 1, 1, 1, 1 });
+
+  // up1 and up2 are left out, shared still feeds out
+  gate.ignore_inputs_ = true;
+  for (int i = 0; i < 3; ++i)
+    run_cycle_and_expect ({ 1, 0, 0, 1, 1, 1 });
+
+  // restored in the next cycle
+  gate.ignore_inputs_ = false;
+  for (int i = 0; i < 3; ++i)
+    run_cycle_and_expect ({ 1, 1, 1, 1, 1, 1 });
+
+  // never pruned while disabled
+  gate.ignore_inputs_ = true;
+  scheduler_->set_subgraph_pruning_enabled (false);
+  run_cycle_and_expect ({ 1, 1, 1, 1, 1, 1 });
+  scheduler_->set_subgraph_pruning_enabled (true);
+  run_cycle_and_expect ({ 1, 0, 0, 1, 1, 1 });
+
+  scheduler_->terminate_threads ();
+  scheduler_.reset ();
+}
+
+TEST_F (GraphSchedulerTest, PublishedCollectionIsAdoptedAtCycleBoundary)
+{
+  scheduler_->rechain_from_node_collection (
+    create_test_collection (), sample_rate_, block_length_);
+  scheduler_->start_threads (2);
+
+  auto other_processable = std::make_unique<MockProcessable> ();
+  ON_CALL (*other_processable, get_node_name ())
+    .WillByDefault (Return (u8"other_node"));
+  ON_CALL (*other_processable, get_single_playback_latency ())
+    .WillByDefault (Return (units::samples (0)));
+
+  auto new_collection = std::make_unique<GraphNodeCollection> ();
+  new_collection->graph_nodes_.push_back (
+    std::make_unique<GraphNode> (1, *other_processable));
+  new_collection->finalize_nodes ();
+
+  // publishing must not touch processables - that's the caller's job
+  EXPECT_CALL (*processable_, release_resources ()).Times (0);
+  EXPECT_CALL (*other_processable, prepare_for_processing_impl (_, _, _))
+    .Times (0);
+
+  ASSERT_FALSE (scheduler_->requires_pause_to_publish (*new_collection));
+  scheduler_->publish_node_collection (std::move (new_collection));
+  EXPECT_TRUE (scheduler_->has_pending_node_collection ());
+  EXPECT_EQ (scheduler_->get_nodes ().graph_nodes_.size (), 3);
+
+  // the next cycle runs the new collection only
+  EXPECT_CALL (*processable_, process_block (_, _, _)).Times (0);
+  EXPECT_CALL (*other_processable, process_block (_, _, _)).Times (1);
+  auto time_info = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256u));
+  scheduler_->run_cycle (
+    time_info, units::samples (0), *transport_, *tempo_map_);
+
+  EXPECT_FALSE (scheduler_->has_pending_node_collection ());
+  EXPECT_EQ (scheduler_->get_nodes ().graph_nodes_.size (), 1);
+
+  // the old collection is handed back for destruction outside the RT thread
+  auto retired = scheduler_->take_retired_node_collection ();
+  ASSERT_NE (retired, nullptr);
+  EXPECT_EQ (retired->graph_nodes_.size (), 3);
+  EXPECT_EQ (scheduler_->take_retired_node_collection (), nullptr);
+
+  scheduler_->terminate_threads ();
+  scheduler_.reset ();
+}
 }
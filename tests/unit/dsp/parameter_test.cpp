@@ -112,6 +112,52 @@ TEST_F (ProcessorParameterTest, AutomationValueApplication)
   EXPECT_FLOAT_EQ (param->valueAfterAutomationApplied (), auto_value);
 }
 
+TEST_F (ProcessorParameterTest, SampleAccurateAutomation)
+{
+  // disable modulation
+  param_mod_input->port_sources ().front ().second->enabled_ = false;
+
+  param->set_sample_accurate_automation (true);
+  param->prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  param->set_automation_provider ([] (auto) { return std::optional{ 0.f }; });
+  param->set_automation_block_provider (
+    [] (units::sample_t start_position, std::span<float> values) {
+      // leave the first sample without automation
+      for (size_t i = 1; i < values.size (); ++i)
+        {
+          const auto pos = start_position + units::samples (i);
+          values[i] = static_cast<float> (pos.in (units::samples)) / 1000.f;
+        }
+    });
+  ON_CALL (*mock_transport_, get_play_state ())
+    .WillByDefault (::testing::Return (ITransport::PlayState::Rolling));
+
+  param->process_block (
+    { .transport_position_ = units::samples (100),
+      .buffer_offset_ = units::samples (10),
+      .nframes_ = units::samples (50) },
+    *mock_transport_, *tempo_map_);
+
+  // values are indexed by buffer position
+  const auto values = param->block_values ();
+  ASSERT_EQ (values.size (), BLOCK_LENGTH.in (units::samples));
+  EXPECT_FLOAT_EQ (values[10], param->baseValue ());
+  EXPECT_FLOAT_EQ (values[11], 0.101f);
+  EXPECT_FLOAT_EQ (values[59], 0.149f);
+  EXPECT_FLOAT_EQ (param->currentValue (), 0.149f);
+
+  // falls back to the per-block value while the transport is not rolling
+  ON_CALL (*mock_transport_, get_play_state ())
+    .WillByDefault (::testing::Return (ITransport::PlayState::Paused));
+  param->process_block (
+    { .transport_position_ = units::samples (100),
+      .buffer_offset_ = units::samples (0),
+      .nframes_ = BLOCK_LENGTH },
+    *mock_transport_, *tempo_map_);
+  EXPECT_TRUE (param->block_values ().empty ());
+  EXPECT_FLOAT_EQ (param->currentValue (), 0.f);
+}
+
 TEST_F (ProcessorParameterTest, ModulationApplication)
 {
   // Enable modulation
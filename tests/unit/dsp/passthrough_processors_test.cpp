@@ -106,6 +106,43 @@ TEST_F (PassthroughProcessorsTest, AudioPassthroughBasic)
     }
 }
 
+TEST_F (PassthroughProcessorsTest, AudioPassthroughAliasesSingleSource)
+{
+  audio_proc_ = std::make_unique<StereoPassthroughProcessor> (*registry_);
+  audio_proc_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  auto &in = audio_proc_->get_audio_in_port ();
+  auto &out = audio_proc_->get_audio_out_port ();
+
+  AudioPort src (u8"Src", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  src.prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  in.set_port_sources (std::views::single (&src));
+  for (int i = 0; i < 512; i++)
+    {
+      src.buffers ()->setSample (0, i, static_cast<float> (i) * 0.01f);
+      src.buffers ()->setSample (1, i, static_cast<float> (i) * -0.01f);
+    }
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (512));
+  for (int cycle = 0; cycle < 2; ++cycle)
+    {
+      in.process_block (time_nfo, *mock_transport_, *tempo_map_);
+      audio_proc_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+
+      // the output refers to the source directly (the input's alias is
+      // dropped after processing)
+      EXPECT_FALSE (in.is_aliased ());
+      ASSERT_TRUE (out.is_aliased ());
+      EXPECT_EQ (
+        out.buffers ()->getReadPointer (1), src.buffers ()->getReadPointer (1));
+      for (int i = 0; i < 512; i++)
+        {
+          EXPECT_NEAR (out.buffers ()->getSample (0, i), i * 0.01f, 1e-4f);
+          EXPECT_NEAR (out.buffers ()->getSample (1, i), i * -0.01f, 1e-4f);
+        }
+    }
+}
+
 TEST_F (PassthroughProcessorsTest, ResourceManagement)
 {
   // Test prepare/release cycle
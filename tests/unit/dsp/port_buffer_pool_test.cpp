@@ -0,0 +1,402 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include "dsp/audio_port.h"
+#include "dsp/cv_port.h"
+#include "dsp/graph.h"
+#include "dsp/port_buffer_pool.h"
+
+#include "./graph_helpers.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+namespace zrythm::dsp
+{
+
+class PortBufferPoolTest : public ::testing::Test
+{
+protected:
+  static constexpr auto SAMPLE_RATE = units::sample_rate (44100);
+  static constexpr auto BLOCK_LENGTH = units::samples (256);
+
+  using MockProcessable = NiceMock<graph_test::MockProcessable>;
+
+  std::unique_ptr<AudioPort>
+  make_port (PortFlow flow = PortFlow::Input, int num_channels = 2)
+  {
+    auto port = std::make_unique<AudioPort> (
+      flow == PortFlow::Input ? u8"In" : u8"Out", flow,
+      num_channels == 1
+        ? AudioPort::BusLayout::Mono
+        : AudioPort::BusLayout::Stereo,
+      num_channels);
+    port->prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+    return port;
+  }
+  std::unique_ptr<AudioPort> make_input (int num_channels = 2)
+  {
+    return make_port (PortFlow::Input, num_channels);
+  }
+  std::unique_ptr<AudioPort> make_output (int num_channels = 2)
+  {
+    return make_port (PortFlow::Output, num_channels);
+  }
+  std::unique_ptr<CVPort> make_cv_port (PortFlow flow)
+  {
+    auto port = std::make_unique<CVPort> (u8"CV", flow);
+    port->prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+    return port;
+  }
+
+  static const float * storage (const AudioPort &port)
+  {
+    return port.buffers ()->getReadPointer (0);
+  }
+
+  graph::GraphNode * add (IProcessable &processable)
+  {
+    return graph_.add_node_for_processable (processable);
+  }
+
+  graph::Graph graph_;
+};
+
+TEST_F (PortBufferPoolTest, SharesStorageAcrossSequentialPorts)
+{
+  // root -> in_a -> proc_a -> merge
+  // root -> in_b -> proc_b -> merge
+  // merge -> in_c -> proc_c -> terminal
+  MockProcessable root, proc_a, proc_b, merge, proc_c;
+  auto            in_a = make_input ();
+  auto            in_b = make_input ();
+  auto            in_c = make_input ();
+  auto            terminal = make_input ();
+  const auto *    terminal_storage = storage (*terminal);
+
+  add (root)->connect_to (*add (*in_a));
+  add (root)->connect_to (*add (*in_b));
+  add (*in_a)->connect_to (*add (proc_a));
+  add (*in_b)->connect_to (*add (proc_b));
+  add (proc_a)->connect_to (*add (merge));
+  add (proc_b)->connect_to (*add (merge));
+  add (merge)->connect_to (*add (*in_c));
+  add (*in_c)->connect_to (*add (proc_c));
+  add (proc_c)->connect_to (*add (*terminal));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  const auto &stats = assignment->stats ();
+
+  // parallel branches may run at the same time
+  EXPECT_NE (storage (*in_a), storage (*in_b));
+
+  // proc_a and proc_b are done before in_c is filled
+  EXPECT_TRUE (
+    storage (*in_c) == storage (*in_a) || storage (*in_c) == storage (*in_b));
+
+  // terminal ports are read after the cycle
+  EXPECT_EQ (storage (*terminal), terminal_storage);
+
+  EXPECT_EQ (stats.num_ports, 3);
+  EXPECT_EQ (stats.num_slots, 2);
+  EXPECT_EQ (stats.unpooled_bytes, 3 * 2 * 256 * sizeof (float));
+  EXPECT_EQ (stats.pooled_bytes, 2 * 2 * 256 * sizeof (float));
+
+  // channels are cache line aligned
+  EXPECT_EQ (reinterpret_cast<uintptr_t> (storage (*in_a)) % 64, 0);
+  EXPECT_EQ (
+    reinterpret_cast<uintptr_t> (in_a->buffers ()->getReadPointer (1)) % 64,
+    0);
+}
+
+TEST_F (PortBufferPoolTest, DoesNotShareStorageBetweenChannelCounts)
+{
+  // mono -> proc_a -> stereo -> proc_b
+  MockProcessable proc_a, proc_b;
+  auto            mono = make_input (1);
+  auto            stereo = make_input (2);
+
+  add (*mono)->connect_to (*add (proc_a));
+  add (proc_a)->connect_to (*add (*stereo));
+  add (*stereo)->connect_to (*add (proc_b));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  const auto &stats = assignment->stats ();
+  EXPECT_EQ (stats.num_ports, 2);
+  EXPECT_EQ (stats.num_slots, 2);
+  EXPECT_NE (storage (*mono), storage (*stereo));
+}
+
+TEST_F (PortBufferPoolTest, StorageIsOnlyUsedAfterBinding)
+{
+  // in_a -> proc_a -> in_b -> proc_b
+  MockProcessable proc_a, proc_b;
+  auto            in_a = make_input ();
+  auto            in_b = make_input ();
+  const auto *    own_storage = storage (*in_a);
+
+  add (*in_a)->connect_to (*add (proc_a));
+  add (proc_a)->connect_to (*add (*in_b));
+  add (*in_b)->connect_to (*add (proc_b));
+  graph_.finalize_nodes ();
+
+  // the ports may still be processed by the live graph here
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  EXPECT_EQ (storage (*in_a), own_storage);
+  EXPECT_FALSE (in_a->is_pooled ());
+
+  assignment->bind ();
+  EXPECT_NE (storage (*in_a), own_storage);
+  EXPECT_TRUE (in_a->is_pooled ());
+
+  // in_a becomes a terminal port in a rebuilt graph
+  graph::Graph rebuilt;
+  rebuilt.add_node_for_processable (proc_b)->connect_to (
+    *rebuilt.add_node_for_processable (*in_a));
+  rebuilt.finalize_nodes ();
+  const auto rebuilt_assignment =
+    PortBufferPool::assign (rebuilt.get_nodes (), BLOCK_LENGTH);
+  rebuilt_assignment->bind ();
+  EXPECT_FALSE (in_a->is_pooled ());
+  EXPECT_EQ (in_a->buffers ()->getNumChannels (), 2);
+  EXPECT_EQ (in_a->buffers ()->getNumSamples (), 256);
+}
+
+TEST_F (PortBufferPoolTest, PooledPortSumsSourcesIntoClearedStorage)
+{
+  AudioPort src (u8"Src", PortFlow::Output, AudioPort::BusLayout::Stereo, 2);
+  src.prepare_for_processing (nullptr, SAMPLE_RATE, BLOCK_LENGTH);
+  MockProcessable proc_a, proc_b;
+  auto            in_a = make_input ();
+  auto            in_b = make_input ();
+  in_b->set_port_sources (std::views::single (&src));
+
+  add (*in_a)->connect_to (*add (proc_a));
+  add (proc_a)->connect_to (*add (*in_b));
+  add (*in_b)->connect_to (*add (proc_b));
+  graph_.finalize_nodes ();
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  ASSERT_EQ (storage (*in_a), storage (*in_b));
+
+  // leftovers from the previous occupant must not leak into the sum
+  in_a->buffers ()->setSample (0, 10, 1.f);
+  src.buffers ()->setSample (0, 10, 0.25f);
+
+  graph_test::MockTransport transport;
+  dsp::TempoMap             tempo_map (SAMPLE_RATE);
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), BLOCK_LENGTH);
+  in_b->process_block (time_nfo, transport, tempo_map);
+  EXPECT_FLOAT_EQ (in_b->buffers ()->getSample (0, 10), 0.25f);
+}
+
+TEST_F (PortBufferPoolTest, SharesStorageBetweenInputAndOutputPorts)
+{
+  // proc_a -> out_a -> in_b -> proc_b -> out_b -> in_c -> proc_c
+  MockProcessable proc_a, proc_b, proc_c;
+  auto            out_a = make_output ();
+  auto            in_b = make_input ();
+  auto            out_b = make_output ();
+  auto            in_c = make_input ();
+
+  add (proc_a)->connect_to (*add (*out_a));
+  add (*out_a)->connect_to (*add (*in_b));
+  add (*in_b)->connect_to (*add (proc_b));
+  add (proc_b)->connect_to (*add (*out_b));
+  add (*out_b)->connect_to (*add (*in_c));
+  add (*in_c)->connect_to (*add (proc_c));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  const auto &stats = assignment->stats ();
+
+  // proc_b reads in_b while writing out_b
+  EXPECT_NE (storage (*in_b), storage (*out_b));
+
+  // in_b has summed out_a before proc_b writes out_b
+  EXPECT_EQ (storage (*out_a), storage (*out_b));
+  EXPECT_EQ (storage (*in_b), storage (*in_c));
+
+  EXPECT_EQ (stats.num_ports, 4);
+  EXPECT_EQ (stats.num_slots, 2);
+}
+
+TEST_F (PortBufferPoolTest, AliasedOutputsLiveUntilAliasReadersAreDone)
+{
+  // proc_a -> out_a -> in_b (aliases out_a) -> proc_b -> out_b (may alias
+  // in_b) -> in_c -> proc_c -> out_c -> in_d -> proc_d
+  MockProcessable proc_a, proc_b, proc_c, proc_d;
+  auto            out_a = make_output ();
+  auto            in_b = make_input ();
+  auto            out_b = make_output ();
+  auto            in_c = make_input ();
+  auto            out_c = make_output ();
+  auto            in_d = make_input ();
+  in_b->set_source_aliasing_allowed (true);
+
+  add (proc_a)->connect_to (*add (*out_a));
+  add (*out_a)->connect_to (*add (*in_b));
+  add (*in_b)->connect_to (*add (proc_b));
+  add (proc_b)->connect_to (*add (*out_b));
+  add (*out_b)->connect_to (*add (*in_c));
+  add (*in_c)->connect_to (*add (proc_c));
+  add (proc_c)->connect_to (*add (*out_c));
+  add (*out_c)->connect_to (*add (*in_d));
+  add (*in_d)->connect_to (*add (proc_d));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+
+  // proc_b and in_c may read out_a's data through the aliases, so out_b and
+  // in_c can't take over its storage
+  EXPECT_NE (storage (*out_b), storage (*out_a));
+  EXPECT_NE (storage (*in_c), storage (*out_a));
+
+  // in_c is done with it once proc_c runs
+  EXPECT_EQ (storage (*out_c), storage (*out_a));
+}
+
+TEST_F (PortBufferPoolTest, DoesNotPoolOutputPortsReadAfterTheCycle)
+{
+  // proc_a -> out_a -> in_b (aliases out_a) -> proc_b -> out_b (terminal)
+  // proc_b -> out_c (read outside the graph) -> in_c -> proc_c
+  MockProcessable proc_a, proc_b, proc_c;
+  auto            out_a = make_output ();
+  auto            in_b = make_input ();
+  auto            out_b = make_output ();
+  auto            out_c = make_output ();
+  auto            in_c = make_input ();
+  const auto *    out_a_storage = storage (*out_a);
+  const auto *    out_c_storage = storage (*out_c);
+  in_b->set_source_aliasing_allowed (true);
+  out_c->mark_as_read_outside_graph ();
+
+  add (proc_a)->connect_to (*add (*out_a));
+  add (*out_a)->connect_to (*add (*in_b));
+  add (*in_b)->connect_to (*add (proc_b));
+  add (proc_b)->connect_to (*add (*out_b));
+  add (proc_b)->connect_to (*add (*out_c));
+  add (*out_c)->connect_to (*add (*in_c));
+  add (*in_c)->connect_to (*add (proc_c));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+
+  // out_b may alias out_a's data
+  EXPECT_EQ (storage (*out_a), out_a_storage);
+  EXPECT_FALSE (out_a->is_pooled ());
+  EXPECT_EQ (storage (*out_c), out_c_storage);
+  EXPECT_FALSE (out_c->is_pooled ());
+  EXPECT_EQ (assignment->stats ().num_ports, 2);
+}
+
+TEST_F (PortBufferPoolTest, PooledOutputPortIsClearedWhenDroppingAlias)
+{
+  MockProcessable proc_a, proc_b;
+  auto            src = make_output ();
+  auto            in = make_input ();
+  auto            out = make_output ();
+  auto            reader = make_input ();
+
+  add (proc_a)->connect_to (*add (*out));
+  add (*out)->connect_to (*add (*reader));
+  add (*reader)->connect_to (*add (proc_b));
+  graph_.finalize_nodes ();
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  ASSERT_TRUE (out->is_pooled ());
+
+  // leftovers from another port sharing the storage
+  const auto * own_storage = storage (*out);
+  out->buffers ()->setSample (0, 10, 1.f);
+  ASSERT_TRUE (out->alias_source_rt (*src));
+  ASSERT_NE (storage (*out), own_storage);
+
+  out->clear_buffer (0, BLOCK_LENGTH.in (units::samples));
+  EXPECT_FALSE (out->is_aliased ());
+  EXPECT_FLOAT_EQ (out->buffers ()->getSample (0, 10), 0.f);
+}
+
+TEST_F (PortBufferPoolTest, SharesStorageBetweenCVAndMonoPorts)
+{
+  // proc_a -> cv_out -> cv_in -> proc_b -> mono_out -> mono_in -> proc_c
+  // -> cv_out_c -> cv_in_c -> proc_d
+  MockProcessable proc_a, proc_b, proc_c, proc_d;
+  auto            cv_out = make_cv_port (PortFlow::Output);
+  auto            cv_in = make_cv_port (PortFlow::Input);
+  auto            mono_out = make_port (PortFlow::Output, 1);
+  auto            mono_in = make_input (1);
+  auto            cv_out_c = make_cv_port (PortFlow::Output);
+  auto            cv_in_c = make_cv_port (PortFlow::Input);
+
+  add (proc_a)->connect_to (*add (*cv_out));
+  add (*cv_out)->connect_to (*add (*cv_in));
+  add (*cv_in)->connect_to (*add (proc_b));
+  add (proc_b)->connect_to (*add (*mono_out));
+  add (*mono_out)->connect_to (*add (*mono_in));
+  add (*mono_in)->connect_to (*add (proc_c));
+  add (proc_c)->connect_to (*add (*cv_out_c));
+  add (*cv_out_c)->connect_to (*add (*cv_in_c));
+  add (*cv_in_c)->connect_to (*add (proc_d));
+  graph_.finalize_nodes ();
+
+  const auto assignment =
+    PortBufferPool::assign (graph_.get_nodes (), BLOCK_LENGTH);
+  assignment->bind ();
+  EXPECT_TRUE (cv_out->is_pooled ());
+  EXPECT_EQ (cv_out->buf_.size (), 256);
+  EXPECT_EQ (storage (*mono_out), cv_out->buf_.data ());
+  EXPECT_EQ (storage (*mono_in), cv_in->buf_.data ());
+  EXPECT_EQ (cv_out_c->buf_.data (), cv_out->buf_.data ());
+  EXPECT_EQ (cv_in_c->buf_.data (), cv_in->buf_.data ());
+  EXPECT_EQ (assignment->stats ().num_slots, 2);
+
+  // cv_out becomes a terminal port in a rebuilt graph
+  graph::Graph rebuilt;
+  rebuilt.add_node_for_processable (proc_a)->connect_to (
+    *rebuilt.add_node_for_processable (*cv_out));
+  rebuilt.finalize_nodes ();
+  const auto rebuilt_assignment =
+    PortBufferPool::assign (rebuilt.get_nodes (), BLOCK_LENGTH);
+  rebuilt_assignment->bind ();
+  EXPECT_FALSE (cv_out->is_pooled ());
+  EXPECT_EQ (cv_out->buf_.size (), 256);
+  EXPECT_NE (cv_out->buf_.data (), cv_in->buf_.data ());
+}
+
+TEST_F (PortBufferPoolTest, PooledCVPortSumsSourcesIntoClearedStorage)
+{
+  auto src = make_cv_port (PortFlow::Output);
+  auto cv_in = make_cv_port (PortFlow::Input);
+  cv_in->set_port_sources (std::views::single (src.get ()));
+  std::vector<float> shared (BLOCK_LENGTH.in (units::samples), 1.f);
+  cv_in->set_pooled_buffer (shared);
+  src->buf_[10] = 0.25f;
+
+  graph_test::MockTransport transport;
+  dsp::TempoMap             tempo_map (SAMPLE_RATE);
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), BLOCK_LENGTH);
+  cv_in->process_block (time_nfo, transport, tempo_map);
+  EXPECT_FLOAT_EQ (shared[10], 0.25f);
+  EXPECT_FLOAT_EQ (shared[11], 0.f);
+}
+
+} // namespace zrythm::dsp
@@ -181,7 +181,6 @@ TEST_F (PortObserverTest, CVCaptureToRingBuffer)
   auto observer = std::make_unique<PortObserver> (registry_, *port);
   observer->prepare_for_processing (nullptr, sample_rate_, block_length_);
 
-  port->buf_.resize (256);
   port->buf_[0] = 0.5f;
   port->buf_[1] = -0.3f;
 
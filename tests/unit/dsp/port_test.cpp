@@ -23,6 +23,7 @@ public:
   }
 
   MOCK_METHOD (void, clear_buffer, (std::size_t, std::size_t), (override));
+  MOCK_METHOD (bool, is_prepared_for_processing, (), (const, override));
   MOCK_METHOD (
     void,
     process_block,
@@ -47,6 +47,13 @@ public:
     (dsp::graph::ProcessBlockInfo, const dsp::ITransport &, const dsp::TempoMap &),
     (noexcept, override));
 
+  std::optional<units::sample_u32_t> get_tail_length () const noexcept override
+  {
+    return tail_length_;
+  }
+
+  std::optional<units::sample_u32_t> tail_length_;
+
 private:
   PortUuidReference input_port_;
   PortUuidReference output_port_;
@@ -426,6 +433,160 @@ TEST_F (ProcessorBaseTest, ChangeTrackerRecordsMultipleParams)
   processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
 }
 
+TEST_F (ProcessorBaseTest, ParameterRampIsConstantWhenUnchanged)
+{
+  auto param_ref = utils::create_object<dsp::ProcessorParameter> (
+    *registry_, *registry_, dsp::ProcessorParameter::UniqueId (u8"test-param"),
+    dsp::ParameterRange{ dsp::ParameterRange::Type::Linear, 0.f, 2.f, 0.f, 1.f },
+    u8"TestParam");
+  processor_->add_parameter (param_ref);
+  auto * param = param_ref.get_object_as<dsp::ProcessorParameter> ();
+
+  processor_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  processor_->enable_parameter_ramp (
+    *param, ProcessorBase::ParameterChangeTracker::RampShape::Linear);
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256));
+
+  // the first cycle has nothing to ramp from
+  for (int i = 0; i < 2; ++i)
+    {
+      EXPECT_CALL (
+        *processor_,
+        custom_process_block (::testing::_, ::testing::_, ::testing::_))
+        .WillOnce ([&] (auto, auto &, auto &) {
+          const auto &ramp = processor_->parameter_ramp (*param);
+          EXPECT_TRUE (ramp.is_constant ());
+          EXPECT_FLOAT_EQ (ramp.value, 1.f);
+        });
+      processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+    }
+}
+
+TEST_F (ProcessorBaseTest, ParameterRampInterpolatesChanges)
+{
+  auto linear_ref = utils::create_object<dsp::ProcessorParameter> (
+    *registry_, *registry_, dsp::ProcessorParameter::UniqueId (u8"linear"),
+    dsp::ParameterRange{ dsp::ParameterRange::Type::Linear, 0.f, 2.f, 0.f, 1.f },
+    u8"Linear");
+  auto exp_ref = utils::create_object<dsp::ProcessorParameter> (
+    *registry_, *registry_, dsp::ProcessorParameter::UniqueId (u8"exp"),
+    dsp::ParameterRange{ dsp::ParameterRange::Type::Linear, 0.f, 2.f, 0.f, 1.f },
+    u8"Exponential");
+  processor_->add_parameter (linear_ref);
+  processor_->add_parameter (exp_ref);
+  auto * linear = linear_ref.get_object_as<dsp::ProcessorParameter> ();
+  auto * exp = exp_ref.get_object_as<dsp::ProcessorParameter> ();
+
+  processor_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  processor_->enable_parameter_ramp (
+    *linear, ProcessorBase::ParameterChangeTracker::RampShape::Linear);
+  processor_->enable_parameter_ramp (
+    *exp, ProcessorBase::ParameterChangeTracker::RampShape::Exponential);
+
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (4));
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .Times (1);
+  processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+
+  // 1 -> 2 over 4 samples
+  linear->setBaseValue (1.f);
+  exp->setBaseValue (1.f);
+  std::vector<float> linear_values;
+  std::vector<float> exp_values;
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .WillOnce ([&] (auto, auto &, auto &) {
+      const auto &linear_ramp = processor_->parameter_ramp (*linear);
+      const auto &exp_ramp = processor_->parameter_ramp (*exp);
+      EXPECT_FLOAT_EQ (linear_ramp.value, 2.f);
+      EXPECT_FLOAT_EQ (exp_ramp.value, 2.f);
+      linear_values.assign (
+        linear_ramp.values.begin (), linear_ramp.values.end ());
+      exp_values.assign (exp_ramp.values.begin (), exp_ramp.values.end ());
+    });
+  processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+
+  ASSERT_EQ (linear_values.size (), 4u);
+  EXPECT_FLOAT_EQ (linear_values[0], 1.25f);
+  EXPECT_FLOAT_EQ (linear_values[1], 1.5f);
+  EXPECT_FLOAT_EQ (linear_values[3], 2.f);
+  ASSERT_EQ (exp_values.size (), 4u);
+  EXPECT_NEAR (exp_values[0], std::pow (2.f, 0.25f), 1e-6f);
+  EXPECT_NEAR (exp_values[1], std::sqrt (2.f), 1e-6f);
+  EXPECT_FLOAT_EQ (exp_values[3], 2.f);
+
+  // settles on the new value
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .WillOnce ([&] (auto, auto &, auto &) {
+      EXPECT_TRUE (processor_->parameter_ramp (*linear).is_constant ());
+      EXPECT_TRUE (processor_->parameter_ramp (*exp).is_constant ());
+    });
+  processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+}
+
+TEST_F (ProcessorBaseTest, SkipsProcessingOnceTailOfSilentInputElapsed)
+{
+  processor_->tail_length_ = units::samples (256u);
+  processor_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+
+  auto input_port =
+    processor_->get_input_ports ()[0].get_object_as<dsp::AudioPort> ();
+  auto output_port =
+    processor_->get_output_ports ()[0].get_object_as<dsp::AudioPort> ();
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256));
+  const auto process = [&] () {
+    processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  };
+
+  // signal, then the tail
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .Times (2);
+  input_port->set_silent (false);
+  process ();
+  input_port->set_silent (true);
+  process ();
+  EXPECT_FALSE (output_port->is_silent ());
+
+  // the tail elapsed
+  process ();
+  EXPECT_TRUE (output_port->is_silent ());
+  ::testing::Mock::VerifyAndClearExpectations (processor_.get ());
+
+  // processing resumes as soon as there is signal again
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .Times (1);
+  input_port->set_silent (false);
+  process ();
+  EXPECT_FALSE (output_port->is_silent ());
+}
+
+TEST_F (ProcessorBaseTest, NeverSkipsProcessingWithoutTail)
+{
+  processor_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+
+  auto input_port =
+    processor_->get_input_ports ()[0].get_object_as<dsp::AudioPort> ();
+  auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), units::samples (256));
+
+  EXPECT_CALL (
+    *processor_, custom_process_block (::testing::_, ::testing::_, ::testing::_))
+    .Times (3);
+  for (int i = 0; i < 3; ++i)
+    {
+      input_port->set_silent (true);
+      processor_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+    }
+}
+
 TEST_F (ProcessorBaseTest, EdgeCases)
 {
   processor_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
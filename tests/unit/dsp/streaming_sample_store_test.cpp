@@ -0,0 +1,318 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <filesystem>
+#include <vector>
+
+#include "dsp/panning.h"
+#include "dsp/streaming_sample_store.h"
+#include "utils/exceptions.h"
+#include "utils/io_utils.h"
+#include "utils/utf8_string.h"
+
+#include <gtest/gtest.h>
+
+namespace zrythm::dsp
+{
+
+namespace
+{
+constexpr int SAMPLE_RATE = 48000;
+constexpr int NUM_FRAMES = 10000;
+constexpr int PAGE_FRAMES = 1024;
+
+float
+expected_left (int64_t frame)
+{
+  return static_cast<float> (frame % 1000) / 1000.f;
+}
+
+float
+expected_right (int64_t frame)
+{
+  return -expected_left (frame);
+}
+
+void
+write_wav (
+  const std::filesystem::path   &path,
+  const juce::AudioSampleBuffer &buf)
+{
+  juce::WavAudioFormat                format;
+  std::unique_ptr<juce::OutputStream> out_stream =
+    std::make_unique<juce::FileOutputStream> (
+      utils::Utf8String::from_path (path).to_juce_file ());
+  ASSERT_TRUE (
+    dynamic_cast<juce::FileOutputStream &> (*out_stream).openedOk ());
+  juce::AudioFormatWriterOptions options;
+  options =
+    options.withSampleRate (SAMPLE_RATE)
+      .withNumChannels (buf.getNumChannels ())
+      .withBitsPerSample (32)
+      .withQualityOptionIndex (0);
+  auto writer = format.createWriterFor (out_stream, options);
+  ASSERT_NE (writer, nullptr);
+  writer->writeFromAudioSampleBuffer (buf, 0, buf.getNumSamples ());
+}
+}
+
+class StreamingSampleStoreTest : public ::testing::Test
+{
+protected:
+  void SetUp () override
+  {
+    temp_dir_obj_ = utils::io::make_tmp_dir ();
+    const auto temp_dir =
+      utils::Utf8String::from_qstring (temp_dir_obj_->path ()).to_path ();
+
+    stereo_wav_ = temp_dir / "stereo.wav";
+    juce::AudioSampleBuffer stereo (2, NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; ++i)
+      {
+        stereo.setSample (0, i, expected_left (i));
+        stereo.setSample (1, i, expected_right (i));
+      }
+    write_wav (stereo_wav_, stereo);
+
+    mono_wav_ = temp_dir / "mono.wav";
+    juce::AudioSampleBuffer mono (1, NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; ++i)
+      {
+        mono.setSample (0, i, 1.f);
+      }
+    write_wav (mono_wav_, mono);
+  }
+
+  static StreamingSampleStore::Options small_pages ()
+  {
+    return {
+      .page_frames_ = PAGE_FRAMES, .read_ahead_pages_ = 1, .keep_passes_ = 2
+    };
+  }
+
+  std::unique_ptr<StreamingSampleStore> open_stereo ()
+  {
+    return std::make_unique<StreamingSampleStore> (
+      stereo_wav_, units::sample_rate (SAMPLE_RATE), small_pages ());
+  }
+
+  std::unique_ptr<QTemporaryDir> temp_dir_obj_;
+  std::filesystem::path          stereo_wav_;
+  std::filesystem::path          mono_wav_;
+};
+
+TEST_F (StreamingSampleStoreTest, ReadsMetadata)
+{
+  auto store = open_stereo ();
+  EXPECT_EQ (store->num_frames (), units::samples (NUM_FRAMES));
+  EXPECT_EQ (store->sample_rate (), units::sample_rate (SAMPLE_RATE));
+  EXPECT_EQ (store->bit_depth (), 32);
+
+  // only the first page is loaded up front
+  EXPECT_EQ (store->stats ().resident_pages, 1);
+  EXPECT_EQ (store->stats ().pages_loaded, 1);
+}
+
+TEST_F (StreamingSampleStoreTest, SampleRateMismatchThrows)
+{
+  EXPECT_THROW (
+    StreamingSampleStore (stereo_wav_, units::sample_rate (44100)),
+    utils::exceptions::ZrythmException);
+}
+
+TEST_F (StreamingSampleStoreTest, NonExistentFileThrows)
+{
+  EXPECT_THROW (
+    StreamingSampleStore (
+      stereo_wav_.parent_path () / "missing.wav",
+      units::sample_rate (SAMPLE_RATE)),
+    utils::exceptions::ZrythmException);
+}
+
+TEST_F (StreamingSampleStoreTest, FirstPageIsAlwaysAvailable)
+{
+  auto               store = open_stereo ();
+  std::vector<float> left (256);
+  std::vector<float> right (256);
+
+  EXPECT_TRUE (store->read (units::samples (100), left, right));
+  EXPECT_FLOAT_EQ (left[0], expected_left (100));
+  EXPECT_FLOAT_EQ (right[255], expected_right (355));
+
+  // the first page is never unloaded
+  for (int i = 0; i < 10; ++i)
+    {
+      store->prefetch ();
+    }
+  EXPECT_TRUE (store->read (units::samples (0), left, right));
+  EXPECT_EQ (store->stats ().underruns, 0);
+}
+
+TEST_F (StreamingSampleStoreTest, ReadingUnloadedPageUnderruns)
+{
+  auto               store = open_stereo ();
+  std::vector<float> left (256, 1.f);
+  std::vector<float> right (256, 1.f);
+
+  EXPECT_FALSE (store->read (units::samples (5000), left, right));
+  for (size_t i = 0; i < left.size (); ++i)
+    {
+      EXPECT_EQ (left[i], 0.f);
+      EXPECT_EQ (right[i], 0.f);
+    }
+
+  const auto stats = store->stats ();
+  EXPECT_EQ (stats.underruns, 1);
+  EXPECT_EQ (stats.underrun_frames, 256);
+
+  store->reset_stats ();
+  EXPECT_EQ (store->stats ().underruns, 0);
+}
+
+TEST_F (StreamingSampleStoreTest, PrefetchLoadsPagesThatWereRead)
+{
+  auto               store = open_stereo ();
+  std::vector<float> left (256);
+  std::vector<float> right (256);
+
+  EXPECT_FALSE (store->read (units::samples (5000), left, right));
+  store->prefetch ();
+  EXPECT_TRUE (store->read (units::samples (5000), left, right));
+  for (size_t i = 0; i < left.size (); ++i)
+    {
+      const auto frame = 5000 + static_cast<int64_t> (i);
+      EXPECT_FLOAT_EQ (left[i], expected_left (frame));
+      EXPECT_FLOAT_EQ (right[i], expected_right (frame));
+    }
+}
+
+TEST_F (StreamingSampleStoreTest, RequestPrefetchesAhead)
+{
+  auto store = open_stereo ();
+  store->request (units::samples (5000));
+  store->prefetch ();
+
+  // the requested page and the read-ahead page are available
+  std::vector<float> left (PAGE_FRAMES);
+  std::vector<float> right (PAGE_FRAMES);
+  EXPECT_TRUE (store->read (units::samples (5000), left, right));
+  EXPECT_FLOAT_EQ (left.back (), expected_left (5000 + PAGE_FRAMES - 1));
+  EXPECT_EQ (store->stats ().underruns, 0);
+}
+
+TEST_F (StreamingSampleStoreTest, ReadPastEndOutputsSilence)
+{
+  auto store = open_stereo ();
+  store->request (units::samples (NUM_FRAMES - 100));
+  store->prefetch ();
+
+  std::vector<float> left (256, 1.f);
+  std::vector<float> right (256, 1.f);
+  EXPECT_TRUE (store->read (units::samples (NUM_FRAMES - 100), left, right));
+  EXPECT_FLOAT_EQ (left[99], expected_left (NUM_FRAMES - 1));
+  EXPECT_EQ (left[100], 0.f);
+  EXPECT_EQ (right.back (), 0.f);
+}
+
+TEST_F (StreamingSampleStoreTest, UnusedPagesAreUnloaded)
+{
+  auto store = open_stereo ();
+  store->request (units::samples (5000));
+  store->prefetch ();
+  EXPECT_GT (store->stats ().resident_pages, 1);
+
+  // keep_passes_ is 2
+  for (int i = 0; i < 3; ++i)
+    {
+      store->prefetch ();
+    }
+  EXPECT_EQ (store->stats ().resident_pages, 1);
+}
+
+TEST_F (StreamingSampleStoreTest, ReadBlockingAcrossPages)
+{
+  auto store = open_stereo ();
+
+  juce::AudioSampleBuffer dest (2, 4000);
+  store->read_blocking (units::samples (900), 3000, dest, 1000);
+  for (int i = 0; i < 3000; ++i)
+    {
+      ASSERT_FLOAT_EQ (dest.getSample (0, 1000 + i), expected_left (900 + i));
+      ASSERT_FLOAT_EQ (dest.getSample (1, 1000 + i), expected_right (900 + i));
+    }
+
+  // pages decoded for blocking reads are not kept
+  EXPECT_EQ (store->stats ().resident_pages, 1);
+}
+
+TEST_F (StreamingSampleStoreTest, PagesAreSharedThroughPageCache)
+{
+  auto options = small_pages ();
+  options.page_cache_ = std::make_shared<DecodedPageCache> (1 << 20);
+  options.cache_source_id_ = DecodedPageCache::SourceId{ QUuid::createUuid () };
+
+  StreamingSampleStore store (
+    stereo_wav_, units::sample_rate (SAMPLE_RATE), options);
+  EXPECT_EQ (options.page_cache_->stats ().misses, 1);
+
+  // blocking reads go through the cache
+  juce::AudioSampleBuffer dest (2, 100);
+  store.read_blocking (units::samples (5000), 100, dest, 0);
+  store.read_blocking (units::samples (5000), 100, dest, 0);
+  EXPECT_EQ (options.page_cache_->stats ().misses, 2);
+  EXPECT_EQ (options.page_cache_->stats ().hits, 1);
+
+  // another store for the same source doesn't need to decode again
+  StreamingSampleStore other_store (
+    stereo_wav_, units::sample_rate (SAMPLE_RATE), options);
+  EXPECT_EQ (other_store.stats ().pages_loaded, 0);
+  EXPECT_EQ (options.page_cache_->stats ().hits, 2);
+
+  // only the read-ahead page after the cached one needs decoding
+  other_store.request (units::samples (5000));
+  other_store.prefetch ();
+  EXPECT_EQ (other_store.stats ().pages_loaded, 1);
+  EXPECT_EQ (options.page_cache_->stats ().hits, 3);
+
+  std::vector<float> left (16);
+  std::vector<float> right (16);
+  EXPECT_TRUE (other_store.read (units::samples (5000), left, right));
+  EXPECT_FLOAT_EQ (left[0], expected_left (5000));
+}
+
+TEST_F (StreamingSampleStoreTest, MonoFileIsConvertedToStereo)
+{
+  StreamingSampleStore store (
+    mono_wav_, units::sample_rate (SAMPLE_RATE), small_pages ());
+
+  const auto [expected_gain, _] =
+    calculate_panning (PanLaw::Minus3dB, PanAlgorithm::SquareRoot, 0.5f);
+  std::vector<float> left (16);
+  std::vector<float> right (16);
+  EXPECT_TRUE (store.read (units::samples (0), left, right));
+  EXPECT_FLOAT_EQ (left[0], expected_gain);
+  EXPECT_FLOAT_EQ (right[15], expected_gain);
+}
+
+TEST_F (StreamingSampleStoreTest, PrefetcherPrefetchesAddedStores)
+{
+  std::shared_ptr<StreamingSampleStore> store = open_stereo ();
+  StreamingPrefetcher prefetcher (std::chrono::hours (1));
+  prefetcher.add_store (store);
+
+  store->request (units::samples (5000));
+  prefetcher.prefetch_now ();
+
+  std::vector<float> left (256);
+  std::vector<float> right (256);
+  EXPECT_TRUE (store->read (units::samples (5000), left, right));
+  EXPECT_EQ (
+    prefetcher.stats ().resident_pages, store->stats ().resident_pages);
+
+  // destroyed stores are forgotten
+  store.reset ();
+  prefetcher.prefetch_now ();
+  EXPECT_EQ (prefetcher.stats ().resident_pages, 0);
+}
+
+} // namespace zrythm::dsp
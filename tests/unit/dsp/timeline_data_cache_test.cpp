@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: © 2025-2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <algorithm>
+#include <ranges>
+
 #include "dsp/midi_event.h"
 #include "dsp/timeline_data_cache.h"
 #include "utils/midi.h"
@@ -544,6 +547,88 @@ TEST_F (MidiTimelineDataCacheTest, ConstCorrectness)
       decltype (cache->midi_events ()), std::span<const SampleBasedMidiEvent>>);
 }
 
+TEST_F (MidiTimelineDataCacheTest, IncrementalEditsMatchFullRebuild)
+{
+  const auto add_clip = [] (auto &target, int start, midi_byte_t pitch) {
+    target.add_midi_sequence (
+      { units::samples (start), units::samples (start + 100) },
+      std::vector{
+        midi_event::make_note_on (0, pitch, 127, units::samples (start + 20)),
+        midi_event::make_note_off (0, pitch, units::samples (start + 40)),
+        midi_event::make_note_on (0, pitch, 127, units::samples (start + 40)),
+        midi_event::make_note_off (0, pitch, units::samples (start + 90)),
+      });
+  };
+  const auto pitch_for_clip = [] (int index) {
+    return static_cast<midi_byte_t> (60 + index);
+  };
+
+  for (int i = 0; i < 8; ++i)
+    {
+      add_clip (*cache, i * 100, pitch_for_clip (i));
+    }
+  cache->finalize_changes ();
+
+  // Replace one clip, remove another, overwrite a third in place and add an
+  // overlapping one
+  cache->remove_sequences_matching_interval (
+    { units::samples (300), units::samples (301) });
+  add_clip (*cache, 300, 72);
+  cache->remove_sequences_matching_interval (
+    { units::samples (700), units::samples (701) });
+  add_clip (*cache, 0, 49);
+  add_clip (*cache, 50, 48);
+  cache->finalize_changes ();
+
+  MidiTimelineDataCache expected;
+  add_clip (expected, 0, 49);
+  add_clip (expected, 50, 48);
+  for (int i = 1; i < 7; ++i)
+    {
+      add_clip (expected, i * 100, i == 3 ? 72 : pitch_for_clip (i));
+    }
+  expected.finalize_changes ();
+
+  EXPECT_EQ (cache->midi_events ().size (), 8 * 4);
+  EXPECT_TRUE (
+    std::ranges::equal (cache->midi_events (), expected.midi_events ()));
+
+  // Removing everything incrementally leaves nothing behind
+  cache->remove_sequences_matching_interval (
+    { units::samples (0), units::samples (1000) });
+  cache->finalize_changes ();
+  EXPECT_TRUE (cache->midi_events ().empty ());
+}
+
+TEST_F (MidiTimelineDataCacheTest, SameTimestampEventsAreOrderedBySequence)
+{
+  const auto note_on = [] (midi_byte_t pitch) {
+    return midi_event::make_note_on (0, pitch, 127, units::samples (10));
+  };
+  const auto note_off = [] (midi_byte_t pitch) {
+    return midi_event::make_note_off (0, pitch, units::samples (10));
+  };
+
+  cache->add_midi_sequence (
+    { units::samples (5), units::samples (50) },
+    std::vector{ note_on (63), note_off (62) });
+  cache->finalize_changes ();
+  cache->add_midi_sequence (
+    { units::samples (0), units::samples (50) },
+    std::vector{ note_on (61), note_off (60) });
+  cache->finalize_changes ();
+
+  // Non-note-ons come first, then events from earlier intervals
+  const std::vector<SampleBasedMidiEvent> expected{
+    note_off (60), note_off (62), note_on (61), note_on (63)
+  };
+  EXPECT_TRUE (std::ranges::equal (
+    cache->midi_events () | std::views::filter ([] (const auto &ev) {
+      return ev.time_ == units::samples (10);
+    }),
+    expected));
+}
+
 // ========== Audio-Specific Tests ==========
 
 class AudioTimelineDataCacheTest : public ::testing::Test
@@ -869,6 +954,289 @@ TEST_F (AudioTimelineDataCacheTest, EmptyAudioOperations)
   EXPECT_FALSE (cache->has_content ());
 }
 
+TEST_F (AudioTimelineDataCacheTest, AddLazyAudioClip)
+{
+  AudioTimelineDataCache::LazyAudioClip lazy_clip;
+  lazy_clip.frames = std::make_shared<juce::AudioSampleBuffer> (audio_buffer);
+  lazy_clip.loop_end = units::samples (256);
+  lazy_clip.source_length = units::samples (256);
+  lazy_clip.content_length = units::samples (256);
+  cache->add_lazy_audio_clip (
+    { units::samples (100), units::samples (356) }, std::move (lazy_clip));
+  cache->finalize_changes ();
+
+  ASSERT_EQ (cache->audio_clips ().size (), 1);
+  const auto &clip = cache->audio_clips ()[0];
+  EXPECT_TRUE (clip.is_lazy ());
+  EXPECT_EQ (clip.audio_buffer.getNumSamples (), 0);
+  EXPECT_EQ (clip.start_sample, units::samples (100));
+  EXPECT_EQ (clip.end_sample, units::samples (356));
+}
+
+TEST_F (AudioTimelineDataCacheTest, LazyAudioClipLoopsSourceFrames)
+{
+  // 8 source frames: 0, 1, ..., 7, looping frames 4-7 after the first pass
+  auto frames = std::make_shared<juce::AudioSampleBuffer> (2, 8);
+  for (int i = 0; i < 8; ++i)
+    {
+      frames->setSample (0, i, static_cast<float> (i));
+      frames->setSample (1, i, -static_cast<float> (i));
+    }
+
+  AudioTimelineDataCache::LazyAudioClip lazy_clip;
+  lazy_clip.frames = frames;
+  lazy_clip.clip_start = units::samples (2);
+  lazy_clip.loop_start = units::samples (4);
+  lazy_clip.loop_end = units::samples (8);
+  lazy_clip.looped = true;
+  lazy_clip.source_length = units::samples (8);
+  lazy_clip.content_length = units::samples (14);
+  lazy_clip.gain = 0.5f;
+
+  std::vector<float> left (16, 0.f);
+  std::vector<float> right (16, 0.f);
+  lazy_clip.mix (units::samples (0), left, right);
+
+  const std::array<float, 16> expected_frames = { 2, 3, 4, 5, 6, 7, 4, 5,
+                                                  6, 7, 4, 5, 6, 7, 0, 0 };
+  for (size_t i = 0; i < left.size (); ++i)
+    {
+      EXPECT_FLOAT_EQ (left[i], expected_frames[i] * 0.5f) << i;
+      EXPECT_FLOAT_EQ (right[i], -expected_frames[i] * 0.5f) << i;
+    }
+}
+
+TEST_F (AudioTimelineDataCacheTest, LazyAudioClipAppliesFades)
+{
+  auto frames = std::make_shared<juce::AudioSampleBuffer> (2, 1000);
+  for (int ch = 0; ch < 2; ++ch)
+    {
+      juce::FloatVectorOperations::fill (
+        frames->getWritePointer (ch), 1.f, 1000);
+    }
+
+  AudioTimelineDataCache::LazyAudioClip lazy_clip;
+  lazy_clip.frames = frames;
+  lazy_clip.loop_end = units::samples (1000);
+  lazy_clip.source_length = units::samples (1000);
+  lazy_clip.content_length = units::samples (1000);
+  lazy_clip.builtin_fade_frames = 10;
+  lazy_clip.fade_in_length = units::samples (100);
+  lazy_clip.fade_out_start = units::samples (800);
+  lazy_clip.fade_out_length = units::samples (200);
+
+  // mix in blocks that don't line up with the fades
+  std::vector<float> left (1000, 0.f);
+  std::vector<float> right (1000, 0.f);
+  for (size_t offset = 0; offset < left.size (); offset += 333)
+    {
+      const auto len = std::min<size_t> (333, left.size () - offset);
+      lazy_clip.mix (
+        units::samples (static_cast<int64_t> (offset)),
+        std::span (left).subspan (offset, len),
+        std::span (right).subspan (offset, len));
+    }
+
+  const auto expected_gain = [&] (int frame) {
+    float gain = 1.f;
+    if (frame < 10)
+      gain *= static_cast<float> (frame) / 10.f;
+    if (frame >= 990)
+      gain *= 1.f - static_cast<float> (frame - 990) / 10.f;
+    if (frame < 100)
+      gain *= static_cast<float> (
+        lazy_clip.fade_in_opts.get_normalized_y (frame / 100.0, false));
+    if (frame >= 800)
+      gain *= static_cast<float> (
+        lazy_clip.fade_out_opts.get_normalized_y ((frame - 800) / 200.0, true));
+    return gain;
+  };
+  for (int i = 0; i < 1000; ++i)
+    {
+      EXPECT_NEAR (left[static_cast<size_t> (i)], expected_gain (i), 1e-5f)
+        << i;
+      EXPECT_NEAR (right[static_cast<size_t> (i)], expected_gain (i), 1e-5f)
+        << i;
+    }
+  EXPECT_FLOAT_EQ (left[500], 1.f);
+}
+
+// ========== AudioClipIntervalIndex Tests ==========
+
+namespace
+{
+AudioClipIntervalIndex::Entry
+make_index_entry (int64_t start, int64_t end)
+{
+  AudioClipIntervalIndex::Entry entry;
+  entry.start_sample = units::samples (start);
+  entry.end_sample = units::samples (end);
+  return entry;
+}
+
+std::vector<int64_t>
+overlapping_starts (const auto &candidates, int64_t start, int64_t end)
+{
+  std::vector<int64_t> ret;
+  for (const AudioClipIntervalIndex::Entry &entry : candidates)
+    {
+      if (
+        entry.end_sample > units::samples (start)
+        && entry.start_sample < units::samples (end))
+        ret.push_back (entry.start_sample.in (units::samples));
+    }
+  return ret;
+}
+
+std::vector<int64_t>
+expected_overlapping_starts (
+  const AudioClipIntervalIndex &index,
+  int64_t                       start,
+  int64_t                       end)
+{
+  return overlapping_starts (index.clips (), start, end);
+}
+}
+
+TEST (AudioClipIntervalIndexTest, EmptyIndex)
+{
+  AudioClipIntervalIndex index;
+  EXPECT_TRUE (
+    index.find_overlap_candidates (units::samples (0), units::samples (256))
+      .empty ());
+  EXPECT_TRUE (
+    index.clips_starting_in (units::samples (0), units::samples (256)).empty ());
+}
+
+TEST (AudioClipIntervalIndexTest, SortsClipsByStart)
+{
+  const std::vector<AudioClipIntervalIndex::Entry> clips{
+    make_index_entry (300, 400), make_index_entry (100, 200),
+    make_index_entry (200, 300)
+  };
+  AudioClipIntervalIndex index (clips);
+  ASSERT_EQ (index.clips ().size (), 3);
+  EXPECT_EQ (index.clips ()[0].start_sample, units::samples (100));
+  EXPECT_EQ (index.clips ()[2].start_sample, units::samples (300));
+}
+
+TEST (AudioClipIntervalIndexTest, CandidatesFollowPlayback)
+{
+  // back-to-back clips of 1000 samples plus a long clip spanning many of them
+  std::vector<AudioClipIntervalIndex::Entry> clips;
+  for (int64_t i = 0; i < 100; ++i)
+    {
+      clips.push_back (make_index_entry (i * 1000, (i + 1) * 1000));
+    }
+  clips.push_back (make_index_entry (2500, 5500));
+  AudioClipIntervalIndex index (clips);
+
+  for (int64_t pos = 0; pos < 100'000; pos += 256)
+    {
+      const auto candidates = index.find_overlap_candidates (
+        units::samples (pos), units::samples (pos + 256));
+
+      // candidates include all overlapping clips
+      EXPECT_EQ (
+        overlapping_starts (candidates, pos, pos + 256),
+        expected_overlapping_starts (index, pos, pos + 256))
+        << "at position " << pos;
+
+      // and only a few others
+      EXPECT_LE (std::ranges::distance (candidates), 5);
+    }
+}
+
+TEST (AudioClipIntervalIndexTest, LongClipDoesNotAddCandidates)
+{
+  // one clip spanning the whole timeline, then many short clips
+  std::vector<AudioClipIntervalIndex::Entry> clips;
+  clips.push_back (make_index_entry (0, 1'000'000));
+  for (int64_t i = 0; i < 1000; ++i)
+    {
+      clips.push_back (make_index_entry (i * 1000, (i + 1) * 1000));
+    }
+  AudioClipIntervalIndex index (clips);
+
+  for (int64_t pos = 0; pos < 1'000'000; pos += 256)
+    {
+      const auto candidates = index.find_overlap_candidates (
+        units::samples (pos), units::samples (pos + 256));
+      EXPECT_EQ (
+        overlapping_starts (candidates, pos, pos + 256),
+        expected_overlapping_starts (index, pos, pos + 256))
+        << "at position " << pos;
+
+      // the long clip plus the short clips of a single bucket
+      EXPECT_LE (std::ranges::distance (candidates), 5)
+        << "at position " << pos;
+    }
+}
+
+TEST (AudioClipIntervalIndexTest, CandidatesOfLongRanges)
+{
+  std::vector<AudioClipIntervalIndex::Entry> clips;
+  for (int64_t i = 0; i < 100; ++i)
+    {
+      clips.push_back (make_index_entry (i * 1000, i * 1000 + 1500));
+    }
+  AudioClipIntervalIndex index (clips);
+
+  // ranges spanning several buckets list each clip once
+  for (int64_t pos = 0; pos < 100'000; pos += 3'000)
+    {
+      const auto candidates = index.find_overlap_candidates (
+        units::samples (pos), units::samples (pos + 10'000));
+      const auto starts = overlapping_starts (candidates, pos, pos + 10'000);
+      EXPECT_EQ (starts, expected_overlapping_starts (index, pos, pos + 10'000))
+        << "at position " << pos;
+    }
+}
+
+TEST (AudioClipIntervalIndexTest, CandidatesAfterSeek)
+{
+  std::vector<AudioClipIntervalIndex::Entry> clips;
+  for (int64_t i = 0; i < 100; ++i)
+    {
+      clips.push_back (make_index_entry (i * 1000, (i + 1) * 1000));
+    }
+  AudioClipIntervalIndex index (clips);
+
+  EXPECT_EQ (
+    overlapping_starts (
+      index.find_overlap_candidates (
+        units::samples (90'000), units::samples (90'256)),
+      90'000, 90'256),
+    std::vector<int64_t>{ 90'000 });
+
+  // seek backwards
+  EXPECT_EQ (
+    overlapping_starts (
+      index.find_overlap_candidates (
+        units::samples (1'900), units::samples (2'156)),
+      1'900, 2'156),
+    (std::vector<int64_t>{ 1'000, 2'000 }));
+
+  // past the end
+  EXPECT_TRUE (index
+                 .find_overlap_candidates (
+                   units::samples (200'000), units::samples (200'256))
+                 .empty ());
+}
+
+TEST (AudioClipIntervalIndexTest, ClipsStartingIn)
+{
+  const std::vector<AudioClipIntervalIndex::Entry> clips{
+    make_index_entry (0, 100), make_index_entry (500, 600),
+    make_index_entry (1000, 1100)
+  };
+  AudioClipIntervalIndex index (clips);
+  const auto             starting =
+    index.clips_starting_in (units::samples (100), units::samples (1000));
+  ASSERT_EQ (starting.size (), 1);
+  EXPECT_EQ (starting.front ().start_sample, units::samples (500));
+}
+
 // ========== Automation-Specific Tests ==========
 
 class AutomationTimelineDataCacheTest : public ::testing::Test
@@ -288,6 +288,43 @@ TEST (WaveformPeakComputationTest, ReferenceXOffsetShiftsContent)
   EXPECT_FLOAT_EQ (peaks[0][0].max, 1.0f);
 }
 
+TEST (WaveformPeakComputationTest, PeakSummaryBuffer)
+{
+  // 4 blocks of 100 frames, each stored as a min/max pair
+  constexpr int           frames_per_peak = 100;
+  juce::AudioSampleBuffer buf (1, 8);
+  const float             block_peaks[] = { -0.2f, 0.2f, -0.5f, 0.5f,
+                                            -1.0f, 1.0f, 0.0f,  0.0f };
+  for (int i = 0; i < 8; ++i)
+    buf.setSample (0, i, block_peaks[i]);
+
+  // one pixel per block
+  auto frames = compute_linear_frame_mapping (4, 4, 0, 400);
+  auto peaks =
+    compute_waveform_peaks (buf, frames, 4, 0, 0, false, frames_per_peak);
+  ASSERT_EQ (peaks.size (), 1u);
+  ASSERT_EQ (peaks[0].size (), 4u);
+  EXPECT_FLOAT_EQ (peaks[0][0].min, 0.4f);
+  EXPECT_FLOAT_EQ (peaks[0][0].max, 0.6f);
+  EXPECT_FLOAT_EQ (peaks[0][2].min, 0.0f);
+  EXPECT_FLOAT_EQ (peaks[0][2].max, 1.0f);
+  EXPECT_FLOAT_EQ (peaks[0][3].min, 0.5f);
+  EXPECT_FLOAT_EQ (peaks[0][3].max, 0.5f);
+
+  // pixels spanning two blocks
+  frames = compute_linear_frame_mapping (2, 2, 0, 400);
+  peaks = compute_waveform_peaks (buf, frames, 2, 0, 0, false, frames_per_peak);
+  EXPECT_FLOAT_EQ (peaks[0][0].min, 0.25f);
+  EXPECT_FLOAT_EQ (peaks[0][0].max, 0.75f);
+
+  // pixels narrower than a block use the whole block
+  frames = compute_linear_frame_mapping (40, 40, 0, 400);
+  peaks =
+    compute_waveform_peaks (buf, frames, 40, 0, 0, false, frames_per_peak);
+  EXPECT_FLOAT_EQ (peaks[0][25].min, 0.0f);
+  EXPECT_FLOAT_EQ (peaks[0][25].max, 1.0f);
+}
+
 // ===========================================================================
 // Non-linear frame mapping with peaks (simulated tempo ramp)
 // ===========================================================================
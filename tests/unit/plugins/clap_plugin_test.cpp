@@ -60,7 +60,9 @@ protected:
     };
   }
 
-  void load_test_plugin (std::string_view name)
+  void load_test_plugin (
+    std::string_view name,
+    bool             force_main_thread_instantiation = false)
   {
     const auto juce_desc = test_helpers::find_test_clap_plugin_by_name (
       juce::String::fromUTF8 (name.data (), static_cast<int> (name.size ())));
@@ -70,11 +72,18 @@ protected:
     auto config = std::make_unique<PluginConfiguration> ();
     config->descr_ = PluginDescriptor::from_juce_description (*juce_desc);
     ASSERT_NE (config->descr_, nullptr);
+    config->force_main_thread_instantiation_ = force_main_thread_instantiation;
 
     plugin_ =
       std::make_unique<ClapPlugin> (*registry_, create_mock_window_provider ());
-    // CLAP instantiation is synchronous
+    bool instantiation_finished = false;
+    QObject::connect (
+      plugin_.get (), &Plugin::instantiationFinished, plugin_.get (),
+      [&instantiation_finished] () { instantiation_finished = true; });
     plugin_->set_configuration (*config);
+    // main-thread instantiation is synchronous
+    ASSERT_EQ (instantiation_finished, force_main_thread_instantiation);
+    process_events_until_true ([&] () { return instantiation_finished; });
     ASSERT_FALSE (plugin_->get_output_ports ().empty ())
       << "Plugin failed to load";
 
@@ -138,6 +147,34 @@ TEST_P (ClapPluginTest, HasNativeUiIsFalseForGuiLessPlugins)
   EXPECT_FALSE (plugin_->hasNativeUi ());
 }
 
+TEST_P (ClapPluginTest, MainThreadInstantiation)
+{
+  load_test_plugin (GetParam (), true);
+  EXPECT_EQ (
+    plugin_->instantiationStatus (), Plugin::InstantiationStatus::Successful);
+  EXPECT_TRUE (plugin_->instantiation_duration ().has_value ());
+}
+
+TEST_P (ClapPluginTest, DestroyedWhileInstantiating)
+{
+  const auto name = GetParam ();
+  const auto juce_desc = test_helpers::find_test_clap_plugin_by_name (
+    juce::String::fromUTF8 (name.data (), static_cast<int> (name.size ())));
+  ASSERT_NE (juce_desc, nullptr);
+  PluginConfiguration config;
+  config.descr_ = PluginDescriptor::from_juce_description (*juce_desc);
+
+  plugin_ =
+    std::make_unique<ClapPlugin> (*registry_, create_mock_window_provider ());
+  plugin_->set_configuration (config);
+  EXPECT_EQ (
+    plugin_->instantiationStatus (), Plugin::InstantiationStatus::Pending);
+
+  // must wait for the creation on the pool before going away
+  plugin_.reset ();
+  process_events_until_timeout (std::chrono::milliseconds (50));
+}
+
 INSTANTIATE_TEST_SUITE_P (
   NoteDialects,
   ClapPluginTest,
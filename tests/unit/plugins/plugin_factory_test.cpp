@@ -37,11 +37,12 @@ protected:
   JucePlugin::CreatePluginInstanceAsyncFunc create_mock_async_func ()
   {
     return
-      [] (
+      [this] (
         const juce::PluginDescription &, double, int,
         std::function<void (
           std::unique_ptr<juce::AudioPluginInstance>, const juce::String &)>
           callback) {
+        ++num_async_instantiations_;
         // Simulate async failure for now - can be customized in tests
         callback (nullptr, "Mock plugin not found");
       };
@@ -108,6 +109,7 @@ protected:
 
   units::sample_rate_t sample_rate_{ units::sample_rate (48000) };
   units::sample_u32_t  buffer_size_{ units::samples (1024) };
+  int                  num_async_instantiations_{};
 };
 
 // Test basic factory construction
@@ -294,6 +296,28 @@ TEST_F (PluginFactoryTest, InstantiationFinishedHandlerAsync)
   EXPECT_EQ (received_ref->id (), juce_plugin_ref.id ());
 }
 
+TEST_F (PluginFactoryTest, DeferredInstantiationForDeserialization)
+{
+  auto config = create_test_configuration (Protocol::ProtocolType::VST3);
+
+  factory_->set_defer_instantiation (true);
+  auto plugin = factory_->build_for_deserialization<JucePlugin> ();
+  factory_->set_defer_instantiation (false);
+  plugin->set_configuration (*config);
+  EXPECT_EQ (num_async_instantiations_, 0);
+  EXPECT_TRUE (plugin->instantiation_deferred ());
+
+  plugin->instantiate ();
+  EXPECT_EQ (num_async_instantiations_, 1);
+  EXPECT_EQ (
+    plugin->instantiationStatus (), Plugin::InstantiationStatus::Failed);
+
+  // not deferred
+  auto other = factory_->build_for_deserialization<JucePlugin> ();
+  other->set_configuration (*config);
+  EXPECT_EQ (num_async_instantiations_, 2);
+}
+
 // Test factory dependencies are properly used
 TEST_F (PluginFactoryTest, FactoryDependenciesUsed)
 {
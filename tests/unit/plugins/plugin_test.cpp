@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: © 2025 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
+
 #include "plugins/plugin.h"
 #include "utils/object_registry.h"
 #include "utils/registry_utils.h"
@@ -58,7 +60,14 @@ public:
   std::string save_state_impl () const override { return {}; }
   void        load_state_impl (const std::string &) override { }
 
-  bool                         prepare_called_ = false;
+  std::optional<units::sample_u32_t>
+  get_plugin_tail_length () const noexcept override
+  {
+    return tail_length_;
+  }
+
+  std::optional<units::sample_u32_t> tail_length_;
+  bool                               prepare_called_ = false;
   bool                         process_called_ = false;
   units::sample_rate_t         last_sample_rate_;
   units::sample_u32_t          last_max_block_length_;
@@ -418,6 +427,107 @@ TEST_F (PluginTest, InstantiationStatusTransitions)
   EXPECT_EQ (spy.count (), 3);
 }
 
+TEST_F (PluginTest, DeferredInstantiationWaitsForInstantiate)
+{
+  auto descriptor = std::make_unique<PluginDescriptor> ();
+  descriptor->name_ = u8"Deferred Plugin";
+  PluginConfiguration config;
+  config.descr_ = std::move (descriptor);
+
+  QSignalSpy spy (plugin_.get (), &Plugin::configurationChanged);
+  plugin_->defer_instantiation ();
+  plugin_->set_configuration (config);
+  EXPECT_EQ (spy.count (), 0);
+  EXPECT_TRUE (plugin_->instantiation_deferred ());
+  EXPECT_EQ (
+    plugin_->instantiationStatus (), Plugin::InstantiationStatus::Pending);
+
+  plugin_->instantiate ();
+  plugin_->instantiate ();
+  EXPECT_EQ (spy.count (), 1);
+  EXPECT_TRUE (plugin_->instantiation_deferred ());
+
+  plugin_->trigger_instantiation_finished (true);
+  EXPECT_FALSE (plugin_->instantiation_deferred ());
+}
+
+TEST_F (PluginTest, DeferredPluginPassesThroughUntilPreparedAgain)
+{
+  auto descriptor = std::make_unique<PluginDescriptor> ();
+  descriptor->name_ = u8"Deferred Plugin";
+  PluginConfiguration config;
+  config.descr_ = std::move (descriptor);
+  plugin_->defer_instantiation ();
+  plugin_->set_configuration (config);
+  plugin_->bypassParameter ()->setBaseValue (0.0f);
+
+  const auto time_nfo =
+    dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+      units::samples (0), units::samples (512));
+  plugin_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  plugin_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_FALSE (plugin_->process_called_);
+  EXPECT_EQ (plugin_->get_tail_length (), units::samples (0u));
+
+  // instantiated but not prepared yet
+  plugin_->instantiate ();
+  plugin_->trigger_instantiation_finished (true);
+  plugin_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_FALSE (plugin_->process_called_);
+
+  plugin_->release_resources ();
+  plugin_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+  plugin_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  EXPECT_TRUE (plugin_->process_called_);
+}
+
+TEST_F (PluginTest, UninstantiatedPluginSavesLoadedState)
+{
+  plugin_->load_state ("bG9hZGVk");
+  EXPECT_EQ (plugin_->save_state (), "bG9hZGVk");
+
+  // the plugin's own state is saved once instantiated
+  plugin_->trigger_instantiation_finished (true);
+  EXPECT_TRUE (plugin_->save_state ().empty ());
+}
+
+TEST_F (PluginTest, InstantiationDurationIsRecorded)
+{
+  auto descriptor = std::make_unique<PluginDescriptor> ();
+  descriptor->name_ = u8"Timed Plugin";
+  PluginConfiguration config;
+  config.descr_ = std::move (descriptor);
+
+  EXPECT_FALSE (plugin_->instantiation_duration ().has_value ());
+  plugin_->set_configuration (config);
+  EXPECT_FALSE (plugin_->instantiation_duration ().has_value ());
+  plugin_->trigger_instantiation_finished (true);
+  ASSERT_TRUE (plugin_->instantiation_duration ().has_value ());
+  EXPECT_GE (
+    *plugin_->instantiation_duration (), std::chrono::steady_clock::duration{});
+}
+
+TEST_F (PluginTest, RequiresMainThreadInstantiation)
+{
+  PluginConfiguration config;
+  config.descr_ = std::make_unique<PluginDescriptor> ();
+  config.descr_->protocol_ = Protocol::ProtocolType::CLAP;
+  EXPECT_FALSE (config.requires_main_thread_instantiation ());
+
+  config.force_main_thread_instantiation_ = true;
+  EXPECT_TRUE (config.requires_main_thread_instantiation ());
+  const nlohmann::json j = config;
+  PluginConfiguration deserialized;
+  deserialized.descr_ = std::make_unique<PluginDescriptor> ();
+  from_json (j, deserialized);
+  EXPECT_TRUE (deserialized.requires_main_thread_instantiation ());
+
+  // JUCE creates instances on the message thread
+  config.force_main_thread_instantiation_ = false;
+  config.descr_->protocol_ = Protocol::ProtocolType::VST3;
+  EXPECT_TRUE (config.requires_main_thread_instantiation ());
+}
+
 // ============================================================================
 // Tests for configurationChanged signal contract
 // ============================================================================
@@ -499,4 +609,47 @@ TEST_F (
        "generateNewPluginPortsAndParams = false";
 }
 
+
+TEST_F (PluginTest, InstrumentTailStartsAfterLastNoteIsReleased)
+{
+  auto midi_in_ref = utils::create_object<dsp::MidiPort> (
+    *registry_, u8"MIDI In", dsp::PortFlow::Input);
+  plugin_->add_input_port (midi_in_ref);
+  auto &midi_in = *midi_in_ref.get_object_as<dsp::MidiPort> ();
+  plugin_->bypassParameter ()->setBaseValue (0.0f);
+  plugin_->prepare_for_processing (nullptr, sample_rate_, max_block_length_);
+
+  const auto time_nfo =
+    dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+      units::samples (0), units::samples (512));
+  const auto process_event = [&] (std::array<midi_byte_t, 3> event) {
+    midi_in.buffer_.push_back (units::samples (10u), event);
+    plugin_->process_block (time_nfo, *mock_transport_, *tempo_map_);
+  };
+
+  // a zero tail is not trusted for instruments
+  plugin_->tail_length_ = units::samples (0u);
+  EXPECT_EQ (plugin_->get_tail_length (), std::nullopt);
+
+  plugin_->tail_length_ = units::samples (1000u);
+  EXPECT_EQ (plugin_->get_tail_length (), units::samples (1000u));
+
+  process_event ({ 0x90, 60, 100 });
+  EXPECT_EQ (plugin_->get_tail_length (), std::nullopt);
+
+  // held by the sustain pedal
+  process_event ({ 0xB0, 64, 127 });
+  process_event ({ 0x80, 60, 0 });
+  EXPECT_EQ (plugin_->get_tail_length (), std::nullopt);
+
+  process_event ({ 0xB0, 64, 0 });
+  EXPECT_EQ (plugin_->get_tail_length (), units::samples (1000u));
+
+  // note-on with zero velocity releases the note
+  process_event ({ 0x91, 62, 100 });
+  EXPECT_EQ (plugin_->get_tail_length (), std::nullopt);
+  process_event ({ 0x91, 62, 0 });
+  EXPECT_EQ (plugin_->get_tail_length (), units::samples (1000u));
+}
+
 } // namespace zrythm::plugins
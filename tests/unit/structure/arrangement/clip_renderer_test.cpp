@@ -1551,6 +1551,200 @@ TEST_F (ClipRendererTest, SubRangeGrownTailMatchesFullRender)
     }
 }
 
+// ========== Lazy Audio Clip Tests ==========
+
+namespace
+{
+// Renders @p lazy_clip from the start for @p num_frames frames.
+juce::AudioSampleBuffer
+render_lazy_clip (
+  const dsp::AudioTimelineDataCache::LazyAudioClip &lazy_clip,
+  int                                               num_frames)
+{
+  juce::AudioSampleBuffer buffer (2, num_frames);
+  buffer.clear ();
+  lazy_clip.mix (
+    units::samples (0),
+    { buffer.getWritePointer (0), static_cast<size_t> (num_frames) },
+    { buffer.getWritePointer (1), static_cast<size_t> (num_frames) });
+  return buffer;
+}
+} // namespace
+
+TEST_F (ClipRendererTest, LazyClipMatchesRenderedBuffer)
+{
+  audio_clip->length ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (1500)).asDouble ());
+  audio_clip->setGain (0.7f);
+  audio_clip->clipStartPosition ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (100)).asDouble ());
+  audio_clip->fadeRange ()->startOffset ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (60)).asDouble ());
+  audio_clip->fadeRange ()->endOffset ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (80)).asDouble ());
+  audio_clip->fadeRange ()->fadeOutCurveOpts ()->setCurviness (0.5);
+  ASSERT_TRUE (audio_clip->looped ());
+
+  juce::AudioSampleBuffer expected;
+  ClipRenderer::serialize_to_buffer (*audio_clip, expected);
+
+  const auto lazy_clip = ClipRenderer::get_lazy_clip (*audio_clip);
+  ASSERT_TRUE (lazy_clip.has_value ());
+  const auto actual = render_lazy_clip (*lazy_clip, expected.getNumSamples ());
+  for (int ch = 0; ch < 2; ++ch)
+    {
+      for (int i = 0; i < expected.getNumSamples (); ++i)
+        {
+          ASSERT_NEAR (
+            actual.getSample (ch, i), expected.getSample (ch, i), 1e-5f)
+            << "Mismatch at channel " << ch << " sample " << i;
+        }
+    }
+}
+
+TEST_F (ClipRendererTest, LazyClipMixesFromOffset)
+{
+  audio_clip->length ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (1500)).asDouble ());
+
+  juce::AudioSampleBuffer expected;
+  ClipRenderer::serialize_to_buffer (*audio_clip, expected);
+
+  const auto lazy_clip = ClipRenderer::get_lazy_clip (*audio_clip);
+  ASSERT_TRUE (lazy_clip.has_value ());
+
+  // start before the loop end (750) and continue past the loop wrap
+  constexpr int      offset = 600;
+  constexpr int      num_frames = 300;
+  std::vector<float> left (num_frames, 1.f);
+  std::vector<float> right (num_frames, 1.f);
+  lazy_clip->mix (units::samples (offset), left, right);
+  for (int i = 0; i < num_frames; ++i)
+    {
+      // mix() adds to the output
+      ASSERT_NEAR (left[i], 1.f + expected.getSample (0, offset + i), 1e-5f);
+      ASSERT_NEAR (right[i], 1.f + expected.getSample (1, offset + i), 1e-5f);
+    }
+}
+
+TEST_F (ClipRendererTest, LazyClipSharesSourceFrames)
+{
+  // loop 500 frames of the source over a long clip
+  audio_clip->length ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (100000)).asDouble ());
+
+  const auto lazy_clip = ClipRenderer::get_lazy_clip (*audio_clip);
+  ASSERT_TRUE (lazy_clip.has_value ());
+  ASSERT_NE (lazy_clip->frames, nullptr);
+  const auto &source =
+    audio_clip->get_children_view ().front ()->file_audio_source ();
+  EXPECT_EQ (lazy_clip->frames.get (), &source.get_samples ());
+  EXPECT_EQ (lazy_clip->content_length, units::samples (100000));
+
+  juce::AudioSampleBuffer expected;
+  ClipRenderer::serialize_to_buffer (*audio_clip, expected);
+  const auto actual = render_lazy_clip (*lazy_clip, expected.getNumSamples ());
+  for (int i = 0; i < expected.getNumSamples (); i += 97)
+    {
+      ASSERT_NEAR (actual.getSample (0, i), expected.getSample (0, i), 1e-5f)
+        << "Mismatch at sample " << i;
+    }
+}
+
+TEST_F (ClipRendererTest, StretchedClipIsNotLazy)
+{
+  auto clip = create_musical_test_clip ();
+  EXPECT_FALSE (ClipRenderer::get_lazy_clip (*clip).has_value ());
+
+  // native speed
+  clip->timebaseProvider ()->setOverride (dsp::Timebase::Absolute);
+  EXPECT_TRUE (ClipRenderer::get_lazy_clip (*clip).has_value ());
+}
+
+namespace
+{
+dsp::AudioPeakSummary
+summarize_source (const AudioClip &clip)
+{
+  const auto &source =
+    clip.get_children_view ().front ()->file_audio_source ();
+  dsp::AudioPeakSummary peaks (source.get_num_channels ());
+  peaks.extend (
+    units::samples (source.get_num_frames ()),
+    [&] (units::sample_t start, int num_frames, juce::AudioSampleBuffer &dest) {
+      source.read_frames (start, num_frames, dest, 0);
+    });
+  return peaks;
+}
+} // namespace
+
+TEST_F (ClipRendererTest, PeaksCoverRenderedBuffer)
+{
+  audio_clip->length ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (3000)).asDouble ());
+  audio_clip->setGain (0.7f);
+  audio_clip->clipStartPosition ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (100)).asDouble ());
+  audio_clip->fadeRange ()->startOffset ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (600)).asDouble ());
+  audio_clip->fadeRange ()->endOffset ()->setTicks (
+    tempo_map->samples_to_tick (units::samples (800)).asDouble ());
+  ASSERT_TRUE (audio_clip->looped ());
+
+  juce::AudioSampleBuffer expected;
+  ClipRenderer::serialize_to_buffer (*audio_clip, expected);
+
+  constexpr int           frames_per_peak = 256;
+  juce::AudioSampleBuffer peaks;
+  ClipRenderer::serialize_peaks_to_buffer (
+    *audio_clip, summarize_source (*audio_clip), frames_per_peak, peaks);
+  const int num_frames = expected.getNumSamples ();
+  const int num_peaks = (num_frames + frames_per_peak - 1) / frames_per_peak;
+  ASSERT_EQ (peaks.getNumSamples (), num_peaks * 2);
+
+  // each min/max pair covers the rendered frames of its block
+  for (int ch = 0; ch < 2; ++ch)
+    {
+      for (int peak = 0; peak < num_peaks; ++peak)
+        {
+          const int  begin = peak * frames_per_peak;
+          const auto range = juce::FloatVectorOperations::findMinAndMax (
+            expected.getReadPointer (ch, begin),
+            std::min (frames_per_peak, num_frames - begin));
+          EXPECT_LE (peaks.getSample (ch, peak * 2), range.getStart () + 1e-5f)
+            << "Mismatch at channel " << ch << " peak " << peak;
+          EXPECT_GE (
+            peaks.getSample (ch, peak * 2 + 1), range.getEnd () - 1e-5f)
+            << "Mismatch at channel " << ch << " peak " << peak;
+        }
+    }
+
+  // gain is applied
+  EXPECT_NEAR (peaks.getSample (0, (num_peaks / 2) * 2 + 1), 0.7f, 1e-3f);
+}
+
+TEST_F (ClipRendererTest, StretchedClipPeaksFollowStretchedFrames)
+{
+  auto clip = create_musical_test_clip (units::bpm (100.0));
+  ASSERT_FALSE (ClipRenderer::get_lazy_clip (*clip).has_value ());
+
+  constexpr int           frames_per_peak = 256;
+  juce::AudioSampleBuffer peaks;
+  ClipRenderer::serialize_peaks_to_buffer (
+    *clip, summarize_source (*clip), frames_per_peak, peaks);
+
+  // 1600 musical ticks @ 120 BPM = 36750 samples
+  constexpr int num_peaks = (36750 + frames_per_peak - 1) / frames_per_peak;
+  ASSERT_EQ (peaks.getNumSamples (), num_peaks * 2);
+
+  // the source is a full-scale sine throughout
+  for (int peak = 1; peak < num_peaks - 1; ++peak)
+    {
+      EXPECT_NEAR (peaks.getSample (0, peak * 2), -1.f, 1e-3f);
+      EXPECT_NEAR (peaks.getSample (0, peak * 2 + 1), 1.f, 1e-3f);
+    }
+}
+
 // ========== Automation Clip Tests ==========
 
 namespace
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: © 2025 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <ranges>
+
 #include "dsp/midi_event.h"
 #include "dsp/tempo_map.h"
 #include "dsp/tempo_map_qml_adapter.h"
@@ -91,7 +93,8 @@ protected:
     int    num_samples,
     double frequency_hz = 441.0, // 441 Hz divides evenly into 44100 Hz (100
                                  // samples per period)
-    double phase_offset = M_PI / 4.0) // Start at 45 degrees to avoid zero
+    double phase_offset = M_PI / 4.0, // Start at 45 degrees to avoid zero
+    units::bpm_t source_bpm = units::bpm (120.0))
   {
     auto sample_buffer =
       std::make_unique<utils::audio::AudioBuffer> (2, num_samples);
@@ -111,7 +114,7 @@ protected:
 
     auto source_ref = utils::create_object<dsp::FileAudioSource> (
       *obj_registry_, *sample_buffer, utils::audio::BitDepth::BIT_DEPTH_32,
-      units::sample_rate (44100), units::bpm (120.0), u8"SineTestSource");
+      units::sample_rate (44100), source_bpm, u8"SineTestSource");
 
     return utils::create_object<AudioSourceObject> (
       *obj_registry_, *tempo_map_wrapper_, *obj_registry_, source_ref);
@@ -119,12 +122,14 @@ protected:
 
   // Helper function to create an audio clip
   AudioClip * create_audio_clip (
-    double start_pos_ticks,
-    double end_pos_ticks,
-    float  gain = 1.0f)
+    double       start_pos_ticks,
+    double       end_pos_ticks,
+    float        gain = 1.0f,
+    units::bpm_t source_bpm = units::bpm (120.0))
   {
     // Create a sine wave audio source
-    auto audio_source_object_ref = create_sine_wave_audio_source (4096);
+    auto audio_source_object_ref =
+      create_sine_wave_audio_source (4096, 441.0, M_PI / 4.0, source_bpm);
 
     // Create the audio clip
     auto clip_ref = utils::create_object<AudioClip> (
@@ -831,6 +836,65 @@ TEST_F (TimelineDataProviderTest, PreciseTimingVerification)
     }
 }
 
+TEST_F (TimelineDataProviderTest, UnchangedClipsAreNotRenderedAgain)
+{
+  auto clip1 = create_midi_clip (0.0, 200.0, 60);
+  auto clip2 = create_midi_clip (400.0, 600.0, 64);
+
+  std::vector<const MidiClip *> clips{ clip1, clip2 };
+
+  midi_provider_->generate_midi_events (*tempo_map_, clips, {});
+  EXPECT_EQ (midi_provider_->render_stats ().renders, 2);
+  const auto num_events = midi_provider_->midi_events ().size ();
+
+  midi_provider_->generate_midi_events (*tempo_map_, clips, {});
+  EXPECT_EQ (midi_provider_->render_stats ().renders, 2);
+  EXPECT_EQ (midi_provider_->render_stats ().reuses, 2);
+  EXPECT_EQ (midi_provider_->midi_events ().size (), num_events);
+
+  // only the edited clip is rendered again
+  auto * note = clip2->ArrangerObjectOwner<MidiNote>::get_children_view ()[0];
+  note->setPitch (67);
+  midi_provider_->generate_midi_events (*tempo_map_, clips, {});
+  EXPECT_EQ (midi_provider_->render_stats ().renders, 3);
+  EXPECT_EQ (midi_provider_->render_stats ().reuses, 3);
+
+  const auto events = midi_provider_->midi_events ();
+  ASSERT_EQ (events.size (), num_events);
+  EXPECT_EQ (utils::midi::midi_get_note_number (events.back ().data ()), 67);
+
+  // tempo changes affect all clips
+  tempo_map_->set_base_bpm (units::bpm (140.0));
+  midi_provider_->generate_midi_events (*tempo_map_, clips, {});
+  EXPECT_EQ (midi_provider_->render_stats ().renders, 5);
+}
+
+TEST_F (TimelineDataProviderTest, QueuedUpdatesArePublishedTogether)
+{
+  auto clip1 = create_midi_clip (0.0, 200.0, 60);
+  auto clip2 = create_midi_clip (400.0, 600.0, 64);
+
+  std::vector<const MidiClip *> clips{ clip1, clip2 };
+
+  midi_provider_->generate_events<MidiClip> (*tempo_map_, clips, {});
+  midi_provider_->generate_events<MidiClip> (
+    *tempo_map_, clips, utils::ExpandableTickRange{ std::pair (0.0, 200.0) });
+  midi_provider_->generate_events<MidiClip> (
+    *tempo_map_, clips, utils::ExpandableTickRange{ std::pair (400.0, 600.0) });
+  midi_provider_->wait_for_cache_updates ();
+
+  // 2 note-ons and 2 note-offs, each once
+  EXPECT_EQ (midi_provider_->midi_events ().size (), 4);
+
+  auto output_buffer = dsp::MidiEventBuffer::make_reserved ();
+  midi_provider_->process_midi_events (
+    dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+      units::samples (0), units::samples (256)),
+    dsp::ITransport::PlayState::Rolling, output_buffer);
+  ASSERT_GE (output_buffer.size (), 1);
+  EXPECT_TRUE (utils::midi::midi_is_note_on (output_buffer.front ().data ()));
+}
+
 // ========== Audio Provider Tests ==========
 
 TEST_F (TimelineDataProviderTest, AudioInitialState)
@@ -1363,6 +1427,54 @@ TEST_F (TimelineDataProviderTest, AudioPreciseTimingVerification)
   EXPECT_TRUE (has_audio);
 }
 
+TEST_F (TimelineDataProviderTest, StretchedAudioClipsAreNotStretchedAgain)
+{
+  // the source tempo differs from the project tempo so the clip is stretched
+  auto clip = create_audio_clip (0.0, 96.0, 1.0f, units::bpm (100.0));
+  ASSERT_FALSE (ClipRenderer::get_lazy_clip (*clip).has_value ());
+
+  std::vector<const AudioClip *> clips{ clip };
+  audio_provider_->generate_audio_events (*tempo_map_, clips, {});
+  EXPECT_EQ (audio_provider_->render_stats ().renders, 1);
+
+  // playback matches the clip's serialization
+  const auto expect_output_matches_clip = [&] () {
+    juce::AudioSampleBuffer expected;
+    ClipRenderer::serialize_to_buffer (*clip, expected);
+    ASSERT_GT (expected.getNumSamples (), 0);
+
+    const auto nframes = static_cast<size_t> (expected.getNumSamples ());
+    std::vector<float> output_left (nframes, 0.0f);
+    std::vector<float> output_right (nframes, 0.0f);
+    audio_provider_->process_audio_events (
+      dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+        units::samples (0), units::samples (static_cast<int64_t> (nframes))),
+      dsp::ITransport::PlayState::Rolling, output_left, output_right);
+    for (const auto i : std::views::iota (0zu, nframes))
+      {
+        EXPECT_NEAR (
+          output_left[i], expected.getSample (0, static_cast<int> (i)), 1e-5f)
+          << "At sample " << i;
+        EXPECT_NEAR (
+          output_right[i], expected.getSample (1, static_cast<int> (i)), 1e-5f)
+          << "At sample " << i;
+      }
+  };
+  expect_output_matches_clip ();
+
+  // gain is applied during playback
+  clip->setGain (0.5f);
+  audio_provider_->generate_audio_events (*tempo_map_, clips, {});
+  EXPECT_EQ (audio_provider_->render_stats ().renders, 1);
+  EXPECT_EQ (audio_provider_->render_stats ().reuses, 1);
+  expect_output_matches_clip ();
+
+  // the stretch depends on the tempo
+  tempo_map_->set_base_bpm (units::bpm (140.0));
+  audio_provider_->generate_audio_events (*tempo_map_, clips, {});
+  EXPECT_EQ (audio_provider_->render_stats ().renders, 2);
+}
+
 TEST_F (TimelineDataProviderTest, AudioBasicFunctionality)
 {
   // Test that the provider can be constructed
@@ -2336,4 +2448,50 @@ TEST_F (TimelineDataProviderTest, AutomationProviderLogarithmicCurvinessZero)
     << "Logarithmic at curviness 0 must not linearize to 0.5 at midpoint";
 }
 
+// Filling a block at once must produce the same values as evaluating each
+// sample, including across clip boundaries, gaps (latched values) and
+// tempo-ramp subdivisions.
+TEST_F (TimelineDataProviderTest, AutomationProviderBlockFillMatchesPerSample)
+{
+  tempo_map_->add_tempo_event (
+    units::ticks (0), units::bpm (120.0), dsp::TempoMap::CurveType::Linear);
+  tempo_map_->add_tempo_event (
+    units::ticks (3840), units::bpm (90.0), dsp::TempoMap::CurveType::Constant);
+
+  auto * ascending = create_automation_clip (960.0, 3840.0, 0.1f, 0.9f);
+  ascending->get_children_view ()[0]->curveOpts ()->setCurviness (0.5);
+  auto * descending = create_automation_clip (5760.0, 7680.0, 0.8f, 0.2f);
+  auto * descending_ap = descending->get_children_view ()[0];
+  descending_ap->curveOpts ()->setAlgorithm (
+    dsp::CurveOptions::Algorithm::Vital);
+  descending_ap->curveOpts ()->setCurviness (-0.3);
+
+  std::vector<const AutomationClip *> clips{ ascending, descending };
+  utils::ExpandableTickRange          range (std::pair (0.0, 9600.0));
+  automation_provider_->generate_automation_events (*tempo_map_, clips, range);
+
+  constexpr float kNoValue = -1.f;
+  const auto      end_sample = tempo_map_->tick_to_samples_rounded (
+    dsp::TimelineTick{ units::ticks (9600.0) });
+  std::vector<float> values (1000);
+  int                num_mismatches = 0;
+  for (
+    auto block_start = units::samples (0); block_start < end_sample;
+    block_start += units::samples (values.size ()))
+    {
+      std::ranges::fill (values, kNoValue);
+      automation_provider_->fill_automation_values_rt (block_start, values);
+      for (size_t i = 0; i < values.size (); ++i)
+        {
+          const auto expected =
+            automation_provider_
+              ->get_automation_value_rt (block_start + units::samples (i))
+              .value_or (kNoValue);
+          if (std::abs (values[i] - expected) > 1e-5f)
+            ++num_mismatches;
+        }
+    }
+  EXPECT_EQ (num_mismatches, 0);
+}
+
 } // namespace zrythm::structure::arrangement
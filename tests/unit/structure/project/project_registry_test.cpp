@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
+#include <vector>
+
 #include "dsp/audio_port.h"
 #include "dsp/cv_port.h"
 #include "dsp/file_audio_source.h"
@@ -451,4 +454,70 @@ TEST_F (ProjectRegistryTest, ToJsonRoundTripEmptyRegistry)
   EXPECT_TRUE (j.contains ("fileAudioSources"));
 }
 
+// ============================================================================
+// Change tracking
+// ============================================================================
+
+TEST_F (ProjectRegistryTest, TakeChangesRecordsPropertyChanges)
+{
+  auto param = std::make_unique<dsp::ProcessorParameter> (
+    *registry_, dsp::ProcessorParameter::UniqueId{},
+    dsp::ParameterRange (dsp::ParameterRange::Type::Linear, 0.f, 1.f, 0.f, 0.01f),
+    u8"gain");
+  auto * raw = param.get ();
+  auto   uuid = param->raw_uuid ();
+  registry_->register_object (*param);
+  param.release ();
+
+  registry_->start_change_tracking ();
+  EXPECT_TRUE (registry_->take_changes ().empty ());
+
+  raw->setBaseValue (0.5f);
+  const auto changes = registry_->take_changes ();
+  EXPECT_EQ (changes.changed, std::vector{ uuid });
+  EXPECT_TRUE (changes.removed.empty ());
+  EXPECT_TRUE (registry_->take_changes ().empty ());
+}
+
+TEST_F (ProjectRegistryTest, TakeChangesRecordsAddedAndRemovedObjects)
+{
+  registry_->start_change_tracking ();
+
+  auto port = std::make_unique<dsp::AudioPort> (
+    u8"port", dsp::PortFlow::Input, dsp::AudioPort::BusLayout{}, 2,
+    dsp::AudioPort::Purpose::Main);
+  auto uuid = port->raw_uuid ();
+  registry_->register_object (*port);
+  port.release ();
+  registry_->acquire_reference (uuid);
+  EXPECT_EQ (registry_->take_changes ().changed, std::vector{ uuid });
+
+  registry_->release_reference (uuid);
+  const auto changes = registry_->take_changes ();
+  EXPECT_TRUE (changes.changed.empty ());
+  EXPECT_EQ (changes.removed, std::vector{ uuid });
+}
+
+TEST_F (ProjectRegistryTest, SerializeObjectsKeysByBucketAndId)
+{
+  auto port = std::make_unique<dsp::AudioPort> (
+    u8"port", dsp::PortFlow::Input, dsp::AudioPort::BusLayout{}, 2,
+    dsp::AudioPort::Purpose::Main);
+  auto port_uuid = port->raw_uuid ();
+  registry_->register_object (*port);
+  port.release ();
+
+  auto cv_port = std::make_unique<dsp::CVPort> (u8"cv", dsp::PortFlow::Output);
+  registry_->register_object (*cv_port);
+  cv_port.release ();
+
+  const std::array ids{ port_uuid };
+  const auto       j = registry_->serialize_objects (ids);
+  ASSERT_EQ (j.size (), 1u);
+  ASSERT_EQ (j["ports"].size (), 1u);
+  const auto key = nlohmann::json (port_uuid).get<std::string> ();
+  ASSERT_TRUE (j["ports"].contains (key));
+  EXPECT_EQ (j["ports"][key]["id"].get<QUuid> (), port_uuid);
+}
+
 } // namespace zrythm::structure::project
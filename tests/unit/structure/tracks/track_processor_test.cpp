@@ -3,6 +3,7 @@
 
 #include <array>
 
+#include "dsp/fader.h"
 #include "dsp/midi_event.h"
 #include "dsp/tempo_map.h"
 #include "structure/arrangement/arranger_object_all.h"
@@ -2198,4 +2199,61 @@ TEST_F (TrackProcessorTest, MidiOutputSortedNoteOffBeforeNoteOnAtSameTimestamp)
   EXPECT_TRUE (is_note_on (*it)) << "Fourth event at t=10 should be note-on";
 }
 
+
+TEST_F (TrackProcessorTest, AudioTrackWithoutClipsSilencesDownstreamFader)
+{
+  TrackProcessor processor (
+    *tempo_map_, dsp::PortType::Audio, [] { return u8"Audio Track"; },
+    [] { return true; }, TrackProcessor::Capabilities::AudioTrack, *registry_);
+  dsp::Fader fader (
+    *registry_, dsp::PortType::Audio, false, true,
+    [] { return u8"Audio Track"; }, [] (bool) { return false; });
+
+  dsp::graph::Graph graph;
+  dsp::ProcessorGraphBuilder::add_nodes (graph, processor);
+  dsp::ProcessorGraphBuilder::add_nodes (graph, fader);
+  dsp::ProcessorGraphBuilder::add_connections (graph, processor);
+  dsp::ProcessorGraphBuilder::add_connections (graph, fader);
+  auto &nodes = graph.get_nodes ();
+  nodes.find_node_for_processable (processor.get_stereo_out_port ())
+    ->connect_to (
+      *nodes.find_node_for_processable (fader.get_stereo_in_port ()));
+  graph.finalize_nodes ();
+  for (auto * node : nodes.topological_order_)
+    {
+      node->get_processable ().prepare_for_processing (
+        node, sample_rate_, block_length_);
+    }
+
+  ON_CALL (*transport_, get_play_state ())
+    .WillByDefault (::testing::Return (dsp::ITransport::PlayState::Rolling));
+  const auto time_nfo = dsp::graph::ProcessBlockInfo::from_position_and_nframes (
+    units::samples (0), block_length_);
+  const auto run_cycle = [&] () {
+    for (auto * node : nodes.topological_order_)
+      {
+        node->process (time_nfo, units::samples (0), *transport_, *tempo_map_);
+      }
+  };
+
+  // nothing playing and no input: the track marks its output silent
+  run_cycle ();
+  EXPECT_TRUE (processor.get_stereo_out_port ().is_silent ());
+  EXPECT_TRUE (fader.get_stereo_in_port ().is_silent ());
+  // the fader still runs once to pick up its initial parameter values
+  EXPECT_FALSE (fader.get_stereo_out_port ().is_silent ());
+
+  // then it is skipped and passes the silence on
+  run_cycle ();
+  const auto &out_buf = fader.get_stereo_out_port ().buffers ();
+  EXPECT_TRUE (fader.get_stereo_out_port ().is_silent ());
+  for (const auto ch : { 0, 1 })
+    {
+      for (const auto i : std::views::iota (0, out_buf->getNumSamples ()))
+        {
+          EXPECT_EQ (out_buf->getSample (ch, i), 0.f);
+        }
+    }
+}
+
 } // namespace zrythm::structure::tracks
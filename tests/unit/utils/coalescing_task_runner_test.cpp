@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <atomic>
+#include <optional>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "utils/coalescing_task_runner.h"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+namespace zrythm::utils
+{
+
+class CoalescingTaskRunnerTest : public ::testing::Test
+{
+protected:
+  /**
+   * @brief Returns a task that blocks until @ref release_ is released.
+   */
+  CoalescingTaskRunner::Task make_blocking_task ()
+  {
+    return [this] () {
+      started_.release ();
+      release_.acquire ();
+    };
+  }
+
+  QThreadPool                pool_;
+  std::binary_semaphore      started_{ 0 };
+  std::binary_semaphore      release_{ 0 };
+  std::atomic<int>           num_commits_{ 0 };
+  std::vector<int>           order_;
+  CoalescingTaskRunner::Task count_commit_ = [this] () { ++num_commits_; };
+};
+
+TEST_F (CoalescingTaskRunnerTest, RunsTaskAndCommits)
+{
+  CoalescingTaskRunner runner (count_commit_, &pool_);
+  runner.queue ([this] () { order_.push_back (1); });
+  runner.wait ();
+
+  EXPECT_EQ (order_, std::vector{ 1 });
+  EXPECT_EQ (num_commits_, 1);
+  EXPECT_FALSE (runner.is_busy ());
+  EXPECT_EQ (runner.stats ().tasks_run, 1);
+  EXPECT_EQ (runner.stats ().commits, 1);
+}
+
+TEST_F (CoalescingTaskRunnerTest, TasksQueuedWhileBusyAreCommittedOnce)
+{
+  CoalescingTaskRunner runner (count_commit_, &pool_);
+  runner.queue (make_blocking_task ());
+  started_.acquire ();
+
+  runner.queue ([this] () { order_.push_back (1); });
+  runner.queue ([this] () { order_.push_back (2); });
+  EXPECT_TRUE (runner.is_busy ());
+  release_.release ();
+  runner.wait ();
+
+  // the first batch's commit is superseded by the second batch
+  EXPECT_EQ (order_, (std::vector{ 1, 2 }));
+  EXPECT_EQ (num_commits_, 1);
+  const auto stats = runner.stats ();
+  EXPECT_EQ (stats.tasks_run, 3);
+  EXPECT_EQ (stats.commits_skipped, 1);
+}
+
+TEST_F (CoalescingTaskRunnerTest, QueueReplacingPendingDropsTasksNotStarted)
+{
+  CoalescingTaskRunner runner (count_commit_, &pool_);
+  runner.queue (make_blocking_task ());
+  started_.acquire ();
+
+  runner.queue ([this] () { order_.push_back (1); });
+  runner.queue ([this] () { order_.push_back (2); });
+  runner.queue_replacing_pending ([this] () { order_.push_back (3); });
+  release_.release ();
+  runner.wait ();
+
+  EXPECT_EQ (order_, std::vector{ 3 });
+  EXPECT_EQ (runner.stats ().tasks_dropped, 2);
+  EXPECT_EQ (num_commits_, 1);
+}
+
+TEST_F (CoalescingTaskRunnerTest, FailingTaskDoesNotStopQueue)
+{
+  CoalescingTaskRunner runner (count_commit_, &pool_);
+  runner.queue ([] () { throw std::runtime_error ("task failed"); });
+  runner.queue ([this] () { order_.push_back (1); });
+  runner.wait ();
+
+  EXPECT_EQ (order_, std::vector{ 1 });
+  EXPECT_GE (num_commits_, 1);
+}
+
+TEST_F (CoalescingTaskRunnerTest, DestructionDropsPendingTasks)
+{
+  std::optional<CoalescingTaskRunner> runner (
+    std::in_place, count_commit_, &pool_);
+  runner->queue (make_blocking_task ());
+  started_.acquire ();
+  runner->queue ([this] () { order_.push_back (1); });
+
+  // let the running task finish while the runner is being destroyed
+  std::jthread releaser ([this] () {
+    std::this_thread::sleep_for (50ms);
+    release_.release ();
+  });
+  runner.reset ();
+
+  EXPECT_TRUE (order_.empty ());
+  EXPECT_EQ (num_commits_, 0);
+}
+
+} // namespace zrythm::utils
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "utils/float_ranges_kernels.h"
+
+#include <gtest/gtest.h>
+
+namespace zrythm::utils::float_ranges::kernels
+{
+
+namespace
+{
+// includes sizes that leave tails for every vector width
+constexpr std::array<size_t, 12> SIZES = { 0,  1,   3,   7,    15,   16,
+                                           17, 33,  64,  127,  1000, 4096 };
+
+std::vector<float>
+make_signal (size_t size, unsigned seed)
+{
+  std::mt19937                          rng (seed);
+  std::uniform_real_distribution<float> dist (-2.f, 2.f);
+  std::vector<float>                    buf (size);
+  std::ranges::generate (buf, [&] { return dist (rng); });
+  return buf;
+}
+
+/**
+ * @brief Expects the buffers to match, allowing for differences caused by
+ * fused multiply-adds.
+ */
+void
+expect_near (
+  const std::vector<float> &actual,
+  const std::vector<float> &expected)
+{
+  ASSERT_EQ (actual.size (), expected.size ());
+  for (size_t i = 0; i < actual.size (); ++i)
+    {
+      EXPECT_NEAR (
+        actual[i], expected[i], 1e-6f * std::max (1.f, std::abs (expected[i])))
+        << "at index " << i;
+    }
+}
+}
+
+/**
+ * @brief Compares each SIMD kernel table supported by this CPU against the
+ * portable one.
+ */
+class FloatRangesKernelsTest
+    : public testing::TestWithParam<const KernelTable *>
+{
+protected:
+  const KernelTable &simd () const { return *GetParam (); }
+  const KernelTable &ref () const { return portable (); }
+};
+
+TEST_P (FloatRangesKernelsTest, ElementWise)
+{
+  for (const auto size : SIZES)
+    {
+      SCOPED_TRACE (size);
+      const auto a = make_signal (size, 1);
+      const auto b = make_signal (size, 2);
+      const auto gains = make_signal (size, 3);
+
+      auto actual = a;
+      auto expected = a;
+      simd ().fill (actual.data (), 0.25f, size);
+      ref ().fill (expected.data (), 0.25f, size);
+      expect_near (actual, expected);
+
+      actual = a;
+      expected = a;
+      simd ().clip (actual.data (), -1.f, 1.f, size);
+      ref ().clip (expected.data (), -1.f, 1.f, size);
+      expect_near (actual, expected);
+
+      simd ().copy (actual.data (), b.data (), size);
+      EXPECT_EQ (actual, b);
+
+      actual = a;
+      expected = a;
+      simd ().mul_k2 (actual.data (), 0.7f, size);
+      ref ().mul_k2 (expected.data (), 0.7f, size);
+      expect_near (actual, expected);
+
+      actual = a;
+      expected = a;
+      simd ().add2 (actual.data (), b.data (), size);
+      ref ().add2 (expected.data (), b.data (), size);
+      expect_near (actual, expected);
+
+      actual = a;
+      expected = a;
+      simd ().mul2 (actual.data (), b.data (), size);
+      ref ().mul2 (expected.data (), b.data (), size);
+      expect_near (actual, expected);
+
+      simd ().product (actual.data (), b.data (), 0.3f, size);
+      ref ().product (expected.data (), b.data (), 0.3f, size);
+      expect_near (actual, expected);
+
+      actual = a;
+      expected = a;
+      simd ().mix_product (actual.data (), b.data (), 0.3f, size);
+      ref ().mix_product (expected.data (), b.data (), 0.3f, size);
+      expect_near (actual, expected);
+
+      actual = a;
+      expected = a;
+      simd ().mix_product_gains (
+        actual.data (), b.data (), gains.data (), size);
+      ref ().mix_product_gains (
+        expected.data (), b.data (), gains.data (), size);
+      expect_near (actual, expected);
+    }
+}
+
+TEST_P (FloatRangesKernelsTest, Reductions)
+{
+  for (const auto size : SIZES)
+    {
+      SCOPED_TRACE (size);
+      const auto a = make_signal (size, 4);
+      EXPECT_EQ (
+        simd ().abs_max (a.data (), size), ref ().abs_max (a.data (), size));
+      if (size > 0)
+        {
+          EXPECT_EQ (
+            simd ().min (a.data (), size), ref ().min (a.data (), size));
+          EXPECT_EQ (
+            simd ().max (a.data (), size), ref ().max (a.data (), size));
+        }
+    }
+}
+
+TEST_P (FloatRangesKernelsTest, LinearFades)
+{
+  for (const auto size : SIZES)
+    {
+      SCOPED_TRACE (size);
+      const auto a = make_signal (size, 5);
+      const auto divisor = static_cast<float> (size + 20);
+
+      // fade in
+      auto actual = a;
+      auto expected = a;
+      simd ().linear_fade (actual.data (), 0.2f, 10.f, 1.f, divisor, size);
+      ref ().linear_fade (expected.data (), 0.2f, 10.f, 1.f, divisor, size);
+      expect_near (actual, expected);
+
+      // fade out
+      actual = a;
+      expected = a;
+      const auto first_index = divisor - 10.f;
+      simd ().linear_fade (
+        actual.data (), 0.f, first_index, -1.f, divisor, size);
+      ref ().linear_fade (
+        expected.data (), 0.f, first_index, -1.f, divisor, size);
+      expect_near (actual, expected);
+    }
+}
+
+TEST_P (FloatRangesKernelsTest, MakeMono)
+{
+  for (const auto size : SIZES)
+    {
+      SCOPED_TRACE (size);
+      auto actual_l = make_signal (size, 6);
+      auto actual_r = make_signal (size, 7);
+      auto expected_l = actual_l;
+      auto expected_r = actual_r;
+      simd ().make_mono (actual_l.data (), actual_r.data (), 0.7079f, size);
+      ref ().make_mono (expected_l.data (), expected_r.data (), 0.7079f, size);
+      expect_near (actual_l, expected_l);
+      expect_near (actual_r, expected_r);
+    }
+}
+
+TEST_P (FloatRangesKernelsTest, StereoFader)
+{
+  for (const auto size : SIZES)
+    {
+      SCOPED_TRACE (size);
+      const auto gains_l = make_signal (size, 8);
+      const auto gains_r = make_signal (size, 9);
+      for (const bool mono : { false, true })
+        {
+          auto actual_l = make_signal (size, 10);
+          auto actual_r = make_signal (size, 11);
+          auto expected_l = actual_l;
+          auto expected_r = actual_r;
+          simd ().stereo_fader (
+            actual_l.data (), actual_r.data (), gains_l.data (),
+            gains_r.data (), mono, 2.f, size);
+          ref ().stereo_fader (
+            expected_l.data (), expected_r.data (), gains_l.data (),
+            gains_r.data (), mono, 2.f, size);
+          expect_near (actual_l, expected_l);
+          expect_near (actual_r, expected_r);
+        }
+    }
+}
+
+TEST (FloatRangesKernelsSelectionTest, ActiveIsBestSupported)
+{
+  const auto tables = supported ();
+  ASSERT_FALSE (tables.empty ());
+  EXPECT_EQ (tables.front (), &portable ());
+  EXPECT_EQ (&active (), tables.back ());
+}
+
+INSTANTIATE_TEST_SUITE_P (
+  FloatRangesKernelsTest,
+  FloatRangesKernelsTest,
+  testing::ValuesIn (supported ().subspan (1)),
+  [] (const testing::TestParamInfo<const KernelTable *> &param_info) {
+    std::string name = param_info.param->name;
+    std::erase_if (name, [] (char c) { return std::isalnum (c) == 0; });
+    return name;
+  });
+
+// the CPU may not support any of the SIMD kernels
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST (FloatRangesKernelsTest);
+
+} // namespace zrythm::utils::float_ranges::kernels
@@ -88,6 +88,17 @@ TEST (FloatRangesTest, Add)
     }
 }
 
+TEST (FloatRangesTest, Multiply)
+{
+  std::array<float, 4> dest = { 1.0f, 2.0f, 3.0f, 4.0f };
+  std::array<float, 4> src = { 0.5f, -1.0f, 0.0f, 2.0f };
+  mul2 (dest, src);
+  EXPECT_FLOAT_EQ (dest[0], 0.5f);
+  EXPECT_FLOAT_EQ (dest[1], -2.0f);
+  EXPECT_FLOAT_EQ (dest[2], 0.0f);
+  EXPECT_FLOAT_EQ (dest[3], 8.0f);
+}
+
 TEST (FloatRangesTest, Product)
 {
   std::array<float, 4> src = { 1.0f, 2.0f, 3.0f, 4.0f };
@@ -123,6 +134,18 @@ TEST (FloatRangesTest, MixProduct)
     }
 }
 
+TEST (FloatRangesTest, MixProductWithGains)
+{
+  std::array<float, 4> dest = { 1.0f, 2.0f, 3.0f, 4.0f };
+  std::array<float, 4> src = { 0.5f, 1.0f, 1.5f, 2.0f };
+  std::array<float, 4> gains = { 0.f, 0.25f, 0.5f, 1.f };
+  mix_product (dest, src, gains);
+  for (int i = 0; i < 4; i++)
+    {
+      EXPECT_FLOAT_EQ (dest[i], (i + 1) + (i + 1) * 0.5f * gains[i]);
+    }
+}
+
 TEST (FloatRangesTest, Reverse)
 {
   std::array<float, 4> src = { 1.0f, 2.0f, 3.0f, 4.0f };
@@ -179,6 +202,32 @@ TEST (FloatRangesTest, MakeMono)
     }
 }
 
+TEST (FloatRangesTest, StereoFader)
+{
+  std::array<float, 4>       l = { 1.0f, 1.0f, 1.0f, 1.0f };
+  std::array<float, 4>       r = { 1.0f, 1.0f, 1.0f, 1.0f };
+  const std::array<float, 4> gains_l = { 0.5f, 1.0f, 3.0f, -1.0f };
+  const std::array<float, 4> gains_r = { 0.25f, 0.0f, 1.0f, -3.0f };
+
+  stereo_fader (l, r, gains_l, gains_r, false, 2.0f);
+  EXPECT_FLOAT_EQ (l[0], 0.5f);
+  EXPECT_FLOAT_EQ (r[0], 0.25f);
+  EXPECT_FLOAT_EQ (r[1], 0.0f);
+  EXPECT_FLOAT_EQ (l[2], 2.0f);
+  EXPECT_FLOAT_EQ (l[3], -1.0f);
+  EXPECT_FLOAT_EQ (r[3], -2.0f);
+
+  l = { 1.0f, 2.0f, 3.0f, 4.0f };
+  r = { 3.0f, 2.0f, 1.0f, 0.0f };
+  const std::array<float, 4> unity = { 1.0f, 1.0f, 1.0f, 1.0f };
+  stereo_fader (l, r, unity, unity, true);
+  for (int i = 0; i < 4; i++)
+    {
+      EXPECT_FLOAT_EQ (l[i], 2.0f);
+      EXPECT_FLOAT_EQ (r[i], 2.0f);
+    }
+}
+
 TEST (FloatRangesTest, NormalizeSilentBuffer)
 {
   std::array<float, 4> src = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: © 2024 Alexandros Theodotou <alex@zrythm.org>
 // SPDX-License-Identifier: LicenseRef-ZrythmLicense
 
+#include <array>
+#include <span>
+
 #include "utils/hash.h"
 
 #include <gtest/gtest.h>
@@ -49,3 +52,16 @@ TEST (HashTest, HashString)
   EXPECT_EQ (hash1, hash2);
   EXPECT_NE (hash1, hash3);
 }
+
+TEST (HashTest, HashCombined)
+{
+  const std::string test = "Hello World";
+  const auto        bytes = std::as_bytes (std::span (test));
+  const std::array<std::span<const std::byte>, 2> parts{
+    bytes.first (5), bytes.subspan (5)
+  };
+
+  EXPECT_EQ (
+    zrythm::utils::hash::get_combined_hash (parts),
+    zrythm::utils::hash::get_string_hash (test));
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: © 2026 Alexandros Theodotou <alex@zrythm.org>
+// SPDX-License-Identifier: LicenseRef-ZrythmLicense
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "utils/work_stealing_deque.h"
+
+#include <gtest/gtest.h>
+
+TEST (WorkStealingDequeTest, OwnerPopsLifo)
+{
+  WorkStealingDeque<int> deque (8);
+
+  EXPECT_TRUE (deque.push (1));
+  EXPECT_TRUE (deque.push (2));
+  EXPECT_TRUE (deque.push (3));
+
+  int value{};
+  EXPECT_TRUE (deque.pop (value));
+  EXPECT_EQ (value, 3);
+  EXPECT_TRUE (deque.pop (value));
+  EXPECT_EQ (value, 2);
+  EXPECT_TRUE (deque.pop (value));
+  EXPECT_EQ (value, 1);
+  EXPECT_FALSE (deque.pop (value));
+  EXPECT_TRUE (deque.empty ());
+}
+
+TEST (WorkStealingDequeTest, ThievesStealFifo)
+{
+  WorkStealingDeque<int> deque (8);
+  deque.push (1);
+  deque.push (2);
+
+  int value{};
+  EXPECT_TRUE (deque.steal (value));
+  EXPECT_EQ (value, 1);
+  EXPECT_TRUE (deque.pop (value));
+  EXPECT_EQ (value, 2);
+  EXPECT_FALSE (deque.steal (value));
+}
+
+TEST (WorkStealingDequeTest, PushFailsWhenFull)
+{
+  WorkStealingDeque<int> deque (4);
+  EXPECT_EQ (deque.capacity (), 4);
+  for (int i = 0; i < 4; ++i)
+    {
+      EXPECT_TRUE (deque.push (i));
+    }
+  EXPECT_FALSE (deque.push (42));
+
+  // reserving only grows
+  int value{};
+  while (deque.pop (value))
+    ;
+  deque.reserve (2);
+  EXPECT_EQ (deque.capacity (), 4);
+  deque.reserve (5);
+  EXPECT_EQ (deque.capacity (), 8);
+}
+
+TEST (WorkStealingDequeTest, ConcurrentStealingTakesEachItemOnce)
+{
+  constexpr int                 num_items = 100000;
+  constexpr int                 num_thieves = 4;
+  WorkStealingDeque<int>        deque (num_items);
+  std::vector<std::atomic<int>> taken (num_items);
+  std::atomic<int>              total_taken{ 0 };
+  std::atomic<bool>             done{ false };
+
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < num_thieves; ++i)
+    {
+      thieves.emplace_back ([&] () {
+        int value{};
+        while (!done.load () || !deque.empty ())
+          {
+            if (deque.steal (value))
+              {
+                taken[value].fetch_add (1);
+                total_taken.fetch_add (1);
+              }
+          }
+      });
+    }
+
+  // the owner interleaves pushes with pops
+  int value{};
+  for (int i = 0; i < num_items; ++i)
+    {
+      ASSERT_TRUE (deque.push (i));
+      if (i % 3 == 0 && deque.pop (value))
+        {
+          taken[value].fetch_add (1);
+          total_taken.fetch_add (1);
+        }
+    }
+  while (deque.pop (value))
+    {
+      taken[value].fetch_add (1);
+      total_taken.fetch_add (1);
+    }
+  done = true;
+
+  for (auto &thief : thieves)
+    {
+      thief.join ();
+    }
+
+  EXPECT_EQ (total_taken.load (), num_items);
+  for (const auto &count : taken)
+    {
+      EXPECT_EQ (count.load (), 1);
+    }
+}